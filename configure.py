@@ -26,6 +26,7 @@
 #   -omp              enable parallelization with OpenMP
 #   -hdf5             enable HDF5 output (requires the HDF5 library)
 #   --hdf5_path=path  path to HDF5 libraries (requires the HDF5 library)
+#   -plugins          enable in-situ analysis plugins (shared libraries loaded at runtime)
 #   -fft              enable FFT (requires the FFTW library)
 #   --fftw_path=path  path to FFTW libraries (requires the FFTW library)
 #   --grav=xxx        use xxx as the self-gravity solver
@@ -205,6 +206,12 @@ parser.add_argument('--hdf5_path',
                     default='',
                     help='path to HDF5 libraries')
 
+# -plugins argument
+parser.add_argument('-plugins',
+                    action='store_true',
+                    default=False,
+                    help='enable in-situ analysis plugins')
+
 # The main choices for --cxx flag, using "ctype[-suffix]" formatting, where "ctype" is the
 # major family/suite/group of compilers and "suffix" may represent variants of the
 # compiler version and/or predefined sets of compiler options. The C++ compiler front ends
@@ -749,6 +756,14 @@ if args['h5double']:
 else:
     definitions['H5_DOUBLE_PRECISION_ENABLED'] = '0'
 
+# -plugins argument: export the symbols of the executable to the plugins
+if args['plugins']:
+    definitions['PLUGINS_OPTION'] = 'ANALYSIS_PLUGINS'
+    makefile_options['LINKER_FLAGS'] += ' -rdynamic'
+    makefile_options['LIBRARY_FLAGS'] += ' -ldl'
+else:
+    definitions['PLUGINS_OPTION'] = 'NO_ANALYSIS_PLUGINS'
+
 # --cflag=[string] argument
 if args['cflag'] is not None:
     makefile_options['COMPILER_FLAGS'] += ' '+args['cflag']
@@ -828,6 +843,7 @@ print('  FFT:                        ' + ('ON' if args['fft'] else 'OFF'))
 print('  HDF5 output:                ' + ('ON' if args['hdf5'] else 'OFF'))
 if args['hdf5']:
     print('  HDF5 precision:             ' + ('double' if args['h5double'] else 'single'))
+print('  Analysis plugins:           ' + ('ON' if args['plugins'] else 'OFF'))
 print('  Compiler:                   ' + args['cxx'])
 print('  Compilation command:        ' + makefile_options['COMPILER_COMMAND'] + ' '
       + makefile_options['PREPROCESSOR_FLAGS'] + ' ' + makefile_options['COMPILER_FLAGS'])
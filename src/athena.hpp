@@ -156,6 +156,10 @@ enum TriangleIndex {T00=0, T10=1, T11=2, T20=3, T21=4, T22=5, T30=6, T31=7, T32=
 //! array indices for grid directions
 enum CoordinateDirection {X1DIR=0, X2DIR=1, X3DIR=2};
 
+//! bit masks of the variables a physics module reads (as primitives) or writes (as
+//! conserved variables), see Mesh::EnrollPhysicsModule()
+enum PhysicsVariable {kPhysNone=0, kPhysHydro=1, kPhysScalars=2, kPhysAll=3};
+
 //------------------
 // strongly typed / scoped enums (C++11):
 //------------------
@@ -170,6 +174,8 @@ enum class BoundaryCommSubset {mesh_init, gr_amr, all, orbital};
 enum class FluidFormulation {evolve, background, disabled}; // rename background -> fixed?
 enum class TaskType {op_split_before, main_int, op_split_after};
 enum class UserHistoryOperation {sum, max, min};
+//! when an enrolled physics module is applied (see PhysicsModules)
+enum class PhysicsStage {every_stage, before_step, after_step};
 
 //----------------------------------------------------------------------------------------
 // function pointer prototypes for user-defined modules set at runtime
@@ -185,8 +191,16 @@ using SrcTermFunc = void (*)(
     MeshBlock *pmb, const Real time, const Real dt, const AthenaArray<Real> &prim,
     const AthenaArray<Real> &prim_scalar, const AthenaArray<Real> &bcc,
     AthenaArray<Real> &cons, AthenaArray<Real> &cons_scalar);
+using SrcTermPencilFunc = void (*)(
+    MeshBlock *pmb, const int k, const int j, const Real time, const Real dt,
+    const AthenaArray<Real> &prim, const AthenaArray<Real> &prim_scalar,
+    const AthenaArray<Real> &bcc,
+    AthenaArray<Real> &cons, AthenaArray<Real> &cons_scalar);
 using TimeStepFunc = Real (*)(MeshBlock *pmb);
+using TimeStepPencilFunc = Real (*)(
+    MeshBlock *pmb, const int k, const int j, const AthenaArray<Real> &prim);
 using HistoryOutputFunc = Real (*)(MeshBlock *pmb, int iout);
+using OutputRegionFunc = bool (*)(MeshBlock *pmb, int block_number);
 using MetricFunc = void (*)(
     Real x1, Real x2, Real x3, ParameterInput *pin,
     AthenaArray<Real> &g, AthenaArray<Real> &g_inv,
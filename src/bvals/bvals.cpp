@@ -248,6 +248,45 @@ BoundaryValues::~BoundaryValues() {
   }
 }
 
+//----------------------------------------------------------------------------------------
+//! \fn void BoundaryValues::BuildSameLevelCopyPlans()
+//! \brief Describe the regions exchanged with each same-level neighbor as contiguous
+//!        runs once per neighbor search, instead of in every cell-centered pack/unpack
+
+void BoundaryValues::BuildSameLevelCopyPlans() {
+  MeshBlock *pmb = pmy_block_;
+  for (int b=0; b<BoundaryData<>::kMaxNeighbor; b++) {
+    cc_send_plan_[b] = BufferUtility::CopyPlan();
+    cc_recv_plan_[b] = BufferUtility::CopyPlan();
+  }
+  for (int n=0; n<nneighbor; n++) {
+    NeighborBlock& nb = neighbor[n];
+    if (nb.snb.level != pmb->loc.level) continue;
+    int si, sj, sk, ei, ej, ek;
+    si = (nb.ni.ox1 > 0) ? (pmb->ie - NGHOST + 1) : pmb->is;
+    ei = (nb.ni.ox1 < 0) ? (pmb->is + NGHOST - 1) : pmb->ie;
+    sj = (nb.ni.ox2 > 0) ? (pmb->je - NGHOST + 1) : pmb->js;
+    ej = (nb.ni.ox2 < 0) ? (pmb->js + NGHOST - 1) : pmb->je;
+    sk = (nb.ni.ox3 > 0) ? (pmb->ke - NGHOST + 1) : pmb->ks;
+    ek = (nb.ni.ox3 < 0) ? (pmb->ks + NGHOST - 1) : pmb->ke;
+    BufferUtility::BuildCopyPlan(cc_send_plan_[nb.bufid], pmb->ncells3, pmb->ncells2,
+                                 pmb->ncells1, si, ei, sj, ej, sk, ek);
+
+    if (nb.ni.ox1 == 0)     si = pmb->is,          ei = pmb->ie;
+    else if (nb.ni.ox1 > 0) si = pmb->ie + 1,      ei = pmb->ie + NGHOST;
+    else                    si = pmb->is - NGHOST, ei = pmb->is - 1;
+    if (nb.ni.ox2 == 0)     sj = pmb->js,          ej = pmb->je;
+    else if (nb.ni.ox2 > 0) sj = pmb->je + 1,      ej = pmb->je + NGHOST;
+    else                    sj = pmb->js - NGHOST, ej = pmb->js - 1;
+    if (nb.ni.ox3 == 0)     sk = pmb->ks,          ek = pmb->ke;
+    else if (nb.ni.ox3 > 0) sk = pmb->ke + 1,      ek = pmb->ke + NGHOST;
+    else                    sk = pmb->ks - NGHOST, ek = pmb->ks - 1;
+    BufferUtility::BuildCopyPlan(cc_recv_plan_[nb.bufid], pmb->ncells3, pmb->ncells2,
+                                 pmb->ncells1, si, ei, sj, ej, sk, ek);
+  }
+  return;
+}
+
 //----------------------------------------------------------------------------------------
 //! \fn void BoundaryValues::SetupPersistentMPI()
 //! \brief Setup persistent MPI requests to be reused throughout the entire simulation
@@ -256,6 +295,7 @@ BoundaryValues::~BoundaryValues() {
 //! initializes the shearing block lists
 
 void BoundaryValues::SetupPersistentMPI() {
+  BuildSameLevelCopyPlans();
   for (auto bvars_it = bvars_main_int.begin(); bvars_it != bvars_main_int.end();
        ++bvars_it) {
     (*bvars_it)->SetupPersistentMPI();
@@ -17,6 +17,7 @@
 // Athena++ headers
 #include "../athena.hpp"
 #include "../athena_arrays.hpp"
+#include "../utils/buffer_utils.hpp"
 #include "bvals_interfaces.hpp"
 
 // MPI headers
@@ -179,6 +180,12 @@ class BoundaryValues : public BoundaryBase, //public BoundaryPhysics,
   int xorder_, xgh_;
   AthenaArray<Real> pflux_;    // pencil buffer for remapping
 
+  //! interior (send) and ghost (recv) regions of each same-level neighbor as contiguous
+  //! runs, indexed by bufid; built in SetupPersistentMPI() and shared by all
+  //! cell-centered variables
+  BufferUtility::CopyPlan cc_send_plan_[BoundaryData<>::kMaxNeighbor];
+  BufferUtility::CopyPlan cc_recv_plan_[BoundaryData<>::kMaxNeighbor];
+
   std::int64_t nblx2;
   //! it is possible for a MeshBlock to have is_shear={true, true},
   //! if it is the only block along x1
@@ -207,6 +214,7 @@ class BoundaryValues : public BoundaryBase, //public BoundaryPhysics,
       std::vector<BoundaryVariable *> bvars_subset);
 
   void CheckPolarBoundaries();  // called in BoundaryValues() ctor
+  void BuildSameLevelCopyPlans();  // called in SetupPersistentMPI()
 
   // temporary--- Added by @tomidakn on 2015-11-27 in f0f989f85f
   //! \todo (felker):
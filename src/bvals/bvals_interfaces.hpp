@@ -36,6 +36,7 @@ class Coordinates;
 class BoundaryValues;
 struct RegionSize;
 struct FaceField;
+struct NodeSharedSlot;
 
 //! \todo (felker):
 //! - nest these enum definitions inside bvals/ classes, when possible.
@@ -314,6 +315,7 @@ class BoundaryPhysics {
 
 class BoundaryVariable : public BoundaryCommunication, public BoundaryBuffer,
                          public BoundaryPhysics {
+  friend class NodeSharedBuffers;
  public:
   explicit BoundaryVariable(MeshBlock *pmb);
   virtual ~BoundaryVariable() = default;
@@ -345,6 +347,19 @@ class BoundaryVariable : public BoundaryCommunication, public BoundaryBuffer,
   void CopyVariableBufferSameProcess(NeighborBlock& nb, int ssize);
   void CopyFluxCorrectionBufferSameProcess(NeighborBlock& nb, int ssize);
 
+  // mailboxes in the node shared window (NodeSharedBuffers), nullptr unless the
+  // neighbor lives on another rank of the same node: ghost data are loaded directly
+  // into the receiver's slot instead of bd_var_.send[] + MPI
+  NodeSharedSlot *shm_send_[BoundaryData<>::kMaxNeighbor]{};
+  NodeSharedSlot *shm_recv_[BoundaryData<>::kMaxNeighbor]{};
+  Real *RecvBuffer(const NeighborBlock& nb);
+
+  // same-level neighbors on this rank whose sender wrote the ghost zones directly into
+  // our array (nothing to unpack in SetBoundaries)
+  bool recv_in_place_[BoundaryData<>::kMaxNeighbor]{};
+  virtual bool CopyVariableSameLevelInPlace(BoundaryVariable *ptarget,
+                                            const NeighborBlock& nb);
+
   void InitBoundaryData(BoundaryData<> &bd, BoundaryQuantity type);
   void DestroyBoundaryData(BoundaryData<> &bd);
 
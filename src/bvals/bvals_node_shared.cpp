@@ -0,0 +1,214 @@
+//========================================================================================
+// Athena++ astrophysical MHD code
+// Copyright(C) 2014 James M. Stone <jmstone@princeton.edu> and other code contributors
+// Licensed under the 3-clause BSD License, see LICENSE file for details
+//========================================================================================
+//! \file bvals_node_shared.cpp
+//! \brief implements the on-node shared-memory ghost-zone exchange (MPI-3 windows)
+
+// C headers
+
+// C++ headers
+#include <algorithm>  // copy
+#include <cstdint>    // int64_t
+#include <new>        // placement new
+#include <vector>
+
+// Athena++ headers
+#include "../athena.hpp"
+#include "../globals.hpp"
+#include "../mesh/mesh.hpp"
+#include "bvals.hpp"
+#include "bvals_interfaces.hpp"
+#include "bvals_node_shared.hpp"
+
+// MPI headers
+#ifdef MPI_PARALLEL
+#include <mpi.h>
+#endif
+
+namespace {
+constexpr std::size_t kAlign = 64;
+std::size_t RoundUp(std::size_t n) { return (n + kAlign - 1)/kAlign*kAlign; }
+constexpr int kMaxNeighbor = BoundaryData<>::kMaxNeighbor;
+} // namespace
+
+static_assert(sizeof(NodeSharedSlot) <= NodeSharedSlot::kHeaderBytes,
+              "NodeSharedSlot header does not fit in kHeaderBytes");
+
+//----------------------------------------------------------------------------------------
+//! \fn std::size_t NodeSharedSlot::Bytes(int size)
+//! \brief size of a slot holding two buffers of size Real, padded to a cache line
+
+std::size_t NodeSharedSlot::Bytes(int size) {
+  return kHeaderBytes + RoundUp(2*static_cast<std::size_t>(size)*sizeof(Real));
+}
+
+//----------------------------------------------------------------------------------------
+//! NodeSharedBuffers constructor: split off the node communicator and record which
+//! world ranks share memory with this one
+
+NodeSharedBuffers::NodeSharedBuffers(Mesh *pm) : pmy_mesh_(pm), nbvar_(),
+    node_rank_(Globals::nranks, -1), win_allocated_(false) {
+#ifdef MPI_PARALLEL
+  MPI_Comm_split_type(MPI_COMM_WORLD, MPI_COMM_TYPE_SHARED, Globals::my_rank,
+                      MPI_INFO_NULL, &node_comm_);
+  MPI_Group world_group, node_group;
+  MPI_Comm_group(MPI_COMM_WORLD, &world_group);
+  MPI_Comm_group(node_comm_, &node_group);
+  std::vector<int> world_ranks(Globals::nranks);
+  for (int r=0; r<Globals::nranks; ++r)
+    world_ranks[r] = r;
+  MPI_Group_translate_ranks(world_group, Globals::nranks, world_ranks.data(),
+                            node_group, node_rank_.data());
+  for (int r=0; r<Globals::nranks; ++r) {
+    if (node_rank_[r] == MPI_UNDEFINED) node_rank_[r] = -1;
+  }
+  MPI_Group_free(&world_group);
+  MPI_Group_free(&node_group);
+  int node_nranks;
+  MPI_Comm_size(node_comm_, &node_nranks);
+  peer_base_.resize(node_nranks, nullptr);
+#endif
+}
+
+NodeSharedBuffers::~NodeSharedBuffers() {
+  Release();
+#ifdef MPI_PARALLEL
+  MPI_Comm_free(&node_comm_);
+#endif
+}
+
+//----------------------------------------------------------------------------------------
+//! \fn void NodeSharedBuffers::Release()
+//! \brief free the shared window (collective over the node communicator)
+
+void NodeSharedBuffers::Release() {
+#ifdef MPI_PARALLEL
+  if (win_allocated_) {
+    MPI_Win_unlock_all(win_);
+    MPI_Win_free(&win_);
+    win_allocated_ = false;
+  }
+#endif
+}
+
+//----------------------------------------------------------------------------------------
+//! \fn std::int64_t NodeSharedBuffers::SlotIndex(int lid, int bvar, int bufid) const
+//! \brief index of the slot offset in the directory at the start of each segment
+
+std::int64_t NodeSharedBuffers::SlotIndex(int lid, int bvar, int bufid) const {
+  return 2 + (static_cast<std::int64_t>(lid)*nbvar_ + bvar)*kMaxNeighbor + bufid;
+}
+
+//----------------------------------------------------------------------------------------
+//! \fn NodeSharedSlot *NodeSharedBuffers::FindSlot(int node_rank, int lid, int bvar,
+//!                                                 int bufid) const
+//! \brief look up the receive slot of (lid, bvar, bufid) in the segment of node_rank
+
+NodeSharedSlot *NodeSharedBuffers::FindSlot(int node_rank, int lid, int bvar,
+                                            int bufid) const {
+  char *base = peer_base_[node_rank];
+  if (base == nullptr) return nullptr;
+  std::int64_t *dir = reinterpret_cast<std::int64_t *>(base);
+  if (lid >= dir[0] || bvar >= dir[1]) return nullptr;
+  std::int64_t offset = dir[SlotIndex(lid, bvar, bufid)];
+  if (offset < 0) return nullptr;
+  return reinterpret_cast<NodeSharedSlot *>(base + offset);
+}
+
+//----------------------------------------------------------------------------------------
+//! \fn void NodeSharedBuffers::Setup()
+//! \brief allocate one receive slot per on-node neighbor of every local MeshBlock and
+//!        hand the slot pointers to the BoundaryVariable objects of both sides.
+//!        Called from Mesh::Initialize() on all ranks, so also after load balancing.
+
+void NodeSharedBuffers::Setup() {
+  Mesh *pm = pmy_mesh_;
+  // drop the pointers into the previous window before it is freed
+  for (int i=0; i<pm->nblocal; ++i) {
+    BoundaryValues *pbval = pm->my_blocks(i)->pbval;
+    for (auto pbvar : pbval->bvars_main_int) {
+      for (int n=0; n<kMaxNeighbor; ++n) {
+        pbvar->shm_send_[n] = nullptr;
+        pbvar->shm_recv_[n] = nullptr;
+      }
+    }
+  }
+  Release();
+#ifdef MPI_PARALLEL
+  if (peer_base_.size() < 2) return;  // nobody to share with
+
+  // directory followed by the slots of this rank
+  nbvar_ = (pm->nblocal > 0) ?
+           static_cast<int>(pm->my_blocks(0)->pbval->bvars_main_int.size()) : 0;
+  std::vector<std::int64_t> dir(SlotIndex(pm->nblocal, 0, 0), -1);
+  dir[0] = pm->nblocal;
+  dir[1] = nbvar_;
+  std::size_t nbytes = RoundUp(dir.size()*sizeof(std::int64_t));
+  for (int i=0; i<pm->nblocal; ++i) {
+    MeshBlock *pmb = pm->my_blocks(i);
+    BoundaryValues *pbval = pmb->pbval;
+    for (int n=0; n<pbval->nneighbor; ++n) {
+      NeighborBlock& nb = pbval->neighbor[n];
+      if (nb.snb.rank == Globals::my_rank || node_rank_[nb.snb.rank] < 0) continue;
+      for (int b=0; b<nbvar_; ++b) {
+        int size = pbval->bvars_main_int[b]->ComputeVariableBufferSize(
+            pbval->ni[nb.bufid], pmb->cnghost);
+        dir[SlotIndex(i, b, nb.bufid)] = nbytes;
+        nbytes += NodeSharedSlot::Bytes(size);
+      }
+    }
+  }
+
+  MPI_Info info;
+  MPI_Info_create(&info);
+  MPI_Info_set(info, "alloc_shared_noncontig", "true");
+  char *base;
+  MPI_Win_allocate_shared(static_cast<MPI_Aint>(nbytes), 1, info, node_comm_, &base,
+                          &win_);
+  MPI_Info_free(&info);
+  MPI_Win_lock_all(MPI_MODE_NOCHECK, win_);
+  win_allocated_ = true;
+
+  std::copy(dir.begin(), dir.end(), reinterpret_cast<std::int64_t *>(base));
+  for (int i=0; i<pm->nblocal; ++i) {
+    BoundaryValues *pbval = pm->my_blocks(i)->pbval;
+    for (int n=0; n<pbval->nneighbor; ++n) {
+      NeighborBlock& nb = pbval->neighbor[n];
+      for (int b=0; b<nbvar_; ++b) {
+        std::int64_t offset = dir[SlotIndex(i, b, nb.bufid)];
+        if (offset < 0) continue;
+        int size = pbval->bvars_main_int[b]->ComputeVariableBufferSize(
+            pbval->ni[nb.bufid], pm->my_blocks(i)->cnghost);
+        pbval->bvars_main_int[b]->shm_recv_[nb.bufid] =
+            new (base + offset) NodeSharedSlot(size);
+      }
+    }
+  }
+  // make the directories and zeroed counters visible before anyone looks them up
+  MPI_Win_sync(win_);
+  MPI_Barrier(node_comm_);
+  MPI_Win_sync(win_);
+
+  for (int r=0; r<static_cast<int>(peer_base_.size()); ++r) {
+    MPI_Aint size;
+    int disp_unit;
+    MPI_Win_shared_query(win_, r, &size, &disp_unit, &peer_base_[r]);
+  }
+  for (int i=0; i<pm->nblocal; ++i) {
+    BoundaryValues *pbval = pm->my_blocks(i)->pbval;
+    for (int n=0; n<pbval->nneighbor; ++n) {
+      NeighborBlock& nb = pbval->neighbor[n];
+      if (pbval->bvars_main_int.empty() || pbval->bvars_main_int[0]->shm_recv_[nb.bufid]
+          == nullptr) continue;
+      // neighbor relations are symmetric, so the target slot exists
+      for (int b=0; b<nbvar_; ++b) {
+        pbval->bvars_main_int[b]->shm_send_[nb.bufid] =
+            FindSlot(node_rank_[nb.snb.rank], nb.snb.lid, b, nb.targetid);
+      }
+    }
+  }
+#endif
+  return;
+}
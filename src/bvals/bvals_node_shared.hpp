@@ -0,0 +1,101 @@
+#ifndef BVALS_BVALS_NODE_SHARED_HPP_
+#define BVALS_BVALS_NODE_SHARED_HPP_
+//========================================================================================
+// Athena++ astrophysical MHD code
+// Copyright(C) 2014 James M. Stone <jmstone@princeton.edu> and other code contributors
+// Licensed under the 3-clause BSD License, see LICENSE file for details
+//========================================================================================
+//! \file bvals_node_shared.hpp
+//! \brief defines NodeSharedBuffers class, which replaces MPI messages between
+//!        MeshBlocks owned by different ranks on the same node by an MPI-3 shared
+//!        memory window
+
+// C headers
+
+// C++ headers
+#include <atomic>
+#include <cstdint>  // int64_t
+#include <vector>
+
+// Athena++ headers
+#include "../athena.hpp"
+
+// MPI headers
+#ifdef MPI_PARALLEL
+#include <mpi.h>
+#endif
+
+class Mesh;
+
+//----------------------------------------------------------------------------------------
+//! \struct NodeSharedSlot
+//! \brief ghost-zone mailbox of one (receiving MeshBlock, variable, neighbor) triple,
+//!        placed in the shared window of the receiving rank.
+//!
+//! The sender loads message m directly into Buffer(m) and then publishes it by a release
+//! store of nposted = m; the receiver consumes messages in order. Two alternating
+//! buffers suffice: a sender cannot post message m+2 before it has received the
+//! receiver's message m+1, which is only sent after message m has been unpacked.
+
+struct NodeSharedSlot {
+  static constexpr int kHeaderBytes = 64;
+  explicit NodeSharedSlot(int size) : nposted(0), nreceived(0), size(size) {}
+
+  std::atomic<int> nposted;  //!< number of messages written by the sender
+  int nreceived;             //!< number of messages consumed (owned by the receiver)
+  int size;                  //!< capacity of each of the two buffers, in Real
+
+  static std::size_t Bytes(int size);
+
+  Real *Buffer(int m) {
+    return reinterpret_cast<Real *>(reinterpret_cast<char *>(this) + kHeaderBytes)
+        + (m & 1)*size;
+  }
+  Real *SendBuffer() { return Buffer(nposted.load(std::memory_order_relaxed) + 1); }
+  void Post() {
+    nposted.store(nposted.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+  }
+  bool Poll() {
+    if (nposted.load(std::memory_order_acquire) > nreceived) {
+      ++nreceived;
+      return true;
+    }
+    return false;
+  }
+  Real *RecvBuffer() { return Buffer(nreceived); }
+};
+
+//----------------------------------------------------------------------------------------
+//! \class NodeSharedBuffers
+//! \brief one per Mesh; owns the node communicator and the shared window holding the
+//!        receive slots of all local MeshBlocks with on-node (but off-rank) neighbors.
+//!
+//! Only the variables in bvars_main_int (hydro, field, passive scalars) use this path,
+//! and only for the ghost-zone exchange. Flux correction, shearing box and orbital
+//! advection messages still go through MPI.
+
+class NodeSharedBuffers {
+ public:
+  explicit NodeSharedBuffers(Mesh *pm);
+  ~NodeSharedBuffers();
+
+  // collective over all ranks; rebuild the window for the current MeshBlock layout
+  void Setup();
+
+ private:
+  Mesh *pmy_mesh_;
+  int nbvar_;                       // number of variables sharing slots per MeshBlock
+  std::vector<int> node_rank_;      // node-local rank of each world rank, -1 if off-node
+#ifdef MPI_PARALLEL
+  MPI_Comm node_comm_;
+  MPI_Win win_;
+#endif
+  bool win_allocated_;
+  std::vector<char *> peer_base_;   // segment base of each node-local rank
+
+  void Release();
+  std::int64_t SlotIndex(int lid, int bvar, int bufid) const;
+  NodeSharedSlot *FindSlot(int node_rank, int lid, int bvar, int bufid) const;
+};
+
+#endif // BVALS_BVALS_NODE_SHARED_HPP_
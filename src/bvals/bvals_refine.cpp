@@ -385,10 +385,13 @@ void BoundaryValues::ApplyPhysicalBoundariesOnCoarseLevel(
   //!   no longer members of MeshRefinement that always exist (even if not allocated).
 
   // KGF: COUPLING OF QUANTITIES (must be manually specified)
+  // (the coarse buffer only fills ghost zones; do not count it in the ceiling losses)
+  pmb->peos->SetCeilingAccounting(false);
   pmb->peos->ConservedToPrimitive(ph->coarse_cons_, ph->coarse_prim_,
                                   pf->coarse_b_, ph->coarse_prim_,
                                   pf->coarse_bcc_, pmr->pcoarsec,
                                   si-f1m, ei+f1p, sj-f2m, ej+f2p, sk-f3m, ek+f3p);
+  pmb->peos->SetCeilingAccounting(true);
   
   PassiveScalars *ps = pmb->pscalars;
   if (NSCALARS > 0) {
@@ -22,6 +22,7 @@
 #include "../globals.hpp"
 #include "../mesh/mesh.hpp"
 #include "bvals_interfaces.hpp"
+#include "bvals_node_shared.hpp"
 
 // MPI header
 #ifdef MPI_PARALLEL
@@ -122,6 +123,31 @@ void BoundaryVariable::CopyVariableBufferSameProcess(NeighborBlock& nb, int ssiz
 // KGF: change ssize to send_count
 
 
+//----------------------------------------------------------------------------------------
+//! \fn bool BoundaryVariable::CopyVariableSameLevelInPlace(BoundaryVariable *ptarget,
+//!                                                         const NeighborBlock& nb)
+//! \brief Copy the ghost zones for a same-level neighbor on this process directly into
+//! the array of ptarget. Returns false if the variable has no such path, in which case
+//! the data go through bd_var_ as usual.
+
+bool BoundaryVariable::CopyVariableSameLevelInPlace(BoundaryVariable *ptarget,
+                                                    const NeighborBlock& nb) {
+  return false;
+}
+
+
+//----------------------------------------------------------------------------------------
+//! \fn Real *BoundaryVariable::RecvBuffer(const NeighborBlock& nb)
+//! \brief buffer holding the last received message from nb: the slot in the node
+//! shared window for on-node neighbors, bd_var_.recv[] otherwise
+
+Real *BoundaryVariable::RecvBuffer(const NeighborBlock& nb) {
+  if (shm_recv_[nb.bufid] != nullptr)
+    return shm_recv_[nb.bufid]->RecvBuffer();
+  return bd_var_.recv[nb.bufid];
+}
+
+
 //----------------------------------------------------------------------------------------
 //! \fn void BoundaryVariable::CopyFluxCorrectionBufferSameProcess(NeighborBlock& nb,
 //!                                                                int ssize)
@@ -216,15 +242,35 @@ void BoundaryVariable::SendBoundaryBuffers() {
   for (int n=0; n<pbval_->nneighbor; n++) {
     NeighborBlock& nb = pbval_->neighbor[n];
     if (bd_var_.sflag[nb.bufid] == BoundaryStatus::completed) continue;
+    if (nb.snb.rank == Globals::my_rank && nb.snb.level == mylevel) {
+      // same process and level: try to skip the buffers and copy straight into the
+      // ghost zones of the target; its flag still goes through "arrived". Only once the
+      // target has sent to us in this stage: before that, its integrator may still
+      // swap the registers (e.g. u <-> u1) and the copied ghost zones would be lost.
+      BoundaryVariable *ptarget =
+          pmy_mesh_->FindMeshBlock(nb.snb.gid)->pbval->bvars[bvar_index];
+      if (ptarget->bd_var_.sflag[nb.targetid] == BoundaryStatus::completed
+          && CopyVariableSameLevelInPlace(ptarget, nb)) {
+        ptarget->recv_in_place_[nb.targetid] = true;
+        ptarget->bd_var_.flag[nb.targetid] = BoundaryStatus::arrived;
+        bd_var_.sflag[nb.bufid] = BoundaryStatus::completed;
+        continue;
+      }
+    }
+    NodeSharedSlot *pslot = shm_send_[nb.bufid];
+    // on-node neighbor: load straight into its receive slot
+    Real *sbuf = (pslot != nullptr) ? pslot->SendBuffer() : bd_var_.send[nb.bufid];
     int ssize;
     if (nb.snb.level == mylevel)
-      ssize = LoadBoundaryBufferSameLevel(bd_var_.send[nb.bufid], nb);
+      ssize = LoadBoundaryBufferSameLevel(sbuf, nb);
     else if (nb.snb.level<mylevel)
-      ssize = LoadBoundaryBufferToCoarser(bd_var_.send[nb.bufid], nb);
+      ssize = LoadBoundaryBufferToCoarser(sbuf, nb);
     else
-      ssize = LoadBoundaryBufferToFiner(bd_var_.send[nb.bufid], nb);
+      ssize = LoadBoundaryBufferToFiner(sbuf, nb);
     if (nb.snb.rank == Globals::my_rank) {  // on the same process
       CopyVariableBufferSameProcess(nb, ssize);
+    } else if (pslot != nullptr) {  // on the same node
+      pslot->Post();
     }
 #ifdef MPI_PARALLEL
     else  // MPI
@@ -250,6 +296,12 @@ bool BoundaryVariable::ReceiveBoundaryBuffers() {
       if (nb.snb.rank == Globals::my_rank) {  // on the same process
         bflag = false;
         continue;
+      } else if (shm_recv_[nb.bufid] != nullptr) {  // on the same node
+        if (!shm_recv_[nb.bufid]->Poll()) {
+          bflag = false;
+          continue;
+        }
+        bd_var_.flag[nb.bufid] = BoundaryStatus::arrived;
       }
 #ifdef MPI_PARALLEL
       else { // NOLINT // MPI boundary
@@ -280,12 +332,15 @@ void BoundaryVariable::SetBoundaries() {
   int mylevel = pmb->loc.level;
   for (int n=0; n<pbval_->nneighbor; n++) {
     NeighborBlock& nb = pbval_->neighbor[n];
-    if (nb.snb.level == mylevel)
-      SetBoundarySameLevel(bd_var_.recv[nb.bufid], nb);
+    Real *rbuf = RecvBuffer(nb);
+    if (recv_in_place_[nb.bufid])
+      recv_in_place_[nb.bufid] = false;
+    else if (nb.snb.level == mylevel)
+      SetBoundarySameLevel(rbuf, nb);
     else if (nb.snb.level < mylevel) // only sets the prolongation buffer
-      SetBoundaryFromCoarser(bd_var_.recv[nb.bufid], nb);
+      SetBoundaryFromCoarser(rbuf, nb);
     else
-      SetBoundaryFromFiner(bd_var_.recv[nb.bufid], nb);
+      SetBoundaryFromFiner(rbuf, nb);
     bd_var_.flag[nb.bufid] = BoundaryStatus::completed; // completed
   }
 
@@ -306,16 +361,22 @@ void BoundaryVariable::ReceiveAndSetBoundariesWithWait() {
   int mylevel = pmb->loc.level;
   for (int n=0; n<pbval_->nneighbor; n++) {
     NeighborBlock& nb = pbval_->neighbor[n];
+    if (shm_recv_[nb.bufid] != nullptr) {
+      while (!shm_recv_[nb.bufid]->Poll()) {}
+    }
 #ifdef MPI_PARALLEL
-    if (nb.snb.rank != Globals::my_rank)
+    else if (nb.snb.rank != Globals::my_rank) // NOLINT
       MPI_Wait(&(bd_var_.req_recv[nb.bufid]),MPI_STATUS_IGNORE);
 #endif
-    if (nb.snb.level == mylevel)
-      SetBoundarySameLevel(bd_var_.recv[nb.bufid], nb);
+    Real *rbuf = RecvBuffer(nb);
+    if (recv_in_place_[nb.bufid])
+      recv_in_place_[nb.bufid] = false;
+    else if (nb.snb.level == mylevel)
+      SetBoundarySameLevel(rbuf, nb);
     else if (nb.snb.level < mylevel)
-      SetBoundaryFromCoarser(bd_var_.recv[nb.bufid], nb);
+      SetBoundaryFromCoarser(rbuf, nb);
     else
-      SetBoundaryFromFiner(bd_var_.recv[nb.bufid], nb);
+      SetBoundaryFromFiner(rbuf, nb);
     bd_var_.flag[nb.bufid] = BoundaryStatus::completed; // completed
   }
 
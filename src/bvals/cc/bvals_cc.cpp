@@ -43,7 +43,7 @@ CellCenteredBoundaryVariable::CellCenteredBoundaryVariable(
     AthenaArray<Real> *var_flux)
     : BoundaryVariable(pmb), var_cc(var), coarse_buf(coarse_var), x1flux(var_flux[X1DIR]),
       x2flux(var_flux[X2DIR]), x3flux(var_flux[X3DIR]), nl_(0), nu_(var->GetDim4() -1),
-      flip_across_pole_(nullptr) {
+      flip_across_pole_(nullptr), var_cc_home_(var) {
   //! \note
   //! CellCenteredBoundaryVariable should only be used w/ 4D or 3D (nx4=1) AthenaArray
   //! For now, assume that full span of 4th dim of input AthenaArray should be used:
@@ -204,10 +204,72 @@ int CellCenteredBoundaryVariable::LoadBoundaryBufferSameLevel(Real *buf,
   ek = (nb.ni.ox3 < 0) ? (pmb->ks + NGHOST - 1) : pmb->ke;
   int p = 0;
   AthenaArray<Real> &var = *var_cc;
-  BufferUtility::PackData(var, buf, nl_, nu_, si, ei, sj, ej, sk, ek, p);
+  const int nthreads = pmb->pmy_mesh->GetNumLoopThreads();
+  const BufferUtility::CopyPlan &plan = pbval_->cc_send_plan_[nb.bufid];
+  if (!float_buffers && plan.Matches(var)) {
+    BufferUtility::PackData(var, buf, nl_, nu_, plan, p, nthreads);
+    return p;
+  }
+  if (float_buffers) {
+    BufferUtility::PackDataConverted(var, reinterpret_cast<float *>(buf),
+                                     nl_, nu_, si, ei, sj, ej, sk, ek, p, nthreads);
+    return FloatBufferSize(p);
+  }
+  BufferUtility::PackData(var, buf, nl_, nu_, si, ei, sj, ej, sk, ek, p, nthreads);
   return p;
 }
 
+//----------------------------------------------------------------------------------------
+//! \fn bool CellCenteredBoundaryVariable::CopyVariableSameLevelInPlace(
+//!                                BoundaryVariable *ptarget, const NeighborBlock& nb)
+//! \brief Copy the region LoadBoundaryBufferSameLevel() would pack straight into the
+//!        ghost zones of a same-level MeshBlock on this process (one copy instead of
+//!        pack + memcpy + unpack). Falls back to the buffers when the receiving side
+//!        transforms the data (polar, shearing box, orbital advection, float buffers)
+//!        or when var_cc is not the array bound at construction.
+
+bool CellCenteredBoundaryVariable::CopyVariableSameLevelInPlace(
+    BoundaryVariable *ptarget, const NeighborBlock& nb) {
+  if (var_cc != var_cc_home_ || float_buffers || nb.polar
+      || pbval_->shearing_box != 0 || pmy_mesh_->orbital_advection != 0)
+    return false;
+  MeshBlock *pmb = pmy_block_;
+  int si, sj, sk, ei, ej, ek;
+
+  si = (nb.ni.ox1 > 0) ? (pmb->ie - NGHOST + 1) : pmb->is;
+  ei = (nb.ni.ox1 < 0) ? (pmb->is + NGHOST - 1) : pmb->ie;
+  sj = (nb.ni.ox2 > 0) ? (pmb->je - NGHOST + 1) : pmb->js;
+  ej = (nb.ni.ox2 < 0) ? (pmb->js + NGHOST - 1) : pmb->je;
+  sk = (nb.ni.ox3 > 0) ? (pmb->ke - NGHOST + 1) : pmb->ks;
+  ek = (nb.ni.ox3 < 0) ? (pmb->ks + NGHOST - 1) : pmb->ke;
+  // same-level MeshBlocks have the same size: the ghost zones of the target are the
+  // source region shifted by one block length against the direction of the neighbor
+  int di = -nb.ni.ox1*pmb->block_size.nx1;
+  int dj = -nb.ni.ox2*pmb->block_size.nx2;
+  int dk = -nb.ni.ox3*pmb->block_size.nx3;
+
+  AthenaArray<Real> &src = *var_cc;
+  CellCenteredBoundaryVariable *ptgt =
+      static_cast<CellCenteredBoundaryVariable *>(ptarget);
+  AthenaArray<Real> &dst = *(ptgt->var_cc_home_);
+  const BufferUtility::CopyPlan &src_plan = pbval_->cc_send_plan_[nb.bufid];
+  const BufferUtility::CopyPlan &dst_plan = ptgt->pbval_->cc_recv_plan_[nb.targetid];
+  if (src_plan.Matches(src) && dst_plan.Matches(dst)) {
+    BufferUtility::CopyData(src, src_plan, dst, dst_plan, nl_, nu_);
+    return true;
+  }
+  for (int n=nl_; n<=nu_; ++n) {
+    for (int k=sk; k<=ek; ++k) {
+      for (int j=sj; j<=ej; ++j) {
+#pragma omp simd
+        for (int i=si; i<=ei; ++i)
+          dst(n,k+dk,j+dj,i+di) = src(n,k,j,i);
+      }
+    }
+  }
+  return true;
+}
+
 //----------------------------------------------------------------------------------------
 //! \fn int CellCenteredBoundaryVariable::LoadBoundaryBufferToCoarser(Real *buf,
 //!                                                             const NeighborBlock& nb)
@@ -307,8 +369,28 @@ void CellCenteredBoundaryVariable::SetBoundarySameLevel(Real *buf,
   else              sk = pmb->ks - NGHOST, ek = pmb->ks - 1;
 
   int p = 0;
+  const int nthreads = pmb->pmy_mesh->GetNumLoopThreads();
 
-  if (nb.polar) {
+  if (float_buffers) {
+    const float *fbuf = reinterpret_cast<const float *>(buf);
+    if (nb.polar) {
+      for (int n=nl_; n<=nu_; ++n) {
+        Real sign = 1.0;
+        if (flip_across_pole_ != nullptr) sign = flip_across_pole_[n] ? -1.0 : 1.0;
+        for (int k=sk; k<=ek; ++k) {
+          for (int j=ej; j>=sj; --j) {
+#pragma omp simd linear(p)
+            for (int i=si; i<=ei; ++i) {
+              var(n,k,j,i) = sign * static_cast<Real>(fbuf[p++]);
+            }
+          }
+        }
+      }
+    } else {
+      BufferUtility::UnpackDataConverted(fbuf, var, nl_, nu_, si, ei, sj, ej, sk, ek, p,
+                                         nthreads);
+    }
+  } else if (nb.polar) {
     for (int n=nl_; n<=nu_; ++n) {
       Real sign = 1.0;
       if (flip_across_pole_ != nullptr) sign = flip_across_pole_[n] ? -1.0 : 1.0;
@@ -321,8 +403,11 @@ void CellCenteredBoundaryVariable::SetBoundarySameLevel(Real *buf,
         }
       }
     }
+  } else if (pbval_->cc_recv_plan_[nb.bufid].Matches(var)) {
+    BufferUtility::UnpackData(buf, var, nl_, nu_, pbval_->cc_recv_plan_[nb.bufid], p,
+                              nthreads);
   } else {
-    BufferUtility::UnpackData(buf, var, nl_, nu_, si, ei, sj, ej, sk, ek, p);
+    BufferUtility::UnpackData(buf, var, nl_, nu_, si, ei, sj, ej, sk, ek, p, nthreads);
   }
 
   return;
@@ -554,6 +639,10 @@ void CellCenteredBoundaryVariable::SetupPersistentMPI() {
               *((nb.ni.ox3 == 0) ? ((pmb->block_size.nx3 + 1)/2) : NGHOST);
       }
       ssize *= (nu_ + 1); rsize *= (nu_ + 1);
+      if (float_buffers && nb.snb.level == mylevel) {
+        ssize = FloatBufferSize(ssize);
+        rsize = FloatBufferSize(rsize);
+      }
       // specify the offsets in the view point of the target block: flip ox? signs
 
       // Initialize persistent communication requests attached to specific BoundaryData
@@ -632,7 +721,8 @@ void CellCenteredBoundaryVariable::StartReceiving(BoundaryCommSubset phase) {
   for (int n=0; n<pbval_->nneighbor; n++) {
     NeighborBlock& nb = pbval_->neighbor[n];
     if (nb.snb.rank != Globals::my_rank) {
-      MPI_Start(&(bd_var_.req_recv[nb.bufid]));
+      if (shm_recv_[nb.bufid] == nullptr)  // else delivered in the node shared window
+        MPI_Start(&(bd_var_.req_recv[nb.bufid]));
       if (phase == BoundaryCommSubset::all && nb.ni.type == NeighborConnect::face) {
         if ((nb.shear&&(nb.fid == BoundaryFace::inner_x1
              || nb.fid == BoundaryFace::outer_x1)
@@ -718,7 +808,8 @@ void CellCenteredBoundaryVariable::ClearBoundary(BoundaryCommSubset phase) {
     int mylevel = pmb->loc.level;
     if (nb.snb.rank != Globals::my_rank) {
       // Wait for Isend
-      MPI_Wait(&(bd_var_.req_send[nb.bufid]), MPI_STATUS_IGNORE);
+      if (shm_send_[nb.bufid] == nullptr)
+        MPI_Wait(&(bd_var_.req_send[nb.bufid]), MPI_STATUS_IGNORE);
       if (phase == BoundaryCommSubset::all && nb.ni.type == NeighborConnect::face) {
         if ((nb.shear && (nb.fid == BoundaryFace::inner_x1
                           || nb.fid == BoundaryFace::outer_x1)
@@ -50,6 +50,10 @@ class CellCenteredBoundaryVariable : public BoundaryVariable {
   AthenaArray<Real> &x1flux, &x2flux, &x3flux;
   //!@}
 
+  //! pack the ghost zones exchanged with same-level neighbors in single precision
+  //! (halves the message volume; refinement and flux correction buffers are unaffected)
+  bool float_buffers = false;
+
 
   //! maximum number of reserved unique "physics ID" component of MPI tag bitfield
   //! \note
@@ -125,6 +129,9 @@ class CellCenteredBoundaryVariable : public BoundaryVariable {
  protected:
   int nl_, nu_;
   const bool *flip_across_pole_;
+  //! array bound at construction (u, s, phi): the only one written in place by
+  //! same-rank neighbors, since their var_cc may be rebound to another register
+  AthenaArray<Real> *var_cc_home_;
 
   //! shearing box:
   //! working arrays of remapped quantities
@@ -135,6 +142,8 @@ class CellCenteredBoundaryVariable : public BoundaryVariable {
   //! BoundaryBuffer:
   int LoadBoundaryBufferSameLevel(Real *buf, const NeighborBlock& nb) override;
   void SetBoundarySameLevel(Real *buf, const NeighborBlock& nb) override;
+  bool CopyVariableSameLevelInPlace(BoundaryVariable *ptarget,
+                                    const NeighborBlock& nb) override;
 
   int LoadBoundaryBufferToCoarser(Real *buf, const NeighborBlock& nb) override;
   int LoadBoundaryBufferToFiner(Real *buf, const NeighborBlock& nb) override;
@@ -151,6 +160,11 @@ class CellCenteredBoundaryVariable : public BoundaryVariable {
 
   void PolarBoundarySingleAzimuthalBlock() override;
 
+  //! number of Real buffer elements occupied by n single-precision values
+  static int FloatBufferSize(int n) {
+    return static_cast<int>((n*sizeof(float) + sizeof(Real) - 1)/sizeof(Real));
+  }
+
 #ifdef MPI_PARALLEL
   int cc_phys_id_, cc_flx_phys_id_;
 #endif
@@ -112,4 +112,18 @@ class MGGravityBoundaryValues : public MGBoundaryValues {
   friend class MultigridDriver;
 };
 
+
+//----------------------------------------------------------------------------------------
+//! \class MGConductionBoundaryValues
+//! \brief BVals data and functions for Multigrid implicit conduction
+//!
+//! The flux-conserving formulae at level boundaries are those of gravity, applied to all
+//! the variables (temperature and the restricted coefficients)
+
+class MGConductionBoundaryValues : public MGGravityBoundaryValues {
+ public:
+  MGConductionBoundaryValues(Multigrid *pmg, BoundaryFlag *input_bcs)
+    : MGGravityBoundaryValues(pmg, input_bcs) {}
+};
+
 #endif // BVALS_CC_MG_BVALS_MG_HPP_
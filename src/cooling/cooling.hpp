@@ -2,6 +2,7 @@
 #define COOLING_HPP_
 
 #include "../athena.hpp"
+#include "../utils/utils.hpp"   // RuntimeDiagnostics
 #include <fstream>
 #include <sstream>
 
@@ -47,6 +48,9 @@ private:
     Real get_zero_point(const int i, const Real rho);
     Real compute_constant_factor();
     bool isClose(const Real a, const Real b, const Real tol = 1e-20);
+
+    // Diagnostics category of NaN cooling results (counted, not printed per cell)
+    int nan_diag_;
 };
 
 // Constructor
@@ -65,6 +69,8 @@ Cooling::Cooling() {
     temps       = {0.};
     Ys          = {0.};
 
+    nan_diag_ = RuntimeDiagnostics::AddCategory("Cooling result is NaN, cell not cooled",
+                                                "T,rho,dt");
     return;
 }
 
@@ -106,6 +112,8 @@ Cooling::Cooling(const std::string in) {
     temps.resize(nbins_,0);
     Ys.resize(nbins_,0);
 
+    nan_diag_ = RuntimeDiagnostics::AddCategory("Cooling result is NaN, cell not cooled",
+                                                "T,rho,dt");
     return;
 }
 
@@ -373,7 +381,7 @@ Real Cooling::townsend_cooling(const Real T, const Real rho, const Real dt) {
     }
 
     if (std::isnan(T_new)) {
-          std::cout << " Warning : Cooling result is NaN. Cell will not be cooled. " << std::endl;
+          RuntimeDiagnostics::Record(nan_diag_, T, rho, dt);
           T_new = T;
     }
     
@@ -28,7 +28,9 @@ EquationOfState::EquationOfState(MeshBlock *pmb, ParameterInput *pin) :
     gamma_{pin->GetReal("hydro", "gamma")},
     density_floor_{pin->GetOrAddReal("hydro", "dfloor", std::sqrt(1024*float_min))},
     pressure_floor_{pin->GetOrAddReal("hydro", "pfloor", std::sqrt(1024*float_min))},
-    scalar_floor_{pin->GetOrAddReal("hydro", "sfloor", std::sqrt(1024*float_min))} {}
+    scalar_floor_{pin->GetOrAddReal("hydro", "sfloor", std::sqrt(1024*float_min))} {
+  InitCeilings(pin);
+}
 
 //----------------------------------------------------------------------------------------
 //! \fn void EquationOfState::ConservedToPrimitive(AthenaArray<Real> &cons,
@@ -46,46 +48,53 @@ void EquationOfState::ConservedToPrimitive(
 
   pmy_block_->pfield->CalculateCellCenteredField(b,bcc,pco,il,iu,jl,ju,kl,ku);
 
-  for (int k=kl; k<=ku; ++k) {
-    for (int j=jl; j<=ju; ++j) {
+  const int nthreads = pmy_block_->pmy_mesh->GetNumLoopThreads();
+#pragma omp parallel num_threads(nthreads)
+  {
+    int jb = jl, jt = ju, kb = kl, kt = ku;
+    pmy_block_->LoopThreadRange(jb, jt, kb, kt);
+    for (int k=kb; k<=kt; ++k) {
+      for (int j=jb; j<=jt; ++j) {
 #pragma omp simd
-      for (int i=il; i<=iu; ++i) {
-        Real& u_d  = cons(IDN,k,j,i);
-        Real& u_m1 = cons(IVX,k,j,i);
-        Real& u_m2 = cons(IVY,k,j,i);
-        Real& u_m3 = cons(IVZ,k,j,i);
-        Real& u_e  = cons(IEN,k,j,i);
-
-        Real& w_d  = prim(IDN,k,j,i);
-        Real& w_vx = prim(IVX,k,j,i);
-        Real& w_vy = prim(IVY,k,j,i);
-        Real& w_vz = prim(IVZ,k,j,i);
-        Real& w_p  = prim(IPR,k,j,i);
-
-        // apply density floor, without changing momentum or energy
-        u_d = (u_d > density_floor_) ?  u_d : density_floor_;
-        w_d = u_d;
-
-        Real di = 1.0/u_d;
-        w_vx = u_m1*di;
-        w_vy = u_m2*di;
-        w_vz = u_m3*di;
-
-        const Real& bcc1 = bcc(IB1,k,j,i);
-        const Real& bcc2 = bcc(IB2,k,j,i);
-        const Real& bcc3 = bcc(IB3,k,j,i);
-
-        Real pb = 0.5*(SQR(bcc1) + SQR(bcc2) + SQR(bcc3));
-        Real e_k = 0.5*di*(SQR(u_m1) + SQR(u_m2) + SQR(u_m3));
-        w_p = gm1*(u_e - e_k - pb);
-
-        // apply pressure floor, correct total energy
-        u_e = (w_p > pressure_floor_) ?  u_e : ((pressure_floor_/gm1) + e_k + pb);
-        w_p = (w_p > pressure_floor_) ?  w_p : pressure_floor_;
+        for (int i=il; i<=iu; ++i) {
+          Real& u_d  = cons(IDN,k,j,i);
+          Real& u_m1 = cons(IVX,k,j,i);
+          Real& u_m2 = cons(IVY,k,j,i);
+          Real& u_m3 = cons(IVZ,k,j,i);
+          Real& u_e  = cons(IEN,k,j,i);
+
+          Real& w_d  = prim(IDN,k,j,i);
+          Real& w_vx = prim(IVX,k,j,i);
+          Real& w_vy = prim(IVY,k,j,i);
+          Real& w_vz = prim(IVZ,k,j,i);
+          Real& w_p  = prim(IPR,k,j,i);
+
+          // apply density floor, without changing momentum or energy
+          u_d = (u_d > density_floor_) ?  u_d : density_floor_;
+          w_d = u_d;
+
+          Real di = 1.0/u_d;
+          w_vx = u_m1*di;
+          w_vy = u_m2*di;
+          w_vz = u_m3*di;
+
+          const Real& bcc1 = bcc(IB1,k,j,i);
+          const Real& bcc2 = bcc(IB2,k,j,i);
+          const Real& bcc3 = bcc(IB3,k,j,i);
+
+          Real pb = 0.5*(SQR(bcc1) + SQR(bcc2) + SQR(bcc3));
+          Real e_k = 0.5*di*(SQR(u_m1) + SQR(u_m2) + SQR(u_m3));
+          w_p = gm1*(u_e - e_k - pb);
+
+          // apply pressure floor, correct total energy
+          u_e = (w_p > pressure_floor_) ?  u_e : ((pressure_floor_/gm1) + e_k + pb);
+          w_p = (w_p > pressure_floor_) ?  w_p : pressure_floor_;
+        }
       }
     }
   }
 
+  if (ceilings_) ApplyCeilings(cons, prim, pco, il, iu, jl, ju, kl, ku);
   return;
 }
 
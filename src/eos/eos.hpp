@@ -148,6 +148,9 @@ class EquationOfState {
   Real GetIsoSoundSpeed() const {return iso_sound_speed_;}
   Real GetDensityFloor() const {return density_floor_;}
   Real GetPressureFloor() const {return pressure_floor_;}
+  bool CeilingsEnabled() const {return ceilings_;}
+  void SetCeilingAccounting(bool flag) {account_ceilings_ = flag;}
+  void TakeCeilingLosses(Real losses[2]);
   EosTable* ptable; // pointer to EOS table data
 #if GENERAL_EOS
   Real GetGamma();
@@ -167,6 +170,11 @@ class EquationOfState {
   Real gamma_max_;                       // maximum Lorentz factor
   Real rho_min_, rho_pow_;               // variables to control power-law denity floor
   Real pgas_min_, pgas_pow_;             // variables to control power-law pressure floor
+  Real temperature_ceiling_{-1.0};       // maximum p/rho (<= 0: no ceiling)
+  Real velocity_ceiling_{-1.0};          // maximum |v| (<= 0: no ceiling)
+  bool ceilings_{false};                 // any ceiling is applied
+  bool account_ceilings_{true};          // add the energy removed to ceiling_losses_
+  Real ceiling_losses_[2]{};             // thermal, kinetic energy removed by ceilings
   Real rho_unit_, inv_rho_unit_;         // physical unit/sim unit for mass density
   Real egas_unit_, inv_egas_unit_;       // physical unit/sim unit for energy density
   Real vsqr_unit_, inv_vsqr_unit_;       // physical unit/sim unit for speed^2
@@ -177,6 +185,9 @@ class EquationOfState {
   AthenaArray<Real> normal_bb_;          // normal-frame fields, used in relativistic MHD
   AthenaArray<Real> normal_tt_;          // normal-frame M.B, used in relativistic MHD
   void InitEosConstants(ParameterInput *pin);
+  void InitCeilings(ParameterInput *pin);
+  void ApplyCeilings(AthenaArray<Real> &cons, AthenaArray<Real> &prim, Coordinates *pco,
+                     int il, int iu, int jl, int ju, int kl, int ku);
 };
 
 #endif // EOS_EOS_HPP_
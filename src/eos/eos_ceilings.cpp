@@ -0,0 +1,133 @@
+//========================================================================================
+// Athena++ astrophysical MHD code
+// Copyright(C) 2014 James M. Stone <jmstone@princeton.edu> and other code contributors
+// Licensed under the 3-clause BSD License, see LICENSE file for details
+//========================================================================================
+//! \file eos_ceilings.cpp
+//! \brief temperature and velocity ceilings of the non-relativistic EOS
+//!
+//! Parameters (optional) in the <hydro> block:
+//! - tceil: maximum of p/rho, the temperature in code units (default -1 = no ceiling)
+//! - vceil: maximum of |v| (default -1 = no ceiling)
+//!
+//! The ceilings are applied at the end of ConservedToPrimitive() in all cells it
+//! converts. The velocity is rescaled at fixed density, and the kinetic energy in excess
+//! is removed rather than converted to heat; the pressure is then reduced at fixed
+//! density. The energy removed from the active cells is integrated over their volume and
+//! summed by Mesh::NewTimeStep() into Mesh::ceiling_losses, the running totals written
+//! to the history file as tceil-E and vceil-E. Only the final W(U) of each cycle is
+//! accounted for, since the intermediate stages of the time integrator do not change the
+//! solution at the end of the step.
+
+// C headers
+
+// C++ headers
+#include <cmath>   // sqrt()
+#include <limits>  // numeric_limits
+
+// Athena++ headers
+#include "../athena.hpp"
+#include "../athena_arrays.hpp"
+#include "../coordinates/coordinates.hpp"
+#include "../mesh/mesh.hpp"
+#include "../parameter_input.hpp"
+#include "eos.hpp"
+
+//----------------------------------------------------------------------------------------
+//! \fn void EquationOfState::InitCeilings(ParameterInput *pin)
+//! \brief read the ceilings; called by the constructors of the non-relativistic EOS
+
+void EquationOfState::InitCeilings(ParameterInput *pin) {
+  if (NON_BAROTROPIC_EOS)
+    temperature_ceiling_ = pin->GetOrAddReal("hydro", "tceil", -1.0);
+  velocity_ceiling_ = pin->GetOrAddReal("hydro", "vceil", -1.0);
+  ceilings_ = (temperature_ceiling_ > 0.0 || velocity_ceiling_ > 0.0);
+  return;
+}
+
+//----------------------------------------------------------------------------------------
+//! \fn void EquationOfState::ApplyCeilings(AthenaArray<Real> &cons,
+//!          AthenaArray<Real> &prim, Coordinates *pco,
+//!          int il, int iu, int jl, int ju, int kl, int ku)
+//! \brief apply the velocity and temperature ceilings to primitive and conserved
+//!        variables after W(U). The magnetic field is not changed.
+
+void EquationOfState::ApplyCeilings(
+    AthenaArray<Real> &cons, AthenaArray<Real> &prim, Coordinates *pco,
+    int il, int iu, int jl, int ju, int kl, int ku) {
+  MeshBlock *pmb = pmy_block_;
+  const Real vmax2 = (velocity_ceiling_ > 0.0) ? SQR(velocity_ceiling_)
+                                               : std::numeric_limits<Real>::max();
+  const Real tmax = (temperature_ceiling_ > 0.0) ? temperature_ceiling_
+                                                 : std::numeric_limits<Real>::max();
+  Real de_th = 0.0, de_kin = 0.0;
+
+  const int nthreads = pmb->pmy_mesh->GetNumLoopThreads();
+#pragma omp parallel num_threads(nthreads) reduction(+:de_th, de_kin)
+  {
+    int jb = jl, jt = ju, kb = kl, kt = ku;
+    pmb->LoopThreadRange(jb, jt, kb, kt);
+    for (int k=kb; k<=kt; ++k) {
+      for (int j=jb; j<=jt; ++j) {
+        bool active = (account_ceilings_ && k >= pmb->ks && k <= pmb->ke
+                       && j >= pmb->js && j <= pmb->je);
+        for (int i=il; i<=iu; ++i) {
+          Real& w_d  = prim(IDN,k,j,i);
+          Real& w_vx = prim(IVX,k,j,i);
+          Real& w_vy = prim(IVY,k,j,i);
+          Real& w_vz = prim(IVZ,k,j,i);
+          Real v2 = SQR(w_vx) + SQR(w_vy) + SQR(w_vz);
+          bool fast = (v2 > vmax2);
+          bool hot = (NON_BAROTROPIC_EOS && prim(IPR,k,j,i) > tmax*w_d);
+          if (!fast && !hot) continue;
+
+          Real de_k = 0.0, de_t = 0.0;
+          if (fast) {
+            Real f = velocity_ceiling_/std::sqrt(v2);
+            de_k = 0.5*w_d*v2*(1.0 - SQR(f));
+            w_vx *= f;
+            w_vy *= f;
+            w_vz *= f;
+            cons(IM1,k,j,i) = w_d*w_vx;
+            cons(IM2,k,j,i) = w_d*w_vy;
+            cons(IM3,k,j,i) = w_d*w_vz;
+          }
+          if (NON_BAROTROPIC_EOS) {
+            Real& w_p = prim(IPR,k,j,i);
+            if (hot) {
+              Real p_max = tmax*w_d;
+#if GENERAL_EOS
+              de_t = EgasFromRhoP(w_d, w_p) - EgasFromRhoP(w_d, p_max);
+#else
+              de_t = (w_p - p_max)/(GetGamma() - 1.0);
+#endif
+              w_p = p_max;
+            }
+            cons(IEN,k,j,i) -= de_k + de_t;
+          }
+          if (active && i >= pmb->is && i <= pmb->ie) {
+            Real vol = pco->GetCellVolume(k,j,i);
+            de_th += vol*de_t;
+            de_kin += vol*de_k;
+          }
+        }
+      }
+    }
+  }
+  ceiling_losses_[0] += de_th;
+  ceiling_losses_[1] += de_kin;
+  return;
+}
+
+//----------------------------------------------------------------------------------------
+//! \fn void EquationOfState::TakeCeilingLosses(Real losses[2])
+//! \brief add the thermal and kinetic energy removed by the ceilings since the last call
+//!        to losses[0] and losses[1], and reset them
+
+void EquationOfState::TakeCeilingLosses(Real losses[2]) {
+  losses[0] += ceiling_losses_[0];
+  losses[1] += ceiling_losses_[1];
+  ceiling_losses_[0] = 0.0;
+  ceiling_losses_[1] = 0.0;
+  return;
+}
@@ -62,6 +62,7 @@ EquationOfState::EquationOfState(MeshBlock *pmb, ParameterInput *pin) :
     }
   }
   InitEosConstants(pin);
+  InitCeilings(pin);
 }
 
 //----------------------------------------------------------------------------------------
@@ -111,6 +112,7 @@ void EquationOfState::ConservedToPrimitive(
     }
   }
 
+  if (ceilings_) ApplyCeilings(cons, prim, pco, il, iu, jl, ju, kl, ku);
   return;
 }
 
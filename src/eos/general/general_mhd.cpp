@@ -61,6 +61,7 @@ EquationOfState::EquationOfState(MeshBlock *pmb, ParameterInput *pin) :
     }
   }
   InitEosConstants(pin);
+  InitCeilings(pin);
 }
 
 //----------------------------------------------------------------------------------------
@@ -118,6 +119,7 @@ void EquationOfState::ConservedToPrimitive(
     }
   }
 
+  if (ceilings_) ApplyCeilings(cons, prim, pco, il, iu, jl, ju, kl, ku);
   return;
 }
 
@@ -5,6 +5,13 @@
 //======================================================================================
 //! \file hydrogen.cpp
 //! \brief implements functions in class EquationOfState for simple hydrogen EOS
+//!
+//! The temperature is recovered from (rho, e) and (rho, P) by root finding. With
+//! <hydro>/eos_tabulate = true, both inversions are tabulated at startup with class
+//! InversionTable instead, for densities eos_tab_rho_min <= rho < eos_tab_rho_max and
+//! temperatures eos_tab_T_min <= T <= eos_tab_T_max (in the units of the EOS), to a
+//! relative accuracy eos_tab_tol of the pressure, internal energy and sound speed. The
+//! root finder is still used outside the tables and where they do not reach eos_tab_tol.
 //======================================================================================
 
 // C headers
@@ -17,6 +24,7 @@
 #include <limits>   // std::numeric_limits<float>::epsilon()
 #include <sstream>
 #include <stdexcept> // std::invalid_argument
+#include <vector>
 
 // Athena++ headers
 #include "../../athena.hpp"
@@ -24,12 +32,14 @@
 #include "../../coordinates/coordinates.hpp"
 #include "../../field/field.hpp"
 #include "../../parameter_input.hpp"
+#include "../../utils/inversion_table.hpp"
 #include "../eos.hpp"
 
 namespace {
 const Real float_eps = std::numeric_limits<float>::epsilon();
 const Real float_1pe = 1.0 + float_eps;
 Real prec = 1e-12;
+InversionTable e_table, p_table;  // T(rho, e) and T(rho, P), shared by all MeshBlocks
 
 //----------------------------------------------------------------------------------------
 //! \fn Real x_(Real rho, Real T) {
@@ -130,6 +140,30 @@ Real invert(Real(*f) (Real, Real), Real rho, Real sol, Real Ta, Real Tb) {
   }
   return Tb;
 }
+
+//----------------------------------------------------------------------------------------
+//! \fn Real T_of_rho_e(Real rho, Real egas)
+//! \brief compute temperature from internal energy density by root finding
+Real T_of_rho_e(Real rho, Real egas) {
+  // no internal energy left, e.g. round-off in E - KE at the energy floor: e and P
+  // vanish in the limit T -> 0, and the root cannot be bracketed
+  if (!(egas > 0.0)) return 0.0;
+  Real es = egas / rho;
+  Real Ta = std::max(es - 1.0, 0.1*es)/3.0;
+  // at low density hydrogen is fully ionized at T < es/30 already; invert() stops with
+  // an error if the root is still not bracketed after max_decades
+  const int max_decades = 32;
+  for (int n=0; n<max_decades && e_of_rho_T(rho, Ta) > egas; ++n) Ta *= 0.1;
+  return invert(*e_of_rho_T, rho, egas, Ta, float_1pe*2.0*es/3.0);
+}
+
+//----------------------------------------------------------------------------------------
+//! \fn Real T_of_rho_P(Real rho, Real pres)
+//! \brief compute temperature from gas pressure by root finding
+Real T_of_rho_P(Real rho, Real pres) {
+  Real ps = pres / rho;
+  return invert(*P_of_rho_T, rho, pres, 0.5*ps, float_1pe*ps);
+}
 } // namespace
 
 //----------------------------------------------------------------------------------------
@@ -138,9 +172,8 @@ Real invert(Real(*f) (Real, Real), Real rho, Real sol, Real Ta, Real Tb) {
 Real EquationOfState::PresFromRhoEg(Real rho, Real egas) {
   rho *= rho_unit_;
   egas *= egas_unit_;
-  Real es = egas / rho;
-  Real T = invert(*e_of_rho_T, rho, egas, std::max(es - 1.0, 0.1*es)/3.0,
-                  float_1pe*2.0*es/3.0);
+  Real T;
+  if (!e_table.Lookup(rho, egas, &T)) T = T_of_rho_e(rho, egas);
   return P_of_rho_T(rho, T) * inv_egas_unit_;
 }
 
@@ -150,8 +183,8 @@ Real EquationOfState::PresFromRhoEg(Real rho, Real egas) {
 Real EquationOfState::EgasFromRhoP(Real rho, Real pres) {
   rho *= rho_unit_;
   pres *= egas_unit_;
-  Real ps = pres / rho;
-  Real T = invert(*P_of_rho_T, rho, pres, 0.5*ps, float_1pe*ps);
+  Real T;
+  if (!p_table.Lookup(rho, pres, &T)) T = T_of_rho_P(rho, pres);
   return e_of_rho_T(rho, T) * inv_egas_unit_;
 }
 
@@ -161,8 +194,8 @@ Real EquationOfState::EgasFromRhoP(Real rho, Real pres) {
 Real EquationOfState::AsqFromRhoP(Real rho, Real pres) {
   rho *= rho_unit_;
   pres *= egas_unit_;
-  Real ps = pres / rho;
-  Real T = invert(*P_of_rho_T, rho, pres, 0.5*ps, float_1pe*ps);
+  Real T;
+  if (!p_table.Lookup(rho, pres, &T)) T = T_of_rho_P(rho, pres);
   return asq_(rho, T) * inv_vsqr_unit_;
 }
 
@@ -171,5 +204,27 @@ Real EquationOfState::AsqFromRhoP(Real rho, Real pres) {
 //! \brief Initialize constants for EOS
 void EquationOfState::InitEosConstants(ParameterInput* pin) {
   prec = pin->GetOrAddReal("hydro", "InversionPrecision", prec);
+  if (pin->GetOrAddBoolean("hydro", "eos_tabulate", false) && !e_table.Built()) {
+    Real rho_min = pin->GetOrAddReal("hydro", "eos_tab_rho_min", 1e-16);
+    Real rho_max = pin->GetOrAddReal("hydro", "eos_tab_rho_max", 1.0);
+    Real T_min = pin->GetOrAddReal("hydro", "eos_tab_T_min", 1e-2);
+    Real T_max = pin->GetOrAddReal("hydro", "eos_tab_T_max", 1e2);
+    Real tol = pin->GetOrAddReal("hydro", "eos_tab_tol", 1e-6);
+    int nbase = pin->GetOrAddInteger("hydro", "eos_tab_nbase", 32);
+    int max_level = pin->GetOrAddInteger("hydro", "eos_tab_max_level", 6);
+    int nthreads = pin->GetOrAddInteger("mesh", "num_threads", 1);
+    if (!(0.0 < rho_min && rho_min < rho_max && 0.0 < T_min && T_min < T_max)
+        || tol <= 0.0 || nbase < 1 || max_level < 0 || max_level > 10) {
+      std::stringstream msg;
+      msg << "### FATAL ERROR in EquationOfState::InitEosConstants" << std::endl
+          << "Invalid range, tolerance or resolution of the tabulated EOS in <hydro>."
+          << std::endl;
+      ATHENA_ERROR(msg);
+    }
+    e_table.Build(e_of_rho_T, T_of_rho_e, {P_of_rho_T}, rho_min, rho_max, T_min, T_max,
+                  nbase, max_level, tol, nthreads);
+    p_table.Build(P_of_rho_T, T_of_rho_P, {e_of_rho_T, asq_}, rho_min, rho_max, T_min,
+                  T_max, nbase, max_level, tol, nthreads);
+  }
   return;
 }
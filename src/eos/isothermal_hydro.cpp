@@ -26,7 +26,9 @@ EquationOfState::EquationOfState(MeshBlock *pmb, ParameterInput *pin) :
     pmy_block_(pmb),
     iso_sound_speed_{pin->GetReal("hydro", "iso_sound_speed")},  // error if missing!
     density_floor_{pin->GetOrAddReal("hydro", "dfloor", std::sqrt(1024*float_min) )},
-    scalar_floor_{pin->GetOrAddReal("hydro", "sfloor", std::sqrt(1024*float_min))} {}
+    scalar_floor_{pin->GetOrAddReal("hydro", "sfloor", std::sqrt(1024*float_min))} {
+  InitCeilings(pin);
+}
 
 //----------------------------------------------------------------------------------------
 //! \fn void EquationOfState::ConservedToPrimitive(AthenaArray<Real> &cons,
@@ -37,32 +39,39 @@ void EquationOfState::ConservedToPrimitive(
     AthenaArray<Real> &cons, const AthenaArray<Real> &prim_old, const FaceField &b,
     AthenaArray<Real> &prim, AthenaArray<Real> &bcc,
     Coordinates *pco, int il, int iu, int jl, int ju, int kl, int ku) {
-  for (int k=kl; k<=ku; ++k) {
-    for (int j=jl; j<=ju; ++j) {
+  const int nthreads = pmy_block_->pmy_mesh->GetNumLoopThreads();
+#pragma omp parallel num_threads(nthreads)
+  {
+    int jb = jl, jt = ju, kb = kl, kt = ku;
+    pmy_block_->LoopThreadRange(jb, jt, kb, kt);
+    for (int k=kb; k<=kt; ++k) {
+      for (int j=jb; j<=jt; ++j) {
 #pragma omp simd
-      for (int i=il; i<=iu; ++i) {
-        Real& u_d  = cons(IDN,k,j,i);
-        Real& u_m1 = cons(IM1,k,j,i);
-        Real& u_m2 = cons(IM2,k,j,i);
-        Real& u_m3 = cons(IM3,k,j,i);
-
-        Real& w_d  = prim(IDN,k,j,i);
-        Real& w_vx = prim(IVX,k,j,i);
-        Real& w_vy = prim(IVY,k,j,i);
-        Real& w_vz = prim(IVZ,k,j,i);
-
-        // apply density floor, without changing momentum or energy
-        u_d = (u_d > density_floor_) ?  u_d : density_floor_;
-        w_d = u_d;
-
-        Real di = 1.0/u_d;
-        w_vx = u_m1*di;
-        w_vy = u_m2*di;
-        w_vz = u_m3*di;
+        for (int i=il; i<=iu; ++i) {
+          Real& u_d  = cons(IDN,k,j,i);
+          Real& u_m1 = cons(IM1,k,j,i);
+          Real& u_m2 = cons(IM2,k,j,i);
+          Real& u_m3 = cons(IM3,k,j,i);
+
+          Real& w_d  = prim(IDN,k,j,i);
+          Real& w_vx = prim(IVX,k,j,i);
+          Real& w_vy = prim(IVY,k,j,i);
+          Real& w_vz = prim(IVZ,k,j,i);
+
+          // apply density floor, without changing momentum or energy
+          u_d = (u_d > density_floor_) ?  u_d : density_floor_;
+          w_d = u_d;
+
+          Real di = 1.0/u_d;
+          w_vx = u_m1*di;
+          w_vy = u_m2*di;
+          w_vz = u_m3*di;
+        }
       }
     }
   }
 
+  if (ceilings_) ApplyCeilings(cons, prim, pco, il, iu, jl, ju, kl, ku);
   return;
 }
 
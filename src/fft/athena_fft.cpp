@@ -272,10 +272,12 @@ AthenaFFTPlan *FFTBlock::CreatePlan(int nfast, int nslow,
   plan->dir = static_cast<int>(dir);
   plan->dim = dim_;
 #ifdef MPI_PARALLEL
+  // own communicator, so that the FFT may run concurrently with other MPI traffic
+  MPI_Comm comm_fft = pmy_driver_->MPI_COMM_FFT;
   int nbuf;
   if (dir == AthenaFFTDirection::forward) {
     plan->dir = FFTW_FORWARD;
-    plan->plan2d = fft_2d_create_plan(MPI_COMM_WORLD, nfast, nslow,
+    plan->plan2d = fft_2d_create_plan(comm_fft, nfast, nslow,
                                       f_in_->is[0], f_in_->ie[0],
                                       f_in_->is[1], f_in_->ie[1],
                                       f_out_->is[f_in_->iloc[0]],
@@ -285,7 +287,7 @@ AthenaFFTPlan *FFTBlock::CreatePlan(int nfast, int nslow,
                                       0, permute1_, &nbuf);
   } else {
     plan->dir = FFTW_BACKWARD;
-    plan->plan2d = fft_2d_create_plan(MPI_COMM_WORLD, nfast, nslow,
+    plan->plan2d = fft_2d_create_plan(comm_fft, nfast, nslow,
                                       b_in_->is[0], b_in_->ie[0],
                                       b_in_->is[1], b_in_->ie[1],
                                       b_out_->is[b_in_->iloc[0]],
@@ -328,6 +330,8 @@ AthenaFFTPlan *FFTBlock::CreatePlan(int nfast, int nmid, int nslow,
   plan->dir = static_cast<int>(dir);
   plan->dim = dim_;
 #ifdef MPI_PARALLEL
+  // own communicator, so that the FFT may run concurrently with other MPI traffic
+  MPI_Comm comm_fft = pmy_driver_->MPI_COMM_FFT;
   int nbuf;
   int ois[3], oie[3];
   if (dir == AthenaFFTDirection::forward) {
@@ -336,7 +340,7 @@ AthenaFFTPlan *FFTBlock::CreatePlan(int nfast, int nmid, int nslow,
       oie[l] = f_out_->ie[(l+(dim_-permute1_)) % dim_];
     }
     plan->dir = FFTW_FORWARD;
-    plan->plan3d = fft_3d_create_plan(MPI_COMM_WORLD, nfast, nmid, nslow,
+    plan->plan3d = fft_3d_create_plan(comm_fft, nfast, nmid, nslow,
                                       f_in_->is[0], f_in_->ie[0],
                                       f_in_->is[1], f_in_->ie[1],
                                       f_in_->is[2], f_in_->ie[2],
@@ -350,7 +354,7 @@ AthenaFFTPlan *FFTBlock::CreatePlan(int nfast, int nmid, int nslow,
       oie[l] = b_out_->ie[(l+(dim_-permute2_)) % dim_];
     }
     plan->dir = FFTW_BACKWARD;
-    plan->plan3d = fft_3d_create_plan(MPI_COMM_WORLD, nfast, nmid, nslow,
+    plan->plan3d = fft_3d_create_plan(comm_fft, nfast, nmid, nslow,
                                       b_in_->is[0], b_in_->ie[0],
                                       b_in_->is[1], b_in_->ie[1],
                                       b_in_->is[2], b_in_->ie[2],
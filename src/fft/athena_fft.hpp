@@ -13,6 +13,7 @@
 // C++ headers
 #include <complex>
 #include <iostream>
+#include <string>
 
 // Athena++ headers
 #include "../athena.hpp"
@@ -180,6 +181,10 @@ class FFTDriver {
 
   void QuickCreatePlan();
   void InitializeFFTBlock(bool set_norm);
+  // FFTW wisdom cache, keyed by transform size and MPI layout
+  std::string WisdomFileName() const;
+  bool ImportWisdom();
+  void ExportWisdom();
   // small functions
   int GetNumFFTBlocks() { return nblist_[Globals::my_rank]; }
 
@@ -197,6 +202,8 @@ class FFTDriver {
   int decomp_, pdim_;
 #endif
   const int dim_;
+  std::string wisdom_file_;  // prefix of the wisdom cache file, empty = no caching
+  int nthreads_;             // threads used by FFTW plans in OpenMP builds
 #ifdef MPI_PARALLEL
   MPI_Comm MPI_COMM_FFT;
 #endif
@@ -10,6 +10,8 @@
 
 // C++ headers
 #include <cmath>
+#include <cstdlib>    // free()
+#include <cstring>    // strlen()
 #include <iostream>   // endl
 #include <sstream>    // sstream
 #include <stdexcept>  // runtime_error
@@ -30,7 +32,9 @@
 // constructor, initializes data structures and parameters
 
 FFTDriver::FFTDriver(Mesh *pm, ParameterInput *pin) : nranks_(Globals::nranks),
-                                                      pmy_mesh_(pm), dim_(pm->ndim) {
+    pmy_mesh_(pm), dim_(pm->ndim),
+    wisdom_file_(pin->GetOrAddString("fft", "wisdom_file", "")),
+    nthreads_(pin->GetOrAddInteger("fft", "nthreads", 1)) {
   if (!(pm->use_uniform_meshgen_fn_[X1DIR])
       || !(pm->use_uniform_meshgen_fn_[X2DIR])
       || !(pm->use_uniform_meshgen_fn_[X3DIR])) {
@@ -162,11 +166,132 @@ void FFTDriver::InitializeFFTBlock(bool set_norm) {
   if (set_norm) pmy_fb->SetNormFactor(1./gcnt_);
 }
 
+//----------------------------------------------------------------------------------------
+//! \fn void FFTDriver::QuickCreatePlan()
+//! \brief create the forward and backward plans of the FFTBlock
+//!
+//! If <fft>/wisdom_file is set, FFTW wisdom for this transform size and layout is
+//! imported before planning, and written out after planning if it did not exist yet.
+//! In OpenMP builds, <fft>/nthreads > 1 enables threaded FFTW transforms (including the
+//! 1D transforms of the MPI remap pipeline).
+
 void FFTDriver::QuickCreatePlan() {
+#if defined(FFT) && defined(OPENMP_PARALLEL)
+  if (nthreads_ > 1) {
+    static bool fftw_threads_initialized = false;
+    if (!fftw_threads_initialized) {
+      if (fftw_init_threads() == 0) {
+        std::stringstream msg;
+        msg << "### FATAL ERROR in FFTDriver::QuickCreatePlan" << std::endl
+            << "fftw_init_threads() failed." << std::endl;
+        ATHENA_ERROR(msg);
+      }
+      fftw_threads_initialized = true;
+    }
+    fftw_plan_with_nthreads(nthreads_);
+  }
+#endif
+  bool imported = ImportWisdom();
+
   pmy_fb->fplan_ = pmy_fb->QuickCreatePlan(
       pmy_fb->in_, FFTBlock::AthenaFFTDirection::forward);
   pmy_fb->bplan_ = pmy_fb->QuickCreatePlan(
       pmy_fb->in_, FFTBlock::AthenaFFTDirection::backward);
 
+  if (!imported) ExportWisdom();
+  return;
+}
+
+//----------------------------------------------------------------------------------------
+//! \fn std::string FFTDriver::WisdomFileName() const
+//! \brief name of the wisdom cache file for the current transform size, MPI layout and
+//!        number of FFTW threads
+
+std::string FFTDriver::WisdomFileName() const {
+  std::stringstream fname;
+  fname << wisdom_file_ << "." << dim_ << "d_" << fft_mesh_size_.nx1 << "x"
+        << fft_mesh_size_.nx2 << "x" << fft_mesh_size_.nx3 << "_p" << npx1 << "x"
+        << npx2 << "x" << npx3 << "_t" << nthreads_ << ".wisdom";
+  return fname.str();
+}
+
+//----------------------------------------------------------------------------------------
+//! \fn bool FFTDriver::ImportWisdom()
+//! \brief read the wisdom cache on rank 0 and broadcast it to all other ranks
+//!
+//! Returns true if the cache file existed and was imported. Must be called by all ranks.
+
+bool FFTDriver::ImportWisdom() {
+  int found = 0;
+#ifdef FFT
+  if (wisdom_file_.empty()) return false;
+  if (Globals::my_rank == 0)
+    found = fftw_import_wisdom_from_filename(WisdomFileName().c_str());
+#ifdef MPI_PARALLEL
+  MPI_Bcast(&found, 1, MPI_INT, 0, MPI_COMM_FFT);
+  if (found) {
+    char *wisdom = nullptr;
+    int len = 0;
+    if (Globals::my_rank == 0) {
+      wisdom = fftw_export_wisdom_to_string();
+      len = static_cast<int>(std::strlen(wisdom)) + 1;
+    }
+    MPI_Bcast(&len, 1, MPI_INT, 0, MPI_COMM_FFT);
+    if (Globals::my_rank != 0)
+      wisdom = static_cast<char *>(std::malloc(len));
+    MPI_Bcast(wisdom, len, MPI_CHAR, 0, MPI_COMM_FFT);
+    if (Globals::my_rank != 0)
+      fftw_import_wisdom_from_string(wisdom);
+    std::free(wisdom);
+  }
+#endif // MPI_PARALLEL
+#endif // FFT
+  return (found != 0);
+}
+
+//----------------------------------------------------------------------------------------
+//! \fn void FFTDriver::ExportWisdom()
+//! \brief merge the wisdom accumulated by all ranks on rank 0 and write the cache file
+//!
+//! Must be called by all ranks.
+
+void FFTDriver::ExportWisdom() {
+#ifdef FFT
+  if (wisdom_file_.empty()) return;
+  char *wisdom = fftw_export_wisdom_to_string();
+#ifdef MPI_PARALLEL
+  // each rank plans different local 1D transforms in the remap pipeline
+  int len = static_cast<int>(std::strlen(wisdom)) + 1;
+  int *lens = nullptr, *displs = nullptr;
+  char *all = nullptr;
+  if (Globals::my_rank == 0) {
+    lens = new int[nranks_];
+    displs = new int[nranks_];
+  }
+  MPI_Gather(&len, 1, MPI_INT, lens, 1, MPI_INT, 0, MPI_COMM_FFT);
+  if (Globals::my_rank == 0) {
+    displs[0] = 0;
+    for (int n=1; n<nranks_; n++)
+      displs[n] = displs[n-1] + lens[n-1];
+    all = new char[displs[nranks_-1] + lens[nranks_-1]];
+  }
+  MPI_Gatherv(wisdom, len, MPI_CHAR, all, lens, displs, MPI_CHAR, 0, MPI_COMM_FFT);
+  if (Globals::my_rank == 0) {
+    for (int n=1; n<nranks_; n++)
+      fftw_import_wisdom_from_string(all + displs[n]);
+    delete [] lens;
+    delete [] displs;
+    delete [] all;
+  }
+#endif // MPI_PARALLEL
+  std::free(wisdom);
+  if (Globals::my_rank == 0) {
+    if (fftw_export_wisdom_to_filename(WisdomFileName().c_str()) == 0) {
+      std::cout << "### Warning in FFTDriver::ExportWisdom" << std::endl
+                << "Could not write FFTW wisdom file '" << WisdomFileName() << "'"
+                << std::endl;
+    }
+  }
+#endif // FFT
   return;
 }
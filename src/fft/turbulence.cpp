@@ -12,6 +12,8 @@
 #include <algorithm>
 #include <cmath>
 #include <complex>
+#include <cstdint>
+#include <cstring>    // memcpy()
 #include <iostream>
 #include <random>     // mt19937, normal_distribution, uniform_real_distribution
 #include <sstream>    // sstream
@@ -25,10 +27,15 @@
 #include "../globals.hpp"
 #include "../hydro/hydro.hpp"
 #include "../mesh/mesh.hpp"
+#include "../parameter_input.hpp"
 #include "../utils/utils.hpp"
 #include "athena_fft.hpp"
 #include "turbulence.hpp"
 
+#ifdef MPI_PARALLEL
+#include <mpi.h>
+#endif
+
 //----------------------------------------------------------------------------------------
 //! \fn TurbulenceDriver::TurbulenceDriver(Mesh *pm, ParameterInput *pin)
 //! \brief TurbulenceDriver constructor
@@ -56,6 +63,11 @@ TurbulenceDriver::TurbulenceDriver(Mesh *pm, ParameterInput *pin) :
     // scale height for turbulent driving:
     z_turb(pin->GetOrAddReal("turbulence", "z_turb", -1)),    
     v_rms(pin->GetOrAddReal("turbulence", "v_rms", -1)), // target RMS velocity driving
+    // MeshBlocks whose z_turb weight is everywhere below this are not forced:
+    z_turb_wmin(pin->GetOrAddReal("turbulence", "z_turb_wmin", 0.0)),
+    // overlap generation of the next continuous forcing field with the current cycle:
+    async_driving_(pm->turb_flag == 3 &&
+                   pin->GetOrAddBoolean("turbulence", "async_driving", false)),
     // TODO(changgoo): this assumes 3D and should not work with 1D, 2D. Add check.
     vel{ {nmb, pm->my_blocks(0)->ncells3,
                pm->my_blocks(0)->ncells2, pm->my_blocks(0)->ncells1},
@@ -122,10 +134,54 @@ TurbulenceDriver::TurbulenceDriver(Mesh *pm, ParameterInput *pin) :
     }
   }
   rng_generator.seed(rseed);
+
+  if (async_driving_) {
+#ifndef OPENMP_PARALLEL
+    if (Globals::my_rank == 0) {
+      std::cout << "### Warning in TurbulenceDriver::TurbulenceDriver" << std::endl
+                << "async_driving requires an OpenMP build; "
+                << "the forcing field will be generated synchronously." << std::endl;
+    }
+    async_driving_ = false;
+#elif defined(MPI_PARALLEL)
+    // the helper thread runs the parallel FFT (on its own communicator) concurrently
+    // with the boundary communication of the main thread
+    int mpi_thread_support;
+    MPI_Query_thread(&mpi_thread_support);
+    if (mpi_thread_support != MPI_THREAD_MULTIPLE) {
+      if (Globals::my_rank == 0) {
+        std::cout << "### Warning in TurbulenceDriver::TurbulenceDriver" << std::endl
+                  << "async_driving requires MPI_THREAD_MULTIPLE; "
+                  << "the forcing field will be generated synchronously." << std::endl;
+      }
+      async_driving_ = false;
+    }
+#endif
+  }
+  if (async_driving_) {
+    for (int nv=0; nv<3; nv++)
+      vel_next_[nv].NewAthenaArray(nmb, pm->my_blocks(0)->ncells3,
+                                   pm->my_blocks(0)->ncells2, pm->my_blocks(0)->ncells1);
+  }
+
+  // precompute the vertical weight of the forcing (the MeshBlocks do not move)
+  wz_.NewAthenaArray(pm->nblocal, pm->my_blocks(0)->ncells3);
+  block_forced_.resize(pm->nblocal);
+  for (int nb=0; nb<pm->nblocal; ++nb) {
+    MeshBlock *pmb = pm->my_blocks(nb);
+    Real wmax = 0.0;
+    for (int k=pmb->ks; k<=pmb->ke; k++) {
+      wz_(nb,k) = (z_turb > 0) ? std::exp(-SQR(pmb->pcoord->x3v(k)/z_turb)) : 1.0;
+      wmax = std::max(wmax, wz_(nb,k));
+    }
+    block_forced_[nb] = (wmax >= z_turb_wmin);
+  }
 }
 
 // destructor
 TurbulenceDriver::~TurbulenceDriver() {
+  // the helper thread may still be writing the next forcing field
+  FinishNextField();
   for (int nv=0; nv<3; nv++) {
     delete [] fv_[nv];
     delete [] fv_sh_[nv];
@@ -159,7 +215,15 @@ void TurbulenceDriver::Driving() {
       }
       break;
     case 3: // turb_flag == 3 : continuously driven turbulence with OU smoothing
-      Generate();
+      if (next_field_ready_) {
+        // field generated during the previous cycle (one-step lag in the OU process)
+        FinishNextField();
+        for (int nv=0; nv<3; nv++) vel[nv].SwapAthenaArray(vel_next_[nv]);
+        next_field_ready_ = false;
+      } else {
+        Generate();
+      }
+      if (async_driving_) StartNextField(pm->dt);
       Perturb(pm->dt);
       break;
     default:
@@ -177,12 +241,22 @@ void TurbulenceDriver::Driving() {
 
 void TurbulenceDriver::Generate() {
   Mesh *pm = pmy_mesh_;
-  FFTBlock *pfb = pmy_fb;
-  AthenaFFTPlan *plan = pfb->bplan_;
+  Real OUdt = pm->dt;
+  if (pm->turb_flag == 2) OUdt=dtdrive;
+  GenerateField(vel, OUdt);
+}
 
-  int nbs = nslist_[Globals::my_rank];
-  int nbe = nbs + nblist_[Globals::my_rank] - 1;
+//----------------------------------------------------------------------------------------
+//! \fn void TurbulenceDriver::GenerateField(AthenaArray<Real> *dv, Real ou_dt)
+//! \brief Generate velocity pertubation in dv[3], advancing the OU process by ou_dt.
+//!
+//! Touches only the Fourier-space fields, the RNG, the FFTBlock and dv, so that it can
+//! run on a helper thread while the MeshBlocks are being integrated.
 
+void TurbulenceDriver::GenerateField(AthenaArray<Real> *dv, Real ou_dt) {
+  Mesh *pm = pmy_mesh_;
+  FFTBlock *pfb = pmy_fb;
+  AthenaFFTPlan *plan = pfb->bplan_;
 
   // For driven turbulence (turb_flag == 2 or 3),
   // Ornstein-Uhlenbeck (OU) process is implemented.
@@ -196,23 +270,195 @@ void TurbulenceDriver::Generate() {
     if (f_shear >= 0) Project(fv_, f_shear);
     if (tcorr > 0.) initialized_ = true;
   } else {
-    Real OUdt = pm->dt;
-    if (pm->turb_flag == 2) OUdt=dtdrive;
-    OUProcess(OUdt);
+    OUProcess(ou_dt);
   }
 
   for (int nv=0; nv<3; nv++) {
-    AthenaArray<Real> &dv = vel[nv], dv_mb;
+    AthenaArray<Real> dv_mb;
     for (int kidx=0; kidx<pfb->cnt_; kidx++) pfb->in_[kidx] = fv_[nv][kidx];
     pfb->Execute(plan);
     for (int nb=0; nb<pm->nblocal; ++nb) {
       MeshBlock *pmb = pm->my_blocks(nb);
-      dv_mb.InitWithShallowSlice(dv, 4, nb, 1);
+      dv_mb.InitWithShallowSlice(dv[nv], 4, nb, 1);
       pfb->RetrieveResult(dv_mb, 0, NGHOST, pmb->loc, pmb->block_size);
     }
   }
 }
 
+//----------------------------------------------------------------------------------------
+//! \fn void TurbulenceDriver::StartNextField(Real ou_dt)
+//! \brief Launch the generation of the next forcing field into vel_next_ on a helper
+//!        thread (falls back to generating it immediately)
+
+void TurbulenceDriver::StartNextField(Real ou_dt) {
+  next_ou_dt_ = ou_dt;
+  next_field_ready_ = true;
+#ifdef OPENMP_PARALLEL
+  if (pthread_create(&next_field_thread_, nullptr, GenerateNextField, this) == 0) {
+    helper_running_ = true;
+    return;
+  }
+  std::cout << "### Warning in TurbulenceDriver::StartNextField" << std::endl
+            << "Could not create helper thread; generating forcing synchronously"
+            << std::endl;
+  async_driving_ = false;
+#endif
+  GenerateField(vel_next_, next_ou_dt_);
+  return;
+}
+
+//----------------------------------------------------------------------------------------
+//! \fn void TurbulenceDriver::FinishNextField()
+//! \brief Wait until the helper thread has finished the next forcing field
+
+void TurbulenceDriver::FinishNextField() {
+#ifdef OPENMP_PARALLEL
+  if (helper_running_) pthread_join(next_field_thread_, nullptr);
+#endif
+  helper_running_ = false;
+  return;
+}
+
+#ifdef OPENMP_PARALLEL
+//----------------------------------------------------------------------------------------
+//! \fn void *TurbulenceDriver::GenerateNextField(void *arg)
+//! \brief Helper thread entry point
+
+void *TurbulenceDriver::GenerateNextField(void *arg) {
+  TurbulenceDriver *ptrbd = static_cast<TurbulenceDriver *>(arg);
+  ptrbd->GenerateField(ptrbd->vel_next_, ptrbd->next_ou_dt_);
+  return nullptr;
+}
+#endif
+
+//----------------------------------------------------------------------------------------
+//! \fn IOWrapperSizeT TurbulenceDriver::GetRestartRecordSizeInBytes()
+//! \brief Size of the per-rank driving record in the restart file (identical on all
+//!        ranks so that the records can be addressed by rank)
+//!
+//! Record layout: layout key, tdrive, RNG state (text), fv_[3], and with asynchronous
+//! driving the field already generated for the next cycle (vel_next_[3]).
+
+IOWrapperSizeT TurbulenceDriver::GetRestartRecordSizeInBytes() {
+  std::uint64_t size = kRestartKeys*sizeof(std::int64_t) + sizeof(Real) + kRngStateChars
+                       + 3*pmy_fb->cnt_*sizeof(std::complex<Real>);
+  if (async_driving_) size += 3*vel_next_[0].GetSizeInBytes();
+#ifdef MPI_PARALLEL
+  MPI_Allreduce(MPI_IN_PLACE, &size, 1, MPI_UINT64_T, MPI_MAX, MPI_COMM_WORLD);
+#endif
+  return static_cast<IOWrapperSizeT>(size);
+}
+
+//----------------------------------------------------------------------------------------
+//! \fn void TurbulenceDriver::WriteRestartState(IOWrapper &resfile,
+//!                                              IOWrapperSizeT offset)
+//! \brief Write the state of the OU process and RNG of this rank (collective)
+
+void TurbulenceDriver::WriteRestartState(IOWrapper &resfile, IOWrapperSizeT offset) {
+  // the helper thread may still be advancing the OU process
+  FinishNextField();
+  IOWrapperSizeT recsize = GetRestartRecordSizeInBytes();
+  char *rec = new char[recsize]();
+  char *pdata = rec;
+
+  std::int64_t key[kRestartKeys] = {static_cast<std::int64_t>(recsize), Globals::nranks,
+                                    Globals::my_rank, pmy_fb->cnt_,
+                                    async_driving_ ? vel_next_[0].GetSize() : 0,
+                                    (initialized_ ? 1 : 0) + (next_field_ready_ ? 2 : 0)};
+  std::memcpy(pdata, key, sizeof(key));
+  pdata += sizeof(key);
+  std::memcpy(pdata, &tdrive, sizeof(Real));
+  pdata += sizeof(Real);
+
+  std::stringstream rng_state;
+  rng_state << rng_generator;
+  std::string str = rng_state.str();
+  if (str.size() >= kRngStateChars) {
+    std::stringstream msg;
+    msg << "### FATAL ERROR in TurbulenceDriver::WriteRestartState" << std::endl
+        << "RNG state (" << str.size() << " chars) does not fit in the restart record"
+        << std::endl;
+    ATHENA_ERROR(msg);
+  }
+  std::memcpy(pdata, str.c_str(), str.size());
+  pdata += kRngStateChars;
+
+  for (int nv=0; nv<3; nv++) {
+    std::memcpy(pdata, fv_[nv], pmy_fb->cnt_*sizeof(std::complex<Real>));
+    pdata += pmy_fb->cnt_*sizeof(std::complex<Real>);
+  }
+  if (async_driving_) {
+    for (int nv=0; nv<3; nv++) {
+      std::memcpy(pdata, vel_next_[nv].data(), vel_next_[nv].GetSizeInBytes());
+      pdata += vel_next_[nv].GetSizeInBytes();
+    }
+  }
+
+  resfile.Write_at_all(rec, recsize, 1, offset + recsize*Globals::my_rank);
+  delete [] rec;
+  return;
+}
+
+//----------------------------------------------------------------------------------------
+//! \fn void TurbulenceDriver::ReadRestartState(IOWrapper &resfile,
+//!                                             IOWrapperSizeT offset)
+//! \brief Restore the state of the OU process and RNG of this rank (collective)
+//!
+//! Falls back to a fresh spectrum (as before) if the restart file has no matching
+//! record, e.g. it was written by an older version or with a different number of
+//! ranks or driving mode.
+
+void TurbulenceDriver::ReadRestartState(IOWrapper &resfile, IOWrapperSizeT offset) {
+  IOWrapperSizeT recsize = GetRestartRecordSizeInBytes();
+  char *rec = new char[recsize]();
+  char *pdata = rec;
+
+  int valid = (resfile.Read_at_all(rec, recsize, 1, offset + recsize*Globals::my_rank)
+               == 1);
+  std::int64_t key[kRestartKeys];
+  std::memcpy(key, pdata, sizeof(key));
+  pdata += sizeof(key);
+  valid = valid && key[0] == static_cast<std::int64_t>(recsize)
+          && key[1] == Globals::nranks && key[2] == Globals::my_rank
+          && key[3] == pmy_fb->cnt_
+          && key[4] == (async_driving_ ? vel_next_[0].GetSize() : 0);
+#ifdef MPI_PARALLEL
+  MPI_Allreduce(MPI_IN_PLACE, &valid, 1, MPI_INT, MPI_MIN, MPI_COMM_WORLD);
+#endif
+  if (!valid) {
+    if (Globals::my_rank == 0) {
+      std::cout << "### Warning in TurbulenceDriver::ReadRestartState" << std::endl
+                << "No matching turbulence driving state in the restart file; "
+                << "the forcing spectrum is regenerated." << std::endl;
+    }
+    delete [] rec;
+    return;
+  }
+
+  initialized_ = (key[5] & 1);
+  next_field_ready_ = async_driving_ && (key[5] & 2);
+  std::memcpy(&tdrive, pdata, sizeof(Real));
+  pdata += sizeof(Real);
+
+  char *rng_end = std::find(pdata, pdata + kRngStateChars, '\0');
+  std::stringstream rng_state(std::string(pdata, rng_end));
+  rng_state >> rng_generator;
+  pdata += kRngStateChars;
+
+  for (int nv=0; nv<3; nv++) {
+    std::memcpy(fv_[nv], pdata, pmy_fb->cnt_*sizeof(std::complex<Real>));
+    pdata += pmy_fb->cnt_*sizeof(std::complex<Real>);
+  }
+  if (async_driving_) {
+    for (int nv=0; nv<3; nv++) {
+      std::memcpy(vel_next_[nv].data(), pdata, vel_next_[nv].GetSizeInBytes());
+      pdata += vel_next_[nv].GetSizeInBytes();
+    }
+  }
+  delete [] rec;
+  return;
+}
+
 //----------------------------------------------------------------------------------------
 //! \fn void TurbulenceDriver::OUProcess(Real dt)
 //! \brief Generate velocity pertubation.
@@ -335,107 +581,83 @@ void TurbulenceDriver::PowerSpectrum(std::complex<Real> *amp) {
 //----------------------------------------------------------------------------------------
 //! \fn void TurbulenceDriver::Perturb(Real dt)
 //! \brief Add velocity perturbation to the hydro variables
+//!
+//! The perturbation dv is weighted by the vertical profile, its mass-weighted mean is
+//! removed, and it is scaled by s so that the injected energy is dedt*dt (or the RMS
+//! velocity is v_rms). All moments needed for the mean removal and the normalization
+//! are accumulated in a single pass, using
+//! \f[ \sum \rho |dv - \langle dv \rangle|^2 = \sum \rho |dv|^2 - |P|^2/M \f]
+//! \f[ \sum \mathbf{M}\cdot(dv - \langle dv \rangle)
+//!      = \sum \mathbf{M}\cdot dv - \langle dv \rangle \cdot \sum \mathbf{M} \f]
+//! with P = sum rho*dv and M = sum rho, and reduced with one MPI_Allreduce.
+//! MeshBlocks whose weight is below z_turb_wmin everywhere are skipped entirely.
 
 void TurbulenceDriver::Perturb(Real dt) {
   Mesh *pm = pmy_mesh_;
-  int nbs = nslist_[Globals::my_rank];
-  int nbe = nbs+nblist_[Globals::my_rank]-1;
 
   int il = pm->my_blocks(0)->is, iu = pm->my_blocks(0)->ie;
   int jl = pm->my_blocks(0)->js, ju = pm->my_blocks(0)->je;
   int kl = pm->my_blocks(0)->ks, ku = pm->my_blocks(0)->ke;
 
   Real aa, b, c, s, de, v1, v2, v3, den, M1, M2, M3;
-  Real m[4] = {0};
+  // m[0]: mass, m[1-3]: momentum of dv, m[4]: sum rho*dv^2, m[5]: sum M.dv,
+  // m[6-8]: gas momentum
+  Real m[9] = {0};
   AthenaArray<Real> &dv1 = vel[0], &dv2 = vel[1], &dv3 = vel[2];
 
-  Real z;
-
   for (int nb=0; nb<pm->nblocal; ++nb) {
+    if (!block_forced_[nb]) continue;
     MeshBlock *pmb = pm->my_blocks(nb);
     for (int k=kl; k<=ku; k++) {
+      Real wz = wz_(nb,k);
       for (int j=jl; j<=ju; j++) {
         for (int i=il; i<=iu; i++) {
-          z = pmb->pcoord->x3v(k);
-          den = pmb->phydro->u(IDN,k,j,i);
-
           // Apply a Gaussian weight if a turbulent scale height is defined
-          if (z_turb > 0) {
-            dv1(nb,k,j,i) *= std::exp(-SQR(z/z_turb));
-            dv2(nb,k,j,i) *= std::exp(-SQR(z/z_turb));
-            dv3(nb,k,j,i) *= std::exp(-SQR(z/z_turb));
-          }
-
-          m[0] += den;
-          m[1] += den*dv1(nb,k,j,i);
-          m[2] += den*dv2(nb,k,j,i);
-          m[3] += den*dv3(nb,k,j,i);
-        }
-      }
-    }
-  }
-
-#ifdef MPI_PARALLEL
-  int mpierr;
-  // Sum the perturbations over all processors
-  mpierr = MPI_Allreduce(MPI_IN_PLACE, m, 4, MPI_DOUBLE, MPI_SUM, MPI_COMM_WORLD);
-  if (mpierr) {
-    std::stringstream msg;
-    msg << "[normalize]: MPI_Allreduce error = " << mpierr << std::endl;
-    ATHENA_ERROR(msg);
-  }
-#endif // MPI_PARALLEL
-
-  for (int nb=0; nb<nmb; nb++) {
-    for (int k=kl; k<=ku; k++) {
-      for (int j=jl; j<=ju; j++) {
-        for (int i=il; i<=iu; i++) {
-          dv1(nb,k,j,i) -= m[1]/m[0];
-          dv2(nb,k,j,i) -= m[2]/m[0];
-          dv3(nb,k,j,i) -= m[3]/m[0];
-        }
-      }
-    }
-  }
-
-  // Calculate unscaled energy of perturbations
-  m[0] = 0.0;
-  m[1] = 0.0;
-  m[2] = 0.0;
-  for (int nb=0; nb<pm->nblocal; ++nb) {
-    MeshBlock *pmb = pm->my_blocks(nb);
-    for (int k=kl; k<=ku; k++) {
-      for (int j=jl; j<=ju; j++) {
-        for (int i=il; i<=iu; i++) {
-          v1 = dv1(nb,k,j,i);
-          v2 = dv2(nb,k,j,i);
-          v3 = dv3(nb,k,j,i);
+          v1 = (dv1(nb,k,j,i) *= wz);
+          v2 = (dv2(nb,k,j,i) *= wz);
+          v3 = (dv3(nb,k,j,i) *= wz);
           den = pmb->phydro->u(IDN,k,j,i);
           M1 = pmb->phydro->u(IM1,k,j,i);
           M2 = pmb->phydro->u(IM2,k,j,i);
           M3 = pmb->phydro->u(IM3,k,j,i);
           m[0] += den;
-          m[1] += den*(SQR(v1) + SQR(v2) + SQR(v3));
-          m[2] += M1*v1 + M2*v2 + M3*v3;
+          m[1] += den*v1;
+          m[2] += den*v2;
+          m[3] += den*v3;
+          m[4] += den*(SQR(v1) + SQR(v2) + SQR(v3));
+          m[5] += M1*v1 + M2*v2 + M3*v3;
+          m[6] += M1;
+          m[7] += M2;
+          m[8] += M3;
         }
       }
     }
   }
 
 #ifdef MPI_PARALLEL
-  // Sum the perturbations over all processors
-  mpierr = MPI_Allreduce(MPI_IN_PLACE, m, 3, MPI_DOUBLE, MPI_SUM, MPI_COMM_WORLD);
+  // Sum the moments over all processors
+  int mpierr = MPI_Allreduce(MPI_IN_PLACE, m, 9, MPI_ATHENA_REAL, MPI_SUM,
+                             MPI_COMM_WORLD);
   if (mpierr) {
     std::stringstream msg;
-    msg << "[normalize]: MPI_Allreduce error = "
-        << mpierr << std::endl;
+    msg << "[normalize]: MPI_Allreduce error = " << mpierr << std::endl;
     ATHENA_ERROR(msg);
   }
 #endif // MPI_PARALLEL
 
+  // no MeshBlock is forced
+  if (m[0] <= 0.0) return;
+
+  // mass-weighted mean of the perturbation, removed so that no net momentum is added
+  Real dv1_mean = m[1]/m[0], dv2_mean = m[2]/m[0], dv3_mean = m[3]/m[0];
+  // unscaled energy of the mean-free perturbations
+  Real e_dv = std::max(m[4] - (m[1]*dv1_mean + m[2]*dv2_mean + m[3]*dv3_mean),
+                       static_cast<Real>(0.0));
+  Real m_dv = m[5] - (m[6]*dv1_mean + m[7]*dv2_mean + m[8]*dv3_mean);
+
   // Rescale to give the correct energy injection rate
   if (v_rms > 0) {
-    aa = sqrt(m[1]/m[0]);
+    aa = std::sqrt(e_dv/m[0]);
     s = v_rms/aa;
   } else {
     if (pm->turb_flag > 1) {
@@ -446,9 +668,9 @@ void TurbulenceDriver::Perturb(Real dt) {
       de = dedt;
     }
 
-    aa = 0.5*m[1];
+    aa = 0.5*e_dv;
     aa = std::max(aa,static_cast<Real>(1.0e-20));
-    b = m[2];
+    b = m_dv;
     c = -de/dvol;
     if (b >= 0.0) {
       s = (-2.0*c)/(b + std::sqrt(b*b - 4.0*aa*c));
@@ -461,13 +683,14 @@ void TurbulenceDriver::Perturb(Real dt) {
 
   // Apply momentum pertubations
   for (int nb=0; nb<pm->nblocal; ++nb) {
+    if (!block_forced_[nb]) continue;
     MeshBlock *pmb = pm->my_blocks(nb);
     for (int k=kl; k<=ku; k++) {
       for (int j=jl; j<=ju; j++) {
         for (int i=il; i<=iu; i++) {
-          v1 = dv1(nb,k,j,i);
-          v2 = dv2(nb,k,j,i);
-          v3 = dv3(nb,k,j,i);
+          v1 = dv1(nb,k,j,i) - dv1_mean;
+          v2 = dv2(nb,k,j,i) - dv2_mean;
+          v3 = dv3(nb,k,j,i) - dv3_mean;
           den = pmb->phydro->u(IDN,k,j,i);
           M1 = pmb->phydro->u(IM1,k,j,i);
           M2 = pmb->phydro->u(IM2,k,j,i);
@@ -13,12 +13,19 @@
 
 // C++ headers
 #include <random>     // mt19937, normal_distribution, uniform_real_distribution
+#include <vector>
 
 // Athena++ headers
 #include "../athena.hpp"
 #include "../athena_arrays.hpp"
+#include "../outputs/io_wrapper.hpp"
 #include "athena_fft.hpp"
 
+// POSIX threads header (helper thread for asynchronous driving)
+#ifdef OPENMP_PARALLEL
+#include <pthread.h>
+#endif
+
 class Mesh;
 class MeshBlock;
 class ParameterInput;
@@ -42,18 +49,45 @@ class TurbulenceDriver : public FFTDriver{
   void Project(std::complex<Real> **fv, std::complex<Real> **fv_sh,
                std::complex<Real> **fv_co);
   std::int64_t GetKcomp(int idx, int disp, int Nx);
+  // driving state (OU process, RNG, pending field) stored after the MeshBlock data
+  IOWrapperSizeT GetRestartRecordSizeInBytes();
+  void WriteRestartState(IOWrapper &resfile, IOWrapperSizeT offset);
+  void ReadRestartState(IOWrapper &resfile, IOWrapperSizeT offset);
  private:
+  void GenerateField(AthenaArray<Real> *dv, Real ou_dt);
   std::int64_t rseed;
   int nlow, nhigh;
   Real tdrive, dtdrive, tcorr, f_shear;
   Real expo, dedt, dvol;
   Real z_turb, v_rms;
+  // vertical forcing weight exp(-(z/z_turb)^2) per local MeshBlock and k, and whether a
+  // MeshBlock is forced at all (max. weight >= z_turb_wmin)
+  Real z_turb_wmin;
+  AthenaArray<Real> wz_;
+  std::vector<bool> block_forced_;
+  // continuous driving: the next field is generated on a helper thread while the
+  // current cycle is integrated (OpenMP builds only)
+  bool async_driving_;
   AthenaArray<Real> vel[3];
+  AthenaArray<Real> vel_next_[3];
+  Real next_ou_dt_;
+  // vel_next_ holds (or the helper thread is writing) the field for the next cycle
+  bool next_field_ready_ = false;
+  bool helper_running_ = false;
+#ifdef OPENMP_PARALLEL
+  pthread_t next_field_thread_;
+  static void *GenerateNextField(void *arg);
+#endif
+  void StartNextField(Real ou_dt);
+  void FinishNextField();
   std::complex<Real> **fv_, **fv_new_;
   std::complex<Real> **fv_sh_, **fv_co_;
   bool initialized_ = false;
   bool global_ps_ = false;
   std::mt19937_64 rng_generator;
+  // fixed slot for the textual RNG state in the restart record
+  static const int kRestartKeys = 6;
+  static const std::size_t kRngStateChars = 8192;
 };
 
 #endif // FFT_TURBULENCE_HPP_
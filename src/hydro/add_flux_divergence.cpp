@@ -38,58 +38,115 @@
 // used)
 void Hydro::AddFluxDivergence(const Real wght, AthenaArray<Real> &u_out) {
   MeshBlock *pmb = pmy_block;
+  const int nthreads = pmb->pmy_mesh->GetNumLoopThreads();
+#pragma omp parallel num_threads(nthreads)
+  {
+    int jb = pmb->js, jt = pmb->je, kb = pmb->ks, kt = pmb->ke;
+    pmb->LoopThreadRange(jb, jt, kb, kt);
+    for (int k=kb; k<=kt; ++k) {
+      for (int j=jb; j<=jt; ++j) {
+        AddFluxDivergencePencil(k, j, wght, u_out);
+      }
+    }
+  }
+  return;
+}
+
+//----------------------------------------------------------------------------------------
+//! \fn  void Hydro::AddFluxDivergenceFused
+//! \brief Single-sweep stage update of the time integrator:
+//! u1 += delta*u, u = ave_wghts[0]*u + ave_wghts[1]*u1 + ave_wghts[2]*u2, followed by
+//! the flux divergence and the pencil source terms, all applied pencil by pencil.
+//!
+//! Equivalent to 2x MeshBlock::WeightedAve() + AddFluxDivergence() + the constant
+//! acceleration and user pencil source terms, but each register is streamed through
+//! memory only once per stage. With <mesh> num_loop_threads > 1 the pencils are split
+//! over a team of threads, so user pencil source functions must be thread-safe.
+
+void Hydro::AddFluxDivergenceFused(const Real wght, const Real delta,
+                                   const Real ave_wghts[3], const Real time,
+                                   const AthenaArray<Real> &prim_scalar,
+                                   const AthenaArray<Real> &bcc,
+                                   AthenaArray<Real> &cons_scalar) {
+  MeshBlock *pmb = pmy_block;
+  const Real delta_wghts[3] = {1.0, delta, 0.0};
+  const bool add_sources = hsrc.hydro_sourceterms_defined
+                           && pmb->pmy_mesh->fluid_setup == FluidFormulation::evolve;
+  const int nthreads = pmb->pmy_mesh->GetNumLoopThreads();
+
+#pragma omp parallel num_threads(nthreads)
+  {
+    int jb = pmb->js, jt = pmb->je, kb = pmb->ks, kt = pmb->ke;
+    pmb->LoopThreadRange(jb, jt, kb, kt);
+    for (int k=kb; k<=kt; ++k) {
+      for (int j=jb; j<=jt; ++j) {
+        pmb->WeightedAvePencil(u1, u, u2, delta_wghts, k, j);
+        pmb->WeightedAvePencil(u, u1, u2, ave_wghts, k, j);
+        AddFluxDivergencePencil(k, j, wght, u);
+        if (add_sources)
+          hsrc.AddSourceTermsPencil(k, j, time, wght, w, prim_scalar, bcc, u,
+                                    cons_scalar);
+      }
+    }
+  }
+  return;
+}
+
+//----------------------------------------------------------------------------------------
+//! \fn  void Hydro::AddFluxDivergencePencil
+//! \brief Adds flux divergence to the conserved variables on a single (k,j) pencil
+
+void Hydro::AddFluxDivergencePencil(const int k, const int j, const Real wght,
+                                    AthenaArray<Real> &u_out) {
+  MeshBlock *pmb = pmy_block;
   AthenaArray<Real> &x1flux = flux[X1DIR];
   AthenaArray<Real> &x2flux = flux[X2DIR];
   AthenaArray<Real> &x3flux = flux[X3DIR];
-  int is = pmb->is; int js = pmb->js; int ks = pmb->ks;
-  int ie = pmb->ie; int je = pmb->je; int ke = pmb->ke;
-  AthenaArray<Real> &x1area = x1face_area_, &x2area = x2face_area_,
-                 &x2area_p1 = x2face_area_p1_, &x3area = x3face_area_,
-                 &x3area_p1 = x3face_area_p1_, &vol = cell_volume_, &dflx = dflx_;
-
-  for (int k=ks; k<=ke; ++k) {
-    for (int j=js; j<=je; ++j) {
-      // calculate x1-flux divergence
-      pmb->pcoord->Face1Area(k, j, is, ie+1, x1area);
-      for (int n=0; n<NHYDRO; ++n) {
+  int is = pmb->is; int ie = pmb->ie;
+  PencilScratch &ps = Pencil();
+  AthenaArray<Real> &x1area = ps.x1face_area, &x2area = ps.x2face_area,
+                 &x2area_p1 = ps.x2face_area_p1, &x3area = ps.x3face_area,
+                 &x3area_p1 = ps.x3face_area_p1, &vol = ps.cell_volume, &dflx = ps.dflx;
+
+  // calculate x1-flux divergence
+  pmb->pcoord->Face1Area(k, j, is, ie+1, x1area);
+  for (int n=0; n<NHYDRO; ++n) {
 #pragma omp simd
-        for (int i=is; i<=ie; ++i) {
-          dflx(n,i) = (x1area(i+1)*x1flux(n,k,j,i+1) - x1area(i)*x1flux(n,k,j,i));
-        }
-      }
+    for (int i=is; i<=ie; ++i) {
+      dflx(n,i) = (x1area(i+1)*x1flux(n,k,j,i+1) - x1area(i)*x1flux(n,k,j,i));
+    }
+  }
 
-      // calculate x2-flux divergence
-      if (pmb->block_size.nx2 > 1) {
-        pmb->pcoord->Face2Area(k, j  , is, ie, x2area   );
-        pmb->pcoord->Face2Area(k, j+1, is, ie, x2area_p1);
-        for (int n=0; n<NHYDRO; ++n) {
+  // calculate x2-flux divergence
+  if (pmb->block_size.nx2 > 1) {
+    pmb->pcoord->Face2Area(k, j  , is, ie, x2area   );
+    pmb->pcoord->Face2Area(k, j+1, is, ie, x2area_p1);
+    for (int n=0; n<NHYDRO; ++n) {
 #pragma omp simd
-          for (int i=is; i<=ie; ++i) {
-            dflx(n,i) += (x2area_p1(i)*x2flux(n,k,j+1,i) - x2area(i)*x2flux(n,k,j,i));
-          }
-        }
+      for (int i=is; i<=ie; ++i) {
+        dflx(n,i) += (x2area_p1(i)*x2flux(n,k,j+1,i) - x2area(i)*x2flux(n,k,j,i));
       }
+    }
+  }
 
-      // calculate x3-flux divergence
-      if (pmb->block_size.nx3 > 1) {
-        pmb->pcoord->Face3Area(k  , j, is, ie, x3area   );
-        pmb->pcoord->Face3Area(k+1, j, is, ie, x3area_p1);
-        for (int n=0; n<NHYDRO; ++n) {
+  // calculate x3-flux divergence
+  if (pmb->block_size.nx3 > 1) {
+    pmb->pcoord->Face3Area(k  , j, is, ie, x3area   );
+    pmb->pcoord->Face3Area(k+1, j, is, ie, x3area_p1);
+    for (int n=0; n<NHYDRO; ++n) {
 #pragma omp simd
-          for (int i=is; i<=ie; ++i) {
-            dflx(n,i) += (x3area_p1(i)*x3flux(n,k+1,j,i) - x3area(i)*x3flux(n,k,j,i));
-          }
-        }
+      for (int i=is; i<=ie; ++i) {
+        dflx(n,i) += (x3area_p1(i)*x3flux(n,k+1,j,i) - x3area(i)*x3flux(n,k,j,i));
       }
+    }
+  }
 
-      // update conserved variables
-      pmb->pcoord->CellVolume(k, j, is, ie, vol);
-      for (int n=0; n<NHYDRO; ++n) {
+  // update conserved variables
+  pmb->pcoord->CellVolume(k, j, is, ie, vol);
+  for (int n=0; n<NHYDRO; ++n) {
 #pragma omp simd
-        for (int i=is; i<=ie; ++i) {
-          u_out(n,k,j,i) -= wght*dflx(n,i)/vol(i);
-        }
-      }
+    for (int i=is; i<=ie; ++i) {
+      u_out(n,k,j,i) -= wght*dflx(n,i)/vol(i);
     }
   }
   return;
@@ -112,60 +169,68 @@ void Hydro::AddFluxDivergence_STS(const Real wght, int stage,
   AthenaArray<Real> &x3flux = flux[X3DIR];
   int is = pmb->is; int js = pmb->js; int ks = pmb->ks;
   int ie = pmb->ie; int je = pmb->je; int ke = pmb->ke;
-  AthenaArray<Real> &x1area = x1face_area_, &x2area = x2face_area_,
-                 &x2area_p1 = x2face_area_p1_, &x3area = x3face_area_,
-                 &x3area_p1 = x3face_area_p1_, &vol = cell_volume_, &dflx = dflx_;
-
-  for (int k=ks; k<=ke; ++k) {
-    for (int j=js; j<=je; ++j) {
-      // calculate x1-flux divergence
-      pmb->pcoord->Face1Area(k, j, is, ie+1, x1area);
-      for (int n=0; n<NHYDRO; ++n) {
-        if (std::binary_search(idx_subset.begin(), idx_subset.end(), n)) {
+  const int nthreads = pmb->pmy_mesh->GetNumLoopThreads();
+
+#pragma omp parallel num_threads(nthreads)
+  {
+    int jb = js, jt = je, kb = ks, kt = ke;
+    pmb->LoopThreadRange(jb, jt, kb, kt);
+    for (int k=kb; k<=kt; ++k) {
+      for (int j=jb; j<=jt; ++j) {
+        PencilScratch &ps = Pencil();
+        AthenaArray<Real> &x1area = ps.x1face_area, &x2area = ps.x2face_area,
+                       &x2area_p1 = ps.x2face_area_p1, &x3area = ps.x3face_area,
+                       &x3area_p1 = ps.x3face_area_p1, &vol = ps.cell_volume,
+                       &dflx = ps.dflx;
+        // calculate x1-flux divergence
+        pmb->pcoord->Face1Area(k, j, is, ie+1, x1area);
+        for (int n=0; n<NHYDRO; ++n) {
+          if (std::binary_search(idx_subset.begin(), idx_subset.end(), n)) {
 #pragma omp simd
-          for (int i=is; i<=ie; ++i) {
-            dflx(n,i) = (x1area(i+1) *x1flux(n,k,j,i+1) - x1area(i)*x1flux(n,k,j,i));
+            for (int i=is; i<=ie; ++i) {
+              dflx(n,i) = (x1area(i+1) *x1flux(n,k,j,i+1) - x1area(i)*x1flux(n,k,j,i));
+            }
           }
         }
-      }
 
-      // calculate x2-flux divergence
-      if (pmb->block_size.nx2 > 1) {
-        pmb->pcoord->Face2Area(k, j  , is, ie, x2area   );
-        pmb->pcoord->Face2Area(k, j+1, is, ie, x2area_p1);
-        for (int n=0; n<NHYDRO; ++n) {
-          if (std::binary_search(idx_subset.begin(), idx_subset.end(), n)) {
+        // calculate x2-flux divergence
+        if (pmb->block_size.nx2 > 1) {
+          pmb->pcoord->Face2Area(k, j  , is, ie, x2area   );
+          pmb->pcoord->Face2Area(k, j+1, is, ie, x2area_p1);
+          for (int n=0; n<NHYDRO; ++n) {
+            if (std::binary_search(idx_subset.begin(), idx_subset.end(), n)) {
 #pragma omp simd
-            for (int i=is; i<=ie; ++i) {
-              dflx(n,i) += (x2area_p1(i)*x2flux(n,k,j+1,i) - x2area(i)*x2flux(n,k,j,i));
+              for (int i=is; i<=ie; ++i) {
+                dflx(n,i) += (x2area_p1(i)*x2flux(n,k,j+1,i) - x2area(i)*x2flux(n,k,j,i));
+              }
             }
           }
         }
-      }
 
-      // calculate x3-flux divergence
-      if (pmb->block_size.nx3 > 1) {
-        pmb->pcoord->Face3Area(k  , j, is, ie, x3area   );
-        pmb->pcoord->Face3Area(k+1, j, is, ie, x3area_p1);
-        for (int n=0; n<NHYDRO; ++n) {
-          if (std::binary_search(idx_subset.begin(), idx_subset.end(), n)) {
+        // calculate x3-flux divergence
+        if (pmb->block_size.nx3 > 1) {
+          pmb->pcoord->Face3Area(k  , j, is, ie, x3area   );
+          pmb->pcoord->Face3Area(k+1, j, is, ie, x3area_p1);
+          for (int n=0; n<NHYDRO; ++n) {
+            if (std::binary_search(idx_subset.begin(), idx_subset.end(), n)) {
 #pragma omp simd
-            for (int i=is; i<=ie; ++i) {
-              dflx(n,i) += (x3area_p1(i)*x3flux(n,k+1,j,i) - x3area(i)*x3flux(n,k,j,i));
+              for (int i=is; i<=ie; ++i) {
+                dflx(n,i) += (x3area_p1(i)*x3flux(n,k+1,j,i) - x3area(i)*x3flux(n,k,j,i));
+              }
             }
           }
         }
-      }
 
-      // update conserved variables
-      pmb->pcoord->CellVolume(k, j, is, ie, vol);
-      for (int n=0; n<NHYDRO; ++n) {
-        if (std::binary_search(idx_subset.begin(), idx_subset.end(), n)) {
+        // update conserved variables
+        pmb->pcoord->CellVolume(k, j, is, ie, vol);
+        for (int n=0; n<NHYDRO; ++n) {
+          if (std::binary_search(idx_subset.begin(), idx_subset.end(), n)) {
 #pragma omp simd
-          for (int i=is; i<=ie; ++i) {
-            u_out(n,k,j,i) -= wght*dflx(n,i)/vol(i);
-            if (stage == 1 && pmb->pmy_mesh->sts_integrator == "rkl2") {
-              fl_div_out(n,k,j,i) = -0.5*pmb->pmy_mesh->dt*dflx(n,i)/vol(i);
+            for (int i=is; i<=ie; ++i) {
+              u_out(n,k,j,i) -= wght*dflx(n,i)/vol(i);
+              if (stage == 1 && pmb->pmy_mesh->sts_integrator == "rkl2") {
+                fl_div_out(n,k,j,i) = -0.5*pmb->pmy_mesh->dt*dflx(n,i)/vol(i);
+              }
             }
           }
         }
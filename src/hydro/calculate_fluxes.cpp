@@ -57,6 +57,9 @@ void Hydro::CalculateFluxes(AthenaArray<Real> &w, FaceField &b,
 #endif
   AthenaArray<Real> &flux_fc = scr1_nkji_;
   AthenaArray<Real> &laplacian_all_fc = scr2_nkji_;
+  // the fourth-order and relativistic solvers use scratch arrays shared by all pencils
+  const int nthreads = (order == 4 || RELATIVISTIC_DYNAMICS) ? 1
+                       : pmb->pmy_mesh->GetNumLoopThreads();
 
   //--------------------------------------------------------------------------------------
   // i-direction
@@ -73,31 +76,38 @@ void Hydro::CalculateFluxes(AthenaArray<Real> &w, FaceField &b,
     }
   }
 
-  for (int k=kl; k<=ku; ++k) {
-    for (int j=jl; j<=ju; ++j) {
-      // reconstruct L/R states
-      if (order == 1) {
-        pmb->precon->DonorCellX1(k, j, is-1, ie+1, w, bcc, wl_, wr_);
-      } else if (order == 2) {
-        pmb->precon->PiecewiseLinearX1(k, j, is-1, ie+1, w, bcc, wl_, wr_);
-      } else {
-        pmb->precon->PiecewiseParabolicX1(k, j, is-1, ie+1, w, bcc, wl_, wr_);
-      }
+#pragma omp parallel num_threads(nthreads)
+  {
+    int jb = jl, jt = ju, kb = kl, kt = ku;
+    pmb->LoopThreadRange(jb, jt, kb, kt);
+    for (int k=kb; k<=kt; ++k) {
+      for (int j=jb; j<=jt; ++j) {
+        PencilScratch &ps = Pencil();
+        AthenaArray<Real> &wl = ps.wl, &wr = ps.wr, &dxw = ps.dxw;
+        // reconstruct L/R states
+        if (order == 1) {
+          pmb->precon->DonorCellX1(k, j, is-1, ie+1, w, bcc, wl, wr);
+        } else if (order == 2) {
+          pmb->precon->PiecewiseLinearX1(k, j, is-1, ie+1, w, bcc, wl, wr);
+        } else {
+          pmb->precon->PiecewiseParabolicX1(k, j, is-1, ie+1, w, bcc, wl, wr);
+        }
 
-      pmb->pcoord->CenterWidth1(k, j, is, ie+1, dxw_);
+        pmb->pcoord->CenterWidth1(k, j, is, ie+1, dxw);
 #if !MAGNETIC_FIELDS_ENABLED  // Hydro:
-      RiemannSolver(k, j, is, ie+1, IVX, wl_, wr_, x1flux, dxw_);
+        RiemannSolver(k, j, is, ie+1, IVX, wl, wr, x1flux, dxw);
 #else  // MHD:
-      // x1flux(IBY) = (v1*b2 - v2*b1) = -EMFZ
-      // x1flux(IBZ) = (v1*b3 - v3*b1) =  EMFY
-      RiemannSolver(k, j, is, ie+1, IVX, b1, wl_, wr_, x1flux, e3x1, e2x1, w_x1f, dxw_);
+        // x1flux(IBY) = (v1*b2 - v2*b1) = -EMFZ
+        // x1flux(IBZ) = (v1*b3 - v3*b1) =  EMFY
+        RiemannSolver(k, j, is, ie+1, IVX, b1, wl, wr, x1flux, e3x1, e2x1, w_x1f, dxw);
 #endif
 
-      if (order == 4) {
-        for (int n=0; n<NWAVE; n++) {
-          for (int i=is; i<=ie+1; i++) {
-            wl3d_(n,k,j,i) = wl_(n,i);
-            wr3d_(n,k,j,i) = wr_(n,i);
+        if (order == 4) {
+          for (int n=0; n<NWAVE; n++) {
+            for (int i=is; i<=ie+1; i++) {
+              wl3d_(n,k,j,i) = wl(n,i);
+              wr3d_(n,k,j,i) = wr(n,i);
+            }
           }
         }
       }
@@ -109,6 +119,8 @@ void Hydro::CalculateFluxes(AthenaArray<Real> &w, FaceField &b,
     // TODO(felker): also, this may need to be dx1v, since Laplacian is cell-centered
     Real h = pmb->pcoord->dx1f(is);  // pco->dx1f(i); inside loop
     Real C = (h*h)/24.0;
+    PencilScratch &ps = Pencil();
+    AthenaArray<Real> &wl = ps.wl, &wr = ps.wr, &dxw = ps.dxw;
 
     // construct Laplacian from x1flux
     pmb->pcoord->LaplacianX1All(x1flux, laplacian_all_fc, 0, NHYDRO-1,
@@ -122,24 +134,24 @@ void Hydro::CalculateFluxes(AthenaArray<Real> &w, FaceField &b,
           pmb->pcoord->LaplacianX1(wr3d_, laplacian_r_fc_, n, k, j, is, ie+1);
 #pragma omp simd
           for (int i=is; i<=ie+1; ++i) {
-            wl_(n,i) = wl3d_(n,k,j,i) - C*laplacian_l_fc_(i);
-            wr_(n,i) = wr3d_(n,k,j,i) - C*laplacian_r_fc_(i);
+            wl(n,i) = wl3d_(n,k,j,i) - C*laplacian_l_fc_(i);
+            wr(n,i) = wr3d_(n,k,j,i) - C*laplacian_r_fc_(i);
           }
         }
 #pragma omp simd
         for (int i=is; i<=ie+1; ++i) {
-          pmb->peos->ApplyPrimitiveFloors(wl_, k, j, i);
-          pmb->peos->ApplyPrimitiveFloors(wr_, k, j, i);
+          pmb->peos->ApplyPrimitiveFloors(wl, k, j, i);
+          pmb->peos->ApplyPrimitiveFloors(wr, k, j, i);
         }
 
         // Compute x1 interface fluxes from face-centered primitive variables
         // TODO(felker): check that e3x1,e2x1 arguments added in late 2017 work here
-        pmb->pcoord->CenterWidth1(k, j, is, ie+1, dxw_);
+        pmb->pcoord->CenterWidth1(k, j, is, ie+1, dxw);
 #if !MAGNETIC_FIELDS_ENABLED  // Hydro:
-        RiemannSolver(k, j, is, ie+1, IVX, wl_, wr_, flux_fc, dxw_);
+        RiemannSolver(k, j, is, ie+1, IVX, wl, wr, flux_fc, dxw);
 #else  // MHD:
-        RiemannSolver(k, j, is, ie+1, IVX, b1, wl_, wr_, flux_fc, e3x1, e2x1,
-                      w_x1f, dxw_);
+        RiemannSolver(k, j, is, ie+1, IVX, b1, wl, wr, flux_fc, e3x1, e2x1,
+                      w_x1f, dxw);
 #endif
         // Apply Laplacian of second-order accurate face-averaged flux on x1 faces
         for (int n=0; n<NHYDRO; ++n) {
@@ -172,45 +184,53 @@ void Hydro::CalculateFluxes(AthenaArray<Real> &w, FaceField &b,
         kl = ks-1, ku = ke+1;
     }
 
-    for (int k=kl; k<=ku; ++k) {
-      // reconstruct the first row
-      if (order == 1) {
-        pmb->precon->DonorCellX2(k, js-1, il, iu, w, bcc, wl_, wr_);
-      } else if (order == 2) {
-        pmb->precon->PiecewiseLinearX2(k, js-1, il, iu, w, bcc, wl_, wr_);
-      } else {
-        pmb->precon->PiecewiseParabolicX2(k, js-1, il, iu, w, bcc, wl_, wr_);
-      }
-      for (int j=js; j<=je+1; ++j) {
-        // reconstruct L/R states at j
+    // each thread starts by reconstructing the row below its first face
+#pragma omp parallel num_threads(nthreads)
+    {
+      int jb = js, jt = je+1, kb = kl, kt = ku;
+      pmb->LoopThreadRange(jb, jt, kb, kt);
+      PencilScratch &ps = Pencil();
+      AthenaArray<Real> &wl = ps.wl, &wr = ps.wr, &wlb = ps.wlb, &dxw = ps.dxw;
+      for (int k=kb; k<=kt; ++k) {
+        // reconstruct the first row
         if (order == 1) {
-          pmb->precon->DonorCellX2(k, j, il, iu, w, bcc, wlb_, wr_);
+          pmb->precon->DonorCellX2(k, jb-1, il, iu, w, bcc, wl, wr);
         } else if (order == 2) {
-          pmb->precon->PiecewiseLinearX2(k, j, il, iu, w, bcc, wlb_, wr_);
+          pmb->precon->PiecewiseLinearX2(k, jb-1, il, iu, w, bcc, wl, wr);
         } else {
-          pmb->precon->PiecewiseParabolicX2(k, j, il, iu, w, bcc, wlb_, wr_);
+          pmb->precon->PiecewiseParabolicX2(k, jb-1, il, iu, w, bcc, wl, wr);
         }
+        for (int j=jb; j<=jt; ++j) {
+          // reconstruct L/R states at j
+          if (order == 1) {
+            pmb->precon->DonorCellX2(k, j, il, iu, w, bcc, wlb, wr);
+          } else if (order == 2) {
+            pmb->precon->PiecewiseLinearX2(k, j, il, iu, w, bcc, wlb, wr);
+          } else {
+            pmb->precon->PiecewiseParabolicX2(k, j, il, iu, w, bcc, wlb, wr);
+          }
 
-        pmb->pcoord->CenterWidth2(k, j, il, iu, dxw_);
+          pmb->pcoord->CenterWidth2(k, j, il, iu, dxw);
 #if !MAGNETIC_FIELDS_ENABLED  // Hydro:
-        RiemannSolver(k, j, il, iu, IVY, wl_, wr_, x2flux, dxw_);
+          RiemannSolver(k, j, il, iu, IVY, wl, wr, x2flux, dxw);
 #else  // MHD:
-        // flx(IBY) = (v2*b3 - v3*b2) = -EMFX
-        // flx(IBZ) = (v2*b1 - v1*b2) =  EMFZ
-        RiemannSolver(k, j, il, iu, IVY, b2, wl_, wr_, x2flux, e1x2, e3x2, w_x2f, dxw_);
+          // flx(IBY) = (v2*b3 - v3*b2) = -EMFX
+          // flx(IBZ) = (v2*b1 - v1*b2) =  EMFZ
+          RiemannSolver(k, j, il, iu, IVY, b2, wl, wr, x2flux, e1x2, e3x2, w_x2f, dxw);
 #endif
 
-        if (order == 4) {
-          for (int n=0; n<NWAVE; n++) {
-            for (int i=il; i<=iu; i++) {
-              wl3d_(n,k,j,i) = wl_(n,i);
-              wr3d_(n,k,j,i) = wr_(n,i);
+          if (order == 4) {
+            for (int n=0; n<NWAVE; n++) {
+              for (int i=il; i<=iu; i++) {
+                wl3d_(n,k,j,i) = wl(n,i);
+                wr3d_(n,k,j,i) = wr(n,i);
+              }
             }
           }
-        }
 
-        // swap the arrays for the next step
-        wl_.SwapAthenaArray(wlb_);
+          // swap the arrays for the next step
+          wl.SwapAthenaArray(wlb);
+        }
       }
     }
     if (order == 4) {
@@ -218,6 +238,8 @@ void Hydro::CalculateFluxes(AthenaArray<Real> &w, FaceField &b,
       // TODO(felker): also, this may need to be dx2v, since Laplacian is cell-centered
       Real h = pmb->pcoord->dx2f(js);  // pco->dx2f(j); inside loop
       Real C = (h*h)/24.0;
+      PencilScratch &ps = Pencil();
+      AthenaArray<Real> &wl = ps.wl, &wr = ps.wr, &dxw = ps.dxw;
 
       // construct Laplacian from x2flux
       pmb->pcoord->LaplacianX2All(x2flux, laplacian_all_fc, 0, NHYDRO-1,
@@ -232,24 +254,24 @@ void Hydro::CalculateFluxes(AthenaArray<Real> &w, FaceField &b,
             pmb->pcoord->LaplacianX2(wr3d_, laplacian_r_fc_, n, k, j, il, iu);
 #pragma omp simd
             for (int i=il; i<=iu; ++i) {
-              wl_(n,i) = wl3d_(n,k,j,i) - C*laplacian_l_fc_(i);
-              wr_(n,i) = wr3d_(n,k,j,i) - C*laplacian_r_fc_(i);
+              wl(n,i) = wl3d_(n,k,j,i) - C*laplacian_l_fc_(i);
+              wr(n,i) = wr3d_(n,k,j,i) - C*laplacian_r_fc_(i);
             }
           }
 #pragma omp simd
           for (int i=il; i<=iu; ++i) {
-            pmb->peos->ApplyPrimitiveFloors(wl_, k, j, i);
-            pmb->peos->ApplyPrimitiveFloors(wr_, k, j, i);
+            pmb->peos->ApplyPrimitiveFloors(wl, k, j, i);
+            pmb->peos->ApplyPrimitiveFloors(wr, k, j, i);
           }
 
           // Compute x2 interface fluxes from face-centered primitive variables
           // TODO(felker): check that e1x2,e3x2 arguments added in late 2017 work here
-          pmb->pcoord->CenterWidth2(k, j, il, iu, dxw_);
+          pmb->pcoord->CenterWidth2(k, j, il, iu, dxw);
 #if !MAGNETIC_FIELDS_ENABLED  // Hydro:
-          RiemannSolver(k, j, il, iu, IVY, wl_, wr_, flux_fc, dxw_);
+          RiemannSolver(k, j, il, iu, IVY, wl, wr, flux_fc, dxw);
 #else  // MHD:
-          RiemannSolver(k, j, il, iu, IVY, b2, wl_, wr_, flux_fc, e1x2, e3x2,
-                        w_x2f, dxw_);
+          RiemannSolver(k, j, il, iu, IVY, b2, wl, wr, flux_fc, e1x2, e3x2,
+                        w_x2f, dxw);
 #endif
 
           // Apply Laplacian of second-order accurate face-averaged flux on x1 faces
@@ -278,44 +300,51 @@ void Hydro::CalculateFluxes(AthenaArray<Real> &w, FaceField &b,
       il = is-1, iu = ie+1, jl = js-1, ju = je+1;
     }
 
-    for (int j=jl; j<=ju; ++j) { // this loop ordering is intentional
-      // reconstruct the first row
-      if (order == 1) {
-        pmb->precon->DonorCellX3(ks-1, j, il, iu, w, bcc, wl_, wr_);
-      } else if (order == 2) {
-        pmb->precon->PiecewiseLinearX3(ks-1, j, il, iu, w, bcc, wl_, wr_);
-      } else {
-        pmb->precon->PiecewiseParabolicX3(ks-1, j, il, iu, w, bcc, wl_, wr_);
-      }
-      for (int k=ks; k<=ke+1; ++k) {
-        // reconstruct L/R states at k
+#pragma omp parallel num_threads(nthreads)
+    {
+      int jb = jl, jt = ju, kb = ks, kt = ke+1;
+      pmb->LoopThreadRange(jb, jt, kb, kt);
+      PencilScratch &ps = Pencil();
+      AthenaArray<Real> &wl = ps.wl, &wr = ps.wr, &wlb = ps.wlb, &dxw = ps.dxw;
+      for (int j=jb; j<=jt; ++j) { // this loop ordering is intentional
+        // reconstruct the first row
         if (order == 1) {
-          pmb->precon->DonorCellX3(k, j, il, iu, w, bcc, wlb_, wr_);
+          pmb->precon->DonorCellX3(kb-1, j, il, iu, w, bcc, wl, wr);
         } else if (order == 2) {
-          pmb->precon->PiecewiseLinearX3(k, j, il, iu, w, bcc, wlb_, wr_);
+          pmb->precon->PiecewiseLinearX3(kb-1, j, il, iu, w, bcc, wl, wr);
         } else {
-          pmb->precon->PiecewiseParabolicX3(k, j, il, iu, w, bcc, wlb_, wr_);
+          pmb->precon->PiecewiseParabolicX3(kb-1, j, il, iu, w, bcc, wl, wr);
         }
+        for (int k=kb; k<=kt; ++k) {
+          // reconstruct L/R states at k
+          if (order == 1) {
+            pmb->precon->DonorCellX3(k, j, il, iu, w, bcc, wlb, wr);
+          } else if (order == 2) {
+            pmb->precon->PiecewiseLinearX3(k, j, il, iu, w, bcc, wlb, wr);
+          } else {
+            pmb->precon->PiecewiseParabolicX3(k, j, il, iu, w, bcc, wlb, wr);
+          }
 
-        pmb->pcoord->CenterWidth3(k, j, il, iu, dxw_);
+          pmb->pcoord->CenterWidth3(k, j, il, iu, dxw);
 #if !MAGNETIC_FIELDS_ENABLED  // Hydro:
-        RiemannSolver(k, j, il, iu, IVZ, wl_, wr_, x3flux, dxw_);
+          RiemannSolver(k, j, il, iu, IVZ, wl, wr, x3flux, dxw);
 #else  // MHD:
-        // flx(IBY) = (v3*b1 - v1*b3) = -EMFY
-        // flx(IBZ) = (v3*b2 - v2*b3) =  EMFX
-        RiemannSolver(k, j, il, iu, IVZ, b3, wl_, wr_, x3flux, e2x3, e1x3, w_x3f, dxw_);
+          // flx(IBY) = (v3*b1 - v1*b3) = -EMFY
+          // flx(IBZ) = (v3*b2 - v2*b3) =  EMFX
+          RiemannSolver(k, j, il, iu, IVZ, b3, wl, wr, x3flux, e2x3, e1x3, w_x3f, dxw);
 #endif
-        if (order == 4) {
-          for (int n=0; n<NWAVE; n++) {
-            for (int i=il; i<=iu; i++) {
-              wl3d_(n,k,j,i) = wl_(n,i);
-              wr3d_(n,k,j,i) = wr_(n,i);
+          if (order == 4) {
+            for (int n=0; n<NWAVE; n++) {
+              for (int i=il; i<=iu; i++) {
+                wl3d_(n,k,j,i) = wl(n,i);
+                wr3d_(n,k,j,i) = wr(n,i);
+              }
             }
           }
-        }
 
-        // swap the arrays for the next step
-        wl_.SwapAthenaArray(wlb_);
+          // swap the arrays for the next step
+          wl.SwapAthenaArray(wlb);
+        }
       }
     }
     if (order == 4) {
@@ -323,6 +352,8 @@ void Hydro::CalculateFluxes(AthenaArray<Real> &w, FaceField &b,
       // TODO(felker): also, this may need to be dx3v, since Laplacian is cell-centered
       Real h = pmb->pcoord->dx3f(ks);  // pco->dx3f(j); inside loop
       Real C = (h*h)/24.0;
+      PencilScratch &ps = Pencil();
+      AthenaArray<Real> &wl = ps.wl, &wr = ps.wr, &dxw = ps.dxw;
 
       // construct Laplacian from x3flux
       pmb->pcoord->LaplacianX3All(x3flux, laplacian_all_fc, 0, NHYDRO-1,
@@ -337,24 +368,24 @@ void Hydro::CalculateFluxes(AthenaArray<Real> &w, FaceField &b,
             pmb->pcoord->LaplacianX3(wr3d_, laplacian_r_fc_, n, k, j, il, iu);
 #pragma omp simd
             for (int i=il; i<=iu; ++i) {
-              wl_(n,i) = wl3d_(n,k,j,i) - C*laplacian_l_fc_(i);
-              wr_(n,i) = wr3d_(n,k,j,i) - C*laplacian_r_fc_(i);
+              wl(n,i) = wl3d_(n,k,j,i) - C*laplacian_l_fc_(i);
+              wr(n,i) = wr3d_(n,k,j,i) - C*laplacian_r_fc_(i);
             }
           }
 #pragma omp simd
           for (int i=il; i<=iu; ++i) {
-            pmb->peos->ApplyPrimitiveFloors(wl_, k, j, i);
-            pmb->peos->ApplyPrimitiveFloors(wr_, k, j, i);
+            pmb->peos->ApplyPrimitiveFloors(wl, k, j, i);
+            pmb->peos->ApplyPrimitiveFloors(wr, k, j, i);
           }
 
           // Compute x3 interface fluxes from face-centered primitive variables
           // TODO(felker): check that e2x3,e1x3 arguments added in late 2017 work here
-          pmb->pcoord->CenterWidth3(k, j, il, iu, dxw_);
+          pmb->pcoord->CenterWidth3(k, j, il, iu, dxw);
 #if !MAGNETIC_FIELDS_ENABLED  // Hydro:
-          RiemannSolver(k, j, il, iu, IVZ, wl_, wr_, flux_fc, dxw_);
+          RiemannSolver(k, j, il, iu, IVZ, wl, wr, flux_fc, dxw);
 #else  // MHD:
-          RiemannSolver(k, j, il, iu, IVZ, b3, wl_, wr_, flux_fc, e2x3, e1x3,
-                        w_x3f, dxw_);
+          RiemannSolver(k, j, il, iu, IVZ, b3, wl, wr, flux_fc, e2x3, e1x3,
+                        w_x3f, dxw);
 #endif
           // Apply Laplacian of second-order accurate face-averaged flux on x3 faces
           for (int n=0; n<NHYDRO; ++n) {
@@ -101,21 +101,24 @@ Hydro::Hydro(MeshBlock *pmb, ParameterInput *pin) :
   dt1_.NewAthenaArray(nc1);
   dt2_.NewAthenaArray(nc1);
   dt3_.NewAthenaArray(nc1);
-  dxw_.NewAthenaArray(nc1);
-  wl_.NewAthenaArray(NWAVE, nc1);
-  wr_.NewAthenaArray(NWAVE, nc1);
-  wlb_.NewAthenaArray(NWAVE, nc1);
-  x1face_area_.NewAthenaArray(nc1+1);
-  if (pm->f2) {
-    x2face_area_.NewAthenaArray(nc1);
-    x2face_area_p1_.NewAthenaArray(nc1);
-  }
-  if (pm->f3) {
-    x3face_area_.NewAthenaArray(nc1);
-    x3face_area_p1_.NewAthenaArray(nc1);
+  pencil_.resize(pm->GetNumLoopThreads());
+  for (PencilScratch &ps : pencil_) {
+    ps.dxw.NewAthenaArray(nc1);
+    ps.wl.NewAthenaArray(NWAVE, nc1);
+    ps.wr.NewAthenaArray(NWAVE, nc1);
+    ps.wlb.NewAthenaArray(NWAVE, nc1);
+    ps.x1face_area.NewAthenaArray(nc1+1);
+    if (pm->f2) {
+      ps.x2face_area.NewAthenaArray(nc1);
+      ps.x2face_area_p1.NewAthenaArray(nc1);
+    }
+    if (pm->f3) {
+      ps.x3face_area.NewAthenaArray(nc1);
+      ps.x3face_area_p1.NewAthenaArray(nc1);
+    }
+    ps.cell_volume.NewAthenaArray(nc1);
+    ps.dflx.NewAthenaArray(NHYDRO, nc1);
   }
-  cell_volume_.NewAthenaArray(nc1);
-  dflx_.NewAthenaArray(NHYDRO, nc1);
   if (MAGNETIC_FIELDS_ENABLED && RELATIVISTIC_DYNAMICS) { // only used in (SR/GR)MHD
     bb_normal_.NewAthenaArray(nc1);
   }
@@ -145,6 +148,7 @@ Hydro::Hydro(MeshBlock *pmb, ParameterInput *pin) :
   }
 
   UserTimeStep_ = pmb->pmy_mesh->UserTimeStep_;
+  UserTimeStepPencil_ = pmb->pmy_mesh->UserTimeStepPencil_;
 }
 
 //----------------------------------------------------------------------------------------
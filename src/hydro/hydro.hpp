@@ -17,6 +17,7 @@
 #include "../athena.hpp"
 #include "../athena_arrays.hpp"
 #include "../bvals/cc/hydro/bvals_hydro.hpp"
+#include "../utils/utils.hpp"
 #include "hydro_diffusion/hydro_diffusion.hpp"
 #include "srcterms/hydro_srcterms.hpp"
 
@@ -64,7 +65,14 @@ class Hydro {
 
   // functions
   void NewBlockTimeStep();    // computes new timestep on a MeshBlock
+  void BeginFusedBlockTimeStep();
+  void NewBlockTimeStepPencil(const int k, const int j, const AthenaArray<Real> &w);
   void AddFluxDivergence(const Real wght, AthenaArray<Real> &u_out);
+  void AddFluxDivergenceFused(const Real wght, const Real delta,
+                              const Real ave_wghts[3], const Real time,
+                              const AthenaArray<Real> &prim_scalar,
+                              const AthenaArray<Real> &bcc,
+                              AthenaArray<Real> &cons_scalar);
   void AddFluxDivergence_STS(const Real wght, int stage,
                              AthenaArray<Real> &u_out,
                              AthenaArray<Real> &fl_div_out,
@@ -91,14 +99,24 @@ class Hydro {
 
  private:
   AthenaArray<Real> dt1_, dt2_, dt3_;  // scratch arrays used in NewTimeStep
-  // scratch space used to compute fluxes
-  AthenaArray<Real> dxw_;
-  AthenaArray<Real> x1face_area_, x2face_area_, x3face_area_;
-  AthenaArray<Real> x2face_area_p1_, x3face_area_p1_;
-  AthenaArray<Real> cell_volume_;
-  // 2D
-  AthenaArray<Real> wl_, wr_, wlb_;
-  AthenaArray<Real> dflx_;
+  // running minima of the per-pencil timestep limits, and whether they were already
+  // accumulated during the final W(U) sweep of the cycle
+  Real min_dt_hyperbolic_, min_dt_parabolic_, min_dt_user_;
+  bool fused_dt_ready_{false};
+  // scratch space used to compute fluxes, one set per loop-level OpenMP thread
+  struct PencilScratch {
+    AthenaArray<Real> dxw;
+    AthenaArray<Real> x1face_area, x2face_area, x3face_area;
+    AthenaArray<Real> x2face_area_p1, x3face_area_p1;
+    AthenaArray<Real> cell_volume;
+    // 2D
+    AthenaArray<Real> wl, wr, wlb;
+    AthenaArray<Real> dflx;
+  };
+  std::vector<PencilScratch> pencil_;
+  PencilScratch &Pencil() {
+    return pencil_[LoopThreadNum(static_cast<int>(pencil_.size()))];
+  }
   AthenaArray<Real> bb_normal_;    // normal magnetic field, for (SR/GR)MHD
   AthenaArray<Real> lambdas_p_l_;  // most positive wavespeeds in left state
   AthenaArray<Real> lambdas_m_l_;  // most negative wavespeeds in left state
@@ -116,8 +134,11 @@ class Hydro {
   AthenaArray<Real> laplacian_l_fc_, laplacian_r_fc_;
 
   TimeStepFunc UserTimeStep_;
+  TimeStepPencilFunc UserTimeStepPencil_;
 
   void AddDiffusionFluxes();
+  void AddFluxDivergencePencil(const int k, const int j, const Real wght,
+                               AthenaArray<Real> &u_out);
   Real GetWeightForCT(Real dflx, Real rhol, Real rhor, Real dx, Real dt);
 };
 #endif // HYDRO_HYDRO_HPP_
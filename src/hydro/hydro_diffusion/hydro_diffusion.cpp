@@ -33,7 +33,7 @@ HydroDiffusion::HydroDiffusion(Hydro *phyd, ParameterInput *pin) :
     hydro_diffusion_defined(false),
     nu_iso{pin->GetOrAddReal("problem", "nu_iso", 0.0)},
     nu_aniso{pin->GetOrAddReal("problem", "nu_aniso", 0.0)},
-    kappa_iso{}, kappa_aniso{},
+    kappa_iso{}, kappa_aniso{}, implicit_conduction{},
     pmy_hydro_(phyd), pmb_(pmy_hydro_->pmy_block), pco_(pmb_->pcoord) {
   int nc1 = pmb_->ncells1, nc2 = pmb_->ncells2, nc3 = pmb_->ncells3;
 
@@ -50,9 +50,6 @@ HydroDiffusion::HydroDiffusion(Hydro *phyd, ParameterInput *pin) :
     x2area_p1_.NewAthenaArray(nc1);
     x3area_p1_.NewAthenaArray(nc1);
     vol_.NewAthenaArray(nc1);
-    fx_.NewAthenaArray(nc1);
-    fy_.NewAthenaArray(nc1);
-    fz_.NewAthenaArray(nc1);
     div_vel_.NewAthenaArray(nc3, nc2, nc1);
 
     nu.NewAthenaArray(2, nc3, nc2, nc1);
@@ -66,6 +63,8 @@ HydroDiffusion::HydroDiffusion(Hydro *phyd, ParameterInput *pin) :
   if (NON_BAROTROPIC_EOS) {
     kappa_iso  = pin->GetOrAddReal("problem", "kappa_iso", 0.0); // iso thermal conduction
     kappa_aniso  = pin->GetOrAddReal("problem", "kappa_aniso", 0.0); // aniso conduction
+    // backward-Euler isotropic conduction after the main integrator (see mg_conduction)
+    implicit_conduction = pin->GetOrAddBoolean("problem", "implicit_conduction", false);
     if (kappa_iso > 0.0 || kappa_aniso > 0.0) {
       hydro_diffusion_defined = true;
       cndflx[X1DIR].NewAthenaArray(nc3, nc2, nc1+1);
@@ -112,7 +111,7 @@ void HydroDiffusion::CalcDiffusionFlux(const AthenaArray<Real> &prim,
   if (nu_aniso > 0.0) ViscousFluxAniso(prim, iprim, visflx);
 
   if (kappa_iso > 0.0 || kappa_aniso > 0.0) ClearFlux(cndflx);
-  if (kappa_iso > 0.0) ThermalFluxIso(prim, cndflx);
+  if (kappa_iso > 0.0 && !implicit_conduction) ThermalFluxIso(prim, cndflx);
   if (kappa_aniso > 0.0) ThermalFluxAniso(prim, cndflx);
 
   return;
@@ -238,10 +237,29 @@ void HydroDiffusion::SetDiffusivity(const AthenaArray<Real> &w,
 
 void HydroDiffusion::NewDiffusionDt(Real &dt_vis, Real &dt_cnd) {
   Real real_max = std::numeric_limits<Real>::max();
+  dt_vis = real_max;
+  dt_cnd = real_max;
+
+  for (int k=pmb_->ks; k<=pmb_->ke; ++k) {
+    for (int j=pmb_->js; j<=pmb_->je; ++j) {
+      NewDiffusionDtPencil(k, j, dt_vis, dt_cnd);
+    }
+  }
+  return;
+}
+
+//---------------------------------------------------------------------------------------
+//! \fn void HydroDiffusion::NewDiffusionDtPencil(const int k, const int j,
+//!                                               Real &dt_vis, Real &dt_cnd)
+//! \brief Reduce the viscous and conduction timesteps of a single (k,j) pencil into
+//!        dt_vis and dt_cnd (which are only ever decreased)
+
+void HydroDiffusion::NewDiffusionDtPencil(const int k, const int j,
+                                          Real &dt_vis, Real &dt_cnd) {
   const bool f2 = pmb_->pmy_mesh->f2;
   const bool f3 = pmb_->pmy_mesh->f3;
-  int il = pmb_->is - NGHOST; int jl = pmb_->js; int kl = pmb_->ks;
-  int iu = pmb_->ie + NGHOST; int ju = pmb_->je; int ku = pmb_->ke;
+  int il = pmb_->is - NGHOST;
+  int iu = pmb_->ie + NGHOST;
   Real fac;
   if (f3)
     fac = 1.0/6.0;
@@ -250,55 +268,54 @@ void HydroDiffusion::NewDiffusionDt(Real &dt_vis, Real &dt_cnd) {
   else
     fac = 0.5;
 
-  dt_vis = real_max;
-  dt_cnd = real_max;
-
   AthenaArray<Real> &nu_t = nu_tot_;
   AthenaArray<Real> &kappa_t = kappa_tot_;
   AthenaArray<Real> &len = dx1_, &dx2 = dx2_, &dx3 = dx3_;
 
-  for (int k=kl; k<=ku; ++k) {
-    for (int j=jl; j<=ju; ++j) {
 #pragma omp simd
-      for (int i=il; i<=iu; ++i) {
-        nu_t(i) = 0.0;
-        kappa_t(i) = 0.0;
-      }
-      if (nu_iso > 0.0) {
+  for (int i=il; i<=iu; ++i) {
+    nu_t(i) = 0.0;
+    kappa_t(i) = 0.0;
+  }
+  if (nu_iso > 0.0) {
 #pragma omp simd
-        for (int i=il; i<=iu; ++i) nu_t(i) += nu(DiffProcess::iso,k,j,i);
-      }
-      if (nu_aniso > 0.0) {
+    for (int i=il; i<=iu; ++i) nu_t(i) += nu(DiffProcess::iso,k,j,i);
+  }
+  if (nu_aniso > 0.0) {
 #pragma omp simd
-        for (int i=il; i<=iu; ++i) nu_t(i) += nu(DiffProcess::aniso,k,j,i);
-      }
-      if (kappa_iso > 0.0) {
+    for (int i=il; i<=iu; ++i) nu_t(i) += nu(DiffProcess::aniso,k,j,i);
+  }
+  if (kappa_iso > 0.0) {
 #pragma omp simd
-        for (int i=il; i<=iu; ++i) kappa_t(i) += kappa(DiffProcess::iso,k,j,i);
-      }
-      if (kappa_aniso > 0.0) {
+    for (int i=il; i<=iu; ++i) kappa_t(i) += kappa(DiffProcess::iso,k,j,i);
+  }
+  if (kappa_aniso > 0.0) {
 #pragma omp simd
-        for (int i=il; i<=iu; ++i) kappa_t(i) += kappa(DiffProcess::aniso,k,j,i);
-      }
-      pmb_->pcoord->CenterWidth1(k, j, il, iu, len);
-      pmb_->pcoord->CenterWidth2(k, j, il, iu, dx2);
-      pmb_->pcoord->CenterWidth3(k, j, il, iu, dx3);
+    for (int i=il; i<=iu; ++i) kappa_t(i) += kappa(DiffProcess::aniso,k,j,i);
+  }
+  pmb_->pcoord->CenterWidth1(k, j, il, iu, len);
+  pmb_->pcoord->CenterWidth2(k, j, il, iu, dx2);
+  pmb_->pcoord->CenterWidth3(k, j, il, iu, dx3);
 #pragma omp simd
-      for (int i=il; i<=iu; ++i) {
-        len(i) = (f2) ? std::min(len(i), dx2(i)) : len(i);
-        len(i) = (f3) ? std::min(len(i), dx3(i)) : len(i);
-      }
-      if ((nu_iso > 0.0) || (nu_aniso > 0.0)) {
-        for (int i=il; i<=iu; ++i)
-          dt_vis = std::min(dt_vis, static_cast<Real>(
-              SQR(len(i))*fac/(nu_t(i) + TINY_NUMBER)));
-      }
-      if ((kappa_iso > 0.0) || (kappa_aniso > 0.0)) {
-        for (int i=il; i<=iu; ++i)
-          dt_cnd = std::min(dt_cnd, static_cast<Real>(
-              SQR(len(i))*fac/(kappa_t(i) + TINY_NUMBER)));
-      }
-    }
+  for (int i=il; i<=iu; ++i) {
+    len(i) = (f2) ? std::min(len(i), dx2(i)) : len(i);
+    len(i) = (f3) ? std::min(len(i), dx3(i)) : len(i);
+  }
+  if ((nu_iso > 0.0) || (nu_aniso > 0.0)) {
+    Real dt_v = dt_vis;
+#pragma omp simd reduction(min:dt_v)
+    for (int i=il; i<=iu; ++i)
+      dt_v = std::min(dt_v, static_cast<Real>(
+          SQR(len(i))*fac/(nu_t(i) + TINY_NUMBER)));
+    dt_vis = dt_v;
+  }
+  if (((kappa_iso > 0.0) || (kappa_aniso > 0.0)) && !implicit_conduction) {
+    Real dt_c = dt_cnd;
+#pragma omp simd reduction(min:dt_c)
+    for (int i=il; i<=iu; ++i)
+      dt_c = std::min(dt_c, static_cast<Real>(
+          SQR(len(i))*fac/(kappa_t(i) + TINY_NUMBER)));
+    dt_cnd = dt_c;
   }
   return;
 }
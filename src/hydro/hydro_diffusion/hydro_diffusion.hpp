@@ -47,6 +47,7 @@ class HydroDiffusion {
   AthenaArray<Real> nu; // viscosity array
 
   Real kappa_iso, kappa_aniso; // thermal conduction coeff
+  bool implicit_conduction; // isotropic conduction solved by MGConductionDriver
   AthenaArray<Real> cndflx[3]; // thermal stress tensor
   AthenaArray<Real> kappa; // conduction array
 
@@ -65,6 +66,7 @@ class HydroDiffusion {
   void ClearFlux(AthenaArray<Real> *flx);
   void SetDiffusivity(const AthenaArray<Real> &w, const AthenaArray<Real> &bc);
   void NewDiffusionDt(Real &dt_vis, Real &dt_cnd);
+  void NewDiffusionDtPencil(const int k, const int j, Real &dt_vis, Real &dt_cnd);
 
   // viscosity
   void ViscousFluxIso(const AthenaArray<Real> &p, const AthenaArray<Real> &p_i,
@@ -83,7 +85,6 @@ class HydroDiffusion {
   AthenaArray<Real> div_vel_; // divergence of velocity
   AthenaArray<Real> x1area_, x2area_, x2area_p1_, x3area_, x3area_p1_;
   AthenaArray<Real> vol_;
-  AthenaArray<Real> fx_, fy_, fz_;
   AthenaArray<Real> dx1_, dx2_, dx3_;
   AthenaArray<Real> nu_tot_, kappa_tot_;
 
@@ -93,23 +94,8 @@ class HydroDiffusion {
 
   // auxiliary functions to calculate viscous flux
   void DivVelocity(const AthenaArray<Real> &prim, AthenaArray<Real> &divv);
-  void FaceXdx(const int k, const int j, const int il, const int iu,
-               const AthenaArray<Real> &prim, AthenaArray<Real> &len);
-  void FaceXdy(const int k, const int j, const int il, const int iu,
-               const AthenaArray<Real> &prim, AthenaArray<Real> &len);
-  void FaceXdz(const int k, const int j, const int il, const int iu,
-               const AthenaArray<Real> &prim, AthenaArray<Real> &len);
-  void FaceYdx(const int k, const int j, const int il, const int iu,
-               const AthenaArray<Real> &prim, AthenaArray<Real> &len);
-  void FaceYdy(const int k, const int j, const int il, const int iu,
-               const AthenaArray<Real> &prim, AthenaArray<Real> &len);
-  void FaceYdz(const int k, const int j, const int il, const int iu,
-               const AthenaArray<Real> &prim, AthenaArray<Real> &len);
-  void FaceZdx(const int k, const int j, const int il, const int iu,
-               const AthenaArray<Real> &prim, AthenaArray<Real> &len);
-  void FaceZdy(const int k, const int j, const int il, const int iu,
-               const AthenaArray<Real> &prim, AthenaArray<Real> &len);
-  void FaceZdz(const int k, const int j, const int il, const int iu,
-               const AthenaArray<Real> &prim, AthenaArray<Real> &len);
+  template <bool F2, bool F3, bool CART>
+  void ViscousFluxIsoFused(const AthenaArray<Real> &p, const AthenaArray<Real> &p_i,
+                           AthenaArray<Real> *flx);
 };
 #endif // HYDRO_HYDRO_DIFFUSION_HYDRO_DIFFUSION_HPP_
@@ -0,0 +1,414 @@
+//========================================================================================
+// Athena++ astrophysical MHD code
+// Copyright(C) 2014 James M. Stone <jmstone@princeton.edu> and other code contributors
+// Licensed under the 3-clause BSD License, see LICENSE file for details
+//========================================================================================
+//! \file mg_conduction.cpp
+//! \brief implicit (backward-Euler) isotropic thermal conduction using Multigrid
+
+// C headers
+
+// C++ headers
+#include <algorithm>  // max, min
+#include <cmath>      // sqrt
+#include <cstring>    // strcmp
+#include <iostream>
+#include <sstream>    // sstream
+#include <stdexcept>  // runtime_error
+#include <string>     // c_str()
+
+// Athena++ headers
+#include "../../athena.hpp"
+#include "../../athena_arrays.hpp"
+#include "../../bvals/cc/mg/bvals_mg.hpp"
+#include "../../coordinates/coordinates.hpp"
+#include "../../eos/eos.hpp"
+#include "../../field/field.hpp"
+#include "../../globals.hpp"
+#include "../../mesh/mesh.hpp"
+#include "../../multigrid/multigrid.hpp"
+#include "../../parameter_input.hpp"
+#include "../hydro.hpp"
+#include "hydro_diffusion.hpp"
+#include "mg_conduction.hpp"
+
+#ifdef MPI_PARALLEL
+#include <mpi.h>
+#endif
+
+namespace {
+//! face conductivity; clipped at zero since the flux-conserving ghost values at level
+//! boundaries are extrapolated and may undershoot
+inline Real FaceConductivity(Real kc, Real kn) {
+  return std::max(0.5*(kc + kn), 0.0);
+}
+
+//! div(K grad T) - D T on a uniform grid with spacing^-2 = idx2
+inline Real ApplyConductionOperator(const AthenaArray<Real> &u, int k, int j, int i,
+                                    Real idx2) {
+  constexpr int t = MGConduction::itmp, c = MGConduction::icnd;
+  const Real tc = u(t,k,j,i), kc = u(c,k,j,i);
+  Real flx = FaceConductivity(kc, u(c,k,j,i-1))*(u(t,k,j,i-1) - tc)
+           + FaceConductivity(kc, u(c,k,j,i+1))*(u(t,k,j,i+1) - tc)
+           + FaceConductivity(kc, u(c,k,j-1,i))*(u(t,k,j-1,i) - tc)
+           + FaceConductivity(kc, u(c,k,j+1,i))*(u(t,k,j+1,i) - tc)
+           + FaceConductivity(kc, u(c,k-1,j,i))*(u(t,k-1,j,i) - tc)
+           + FaceConductivity(kc, u(c,k+1,j,i))*(u(t,k+1,j,i) - tc);
+  return flx*idx2 - u(MGConduction::icap,k,j,i)*tc;
+}
+} // namespace
+
+//----------------------------------------------------------------------------------------
+//! \fn MGConductionDriver::MGConductionDriver(Mesh *pm, ParameterInput *pin)
+//! \brief MGConductionDriver constructor
+
+MGConductionDriver::MGConductionDriver(Mesh *pm, ParameterInput *pin)
+    : MultigridDriver(pm, pm->MGGravityBoundaryFunction_, 3, true),
+      tol_(pin->GetOrAddReal("problem", "conduction_tol", 1.0e-6)),
+      maxiter_(pin->GetOrAddInteger("problem", "conduction_maxiter", 20)) {
+  std::stringstream msg;
+  if (std::strcmp(COORDINATE_SYSTEM, "cartesian") != 0) {
+    msg << "### FATAL ERROR in MGConductionDriver::MGConductionDriver" << std::endl
+        << "Implicit conduction works only in Cartesian coordinates." << std::endl;
+    ATHENA_ERROR(msg);
+  }
+  if (!NON_BAROTROPIC_EOS || GENERAL_EOS) {
+    msg << "### FATAL ERROR in MGConductionDriver::MGConductionDriver" << std::endl
+        << "Implicit conduction requires the adiabatic ideal-gas EOS." << std::endl;
+    ATHENA_ERROR(msg);
+  }
+  if (pin->GetOrAddReal("problem", "kappa_iso", 0.0) <= 0.0
+      || pin->GetOrAddReal("problem", "kappa_aniso", 0.0) > 0.0) {
+    msg << "### FATAL ERROR in MGConductionDriver::MGConductionDriver" << std::endl
+        << "Implicit conduction requires kappa_iso > 0 and supports only isotropic "
+        << "conduction (kappa_aniso = 0)." << std::endl;
+    ATHENA_ERROR(msg);
+  }
+
+  // periodic boundaries stay periodic, all the others are insulating
+  MGBoundaryFunc periodic[6] = {MGPeriodicInnerX1, MGPeriodicOuterX1, MGPeriodicInnerX2,
+                                MGPeriodicOuterX2, MGPeriodicInnerX3, MGPeriodicOuterX3};
+  MGBoundaryFunc insulating[6] = {MGZeroGradientInnerX1, MGZeroGradientOuterX1,
+                                  MGZeroGradientInnerX2, MGZeroGradientOuterX2,
+                                  MGZeroGradientInnerX3, MGZeroGradientOuterX3};
+  for (int i=0; i<6; ++i) {
+    if (pm->mesh_bcs[i] == BoundaryFlag::periodic)
+      MGBoundaryFunction_[i] = periodic[i];
+    else
+      MGBoundaryFunction_[i] = insulating[i];
+  }
+  // the operator is not singular, and the temperature has no freedom of an offset
+  fsubtract_average_ = false;
+  mode_ = 2; // V(1,1) iterative; FMG prolongation would overwrite the coefficients
+
+  // Allocate the root multigrid
+  mgroot_ = new MGConduction(this, nullptr);
+}
+
+
+//----------------------------------------------------------------------------------------
+//! \fn MGConductionDriver::~MGConductionDriver()
+//! \brief MGConductionDriver destructor
+
+MGConductionDriver::~MGConductionDriver() {
+  delete mgroot_;
+}
+
+
+//----------------------------------------------------------------------------------------
+//! \fn MGConduction::MGConduction(MultigridDriver *pmd, MeshBlock *pmb)
+//! \brief MGConduction constructor
+
+MGConduction::MGConduction(MultigridDriver *pmd, MeshBlock *pmb)
+    : Multigrid(pmd, pmb, 3, 1) {
+  btype = BoundaryQuantity::mggrav;
+  btypef = BoundaryQuantity::mggrav_f;
+  if (pmy_block_ != nullptr)
+    pmgbval = new MGConductionBoundaryValues(this, pmy_block_->pbval->block_bcs);
+  else
+    pmgbval = new MGConductionBoundaryValues(this, pmy_driver_->pmy_mesh_->mesh_bcs);
+}
+
+
+//----------------------------------------------------------------------------------------
+//! \fn MGConduction::~MGConduction()
+//! \brief MGConduction deconstructor
+
+MGConduction::~MGConduction() {
+  delete pmgbval;
+}
+
+
+//----------------------------------------------------------------------------------------
+//! \fn void MGConductionDriver::Solve(int stage)
+//! \brief take the implicit conduction step over the current time step; the step is
+//!        operator split, so it does not depend on the stage
+
+void MGConductionDriver::Solve(int) {
+  Update(pmy_mesh_->dt);
+  return;
+}
+
+
+//----------------------------------------------------------------------------------------
+//! \fn void MGConductionDriver::Update(Real dt)
+//! \brief load the data, solve, and update the pressure and the total energy
+//!
+//! Operator split after the main integrator. Only the active cells are updated; the
+//! caller refreshes the ghost cells with Mesh::RefreshGhostCells() before the next cycle.
+
+void MGConductionDriver::Update(Real dt) {
+  // Construct the Multigrid array
+  vmg_.clear();
+  for (int i=0; i<pmy_mesh_->nblocal; ++i)
+    vmg_.push_back(pmy_mesh_->my_blocks(i)->pmgcnd);
+
+  MeshBlock *pmb0 = pmy_mesh_->my_blocks(0);
+  if (!buf_.IsAllocated())
+    buf_.NewAthenaArray(6, pmb0->ncells3, pmb0->ncells2, pmb0->ncells1);
+  AthenaArray<Real> &buf = buf_;
+
+  // load the initial guess T^n, the coefficients, and the source -D T^n
+  Real norm0 = 0.0;
+  for (Multigrid* pmg : vmg_) {
+    MeshBlock *pmb = pmg->pmy_block_;
+    Hydro *ph = pmb->phydro;
+    ph->hdif.SetDiffusivity(ph->w, pmb->pfield->bcc);
+    Real cfac = 1.0/((pmb->peos->GetGamma() - 1.0)*dt);
+    for (int k=pmb->ks; k<=pmb->ke; ++k) {
+      for (int j=pmb->js; j<=pmb->je; ++j) {
+#pragma omp simd reduction(+:norm0)
+        for (int i=pmb->is; i<=pmb->ie; ++i) {
+          Real rho = ph->w(IDN,k,j,i);
+          buf(0,k,j,i) = ph->w(IPR,k,j,i)/rho;
+          buf(1,k,j,i) = ph->hdif.kappa(HydroDiffusion::DiffProcess::iso,k,j,i)*rho;
+          buf(2,k,j,i) = rho*cfac;
+          buf(3,k,j,i) = buf(2,k,j,i)*buf(0,k,j,i);
+          norm0 += SQR(buf(3,k,j,i))*pmb->pcoord->GetCellVolume(k,j,i);
+        }
+      }
+    }
+    pmg->LoadSource(buf, 3, NGHOST, -1.0);
+    pmg->LoadFinestData(buf, 0, NGHOST);
+  }
+#ifdef MPI_PARALLEL
+  MPI_Allreduce(MPI_IN_PLACE, &norm0, 1, MPI_ATHENA_REAL, MPI_SUM, MPI_COMM_WORLD);
+#endif
+  if (norm0 == 0.0) return;
+  norm0 = std::sqrt(norm0/((mgroot_->size_.x1max - mgroot_->size_.x1min)
+                          *(mgroot_->size_.x2max - mgroot_->size_.x2min)
+                          *(mgroot_->size_.x3max - mgroot_->size_.x3min)));
+
+  SetupMultigrid();
+
+  // the defect is measured relative to the thermal energy source D T^n
+  Real def = norm0;
+  int niter = 0;
+  while (niter < maxiter_ && def > tol_*norm0) {
+    SolveVCycle(1, 1);
+    def = CalculateDefectNorm(MGNormType::l2, MGConduction::itmp);
+    niter++;
+  }
+  if (def > tol_*norm0 && Globals::my_rank == 0) {
+    std::cout << "### Warning in MGConductionDriver::Update" << std::endl
+              << "Implicit conduction did not converge in " << maxiter_
+              << " V-cycles : relative defect = " << def/norm0 << "." << std::endl;
+  }
+
+  // Return the result
+  for (Multigrid* pmg : vmg_) {
+    MeshBlock *pmb = pmg->pmy_block_;
+    Hydro *ph = pmb->phydro;
+    Real igm1 = 1.0/(pmb->peos->GetGamma() - 1.0);
+    pmg->RetrieveResult(buf, 0, NGHOST);
+    for (int k=pmb->ks; k<=pmb->ke; ++k) {
+      for (int j=pmb->js; j<=pmb->je; ++j) {
+#pragma omp simd
+        for (int i=pmb->is; i<=pmb->ie; ++i) {
+          Real rho = ph->w(IDN,k,j,i);
+          Real pnew = rho*buf(0,k,j,i);
+          ph->u(IEN,k,j,i) += (pnew - ph->w(IPR,k,j,i))*igm1;
+          ph->w(IPR,k,j,i) = pnew;
+        }
+      }
+    }
+  }
+  return;
+}
+
+
+//----------------------------------------------------------------------------------------
+//! \fn  void MGConduction::Smooth(AthenaArray<Real> &u, const AthenaArray<Real> &src,
+//!           int rlev, int il, int iu, int jl, int ju, int kl, int ku, int color)
+//! \brief Implementation of the Red-Black Gauss-Seidel Smoother
+//!        rlev = relative level from the finest level of this Multigrid block
+//!
+//! Only the temperature is smoothed; the coefficients K and D are left untouched so
+//! that the FAS correction of these variables vanishes.
+
+void MGConduction::Smooth(AthenaArray<Real> &u, const AthenaArray<Real> &src, int rlev,
+                          int il, int iu, int jl, int ju, int kl, int ku, int color) {
+  int c = color;
+  Real dx;
+  if (rlev <= 0) dx = rdx_*static_cast<Real>(1<<(-rlev));
+  else           dx = rdx_/static_cast<Real>(1<<rlev);
+  Real idx2 = 1.0/SQR(dx);
+  for (int k=kl; k<=ku; k++) {
+    for (int j=jl; j<=ju; j++) {
+      for (int i=il+c; i<=iu; i+=2) {
+        Real kc = u(icnd,k,j,i);
+        Real kxm = FaceConductivity(kc, u(icnd,k,j,i-1));
+        Real kxp = FaceConductivity(kc, u(icnd,k,j,i+1));
+        Real kym = FaceConductivity(kc, u(icnd,k,j-1,i));
+        Real kyp = FaceConductivity(kc, u(icnd,k,j+1,i));
+        Real kzm = FaceConductivity(kc, u(icnd,k-1,j,i));
+        Real kzp = FaceConductivity(kc, u(icnd,k+1,j,i));
+        Real nbsum = kxm*u(itmp,k,j,i-1) + kxp*u(itmp,k,j,i+1)
+                   + kym*u(itmp,k,j-1,i) + kyp*u(itmp,k,j+1,i)
+                   + kzm*u(itmp,k-1,j,i) + kzp*u(itmp,k+1,j,i);
+        Real diag = (kxm + kxp + kym + kyp + kzm + kzp)*idx2 + u(icap,k,j,i);
+        u(itmp,k,j,i) = (nbsum*idx2 - src(itmp,k,j,i))/diag;
+      }
+      c ^= 1;  // bitwise XOR assignment
+    }
+    c ^= 1;
+  }
+  return;
+}
+
+
+//----------------------------------------------------------------------------------------
+//! \fn  void MGConduction::CalculateDefect(AthenaArray<Real> &def,
+//!                      const AthenaArray<Real> &u, const AthenaArray<Real> &src,
+//!                      int rlev, int il, int iu, int jl, int ju, int kl, int ku)
+//! \brief Implementation of the Defect calculation
+//!        rlev = relative level from the finest level of this Multigrid block
+
+void MGConduction::CalculateDefect(AthenaArray<Real> &def, const AthenaArray<Real> &u,
+                                   const AthenaArray<Real> &src, int rlev,
+                                   int il, int iu, int jl, int ju, int kl, int ku) {
+  Real dx;
+  if (rlev <= 0) dx = rdx_*static_cast<Real>(1<<(-rlev));
+  else           dx = rdx_/static_cast<Real>(1<<rlev);
+  Real idx2 = 1.0/SQR(dx);
+  for (int k=kl; k<=ku; k++) {
+    for (int j=jl; j<=ju; j++) {
+      for (int i=il; i<=iu; i++) {
+        def(itmp,k,j,i) = src(itmp,k,j,i) - ApplyConductionOperator(u, k, j, i, idx2);
+        def(icnd,k,j,i) = 0.0;
+        def(icap,k,j,i) = 0.0;
+      }
+    }
+  }
+
+  return;
+}
+
+
+//----------------------------------------------------------------------------------------
+//! \fn  void MGConduction::CalculateFASRHS(AthenaArray<Real> &src,
+//!  const AthenaArray<Real> &u, int rlev, int il, int iu, int jl, int ju, int kl, int ku)
+//! \brief Implementation of the RHS calculation for FAS
+//!        rlev = relative level from the finest level of this Multigrid block
+
+void MGConduction::CalculateFASRHS(AthenaArray<Real> &src, const AthenaArray<Real> &u,
+                         int rlev, int il, int iu, int jl, int ju, int kl, int ku) {
+  Real dx;
+  if (rlev <= 0) dx = rdx_*static_cast<Real>(1<<(-rlev));
+  else           dx = rdx_/static_cast<Real>(1<<rlev);
+  Real idx2 = 1.0/SQR(dx);
+  for (int k=kl; k<=ku; k++) {
+    for (int j=jl; j<=ju; j++) {
+      for (int i=il; i<=iu; i++)
+        src(itmp,k,j,i) += ApplyConductionOperator(u, k, j, i, idx2);
+    }
+  }
+
+  return;
+}
+
+
+//----------------------------------------------------------------------------------------
+//! \fn void MGConductionDriver::ProlongateOctetBoundariesFluxCons(AthenaArray<Real> &dst)
+//! \brief prolongate octet boundaries using the flux conservation formula
+
+void MGConductionDriver::ProlongateOctetBoundariesFluxCons(AthenaArray<Real> &dst) {
+  constexpr Real ot = 1.0/3.0;
+  const int ngh = mgroot_->ngh_;
+  const AthenaArray<Real> &u = dst;
+  const int ci = ngh, cj = ngh, ck = ngh, l = ngh, r = ngh + 1;
+
+  // x1face
+  for (int ox1=-1; ox1<=1; ox1+=2) {
+    if (ncoarse_[1][1][ox1+1]) {
+      int i, fi, fig;
+      if (ox1 > 0) i = ngh + 1, fi = ngh + 1, fig = ngh + 2;
+      else         i = ngh - 1, fi = ngh,     fig = ngh - 1;
+      for (int v=0; v<nvar_; ++v) {
+        Real ccval = cbuf_(v, ck, cj, i);
+        Real gx2m = ccval - cbuf_(v, ck, cj-1, i);
+        Real gx2p = cbuf_(v, ck, cj+1, i) - ccval;
+        Real gx2c = 0.125*(SIGN(gx2m) + SIGN(gx2p))*std::min(std::abs(gx2m),
+                                                             std::abs(gx2p));
+        Real gx3m = ccval - cbuf_(v, ck-1, cj, i);
+        Real gx3p = cbuf_(v, ck+1, cj, i) - ccval;
+        Real gx3c = 0.125*(SIGN(gx3m) + SIGN(gx3p))*std::min(std::abs(gx3m),
+                                                             std::abs(gx3p));
+        dst(v, l, l, fig) = ot*(2.0*(ccval - gx2c - gx3c) + u(v, l, l, fi));
+        dst(v, l, r, fig) = ot*(2.0*(ccval + gx2c - gx3c) + u(v, l, r, fi));
+        dst(v, r, l, fig) = ot*(2.0*(ccval - gx2c + gx3c) + u(v, r, l, fi));
+        dst(v, r, r, fig) = ot*(2.0*(ccval + gx2c + gx3c) + u(v, r, r, fi));
+      }
+    }
+  }
+
+  // x2face
+  for (int ox2=-1; ox2<=1; ox2+=2) {
+    if (ncoarse_[1][ox2+1][1]) {
+      int j, fj, fjg;
+      if (ox2 > 0) j = ngh + 1, fj = ngh + 1, fjg = ngh + 2;
+      else         j = ngh - 1, fj = ngh,     fjg = ngh - 1;
+      for (int v=0; v<nvar_; ++v) {
+        Real ccval = cbuf_(v, ck, j, ci);
+        Real gx1m = ccval - cbuf_(v, ck, j, ci-1);
+        Real gx1p = cbuf_(v, ck, j, ci+1) - ccval;
+        Real gx1c = 0.125*(SIGN(gx1m) + SIGN(gx1p))*std::min(std::abs(gx1m),
+                                                             std::abs(gx1p));
+        Real gx3m = ccval - cbuf_(v, ck-1, j, ci);
+        Real gx3p = cbuf_(v, ck+1, j, ci) - ccval;
+        Real gx3c = 0.125*(SIGN(gx3m) + SIGN(gx3p))*std::min(std::abs(gx3m),
+                                                             std::abs(gx3p));
+        dst(v, l, fjg, l) = ot*(2.0*(ccval - gx1c - gx3c) + u(v, l, fj, l));
+        dst(v, l, fjg, r) = ot*(2.0*(ccval + gx1c - gx3c) + u(v, l, fj, r));
+        dst(v, r, fjg, l) = ot*(2.0*(ccval - gx1c + gx3c) + u(v, r, fj, l));
+        dst(v, r, fjg, r) = ot*(2.0*(ccval + gx1c + gx3c) + u(v, r, fj, r));
+      }
+    }
+  }
+
+  // x3face
+  for (int ox3=-1; ox3<=1; ox3+=2) {
+    if (ncoarse_[ox3+1][1][1]) {
+      int k, fk, fkg;
+      if (ox3 > 0) k = ngh + 1, fk = ngh + 1, fkg = ngh + 2;
+      else         k = ngh - 1, fk = ngh,     fkg = ngh - 1;
+      for (int v=0; v<nvar_; ++v) {
+        Real ccval = cbuf_(v, k, cj, ci);
+        Real gx1m = ccval - cbuf_(v, k, cj, ci-1);
+        Real gx1p = cbuf_(v, k, cj, ci+1) - ccval;
+        Real gx1c = 0.125*(SIGN(gx1m) + SIGN(gx1p))*std::min(std::abs(gx1m),
+                                                             std::abs(gx1p));
+        Real gx2m = ccval - cbuf_(v, k, cj-1, ci);
+        Real gx2p = cbuf_(v, k, cj+1, ci) - ccval;
+        Real gx2c = 0.125*(SIGN(gx2m) + SIGN(gx2p))*std::min(std::abs(gx2m),
+                                                             std::abs(gx2p));
+        dst(v, fkg, l, l) = ot*(2.0*(ccval - gx1c - gx2c) + u(v, fk, l, l));
+        dst(v, fkg, l, r) = ot*(2.0*(ccval + gx1c - gx2c) + u(v, fk, l, r));
+        dst(v, fkg, r, l) = ot*(2.0*(ccval - gx1c + gx2c) + u(v, fk, r, l));
+        dst(v, fkg, r, r) = ot*(2.0*(ccval + gx1c + gx2c) + u(v, fk, r, r));
+      }
+    }
+  }
+
+  return;
+}
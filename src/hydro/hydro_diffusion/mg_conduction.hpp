@@ -0,0 +1,68 @@
+#ifndef HYDRO_HYDRO_DIFFUSION_MG_CONDUCTION_HPP_
+#define HYDRO_HYDRO_DIFFUSION_MG_CONDUCTION_HPP_
+//========================================================================================
+// Athena++ astrophysical MHD code
+// Copyright(C) 2014 James M. Stone <jmstone@princeton.edu> and other code contributors
+// Licensed under the 3-clause BSD License, see LICENSE file for details
+//========================================================================================
+//! \file mg_conduction.hpp
+//! \brief defines MGConduction and MGConductionDriver classes
+//!
+//! Backward-Euler step of isotropic thermal conduction solved with the Multigrid
+//! infrastructure. With T = p/rho, the step over dt is the variable-coefficient problem
+//!   D T - div(K grad T) = D T^n,   K = kappa*rho,   D = rho/((gamma-1) dt)
+//! K and D are carried as Multigrid variables 1 and 2 (never smoothed), so that the Full
+//! Approximation Scheme restricts them to the coarse levels together with T.
+
+// C headers
+
+// C++ headers
+
+// Athena++ headers
+#include "../../athena.hpp"
+#include "../../athena_arrays.hpp"
+#include "../../multigrid/multigrid.hpp"
+
+class MeshBlock;
+class ParameterInput;
+class Coordinates;
+class Multigrid;
+
+//! \class MGConduction
+//! \brief Multigrid implicit conduction solver for each block
+
+class MGConduction : public Multigrid {
+ public:
+  MGConduction(MultigridDriver *pmd, MeshBlock *pmb);
+  ~MGConduction();
+
+  void Smooth(AthenaArray<Real> &dst, const AthenaArray<Real> &src,
+              int rlev, int il, int iu, int jl, int ju, int kl, int ku, int color) final;
+  void CalculateDefect(AthenaArray<Real> &def, const AthenaArray<Real> &u,
+                       const AthenaArray<Real> &src, int rlev,
+                       int il, int iu, int jl, int ju, int kl, int ku) final;
+  void CalculateFASRHS(AthenaArray<Real> &def, const AthenaArray<Real> &src,
+                       int rlev, int il, int iu, int jl, int ju, int kl, int ku) final;
+
+  // indices of the Multigrid variables
+  enum MGConductionVariable {itmp=0, icnd=1, icap=2};
+};
+
+
+//! \class MGConductionDriver
+//! \brief Multigrid implicit conduction solver
+
+class MGConductionDriver : public MultigridDriver {
+ public:
+  MGConductionDriver(Mesh *pm, ParameterInput *pin);
+  ~MGConductionDriver();
+  void Solve(int stage) final;
+  void Update(Real dt);
+  void ProlongateOctetBoundariesFluxCons(AthenaArray<Real> &dst) final;
+ private:
+  Real tol_;     // convergence threshold relative to the initial defect
+  int maxiter_;  // maximum number of V-cycles per step
+  AthenaArray<Real> buf_;  // T, K, D, D*T and the zero sources of K and D
+};
+
+#endif // HYDRO_HYDRO_DIFFUSION_MG_CONDUCTION_HPP_
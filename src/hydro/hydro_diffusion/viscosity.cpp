@@ -9,6 +9,7 @@
 // C headers
 
 // C++ headers
+#include <cstring>  // strcmp
 
 // Athena++ headers
 #include "../../athena.hpp"
@@ -19,15 +20,226 @@
 #include "../hydro.hpp"
 #include "hydro_diffusion.hpp"
 
+namespace {
+//----------------------------------------------------------------------------------------
+// Scale factors of the metric as used by the gradients below. In Cartesian coordinates
+// they are identically 1 (and their derivatives 0), so the compiler can drop the
+// corresponding loads and divisions without changing the result.
+
+template <bool CART>
+struct Metric {
+  static Real h2f(const Coordinates *pco, int i) { return CART ? 1.0 : pco->h2f(i); }
+  static Real h2v(const Coordinates *pco, int i) { return CART ? 1.0 : pco->h2v(i); }
+  static Real h31f(const Coordinates *pco, int i) { return CART ? 1.0 : pco->h31f(i); }
+  static Real h31v(const Coordinates *pco, int i) { return CART ? 1.0 : pco->h31v(i); }
+  static Real h32f(const Coordinates *pco, int j) { return CART ? 1.0 : pco->h32f(j); }
+  static Real h32v(const Coordinates *pco, int j) { return CART ? 1.0 : pco->h32v(j); }
+  static Real dh2vd1(const Coordinates *pco, int i) {
+    return CART ? 0.0 : pco->dh2vd1(i);
+  }
+  static Real dh31vd1(const Coordinates *pco, int i) {
+    return CART ? 0.0 : pco->dh31vd1(i);
+  }
+  static Real dh32vd2(const Coordinates *pco, int j) {
+    return CART ? 0.0 : pco->dh32vd2(j);
+  }
+};
+
+//----------------------------------------------------------------------------------------
+// Components of the (symmetrized) covariant velocity gradient at cell faces, evaluated
+// pointwise so that ViscousFluxIsoFused() gets all three at a face from one pass over
+// the primitive stencil. F2/F3 flag a 2D/3D Mesh, CART Cartesian coordinates.
+
+// v_{x1;x1}  covariant derivative at x1 interface
+inline Real FaceXdx(const AthenaArray<Real> &prim, const Coordinates *pco,
+                    const int k, const int j, const int i) {
+  return 2.0*(prim(IM1,k,j,i) - prim(IM1,k,j,i-1)) / pco->dx1v(i-1);
+}
+
+// v_{x2;x1}+v_{x1;x2}  covariant derivative at x1 interface
+template <bool F2, bool CART>
+inline Real FaceXdy(const AthenaArray<Real> &prim, const Coordinates *pco,
+                    const int k, const int j, const int i) {
+  using M = Metric<CART>;
+  if (F2) {
+    return M::h2f(pco, i)
+           * (prim(IM2,k,j,i)/M::h2v(pco, i) - prim(IM2,k,j,i-1)/M::h2v(pco, i-1))
+           / pco->dx1v(i-1)
+           // KGF: add the off-centered quantities first to preserve FP symmetry
+           + 0.5*(   (prim(IM1,k,j+1,i) + prim(IM1,k,j+1,i-1))
+                     - (prim(IM1,k,j-1,i) + prim(IM1,k,j-1,i-1)) )
+           / M::h2f(pco, i)
+           / (pco->dx2v(j-1) + pco->dx2v(j));
+  }
+  return M::h2f(pco, i)
+         * ( prim(IM2,k,j,i)/M::h2v(pco, i) - prim(IM2,k,j,i-1)/M::h2v(pco, i-1) )
+         / pco->dx1v(i-1);
+}
+
+// v_{x3;x1}+v_{x1;x3}  covariant derivative at x1 interface
+template <bool F3, bool CART>
+inline Real FaceXdz(const AthenaArray<Real> &prim, const Coordinates *pco,
+                    const int k, const int j, const int i) {
+  using M = Metric<CART>;
+  if (F3) {
+    return M::h31f(pco, i)
+           * (prim(IM3,k,j,i)/M::h31v(pco, i) - prim(IM3,k,j,i-1)/M::h31v(pco, i-1))
+           / pco->dx1v(i-1)
+           // KGF: add the off-centered quantities first to preserve FP symmetry
+           + 0.5*(   (prim(IM1,k+1,j,i) + prim(IM1,k+1,j,i-1))
+                     - (prim(IM1,k-1,j,i) + prim(IM1,k-1,j,i-1)) )
+           / M::h31f(pco, i)/M::h32v(pco, j) // note, more terms than FaceXdy() line
+           / (pco->dx3v(k-1) + pco->dx3v(k));
+  }
+  return M::h31f(pco, i)
+         * ( prim(IM3,k,j,i)/M::h31v(pco, i) - prim(IM3,k,j,i-1)/M::h31v(pco, i-1) )
+         / pco->dx1v(i-1);
+}
+
+// v_{x1;x2}+v_{x2;x1}  covariant derivative at x2 interface
+template <bool F2, bool CART>
+inline Real FaceYdx(const AthenaArray<Real> &prim, const Coordinates *pco,
+                    const int k, const int j, const int i) {
+  using M = Metric<CART>;
+  if (F2) {
+    return (prim(IM1,k,j,i) - prim(IM1,k,j-1,i)) / M::h2v(pco, i) / pco->dx2v(j-1)
+           + M::h2v(pco, i)*0.5*
+           (  (prim(IM2,k,j,i+1) + prim(IM2,k,j-1,i+1)) /M::h2v(pco, i+1)
+              - (prim(IM2,k,j,i-1) + prim(IM2,k,j-1,i-1)) /M::h2v(pco, i-1)
+              ) / (pco->dx1v(i-1) + pco->dx1v(i));
+  }
+  return M::h2v(pco, i)
+         * ( prim(IM2,k,j,i+1)/M::h2v(pco, i+1) - prim(IM2,k,j,i-1)/M::h2v(pco, i-1) )
+         / (pco->dx1v(i-1) + pco->dx1v(i));
+}
+
+// v_{x2;x2}  covariant derivative at x2 interface
+template <bool F2, bool CART>
+inline Real FaceYdy(const AthenaArray<Real> &prim, const Coordinates *pco,
+                    const int k, const int j, const int i) {
+  using M = Metric<CART>;
+  if (F2) {
+    return 2.0*(prim(IM2,k,j,i) - prim(IM2,k,j-1,i)) / M::h2v(pco, i) / pco->dx2v(j-1)
+           + (prim(IM1,k,j,i) + prim(IM1,k,j-1,i)) / M::h2v(pco, i) * M::dh2vd1(pco, i);
+  }
+  return 2.0*prim(IM1,k,j,i) / M::h2v(pco, i) * M::dh2vd1(pco, i);
+}
+
+// v_{x3;x2}+v_{x2;x3}  covariant derivative at x2 interface
+template <bool F2, bool F3, bool CART>
+inline Real FaceYdz(const AthenaArray<Real> &prim, const Coordinates *pco,
+                    const int k, const int j, const int i) {
+  using M = Metric<CART>;
+  if (F3) {
+    return M::h32f(pco, j)
+           * ( prim(IM3,k,j,i)/M::h32v(pco, j) - prim(IM3,k,j-1,i)/M::h32v(pco, j-1) )
+           / M::h2v(pco, i) / pco->dx2v(j-1)
+           // KGF: add the off-centered quantities first to preserve FP symmetry
+           + 0.5*(    (prim(IM2,k+1,j,i) + prim(IM2,k+1,j-1,i))
+                      - (prim(IM2,k-1,j,i) + prim(IM2,k-1,j-1,i)) )
+           / M::h31v(pco, i)
+           / M::h32f(pco, j) / (pco->dx3v(k-1) + pco->dx3v(k));
+  } else if (F2) {
+    return M::h32f(pco, j)
+           * ( prim(IM3,k,j,i)/M::h32v(pco, j) - prim(IM3,k,j-1,i)/M::h32v(pco, j-1) )
+           / M::h2v(pco, i) / pco->dx2v(j-1);
+  }
+  return 0.0;
+}
+
+// v_{x1;x3}+v_{x3;x1}  covariant derivative at x3 interface
+template <bool F3, bool CART>
+inline Real FaceZdx(const AthenaArray<Real> &prim, const Coordinates *pco,
+                    const int k, const int j, const int i) {
+  using M = Metric<CART>;
+  if (F3) {
+    return (prim(IM1,k,j,i) - prim(IM1,k-1,j,i))/pco->dx3v(k-1)
+           + 0.5*M::h31v(pco, i)*(
+               (prim(IM3,k,j,i+1) + prim(IM3,k-1,j,i+1))/M::h31v(pco, i+1)
+               -(prim(IM3,k,j,i-1) + prim(IM3,k-1,j,i-1))/M::h31v(pco, i-1)
+                                ) / (pco->dx1v(i-1) + pco->dx1v(i));
+  }
+  return M::h31v(pco, i)
+         * ( prim(IM3,k,j,i+1)/M::h31v(pco, i+1) - prim(IM3,k,j,i-1)/M::h31v(pco, i-1) )
+         / (pco->dx1v(i-1) + pco->dx1v(i));
+}
+
+// v_{x2;x3}+v_{x3;x2}  covariant derivative at x3 interface
+template <bool F2, bool F3, bool CART>
+inline Real FaceZdy(const AthenaArray<Real> &prim, const Coordinates *pco,
+                    const int k, const int j, const int i) {
+  using M = Metric<CART>;
+  if (F3) {
+    return (prim(IM2,k,j,i) - prim(IM2,k-1,j,i))
+           / M::h31v(pco, i) / M::h32v(pco, j) / pco->dx3v(k-1)
+           + 0.5*M::h32v(pco, j)
+           * ( (prim(IM3,k,j+1,i) + prim(IM3,k-1,j+1,i))/M::h32v(pco, j+1)
+               -(prim(IM3,k,j-1,i) + prim(IM3,k-1,j-1,i))/M::h32v(pco, j-1) )
+           / M::h2v(pco, i) / (pco->dx2v(j-1) + pco->dx2v(j));
+  } else if (F2) {
+    return M::h32v(pco, j)
+           * ( prim(IM3,k,j+1,i)/M::h32v(pco, j+1) - prim(IM3,k,j-1,i)/M::h32v(pco, j-1) )
+           / M::h2v(pco, i) / (pco->dx2v(j-1) + pco->dx2v(j));
+  }
+  return 0.0;
+}
+
+// v_{x3;x3}  covariant derivative at x3 interface
+template <bool F3, bool CART>
+inline Real FaceZdz(const AthenaArray<Real> &prim, const Coordinates *pco,
+                    const int k, const int j, const int i) {
+  using M = Metric<CART>;
+  if (F3) {
+    return 2.0*(prim(IM3,k,j,i) - prim(IM3,k-1,j,i))
+           / pco->dx3v(k-1) / M::h31v(pco, i) / M::h32v(pco, j)
+           + ((prim(IM1,k,j,i) + prim(IM1,k-1,j,i))
+              * M::dh31vd1(pco, i)/M::h31v(pco, i))
+           + ((prim(IM2,k,j,i) + prim(IM2,k-1,j,i))
+              * M::dh32vd2(pco, j)/M::h32v(pco, j)/M::h2v(pco, i));
+  }
+  return 2.0*prim(IM1,k,j,i)*M::dh31vd1(pco, i)/M::h31v(pco, i)
+         + 2.0*prim(IM2,k,j,i)*M::dh32vd2(pco, j)/M::h32v(pco, j)/M::h2v(pco, i);
+}
+} // namespace
+
 //----------------------------------------------------------------------------------------
 //! \fn void HydroDiffusion::ViscousFluxIso
 //! \brief Calculate isotropic viscous stress as fluxes
 
 void HydroDiffusion::ViscousFluxIso(const AthenaArray<Real> &p,
                      const AthenaArray<Real> &p_i, AthenaArray<Real> *flx) {
-  Hydro *ph = pmb_->phydro;
-  const bool f2 = pmb_->pmy_mesh->f2;
-  const bool f3 = pmb_->pmy_mesh->f3;
+  DivVelocity(p_i, div_vel_);
+
+  if (std::strcmp(COORDINATE_SYSTEM, "cartesian") == 0) {
+    if (pmb_->pmy_mesh->f3)
+      ViscousFluxIsoFused<true, true, true>(p, p_i, flx);
+    else if (pmb_->pmy_mesh->f2)
+      ViscousFluxIsoFused<true, false, true>(p, p_i, flx);
+    else
+      ViscousFluxIsoFused<false, false, true>(p, p_i, flx);
+  } else {
+    if (pmb_->pmy_mesh->f3)
+      ViscousFluxIsoFused<true, true, false>(p, p_i, flx);
+    else if (pmb_->pmy_mesh->f2)
+      ViscousFluxIsoFused<true, false, false>(p, p_i, flx);
+    else
+      ViscousFluxIsoFused<false, false, false>(p, p_i, flx);
+  }
+  return;
+}
+
+//----------------------------------------------------------------------------------------
+//! \fn template <bool F2, bool F3, bool CART>
+//!     void HydroDiffusion::ViscousFluxIsoFused
+//! \brief Isotropic viscous fluxes across the x1, x2, x3 faces of a 1D (F2=F3=false),
+//!        2D (F2) or 3D (F2, F3) MeshBlock. The three gradient components at a face are
+//!        computed in the same vectorized loop that assembles the flux, instead of
+//!        filling one scratch pencil per component. div_vel_ must be up to date.
+
+template <bool F2, bool F3, bool CART>
+void HydroDiffusion::ViscousFluxIsoFused(const AthenaArray<Real> &p,
+                     const AthenaArray<Real> &p_i, AthenaArray<Real> *flx) {
+  const Coordinates *pco = pco_;
   AthenaArray<Real> &x1flux = flx[X1DIR];
   AthenaArray<Real> &x2flux = flx[X2DIR];
   AthenaArray<Real> &x3flux = flx[X3DIR];
@@ -37,14 +249,12 @@ void HydroDiffusion::ViscousFluxIso(const AthenaArray<Real> &p,
   Real nu1, denf, flx1, flx2, flx3;
   Real nuiso2 = - TWO_3RD;
 
-  DivVelocity(p_i, div_vel_);
-
   // Calculate the flux across each face.
   // i-direction
   jl = js, ju = je, kl = ks, ku = ke;
   if (MAGNETIC_FIELDS_ENABLED) {
-    if (f2) {
-      if (!f3) // 2D MHD limits
+    if (F2) {
+      if (!F3) // 2D MHD limits
         jl = js-1, ju = je+1, kl = ks, ku = ke;
       else // 3D MHD limits
         jl = js-1, ju = je+1, kl = ks-1, ku = ke+1;
@@ -52,16 +262,14 @@ void HydroDiffusion::ViscousFluxIso(const AthenaArray<Real> &p,
   }
   for (int k=kl; k<=ku; ++k) {
     for (int j=jl; j<=ju; ++j) {
-      FaceXdx(k, j, is, ie+1, p_i, fx_);
-      FaceXdy(k, j, is, ie+1, p_i, fy_);
-      FaceXdz(k, j, is, ie+1, p_i, fz_);
 #pragma omp simd private(nu1, denf, flx1, flx2, flx3)
       for (int i=is; i<=ie+1; ++i) {
         nu1  = 0.5*(nu(DiffProcess::iso,k,j,i)   + nu(DiffProcess::iso,k,j,i-1));
         denf = 0.5*(p_i(IDN,k,j,i) + p_i(IDN,k,j,i-1));
-        flx1 = -denf*nu1*(fx_(i) + nuiso2*0.5*(div_vel_(k,j,i) + div_vel_(k,j,i-1)));
-        flx2 = -denf*nu1*fy_(i);
-        flx3 = -denf*nu1*fz_(i);
+        flx1 = -denf*nu1*(FaceXdx(p_i, pco, k, j, i)
+                          + nuiso2*0.5*(div_vel_(k,j,i) + div_vel_(k,j,i-1)));
+        flx2 = -denf*nu1*FaceXdy<F2, CART>(p_i, pco, k, j, i);
+        flx3 = -denf*nu1*FaceXdz<F3, CART>(p_i, pco, k, j, i);
         x1flux(IM1,k,j,i) += flx1;
         x1flux(IM2,k,j,i) += flx2;
         x1flux(IM3,k,j,i) += flx3;
@@ -76,26 +284,22 @@ void HydroDiffusion::ViscousFluxIso(const AthenaArray<Real> &p,
   // j-direction
   il = is, iu = ie, kl = ks, ku = ke;
   if (MAGNETIC_FIELDS_ENABLED) {
-    if (!f3) // 2D MHD limits
+    if (!F3) // 2D MHD limits
       il = is-1, iu = ie+1, kl = ks, ku = ke;
     else // 3D MHD limits
       il = is-1, iu = ie+1, kl = ks-1, ku = ke+1;
   }
-  if (f2) { // modify x2flux for 2D or 3D
+  if (F2) { // modify x2flux for 2D or 3D
     for (int k=kl; k<=ku; ++k) {
       for (int j=js; j<=je+1; ++j) {
-        // compute fluxes
-        FaceYdx(k, j, is, ie, p_i, fx_);
-        FaceYdy(k, j, is, ie, p_i, fy_);
-        FaceYdz(k, j, is, ie, p_i, fz_);
-        // store fluxes
 #pragma omp simd private(nu1, denf, flx1, flx2, flx3)
         for (int i=il; i<=iu; i++) {
           nu1  = 0.5*(nu(DiffProcess::iso,k,j,i)    + nu(DiffProcess::iso,k,j-1,i));
           denf = 0.5*(p_i(IDN,k,j-1,i)+ p_i(IDN,k,j,i));
-          flx1 = -denf*nu1*fx_(i);
-          flx2 = -denf*nu1*(fy_(i) + nuiso2*0.5*(div_vel_(k,j-1,i) + div_vel_(k,j,i)));
-          flx3 = -denf*nu1*fz_(i);
+          flx1 = -denf*nu1*FaceYdx<F2, CART>(p_i, pco, k, j, i);
+          flx2 = -denf*nu1*(FaceYdy<F2, CART>(p_i, pco, k, j, i)
+                            + nuiso2*0.5*(div_vel_(k,j-1,i) + div_vel_(k,j,i)));
+          flx3 = -denf*nu1*FaceYdz<F2, F3, CART>(p_i, pco, k, j, i);
           x2flux(IM1,k,j,i) += flx1;
           x2flux(IM2,k,j,i) += flx2;
           x2flux(IM3,k,j,i) += flx3;
@@ -107,18 +311,14 @@ void HydroDiffusion::ViscousFluxIso(const AthenaArray<Real> &p,
       }
     }
   } else { // modify x2flux for 1D
-    // compute fluxes
-    FaceYdx(ks, js, is, ie, p_i, fx_);
-    FaceYdy(ks, js, is, ie, p_i, fy_);
-    FaceYdz(ks, js, is, ie, p_i, fz_);
-    // store fluxes
 #pragma omp simd private(nu1, denf, flx1, flx2, flx3)
     for (int i=il; i<=iu; i++) {
       nu1  = nu(DiffProcess::iso,ks,js,i);
       denf = p_i(IDN,ks,js,i);
-      flx1 = -denf*nu1*fx_(i);
-      flx2 = -denf*nu1*(fy_(i) + nuiso2*div_vel_(ks,js,i));
-      flx3 = -denf*nu1*fz_(i);
+      flx1 = -denf*nu1*FaceYdx<F2, CART>(p_i, pco, ks, js, i);
+      flx2 = -denf*nu1*(FaceYdy<F2, CART>(p_i, pco, ks, js, i)
+                        + nuiso2*div_vel_(ks,js,i));
+      flx3 = -denf*nu1*FaceYdz<F2, F3, CART>(p_i, pco, ks, js, i);
       x2flux(IM1,ks,js,i) += flx1;
       x2flux(IM2,ks,js,i) += flx2;
       x2flux(IM3,ks,js,i) += flx3;
@@ -140,26 +340,22 @@ void HydroDiffusion::ViscousFluxIso(const AthenaArray<Real> &p,
   // set the loop limits
   il = is, iu = ie, jl = js, ju = je;
   if (MAGNETIC_FIELDS_ENABLED) {
-    if (f2) // 2D or 3D MHD limits
+    if (F2) // 2D or 3D MHD limits
       il = is-1, iu = ie+1, jl = js-1, ju = je+1;
     else // 1D MHD limits
       il = is-1, iu = ie+1;
   }
-  if (pmb_->block_size.nx3 > 1) { // modify x3flux for 3D
+  if (F3) { // modify x3flux for 3D
     for (int k=ks; k<=ke+1; ++k) {
       for (int j=jl; j<=ju; ++j) {
-        // compute fluxes
-        FaceZdx(k, j, is, ie, p_i, fx_);
-        FaceZdy(k, j, is, ie, p_i, fy_);
-        FaceZdz(k, j, is, ie, p_i, fz_);
-        // store fluxes
 #pragma omp simd private(nu1, denf, flx1, flx2, flx3)
         for (int i=il; i<=iu; i++) {
           nu1  = 0.5*(nu(DiffProcess::iso,k,j,i)     + nu(DiffProcess::iso,k-1,j,i));
           denf = 0.5*(p_i(IDN,k-1,j,i) + p_i(IDN,k,j,i));
-          flx1 = -denf*nu1*fx_(i);
-          flx2 = -denf*nu1*fy_(i);
-          flx3 = -denf*nu1*(fz_(i) + nuiso2*0.5*(div_vel_(k-1,j,i) + div_vel_(k,j,i)));
+          flx1 = -denf*nu1*FaceZdx<F3, CART>(p_i, pco, k, j, i);
+          flx2 = -denf*nu1*FaceZdy<F2, F3, CART>(p_i, pco, k, j, i);
+          flx3 = -denf*nu1*(FaceZdz<F3, CART>(p_i, pco, k, j, i)
+                            + nuiso2*0.5*(div_vel_(k-1,j,i) + div_vel_(k,j,i)));
           x3flux(IM1,k,j,i) += flx1;
           x3flux(IM2,k,j,i) += flx2;
           x3flux(IM3,k,j,i) += flx3;
@@ -172,18 +368,14 @@ void HydroDiffusion::ViscousFluxIso(const AthenaArray<Real> &p,
     }
   } else { // modify x2flux for 1D or 2D
     for (int j=jl; j<=ju; ++j) {
-      // compute fluxes
-      FaceZdx(ks, j, is, ie, p_i, fx_);
-      FaceZdy(ks, j, is, ie, p_i, fy_);
-      FaceZdz(ks, j, is, ie, p_i, fz_);
-      // store fluxes
 #pragma omp simd private(nu1, denf, flx1, flx2, flx3)
       for (int i=il; i<=iu; i++) {
         nu1 = nu(DiffProcess::iso,ks,j,i);
         denf = p_i(IDN,ks,j,i);
-        flx1 = -denf*nu1*fx_(i);
-        flx2 = -denf*nu1*fy_(i);
-        flx3 = -denf*nu1*(fz_(i) + nuiso2*div_vel_(ks,j,i));
+        flx1 = -denf*nu1*FaceZdx<F3, CART>(p_i, pco, ks, j, i);
+        flx2 = -denf*nu1*FaceZdy<F2, F3, CART>(p_i, pco, ks, j, i);
+        flx3 = -denf*nu1*(FaceZdz<F3, CART>(p_i, pco, ks, j, i)
+                          + nuiso2*div_vel_(ks,j,i));
         x3flux(IM1,ks,j,i) += flx1;
         x3flux(IM2,ks,j,i) += flx2;
         x3flux(IM3,ks,j,i) += flx3;
@@ -282,211 +474,6 @@ void HydroDiffusion::DivVelocity(const AthenaArray<Real> &prim,
   return;
 }
 
-// v_{x1;x1}  covariant derivative at x1 interface
-void HydroDiffusion::FaceXdx(const int k, const int j, const int il, const int iu,
-                             const AthenaArray<Real> &prim, AthenaArray<Real> &len) {
-#pragma omp simd
-  for (int i=il; i<=iu; ++i) {
-    len(i) = 2.0*(prim(IM1,k,j,i) - prim(IM1,k,j,i-1)) / pco_->dx1v(i-1);
-  }
-  return;
-}
-
-// v_{x2;x1}+v_{x1;x2}  covariant derivative at x1 interface
-void HydroDiffusion::FaceXdy(const int k, const int j, const int il, const int iu,
-                             const AthenaArray<Real> &prim, AthenaArray<Real> &len) {
-  if (pmb_->pmy_mesh->f2) {
-#pragma omp simd
-    for (int i=il; i<=iu; ++i) {
-      len(i) = pco_->h2f(i)
-               * (prim(IM2,k,j,i)/pco_->h2v(i) - prim(IM2,k,j,i-1)/pco_->h2v(i-1))
-               / pco_->dx1v(i-1)
-               // KGF: add the off-centered quantities first to preserve FP symmetry
-               + 0.5*(   (prim(IM1,k,j+1,i) + prim(IM1,k,j+1,i-1))
-                         - (prim(IM1,k,j-1,i) + prim(IM1,k,j-1,i-1)) )
-               / pco_->h2f(i)
-               / (pco_->dx2v(j-1) + pco_->dx2v(j));
-    }
-  } else {
-#pragma omp simd
-    for (int i=il; i<=iu; ++i) {
-      len(i) = pco_->h2f(i)
-               * ( prim(IM2,k,j,i)/pco_->h2v(i) - prim(IM2,k,j,i-1)/pco_->h2v(i-1) )
-               / pco_->dx1v(i-1);
-    }
-  }
-  return;
-}
-
-// v_{x3;x1}+v_{x1;x3}  covariant derivative at x1 interface
-void HydroDiffusion::FaceXdz(const int k, const int j, const int il, const int iu,
-                             const AthenaArray<Real> &prim, AthenaArray<Real> &len) {
-  if (pmb_->pmy_mesh->f3) {
-#pragma omp simd
-    for (int i=il; i<=iu; ++i) {
-      len(i) = pco_->h31f(i)
-               * (prim(IM3,k,j,i)/pco_->h31v(i) - prim(IM3,k,j,i-1)/pco_->h31v(i-1))
-               / pco_->dx1v(i-1)
-               // KGF: add the off-centered quantities first to preserve FP symmetry
-               + 0.5*(   (prim(IM1,k+1,j,i) + prim(IM1,k+1,j,i-1))
-                         - (prim(IM1,k-1,j,i) + prim(IM1,k-1,j,i-1)) )
-               / pco_->h31f(i)/pco_->h32v(j) // note, more terms than FaceXdy() line
-               / (pco_->dx3v(k-1) + pco_->dx3v(k));
-    }
-  } else {
-#pragma omp simd
-    for (int i=il; i<=iu; ++i)
-      len(i) = pco_->h31f(i)
-               * ( prim(IM3,k,j,i)/pco_->h31v(i) - prim(IM3,k,j,i-1)/pco_->h31v(i-1) )
-               / pco_->dx1v(i-1);
-  }
-  return;
-}
-
-// v_{x1;x2}+v_{x2;x1}  covariant derivative at x2 interface
-void HydroDiffusion::FaceYdx(const int k, const int j, const int il, const int iu,
-                             const AthenaArray<Real> &prim, AthenaArray<Real> &len) {
-  if (pmb_->pmy_mesh->f2) {
-#pragma omp simd
-    for (int i=il; i<=iu; ++i) {
-      len(i) = (prim(IM1,k,j,i) - prim(IM1,k,j-1,i)) / pco_->h2v(i) / pco_->dx2v(j-1)
-               + pco_->h2v(i)*0.5*
-               (  (prim(IM2,k,j,i+1) + prim(IM2,k,j-1,i+1)) /pco_->h2v(i+1)
-                  - (prim(IM2,k,j,i-1) + prim(IM2,k,j-1,i-1)) /pco_->h2v(i-1)
-                  ) / (pco_->dx1v(i-1) + pco_->dx1v(i));
-    }
-  } else {
-#pragma omp simd
-    for (int i=il; i<=iu; ++i) {
-      len(i) = pco_->h2v(i)
-               * ( prim(IM2,k,j,i+1)/pco_->h2v(i+1) - prim(IM2,k,j,i-1)/pco_->h2v(i-1) )
-               / (pco_->dx1v(i-1) + pco_->dx1v(i));
-    }
-  }
-  return;
-}
-
-// v_{x2;x2}  covariant derivative at x2 interface
-void HydroDiffusion::FaceYdy(const int k, const int j, const int il, const int iu,
-                             const AthenaArray<Real> &prim, AthenaArray<Real> &len) {
-  if (pmb_->pmy_mesh->f2) {
-#pragma omp simd
-    for (int i=il; i<=iu; ++i) {
-      len(i) = 2.0*(prim(IM2,k,j,i) - prim(IM2,k,j-1,i)) / pco_->h2v(i) / pco_->dx2v(j-1)
-               + (prim(IM1,k,j,i) + prim(IM1,k,j-1,i)) / pco_->h2v(i) * pco_->dh2vd1(i);
-    }
-  } else {
-#pragma omp simd
-    for (int i=il; i<=iu; ++i)
-      len(i) = 2.0*prim(IM1,k,j,i) / pco_->h2v(i) * pco_->dh2vd1(i);
-  }
-  return;
-}
-
-// v_{x3;x2}+v_{x2;x3}  covariant derivative at x2 interface
-void HydroDiffusion::FaceYdz(const int k, const int j, const int il, const int iu,
-                             const AthenaArray<Real> &prim, AthenaArray<Real> &len) {
-  if (pmb_->pmy_mesh->f3) {
-#pragma omp simd
-    for (int i=il; i<=iu; ++i) {
-      len(i) = pco_->h32f(j)
-               * ( prim(IM3,k,j,i)/pco_->h32v(j) - prim(IM3,k,j-1,i)/pco_->h32v(j-1) )
-               / pco_->h2v(i) / pco_->dx2v(j-1)
-               // KGF: add the off-centered quantities first to preserve FP symmetry
-               + 0.5*(    (prim(IM2,k+1,j,i) + prim(IM2,k+1,j-1,i))
-                          - (prim(IM2,k-1,j,i) + prim(IM2,k-1,j-1,i)) )
-               / pco_->h31v(i)
-               / pco_->h32f(j) / (pco_->dx3v(k-1) + pco_->dx3v(k));
-    }
-  } else if (pmb_->pmy_mesh->f2) {
-#pragma omp simd
-    for (int i=il; i<=iu; ++i) {
-      len(i) = pco_->h32f(j)
-               * ( prim(IM3,k,j,i)/pco_->h32v(j) - prim(IM3,k,j-1,i)/pco_->h32v(j-1) )
-               / pco_->h2v(i) / pco_->dx2v(j-1);
-    }
-  } else {
-#pragma omp simd
-    for (int i=il; i<=iu; ++i)
-      len(i) = 0.0;
-  }
-  return;
-}
-
-// v_{x1;x3}+v_{x3;x1}  covariant derivative at x3 interface
-void HydroDiffusion::FaceZdx(const int k, const int j, const int il, const int iu,
-                             const AthenaArray<Real> &prim, AthenaArray<Real> &len) {
-  if (pmb_->pmy_mesh->f3) {
-#pragma omp simd
-    for (int i=il; i<=iu; ++i) {
-      len(i) = (prim(IM1,k,j,i) - prim(IM1,k-1,j,i))/pco_->dx3v(k-1)
-               + 0.5*pco_->h31v(i)*(
-                   (prim(IM3,k,j,i+1) + prim(IM3,k-1,j,i+1))/pco_->h31v(i+1)
-                   -(prim(IM3,k,j,i-1) + prim(IM3,k-1,j,i-1))/pco_->h31v(i-1)
-                                    ) / (pco_->dx1v(i-1) + pco_->dx1v(i));
-    }
-  } else {
-#pragma omp simd
-    for (int i=il; i<=iu; ++i) {
-      len(i) = pco_->h31v(i)
-               * ( prim(IM3,k,j,i+1)/pco_->h31v(i+1) - prim(IM3,k,j,i-1)/pco_->h31v(i-1) )
-               / (pco_->dx1v(i-1) + pco_->dx1v(i));
-    }
-  }
-  return;
-}
-
-// v_{x2;x3}+v_{x3;x2}  covariant derivative at x3 interface
-void HydroDiffusion::FaceZdy(const int k, const int j, const int il, const int iu,
-                             const AthenaArray<Real> &prim, AthenaArray<Real> &len) {
-  if (pmb_->pmy_mesh->f3) {
-#pragma omp simd
-    for (int i=il; i<=iu; ++i) {
-      len(i) = (prim(IM2,k,j,i) - prim(IM2,k-1,j,i))
-               / pco_->h31v(i) / pco_->h32v(j) / pco_->dx3v(k-1)
-               + 0.5*pco_->h32v(j)
-               * ( (prim(IM3,k,j+1,i) + prim(IM3,k-1,j+1,i))/pco_->h32v(j+1)
-                   -(prim(IM3,k,j-1,i) + prim(IM3,k-1,j-1,i))/pco_->h32v(j-1) )
-               / pco_->h2v(i) / (pco_->dx2v(j-1) + pco_->dx2v(j));
-    }
-  } else if (pmb_->pmy_mesh->f2) {
-#pragma omp simd
-    for (int i=il; i<=iu; ++i) {
-      len(i) = pco_->h32v(j)
-               * ( prim(IM3,k,j+1,i)/pco_->h32v(j+1) - prim(IM3,k,j-1,i)/pco_->h32v(j-1) )
-               / pco_->h2v(i) / (pco_->dx2v(j-1) + pco_->dx2v(j));
-    }
-  } else {
-#pragma omp simd
-    for (int i=il; i<=iu; ++i)
-      len(i) = 0.0;
-  }
-  return;
-}
-
-// v_{x3;x3}  covariant derivative at x3 interface
-void HydroDiffusion::FaceZdz(const int k, const int j, const int il, const int iu,
-                             const AthenaArray<Real> &prim, AthenaArray<Real> &len) {
-  if (pmb_->pmy_mesh->f3) {
-#pragma omp simd
-    for (int i=il; i<=iu; ++i) {
-      len(i) = 2.0*(prim(IM3,k,j,i) - prim(IM3,k-1,j,i))
-               / pco_->dx3v(k-1) / pco_->h31v(i) / pco_->h32v(j)
-               + ((prim(IM1,k,j,i) + prim(IM1,k-1,j,i))
-                  * pco_->dh31vd1(i)/pco_->h31v(i))
-               + ((prim(IM2,k,j,i) + prim(IM2,k-1,j,i))
-                  * pco_->dh32vd2(j)/pco_->h32v(j)/pco_->h2v(i));
-    }
-  } else {
-#pragma omp simd
-    for (int i=il; i<=iu; ++i) {
-      len(i) = 2.0*prim(IM1,k,j,i)*pco_->dh31vd1(i)/pco_->h31v(i)
-               + 2.0*prim(IM2,k,j,i)*pco_->dh32vd2(j)/pco_->h32v(j)/pco_->h2v(i);
-    }
-  }
-  return;
-}
-
 //----------------------------------------------------------------------------------------
 //! constant viscosity
 
@@ -38,108 +38,38 @@
 //----------------------------------------------------------------------------------------
 //! \fn void Hydro::NewBlockTimeStep()
 //! \brief calculate the minimum timestep within a MeshBlock
+//!
+//! The per-cell hyperbolic, hydro diffusion and user pencil limits are reduced by
+//! NewBlockTimeStepPencil(), either here or during the final W(U) sweep of the cycle
+//! (<time>/fused_dt = true, see BeginFusedBlockTimeStep()). The fused minima are only
+//! used if MeshBlock::UserWorkInLoop(), which runs in between, is not overridden.
 
 void Hydro::NewBlockTimeStep() {
   MeshBlock *pmb = pmy_block;
-  int is = pmb->is; int js = pmb->js; int ks = pmb->ks;
-  int ie = pmb->ie; int je = pmb->je; int ke = pmb->ke;
-  AthenaArray<Real> &w = pmb->phydro->w;
-  // hyperbolic timestep constraint in each (x1-slice) cell along coordinate direction:
-  AthenaArray<Real> &dt1 = dt1_, &dt2 = dt2_, &dt3 = dt3_;  // (x1 slices)
-  Real wi[NWAVE];
 
   Real real_max = std::numeric_limits<Real>::max();
   Real min_dt = real_max;
-  // Note, "dt_hyperbolic" currently refers to the dt limit imposed by evoluiton of the
-  // ideal hydro or MHD fluid by the main integrator (even if not strictly hyperbolic)
-  Real min_dt_hyperbolic  = real_max;
-  // TODO(felker): consider renaming dt_hyperbolic after general execution model is
-  // implemented and flexibility from #247 (zero fluid configurations) is
-  // addressed. dt_hydro, dt_main (inaccurate since "dt" is actually main), dt_MHD?
-  Real min_dt_parabolic  = real_max;
-  Real min_dt_user  = real_max;
 
-  // TODO(felker): skip this next loop if pm->fluid_setup == FluidFormulation::disabled
-  FluidFormulation fluid_status = pmb->pmy_mesh->fluid_setup;
-  for (int k=ks; k<=ke; ++k) {
-    for (int j=js; j<=je; ++j) {
-      pmb->pcoord->CenterWidth1(k, j, is, ie, dt1);
-      pmb->pcoord->CenterWidth2(k, j, is, ie, dt2);
-      pmb->pcoord->CenterWidth3(k, j, is, ie, dt3);
-      if (!RELATIVISTIC_DYNAMICS) {
-#pragma ivdep
-        for (int i=is; i<=ie; ++i) {
-          wi[IDN] = w(IDN,k,j,i);
-          wi[IVX] = w(IVX,k,j,i);
-          wi[IVY] = w(IVY,k,j,i);
-          wi[IVZ] = w(IVZ,k,j,i);
-          if (NON_BAROTROPIC_EOS) wi[IPR] = w(IPR,k,j,i);
-          if (fluid_status == FluidFormulation::evolve) {
-            if (MAGNETIC_FIELDS_ENABLED) {
-              AthenaArray<Real> &bcc = pmb->pfield->bcc, &b_x1f = pmb->pfield->b.x1f,
-                              &b_x2f = pmb->pfield->b.x2f, &b_x3f = pmb->pfield->b.x3f;
-              Real bx = bcc(IB1,k,j,i) + std::abs(b_x1f(k,j,i) - bcc(IB1,k,j,i));
-              wi[IBY] = bcc(IB2,k,j,i);
-              wi[IBZ] = bcc(IB3,k,j,i);
-              Real cf = pmb->peos->FastMagnetosonicSpeed(wi,bx);
-              dt1(i) /= (std::abs(wi[IVX]) + cf);
-
-              wi[IBY] = bcc(IB3,k,j,i);
-              wi[IBZ] = bcc(IB1,k,j,i);
-              bx = bcc(IB2,k,j,i) + std::abs(b_x2f(k,j,i) - bcc(IB2,k,j,i));
-              cf = pmb->peos->FastMagnetosonicSpeed(wi,bx);
-              dt2(i) /= (std::abs(wi[IVY]) + cf);
-
-              wi[IBY] = bcc(IB1,k,j,i);
-              wi[IBZ] = bcc(IB2,k,j,i);
-              bx = bcc(IB3,k,j,i) + std::abs(b_x3f(k,j,i) - bcc(IB3,k,j,i));
-              cf = pmb->peos->FastMagnetosonicSpeed(wi,bx);
-              dt3(i) /= (std::abs(wi[IVZ]) + cf);
-            } else {
-              Real cs = pmb->peos->SoundSpeed(wi);
-              dt1(i) /= (std::abs(wi[IVX]) + cs);
-              dt2(i) /= (std::abs(wi[IVY]) + cs);
-              dt3(i) /= (std::abs(wi[IVZ]) + cs);
-            }
-          } else { // FluidFormulation::background or disabled. Assume scalar advection:
-            dt1(i) /= (std::abs(wi[IVX]));
-            dt2(i) /= (std::abs(wi[IVY]));
-            dt3(i) /= (std::abs(wi[IVZ]));
-          }
-        }
-      }
-
-      // compute minimum of (v1 +/- C)
-      for (int i=is; i<=ie; ++i) {
-        Real& dt_1 = dt1(i);
-        min_dt_hyperbolic = std::min(min_dt_hyperbolic, dt_1);
-      }
-
-      // if grid is 2D/3D, compute minimum of (v2 +/- C)
-      if (pmb->block_size.nx2 > 1) {
-        for (int i=is; i<=ie; ++i) {
-          Real& dt_2 = dt2(i);
-          min_dt_hyperbolic = std::min(min_dt_hyperbolic, dt_2);
-        }
-      }
-
-      // if grid is 3D, compute minimum of (v3 +/- C)
-      if (pmb->block_size.nx3 > 1) {
-        for (int i=is; i<=ie; ++i) {
-          Real& dt_3 = dt3(i);
-          min_dt_hyperbolic = std::min(min_dt_hyperbolic, dt_3);
-        }
+  if (!fused_dt_ready_ || pmb->user_work_in_loop_) {
+    min_dt_hyperbolic_ = real_max;
+    min_dt_parabolic_ = real_max;
+    min_dt_user_ = real_max;
+    for (int k=pmb->ks; k<=pmb->ke; ++k) {
+      for (int j=pmb->js; j<=pmb->je; ++j) {
+        NewBlockTimeStepPencil(k, j, w);
       }
     }
   }
+  fused_dt_ready_ = false;
 
-  // calculate the timestep limited by the diffusion processes
-  if (hdif.hydro_diffusion_defined) {
-    Real min_dt_vis, min_dt_cnd;
-    hdif.NewDiffusionDt(min_dt_vis, min_dt_cnd);
-    min_dt_parabolic = std::min(min_dt_parabolic, min_dt_vis);
-    min_dt_parabolic = std::min(min_dt_parabolic, min_dt_cnd);
-  } // hydro diffusion
+  // Note, "dt_hyperbolic" currently refers to the dt limit imposed by evoluiton of the
+  // ideal hydro or MHD fluid by the main integrator (even if not strictly hyperbolic)
+  Real min_dt_hyperbolic  = min_dt_hyperbolic_;
+  // TODO(felker): consider renaming dt_hyperbolic after general execution model is
+  // implemented and flexibility from #247 (zero fluid configurations) is
+  // addressed. dt_hydro, dt_main (inaccurate since "dt" is actually main), dt_MHD?
+  Real min_dt_parabolic  = min_dt_parabolic_;
+  Real min_dt_user  = min_dt_user_;
 
   if (MAGNETIC_FIELDS_ENABLED &&
       pmb->pfield->fdif.field_diffusion_defined) {
@@ -151,8 +81,14 @@ void Hydro::NewBlockTimeStep() {
   } // field diffusion
 
   if (NSCALARS > 0 && pmb->pscalars->scalar_diffusion_defined) {
-    Real min_dt_scalar_diff = pmb->pscalars->NewDiffusionDt();
-    min_dt_parabolic = std::min(min_dt_parabolic, min_dt_scalar_diff);
+    Real min_dt_scalar_diff, min_dt_scalar_sts;
+    pmb->pscalars->NewDiffusionDt(min_dt_scalar_diff, min_dt_scalar_sts);
+    min_dt_parabolic = std::min(min_dt_parabolic, min_dt_scalar_sts);
+    // scalars excluded from STS limit the main integrator like the hyperbolic terms
+    if (STS_ENABLED)
+      min_dt_hyperbolic = std::min(min_dt_hyperbolic, min_dt_scalar_diff);
+    else
+      min_dt_parabolic = std::min(min_dt_parabolic, min_dt_scalar_diff);
   } // passive scalar diffusion
 
   min_dt_hyperbolic *= pmb->pmy_mesh->cfl_number;
@@ -172,7 +108,9 @@ void Hydro::NewBlockTimeStep() {
   min_dt = std::min(min_dt, min_dt_hyperbolic);
   // user:
   if (UserTimeStep_ != nullptr) {
-    min_dt_user = UserTimeStep_(pmb);
+    min_dt_user = std::min(min_dt_user, UserTimeStep_(pmb));
+  }
+  if (UserTimeStep_ != nullptr || UserTimeStepPencil_ != nullptr) {
     min_dt = std::min(min_dt, min_dt_user);
   }
   // parabolic:
@@ -188,3 +126,112 @@ void Hydro::NewBlockTimeStep() {
 
   return;
 }
+
+//----------------------------------------------------------------------------------------
+//! \fn void Hydro::BeginFusedBlockTimeStep()
+//! \brief reset the running timestep minima before they are accumulated pencil by pencil
+//!        outside of NewBlockTimeStep(); the next call to NewBlockTimeStep() then uses
+//!        them instead of sweeping over w again
+
+void Hydro::BeginFusedBlockTimeStep() {
+  Real real_max = std::numeric_limits<Real>::max();
+  min_dt_hyperbolic_ = real_max;
+  min_dt_parabolic_ = real_max;
+  min_dt_user_ = real_max;
+  fused_dt_ready_ = true;
+  return;
+}
+
+//----------------------------------------------------------------------------------------
+//! \fn void Hydro::NewBlockTimeStepPencil(const int k, const int j,
+//!                                        const AthenaArray<Real> &w)
+//! \brief reduce the hyperbolic, hydro diffusion and user timestep limits of the active
+//!        cells of a single (k,j) pencil of the primitive variables w
+
+void Hydro::NewBlockTimeStepPencil(const int k, const int j, const AthenaArray<Real> &w) {
+  MeshBlock *pmb = pmy_block;
+  int is = pmb->is; int ie = pmb->ie;
+  // hyperbolic timestep constraint in each (x1-slice) cell along coordinate direction:
+  AthenaArray<Real> &dt1 = dt1_, &dt2 = dt2_, &dt3 = dt3_;  // (x1 slices)
+  Real wi[NWAVE];
+
+  // TODO(felker): skip this next loop if pm->fluid_setup == FluidFormulation::disabled
+  FluidFormulation fluid_status = pmb->pmy_mesh->fluid_setup;
+  pmb->pcoord->CenterWidth1(k, j, is, ie, dt1);
+  pmb->pcoord->CenterWidth2(k, j, is, ie, dt2);
+  pmb->pcoord->CenterWidth3(k, j, is, ie, dt3);
+  if (!RELATIVISTIC_DYNAMICS) {
+#pragma ivdep
+    for (int i=is; i<=ie; ++i) {
+      wi[IDN] = w(IDN,k,j,i);
+      wi[IVX] = w(IVX,k,j,i);
+      wi[IVY] = w(IVY,k,j,i);
+      wi[IVZ] = w(IVZ,k,j,i);
+      if (NON_BAROTROPIC_EOS) wi[IPR] = w(IPR,k,j,i);
+      if (fluid_status == FluidFormulation::evolve) {
+        if (MAGNETIC_FIELDS_ENABLED) {
+          AthenaArray<Real> &bcc = pmb->pfield->bcc, &b_x1f = pmb->pfield->b.x1f,
+                          &b_x2f = pmb->pfield->b.x2f, &b_x3f = pmb->pfield->b.x3f;
+          Real bx = bcc(IB1,k,j,i) + std::abs(b_x1f(k,j,i) - bcc(IB1,k,j,i));
+          wi[IBY] = bcc(IB2,k,j,i);
+          wi[IBZ] = bcc(IB3,k,j,i);
+          Real cf = pmb->peos->FastMagnetosonicSpeed(wi,bx);
+          dt1(i) /= (std::abs(wi[IVX]) + cf);
+
+          wi[IBY] = bcc(IB3,k,j,i);
+          wi[IBZ] = bcc(IB1,k,j,i);
+          bx = bcc(IB2,k,j,i) + std::abs(b_x2f(k,j,i) - bcc(IB2,k,j,i));
+          cf = pmb->peos->FastMagnetosonicSpeed(wi,bx);
+          dt2(i) /= (std::abs(wi[IVY]) + cf);
+
+          wi[IBY] = bcc(IB1,k,j,i);
+          wi[IBZ] = bcc(IB2,k,j,i);
+          bx = bcc(IB3,k,j,i) + std::abs(b_x3f(k,j,i) - bcc(IB3,k,j,i));
+          cf = pmb->peos->FastMagnetosonicSpeed(wi,bx);
+          dt3(i) /= (std::abs(wi[IVZ]) + cf);
+        } else {
+          Real cs = pmb->peos->SoundSpeed(wi);
+          dt1(i) /= (std::abs(wi[IVX]) + cs);
+          dt2(i) /= (std::abs(wi[IVY]) + cs);
+          dt3(i) /= (std::abs(wi[IVZ]) + cs);
+        }
+      } else { // FluidFormulation::background or disabled. Assume scalar advection:
+        dt1(i) /= (std::abs(wi[IVX]));
+        dt2(i) /= (std::abs(wi[IVY]));
+        dt3(i) /= (std::abs(wi[IVZ]));
+      }
+    }
+  }
+
+  // compute minimum of (v1 +/- C), (v2 +/- C) if grid is 2D/3D, (v3 +/- C) if 3D
+  Real dt_hyp = min_dt_hyperbolic_;
+#pragma omp simd reduction(min:dt_hyp)
+  for (int i=is; i<=ie; ++i) {
+    dt_hyp = std::min(dt_hyp, dt1(i));
+  }
+  if (pmb->block_size.nx2 > 1) {
+#pragma omp simd reduction(min:dt_hyp)
+    for (int i=is; i<=ie; ++i) {
+      dt_hyp = std::min(dt_hyp, dt2(i));
+    }
+  }
+  if (pmb->block_size.nx3 > 1) {
+#pragma omp simd reduction(min:dt_hyp)
+    for (int i=is; i<=ie; ++i) {
+      dt_hyp = std::min(dt_hyp, dt3(i));
+    }
+  }
+  min_dt_hyperbolic_ = dt_hyp;
+
+  // timestep limited by the hydro diffusion processes
+  if (hdif.hydro_diffusion_defined) {
+    Real dt_vis = min_dt_parabolic_, dt_cnd = min_dt_parabolic_;
+    hdif.NewDiffusionDtPencil(k, j, dt_vis, dt_cnd);
+    min_dt_parabolic_ = std::min(dt_vis, dt_cnd);
+  }
+
+  if (UserTimeStepPencil_ != nullptr) {
+    min_dt_user_ = std::min(min_dt_user_, UserTimeStepPencil_(pmb, k, j, w));
+  }
+  return;
+}
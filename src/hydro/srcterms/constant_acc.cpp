@@ -26,46 +26,58 @@ void HydroSourceTerms::ConstantAcceleration(const Real dt,const AthenaArray<Real
                                             const AthenaArray<Real> &prim,
                                             AthenaArray<Real> &cons) {
   MeshBlock *pmb = pmy_hydro_->pmy_block;
+  const int nthreads = pmb->pmy_mesh->GetNumLoopThreads();
+
+#pragma omp parallel num_threads(nthreads)
+  {
+    int jb = pmb->js, jt = pmb->je, kb = pmb->ks, kt = pmb->ke;
+    pmb->LoopThreadRange(jb, jt, kb, kt);
+    for (int k=kb; k<=kt; ++k) {
+      for (int j=jb; j<=jt; ++j) {
+        ConstantAccelerationPencil(k, j, dt, prim, cons);
+      }
+    }
+  }
+  return;
+}
+
+//----------------------------------------------------------------------------------------
+//! \fn void HydroSourceTerms::ConstantAccelerationPencil
+//! \brief Adds source terms for constant acceleration on a single (k,j) pencil
+
+void HydroSourceTerms::ConstantAccelerationPencil(const int k, const int j,
+                                                  const Real dt,
+                                                  const AthenaArray<Real> &prim,
+                                                  AthenaArray<Real> &cons) {
+  MeshBlock *pmb = pmy_hydro_->pmy_block;
 
   // acceleration in 1-direction
   if (g1_!=0.0) {
-    for (int k=pmb->ks; k<=pmb->ke; ++k) {
-      for (int j=pmb->js; j<=pmb->je; ++j) {
 #pragma omp simd
-        for (int i=pmb->is; i<=pmb->ie; ++i) {
-          Real src = dt*prim(IDN,k,j,i)*g1_;
-          cons(IM1,k,j,i) += src;
-          if (NON_BAROTROPIC_EOS) cons(IEN,k,j,i) += src*prim(IVX,k,j,i);
-        }
-      }
+    for (int i=pmb->is; i<=pmb->ie; ++i) {
+      Real src = dt*prim(IDN,k,j,i)*g1_;
+      cons(IM1,k,j,i) += src;
+      if (NON_BAROTROPIC_EOS) cons(IEN,k,j,i) += src*prim(IVX,k,j,i);
     }
   }
 
   // acceleration in 2-direction
   if (g2_!=0.0) {
-    for (int k=pmb->ks; k<=pmb->ke; ++k) {
-      for (int j=pmb->js; j<=pmb->je; ++j) {
 #pragma omp simd
-        for (int i=pmb->is; i<=pmb->ie; ++i) {
-          Real src = dt*prim(IDN,k,j,i)*g2_;
-          cons(IM2,k,j,i) += src;
-          if (NON_BAROTROPIC_EOS) cons(IEN,k,j,i) += src*prim(IVY,k,j,i);
-        }
-      }
+    for (int i=pmb->is; i<=pmb->ie; ++i) {
+      Real src = dt*prim(IDN,k,j,i)*g2_;
+      cons(IM2,k,j,i) += src;
+      if (NON_BAROTROPIC_EOS) cons(IEN,k,j,i) += src*prim(IVY,k,j,i);
     }
   }
 
   // acceleration in 3-direction
   if (g3_!=0.0) {
-    for (int k=pmb->ks; k<=pmb->ke; ++k) {
-      for (int j=pmb->js; j<=pmb->je; ++j) {
 #pragma omp simd
-        for (int i=pmb->is; i<=pmb->ie; ++i) {
-          Real src = dt*prim(IDN,k,j,i)*g3_;
-          cons(IM3,k,j,i) += src;
-          if (NON_BAROTROPIC_EOS) cons(IEN,k,j,i) += src*prim(IVZ,k,j,i);
-        }
-      }
+    for (int i=pmb->is; i<=pmb->ie; ++i) {
+      Real src = dt*prim(IDN,k,j,i)*g3_;
+      cons(IM3,k,j,i) += src;
+      if (NON_BAROTROPIC_EOS) cons(IEN,k,j,i) += src*prim(IVZ,k,j,i);
     }
   }
 
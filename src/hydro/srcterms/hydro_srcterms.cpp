@@ -24,6 +24,7 @@
 #include "../../parameter_input.hpp"
 #include "../hydro.hpp"
 #include "hydro_srcterms.hpp"
+#include "physics_modules.hpp"
 
 //! HydroSourceTerms constructor
 
@@ -106,8 +107,23 @@ HydroSourceTerms::HydroSourceTerms(Hydro *phyd, ParameterInput *pin) {
 
   if (SELF_GRAVITY_ENABLED) hydro_sourceterms_defined = true;
 
+  // gravity of sink particles (see SinkParticles)
+  flag_sink_particles_ = pin->GetOrAddBoolean("sinks", "sink_particles", false);
+  if (flag_sink_particles_) hydro_sourceterms_defined = true;
+
   UserSourceTerm = phyd->pmy_block->pmy_mesh->UserSourceTerm_;
   if (UserSourceTerm != nullptr) hydro_sourceterms_defined = true;
+
+  UserSourceTermPencil = phyd->pmy_block->pmy_mesh->UserSourceTermPencil_;
+  if (UserSourceTermPencil != nullptr) hydro_sourceterms_defined = true;
+
+  // physics modules evaluated in every stage (see PhysicsModules)
+  if (phyd->pmy_block->pmy_mesh->pphys->StageModulesDefined())
+    hydro_sourceterms_defined = true;
+
+  // constant acceleration and user pencil source terms are moved into the fused stage
+  // update of the time integrator (see TimeIntegratorTaskList::IntegrateHydro)
+  fused_update = pin->GetOrAddBoolean("time", "fused_update", false);
 }
 
 //----------------------------------------------------------------------------------------
@@ -129,7 +145,7 @@ void HydroSourceTerms::AddSourceTerms(const Real time, const Real dt,
     PointMass(dt, flux, prim, cons);
 
   // constant acceleration (e.g. for RT instability)
-  if (g1_ != 0.0 || g2_ != 0.0 || g3_ != 0.0)
+  if ((g1_ != 0.0 || g2_ != 0.0 || g3_ != 0.0) && !fused_update)
     ConstantAcceleration(dt, flux, prim, cons);
 
   // Add new source terms here
@@ -144,12 +160,59 @@ void HydroSourceTerms::AddSourceTerms(const Real time, const Real dt,
   else if (flag_shearing_source_ == 3)
     RotatingSystemSourceTerms(dt, flux, prim, cons);
 
+  // gravity of sink particles
+  if (flag_sink_particles_)
+    SinkGravity(dt, flux, prim, cons);
+
   // MyNewSourceTerms()
 
+  // user-defined pencil source terms, unless already added in the fused stage update.
+  // Always evaluated before the block-wise user source terms, as in the fused update
+  if (UserSourceTermPencil != nullptr && !fused_update) {
+    for (int k=pmb->ks; k<=pmb->ke; ++k) {
+      for (int j=pmb->js; j<=pmb->je; ++j) {
+        UserSourceTermPencil(pmb, k, j, time, dt, prim, prim_scalar, bcc,
+                             cons, cons_scalar);
+      }
+    }
+  }
+
   //  user-defined source terms
   if (UserSourceTerm != nullptr) {
     UserSourceTerm(pmb, time, dt, prim, prim_scalar, bcc, cons, cons_scalar);
   }
 
+  // physics modules enrolled with PhysicsStage::every_stage
+  PhysicsModules *pphys = pmb->pmy_mesh->pphys;
+  if (pphys->StageModulesDefined())
+    pphys->ApplyStageModules(pmb, time, dt, prim, prim_scalar, bcc, cons, cons_scalar);
+
+  return;
+}
+
+//----------------------------------------------------------------------------------------
+//! \fn void HydroSourceTerms::AddSourceTermsPencil
+//! \brief Adds the pencil-local source terms to the conserved variables on one (k,j)
+//! pencil. Called from the fused stage update right after the flux divergence, while
+//! the pencil is still in cache.
+
+void HydroSourceTerms::AddSourceTermsPencil(const int k, const int j,
+                                            const Real time, const Real dt,
+                                            const AthenaArray<Real> &prim,
+                                            const AthenaArray<Real> &prim_scalar,
+                                            const AthenaArray<Real> &bcc,
+                                            AthenaArray<Real> &cons,
+                                            AthenaArray<Real> &cons_scalar) {
+  MeshBlock *pmb = pmy_hydro_->pmy_block;
+
+  // constant acceleration (e.g. for RT instability)
+  if (g1_ != 0.0 || g2_ != 0.0 || g3_ != 0.0)
+    ConstantAccelerationPencil(k, j, dt, prim, cons);
+
+  //  user-defined pencil source terms
+  if (UserSourceTermPencil != nullptr) {
+    UserSourceTermPencil(pmb, k, j, time, dt, prim, prim_scalar, bcc, cons, cons_scalar);
+  }
+
   return;
 }
@@ -37,6 +37,7 @@ class HydroSourceTerms {
 
   // data
   bool hydro_sourceterms_defined;
+  bool fused_update; // pencil source terms are applied in the fused stage update
 
   // functions
   void AddSourceTerms(const Real time, const Real dt, const AthenaArray<Real> *flx,
@@ -44,10 +45,17 @@ class HydroSourceTerms {
                       const AthenaArray<Real> &prim_scalar,
                       const AthenaArray<Real> &b, AthenaArray<Real> &cons,
                       AthenaArray<Real> &cons_scalar);
+  void AddSourceTermsPencil(const int k, const int j, const Real time, const Real dt,
+                            const AthenaArray<Real> &prim,
+                            const AthenaArray<Real> &prim_scalar,
+                            const AthenaArray<Real> &b, AthenaArray<Real> &cons,
+                            AthenaArray<Real> &cons_scalar);
   void PointMass(const Real dt, const AthenaArray<Real> *flx,const AthenaArray<Real> &p,
                  AthenaArray<Real> &c);
   void ConstantAcceleration(const Real dt, const AthenaArray<Real> *flx,
                             const AthenaArray<Real> &p, AthenaArray<Real> &c);
+  void ConstantAccelerationPencil(const int k, const int j, const Real dt,
+                                  const AthenaArray<Real> &p, AthenaArray<Real> &c);
   // shearing box src terms
   void ShearingBoxSourceTerms(const Real dt, const AthenaArray<Real> *flx,
                               const AthenaArray<Real> &p, AthenaArray<Real> &c);
@@ -59,8 +67,11 @@ class HydroSourceTerms {
 
   void SelfGravity(const Real dt, const AthenaArray<Real> *flx,
                    const AthenaArray<Real> &p, AthenaArray<Real> &c);
+  void SinkGravity(const Real dt, const AthenaArray<Real> *flx,
+                   const AthenaArray<Real> &p, AthenaArray<Real> &c);
   void EnrollSrcTermFunction(SrcTermFunc my_func);
   SrcTermFunc UserSourceTerm;
+  SrcTermPencilFunc UserSourceTermPencil;
 
  private:
   Hydro *pmy_hydro_;  // ptr to Hydro containing this HydroSourceTerms
@@ -70,5 +81,6 @@ class HydroSourceTerms {
   int  ShBoxCoord_;       // ShearCoordinate type: 1=xy (default), 2=xz
   bool flag_point_mass_;      // flag for calling PointMass function
   int  flag_shearing_source_; // 1=orbital advection, 2=shearing box, 3=rotating system
+  bool flag_sink_particles_;  // flag for calling SinkGravity function
 };
 #endif // HYDRO_SRCTERMS_HYDRO_SRCTERMS_HPP_
@@ -0,0 +1,186 @@
+//========================================================================================
+// Athena++ astrophysical MHD code
+// Copyright(C) 2014 James M. Stone <jmstone@princeton.edu> and other code contributors
+// Licensed under the 3-clause BSD License, see LICENSE file for details
+//========================================================================================
+//! \file physics_modules.cpp
+//! \brief scheduling of the physics modules enrolled with Mesh::EnrollPhysicsModule()
+//!
+//! every_stage modules are called from HydroSourceTerms::AddSourceTerms() after the
+//! built-in and user source terms, with the stage time and weighted dt. Operator-split
+//! modules are applied from main.cpp, before_step ones right before the time integrator
+//! and after_step ones right after it (and after sink particles), on cycles where
+//! (ncycle+1) % interval == 0 for after_step and ncycle % interval == 0 for before_step.
+//! They receive the time elapsed since they were last applied, so that every module
+//! covers the whole evolution; a restart or a rollback starts a new interval.
+//!
+//! Operator-split modules run on all MeshBlocks concurrently, modules that are not
+//! thread safe inside a critical section. They are passed the conserved and primitive
+//! variables of the block; when a module has written conserved variables the
+//! primitives of the active cells are recomputed, but only before a later module that
+//! reads them and once at the end.
+
+// C headers
+
+// C++ headers
+#include <algorithm>  // min
+#include <sstream>    // stringstream
+#include <stdexcept>  // runtime_error
+#include <string>
+#include <vector>
+
+// Athena++ headers
+#include "../../athena.hpp"
+#include "../../athena_arrays.hpp"
+#include "../../eos/eos.hpp"
+#include "../../field/field.hpp"
+#include "../../mesh/mesh.hpp"
+#include "../../scalars/scalars.hpp"
+#include "../hydro.hpp"
+#include "physics_modules.hpp"
+
+//----------------------------------------------------------------------------------------
+//! \fn PhysicsModules::PhysicsModules(Mesh *pm)
+//! \brief constructor; modules are enrolled in Mesh::InitUserMeshData()
+
+PhysicsModules::PhysicsModules(Mesh *pm) : pmy_mesh_(pm), nstage_(0) {}
+
+//----------------------------------------------------------------------------------------
+//! \fn void PhysicsModules::Enroll(const std::string &name, SrcTermFunc func,
+//!                                 PhysicsStage stage, int interval, int reads,
+//!                                 int writes, bool thread_safe)
+//! \brief add a module; modules of the same stage are applied in the order enrolled
+
+void PhysicsModules::Enroll(const std::string &name, SrcTermFunc func,
+                            PhysicsStage stage, int interval, int reads, int writes,
+                            bool thread_safe) {
+  std::stringstream msg;
+  msg << "### FATAL ERROR in Mesh::EnrollPhysicsModule" << std::endl
+      << "Physics module '" << name << "': ";
+  if (func == nullptr) {
+    msg << "the function is a nullptr." << std::endl;
+    ATHENA_ERROR(msg);
+  }
+  if (interval < 1 || (stage == PhysicsStage::every_stage && interval != 1)) {
+    msg << "interval = " << interval << " is not allowed; it must be >= 1 for "
+        << "operator-split modules and 1 for every_stage modules." << std::endl;
+    ATHENA_ERROR(msg);
+  }
+  if ((reads | writes) & ~kPhysAll) {
+    msg << "the variables read or written must be a combination of kPhysHydro and "
+        << "kPhysScalars." << std::endl;
+    ATHENA_ERROR(msg);
+  }
+
+  Module m;
+  m.name = name;
+  m.func = func;
+  m.stage = stage;
+  m.interval = interval;
+  m.reads = reads;
+  m.writes = writes;
+  m.thread_safe = thread_safe;
+  m.t_applied = pmy_mesh_->time;
+  modules_.push_back(m);
+  if (stage == PhysicsStage::every_stage) nstage_++;
+  return;
+}
+
+//----------------------------------------------------------------------------------------
+//! \fn void PhysicsModules::ApplyStageModules(MeshBlock *pmb, const Real time,
+//!        const Real dt, const AthenaArray<Real> &prim,
+//!        const AthenaArray<Real> &prim_scalar, const AthenaArray<Real> &bcc,
+//!        AthenaArray<Real> &cons, AthenaArray<Real> &cons_scalar)
+//! \brief add the every_stage modules to one MeshBlock in a stage of the integrator
+
+void PhysicsModules::ApplyStageModules(MeshBlock *pmb, const Real time, const Real dt,
+                                       const AthenaArray<Real> &prim,
+                                       const AthenaArray<Real> &prim_scalar,
+                                       const AthenaArray<Real> &bcc,
+                                       AthenaArray<Real> &cons,
+                                       AthenaArray<Real> &cons_scalar) {
+  for (const Module &m : modules_) {
+    if (m.stage != PhysicsStage::every_stage) continue;
+    if (m.thread_safe) {
+      m.func(pmb, time, dt, prim, prim_scalar, bcc, cons, cons_scalar);
+    } else {
+#pragma omp critical (physics_module)
+      m.func(pmb, time, dt, prim, prim_scalar, bcc, cons, cons_scalar);
+    }
+  }
+  return;
+}
+
+//----------------------------------------------------------------------------------------
+//! \fn bool PhysicsModules::ApplySplitModules(PhysicsStage stage)
+//! \brief apply the before_step or after_step modules that are due in this cycle to all
+//!        MeshBlocks of this rank. Only the active cells are updated; returns whether any
+//!        module was applied, in which case the caller refreshes the ghost cells with
+//!        Mesh::RefreshGhostCells().
+
+bool PhysicsModules::ApplySplitModules(PhysicsStage stage) {
+  Mesh *pm = pmy_mesh_;
+  const Real t_end = pm->time + pm->dt;
+  const int ncycle = (stage == PhysicsStage::after_step) ? pm->ncycle + 1 : pm->ncycle;
+
+  // modules due in this cycle and the time they have to cover
+  std::vector<int> due;
+  std::vector<Real> dt_due;
+  for (int n=0; n<static_cast<int>(modules_.size()); ++n) {
+    Module &m = modules_[n];
+    if (m.stage != stage || ncycle % m.interval != 0) continue;
+    // after a rollback, continue from the restored time
+    m.t_applied = std::min(m.t_applied, pm->time);
+    due.push_back(n);
+    dt_due.push_back(t_end - m.t_applied);
+    m.t_applied = t_end;
+  }
+  if (due.empty()) return false;
+
+  int nthreads = pm->GetNumMeshThreads();
+#pragma omp parallel for num_threads(nthreads)
+  for (int b=0; b<pm->nblocal; ++b) {
+    MeshBlock *pmb = pm->my_blocks(b);
+    Hydro *ph = pmb->phydro;
+    Field *pf = pmb->pfield;
+    PassiveScalars *ps = pmb->pscalars;
+    int stale = kPhysNone;  // variables whose primitives are out of date
+    for (int n=0; n<static_cast<int>(due.size()); ++n) {
+      const Module &m = modules_[due[n]];
+      if (m.reads & stale) {
+        UpdatePrimitives(pmb, stale);
+        stale = kPhysNone;
+      }
+      if (m.thread_safe) {
+        m.func(pmb, pm->time, dt_due[n], ph->w, ps->r, pf->bcc, ph->u, ps->s);
+      } else {
+#pragma omp critical (physics_module)
+        m.func(pmb, pm->time, dt_due[n], ph->w, ps->r, pf->bcc, ph->u, ps->s);
+      }
+      stale |= m.writes;
+    }
+    UpdatePrimitives(pmb, stale);
+  }
+  return true;
+}
+
+//----------------------------------------------------------------------------------------
+//! \fn void PhysicsModules::UpdatePrimitives(MeshBlock *pmb, int stale)
+//! \brief recompute the primitives of the active cells after the conserved variables
+//!        in `stale` have been changed. The passive scalars are divided by the density,
+//!        so they are updated whenever anything has changed.
+
+void PhysicsModules::UpdatePrimitives(MeshBlock *pmb, int stale) {
+  if (stale == kPhysNone) return;
+  Hydro *ph = pmb->phydro;
+  Field *pf = pmb->pfield;
+  PassiveScalars *ps = pmb->pscalars;
+  if (stale & kPhysHydro)
+    pmb->peos->ConservedToPrimitive(ph->u, ph->w, pf->b, ph->w, pf->bcc, pmb->pcoord,
+                                    pmb->is, pmb->ie, pmb->js, pmb->je, pmb->ks, pmb->ke);
+  if (NSCALARS > 0)
+    pmb->peos->PassiveScalarConservedToPrimitive(ps->s, ph->u, ps->r, ps->r, pmb->pcoord,
+                                                 pmb->is, pmb->ie, pmb->js, pmb->je,
+                                                 pmb->ks, pmb->ke);
+  return;
+}
@@ -0,0 +1,67 @@
+#ifndef HYDRO_SRCTERMS_PHYSICS_MODULES_HPP_
+#define HYDRO_SRCTERMS_PHYSICS_MODULES_HPP_
+//========================================================================================
+// Athena++ astrophysical MHD code
+// Copyright(C) 2014 James M. Stone <jmstone@princeton.edu> and other code contributors
+// Licensed under the 3-clause BSD License, see LICENSE file for details
+//========================================================================================
+//! \file physics_modules.hpp
+//! \brief defines class PhysicsModules, the registry of physics modules enrolled with
+//!        Mesh::EnrollPhysicsModule()
+//!
+//! A physics module is a source function with a schedule: every_stage modules are
+//! added with the other source terms in each stage of the time integrator, while
+//! before_step and after_step modules are operator split and applied once every
+//! `interval` cycles, before or after the hydro step. Each module declares the
+//! variables it reads and writes and whether it may run concurrently on different
+//! MeshBlocks.
+
+// C headers
+
+// C++ headers
+#include <string>
+#include <vector>
+
+// Athena++ headers
+#include "../../athena.hpp"
+#include "../../athena_arrays.hpp"
+
+// Forward declarations
+class Mesh;
+class MeshBlock;
+
+//! \class PhysicsModules
+//! \brief enrolled physics modules and their scheduling
+
+class PhysicsModules {
+ public:
+  explicit PhysicsModules(Mesh *pm);
+
+  // functions
+  void Enroll(const std::string &name, SrcTermFunc func, PhysicsStage stage,
+              int interval, int reads, int writes, bool thread_safe);
+  bool StageModulesDefined() const {return nstage_ > 0;}
+  void ApplyStageModules(MeshBlock *pmb, const Real time, const Real dt,
+                         const AthenaArray<Real> &prim,
+                         const AthenaArray<Real> &prim_scalar,
+                         const AthenaArray<Real> &bcc, AthenaArray<Real> &cons,
+                         AthenaArray<Real> &cons_scalar);
+  bool ApplySplitModules(PhysicsStage stage);
+
+ private:
+  struct Module {
+    std::string name;
+    SrcTermFunc func;
+    PhysicsStage stage;
+    int interval;      // cycles between applications (operator-split modules)
+    int reads, writes; // PhysicsVariable bit masks
+    bool thread_safe;  // may run concurrently on different MeshBlocks
+    Real t_applied;    // time up to which the module has been applied
+  };
+  Mesh *pmy_mesh_;
+  std::vector<Module> modules_;
+  int nstage_;  // number of every_stage modules
+
+  void UpdatePrimitives(MeshBlock *pmb, int stale);
+};
+#endif // HYDRO_SRCTERMS_PHYSICS_MODULES_HPP_
@@ -25,17 +25,23 @@
 void HydroSourceTerms::PointMass(const Real dt, const AthenaArray<Real> *flux,
                                  const AthenaArray<Real> &prim, AthenaArray<Real> &cons) {
   MeshBlock *pmb = pmy_hydro_->pmy_block;
-  for (int k=pmb->ks; k<=pmb->ke; ++k) {
-    for (int j=pmb->js; j<=pmb->je; ++j) {
+  const int nthreads = pmb->pmy_mesh->GetNumLoopThreads();
+#pragma omp parallel num_threads(nthreads)
+  {
+    int jb = pmb->js, jt = pmb->je, kb = pmb->ks, kt = pmb->ke;
+    pmb->LoopThreadRange(jb, jt, kb, kt);
+    for (int k=kb; k<=kt; ++k) {
+      for (int j=jb; j<=jt; ++j) {
 #pragma omp simd
-      for (int i=pmb->is; i<=pmb->ie; ++i) {
-        Real den = prim(IDN,k,j,i);
-        Real src = dt*den*pmb->pcoord->coord_src1_i_(i)*gm_/pmb->pcoord->x1v(i);
-        cons(IM1,k,j,i) -= src;
-        if (NON_BAROTROPIC_EOS) {
-          cons(IEN,k,j,i) -=
-              dt*0.5*(pmb->pcoord->phy_src1_i_(i)*flux[X1DIR](IDN,k,j,i)*gm_
-                      +pmb->pcoord->phy_src2_i_(i)*flux[X1DIR](IDN,k,j,i+1)*gm_);
+        for (int i=pmb->is; i<=pmb->ie; ++i) {
+          Real den = prim(IDN,k,j,i);
+          Real src = dt*den*pmb->pcoord->coord_src1_i_(i)*gm_/pmb->pcoord->x1v(i);
+          cons(IM1,k,j,i) -= src;
+          if (NON_BAROTROPIC_EOS) {
+            cons(IEN,k,j,i) -=
+                dt*0.5*(pmb->pcoord->phy_src1_i_(i)*flux[X1DIR](IDN,k,j,i)*gm_
+                        +pmb->pcoord->phy_src2_i_(i)*flux[X1DIR](IDN,k,j,i+1)*gm_);
+          }
         }
       }
     }
@@ -34,40 +34,51 @@ void HydroSourceTerms::SelfGravity(const Real dt,const AthenaArray<Real> *flux,
                                    AthenaArray<Real> &cons) {
   MeshBlock *pmb = pmy_hydro_->pmy_block;
   Gravity *pgrav = pmb->pgrav;
+  const int nthreads = pmb->pmy_mesh->GetNumLoopThreads();
 
   // acceleration in 1-direction
-  for (int k=pmb->ks; k<=pmb->ke; ++k) {
-    for (int j=pmb->js; j<=pmb->je; ++j) {
+#pragma omp parallel num_threads(nthreads)
+  {
+    int jb = pmb->js, jt = pmb->je, kb = pmb->ks, kt = pmb->ke;
+    pmb->LoopThreadRange(jb, jt, kb, kt);
+    for (int k=kb; k<=kt; ++k) {
+      for (int j=jb; j<=jt; ++j) {
 #pragma omp simd
-      for (int i=pmb->is; i<=pmb->ie; ++i) {
-        Real dx1 = pmb->pcoord->dx1v(i);
-        Real dtodx1 = dt/dx1;
-        Real phic = pgrav->phi(k,j,i);
-        Real phil = 0.5*(pgrav->phi(k,j,i-1)+pgrav->phi(k,j,i  ));
-        Real phir = 0.5*(pgrav->phi(k,j,i  )+pgrav->phi(k,j,i+1));
-        cons(IM1,k,j,i) -= dtodx1*prim(IDN,k,j,i)*(phir-phil);
-        if (NON_BAROTROPIC_EOS)
-          cons(IEN,k,j,i) -= dtodx1*(flux[X1DIR](IDN,k,j,i  )*(phic - phil) +
-                                     flux[X1DIR](IDN,k,j,i+1)*(phir - phic));
+        for (int i=pmb->is; i<=pmb->ie; ++i) {
+          Real dx1 = pmb->pcoord->dx1v(i);
+          Real dtodx1 = dt/dx1;
+          Real phic = pgrav->phi(k,j,i);
+          Real phil = 0.5*(pgrav->phi(k,j,i-1)+pgrav->phi(k,j,i  ));
+          Real phir = 0.5*(pgrav->phi(k,j,i  )+pgrav->phi(k,j,i+1));
+          cons(IM1,k,j,i) -= dtodx1*prim(IDN,k,j,i)*(phir-phil);
+          if (NON_BAROTROPIC_EOS)
+            cons(IEN,k,j,i) -= dtodx1*(flux[X1DIR](IDN,k,j,i  )*(phic - phil) +
+                                       flux[X1DIR](IDN,k,j,i+1)*(phir - phic));
+        }
       }
     }
   }
 
   if (pmb->block_size.nx2 > 1) {
     // acceleration in 2-direction
-    for (int k=pmb->ks; k<=pmb->ke; ++k) {
-      for (int j=pmb->js; j<=pmb->je; ++j) {
+#pragma omp parallel num_threads(nthreads)
+    {
+      int jb = pmb->js, jt = pmb->je, kb = pmb->ks, kt = pmb->ke;
+      pmb->LoopThreadRange(jb, jt, kb, kt);
+      for (int k=kb; k<=kt; ++k) {
+        for (int j=jb; j<=jt; ++j) {
 #pragma omp simd
-        for (int i=pmb->is; i<=pmb->ie; ++i) {
-          Real dx2 = pmb->pcoord->dx2v(j);
-          Real dtodx2 = dt/dx2;
-          Real phic = pgrav->phi(k,j,i);
-          Real phil = 0.5*(pgrav->phi(k,j-1,i)+pgrav->phi(k,j  ,i));
-          Real phir = 0.5*(pgrav->phi(k,j  ,i)+pgrav->phi(k,j+1,i));
-          cons(IM2,k,j,i) -= dtodx2*prim(IDN,k,j,i)*(phir-phil);
-          if (NON_BAROTROPIC_EOS)
-            cons(IEN,k,j,i) -= dtodx2*(flux[X2DIR](IDN,k,j  ,i)*(phic - phil) +
-                                       flux[X2DIR](IDN,k,j+1,i)*(phir - phic));
+          for (int i=pmb->is; i<=pmb->ie; ++i) {
+            Real dx2 = pmb->pcoord->dx2v(j);
+            Real dtodx2 = dt/dx2;
+            Real phic = pgrav->phi(k,j,i);
+            Real phil = 0.5*(pgrav->phi(k,j-1,i)+pgrav->phi(k,j  ,i));
+            Real phir = 0.5*(pgrav->phi(k,j  ,i)+pgrav->phi(k,j+1,i));
+            cons(IM2,k,j,i) -= dtodx2*prim(IDN,k,j,i)*(phir-phil);
+            if (NON_BAROTROPIC_EOS)
+              cons(IEN,k,j,i) -= dtodx2*(flux[X2DIR](IDN,k,j  ,i)*(phic - phil) +
+                                         flux[X2DIR](IDN,k,j+1,i)*(phir - phic));
+          }
         }
       }
     }
@@ -75,19 +86,24 @@ void HydroSourceTerms::SelfGravity(const Real dt,const AthenaArray<Real> *flux,
 
   if (pmb->block_size.nx3 > 1) {
     // acceleration in 3-direction
-    for (int k=pmb->ks; k<=pmb->ke; ++k) {
-      for (int j=pmb->js; j<=pmb->je; ++j) {
+#pragma omp parallel num_threads(nthreads)
+    {
+      int jb = pmb->js, jt = pmb->je, kb = pmb->ks, kt = pmb->ke;
+      pmb->LoopThreadRange(jb, jt, kb, kt);
+      for (int k=kb; k<=kt; ++k) {
+        for (int j=jb; j<=jt; ++j) {
 #pragma omp simd
-        for (int i=pmb->is; i<=pmb->ie; ++i) {
-          Real dx3 = pmb->pcoord->dx3v(k);
-          Real dtodx3 = dt/dx3;
-          Real phic = pgrav->phi(k,j,i);
-          Real phil = 0.5*(pgrav->phi(k-1,j,i)+pgrav->phi(k  ,j,i));
-          Real phir = 0.5*(pgrav->phi(k  ,j,i)+pgrav->phi(k+1,j,i));
-          cons(IM3,k,j,i) -= dtodx3*prim(IDN,k,j,i)*(phir-phil);
-          if (NON_BAROTROPIC_EOS)
-            cons(IEN,k,j,i) -= dtodx3*(flux[X3DIR](IDN,k  ,j,i)*(phic - phil) +
-                                       flux[X3DIR](IDN,k+1,j,i)*(phir - phic));
+          for (int i=pmb->is; i<=pmb->ie; ++i) {
+            Real dx3 = pmb->pcoord->dx3v(k);
+            Real dtodx3 = dt/dx3;
+            Real phic = pgrav->phi(k,j,i);
+            Real phil = 0.5*(pgrav->phi(k-1,j,i)+pgrav->phi(k  ,j,i));
+            Real phir = 0.5*(pgrav->phi(k  ,j,i)+pgrav->phi(k+1,j,i));
+            cons(IM3,k,j,i) -= dtodx3*prim(IDN,k,j,i)*(phir-phil);
+            if (NON_BAROTROPIC_EOS)
+              cons(IEN,k,j,i) -= dtodx3*(flux[X3DIR](IDN,k  ,j,i)*(phic - phil) +
+                                         flux[X3DIR](IDN,k+1,j,i)*(phir - phic));
+          }
         }
       }
     }
@@ -0,0 +1,56 @@
+//========================================================================================
+// Athena++ astrophysical MHD code
+// Copyright(C) 2014 James M. Stone <jmstone@princeton.edu> and other code contributors
+// Licensed under the 3-clause BSD License, see LICENSE file for details
+//========================================================================================
+//! \file sink_gravity.cpp
+//! \brief Adds source terms due to the gravity of sink particles
+
+// C headers
+
+// C++ headers
+
+// Athena++ headers
+#include "../../athena.hpp"
+#include "../../athena_arrays.hpp"
+#include "../../coordinates/coordinates.hpp"
+#include "../../mesh/mesh.hpp"
+#include "../hydro.hpp"
+#include "hydro_srcterms.hpp"
+#include "sink_particles.hpp"
+
+//----------------------------------------------------------------------------------------
+//! \fn void HydroSourceTerms::SinkGravity
+//! \brief Adds source terms due to the (softened) gravity of the sink particles
+
+void HydroSourceTerms::SinkGravity(const Real dt, const AthenaArray<Real> *flux,
+                                   const AthenaArray<Real> &prim,
+                                   AthenaArray<Real> &cons) {
+  MeshBlock *pmb = pmy_hydro_->pmy_block;
+  SinkParticles *psinks = pmb->pmy_mesh->psinks;
+  if (psinks == nullptr || psinks->sinks.empty()) return;
+  Coordinates *pco = pmb->pcoord;
+  const int nthreads = pmb->pmy_mesh->GetNumLoopThreads();
+#pragma omp parallel num_threads(nthreads)
+  {
+    int jb = pmb->js, jt = pmb->je, kb = pmb->ks, kt = pmb->ke;
+    pmb->LoopThreadRange(jb, jt, kb, kt);
+    for (int k=kb; k<=kt; ++k) {
+      for (int j=jb; j<=jt; ++j) {
+        for (int i=pmb->is; i<=pmb->ie; ++i) {
+          Real acc[3];
+          psinks->Acceleration(pco->x1v(i), pco->x2v(j), pco->x3v(k), acc);
+          Real den = prim(IDN,k,j,i);
+          cons(IM1,k,j,i) += dt*den*acc[0];
+          cons(IM2,k,j,i) += dt*den*acc[1];
+          cons(IM3,k,j,i) += dt*den*acc[2];
+          if (NON_BAROTROPIC_EOS) {
+            cons(IEN,k,j,i) += dt*den*(acc[0]*prim(IVX,k,j,i) + acc[1]*prim(IVY,k,j,i)
+                                       + acc[2]*prim(IVZ,k,j,i));
+          }
+        }
+      }
+    }
+  }
+  return;
+}
@@ -0,0 +1,613 @@
+//========================================================================================
+// Athena++ astrophysical MHD code
+// Copyright(C) 2014 James M. Stone <jmstone@princeton.edu> and other code contributors
+// Licensed under the 3-clause BSD License, see LICENSE file for details
+//========================================================================================
+//! \file sink_particles.cpp
+//! \brief Sink particles: creation, threshold accretion and operator-split dynamics
+//!
+//! Once per cycle, after the hydro step (see main.cpp), SinkParticles::Update
+//! 1. removes the gas above the density threshold inside the accretion radius, while
+//!    summing its mass and momentum and the gravitational pull of the gas on the sinks
+//!    (AccreteAndCouple),
+//! 2. collects the unresolved collapsing cells that may form new sinks (FindCandidates).
+//! The sums and the number of candidates are reduced over the ranks together with the
+//! new time step (Mesh::preduce). When the reduction completes, FinishUpdate
+//! 3. adds the accreted mass and momentum to the sinks and kicks and drifts them
+//!    (MoveSinks),
+//! 4. gathers the candidates, if there are any, and creates the new sinks (CreateSinks),
+//!    which start accreting in the next cycle.
+//! The pull of the sinks on the gas is a hydro source term (HydroSourceTerms::
+//! SinkGravity), so momentum is conserved between gas and sinks up to time splitting.
+
+// C headers
+
+// C++ headers
+#include <algorithm>  // sort, min, max
+#include <cmath>      // sqrt
+#include <cstdint>    // int64_t
+#include <cstring>    // memcpy, strcmp
+#include <iostream>   // endl
+#include <limits>
+#include <sstream>    // stringstream
+#include <stdexcept>  // runtime_error
+#include <vector>
+
+// Athena++ headers
+#include "../../athena.hpp"
+#include "../../athena_arrays.hpp"
+#include "../../coordinates/coordinates.hpp"
+#include "../../eos/eos.hpp"
+#include "../../field/field.hpp"
+#include "../../globals.hpp"
+#include "../../mesh/global_reduction.hpp"
+#include "../../mesh/mesh.hpp"
+#include "../../parameter_input.hpp"
+#include "../../scalars/scalars.hpp"
+#include "../hydro.hpp"
+#include "sink_particles.hpp"
+
+#ifdef MPI_PARALLEL
+#include <mpi.h>
+#endif
+
+//----------------------------------------------------------------------------------------
+//! \fn SinkParticles::SinkParticles(Mesh *pm, ParameterInput *pin)
+//! \brief read the <sinks> block. The accretion radius defaults to 2 cells of the finest
+//!        refinement level, the softening length to the accretion radius.
+
+SinkParticles::SinkParticles(Mesh *pm, ParameterInput *pin) : pmy_mesh_(pm),
+    next_id_(), slot_(pm->preduce->Register(ReductionOp::sum, 1)), dt_(),
+    pending_(false) {
+  if (std::strcmp(COORDINATE_SYSTEM, "cartesian") != 0 || RELATIVISTIC_DYNAMICS) {
+    std::stringstream msg;
+    msg << "### FATAL ERROR in SinkParticles constructor" << std::endl
+        << "Sink particles only work in Newtonian dynamics with Cartesian coordinates."
+        << std::endl;
+    ATHENA_ERROR(msg);
+  }
+  RegionSize &ms = pm->mesh_size;
+  Real dx = (ms.x1max - ms.x1min)/ms.nx1;
+  if (pm->f2) dx = std::min(dx, (ms.x2max - ms.x2min)/ms.nx2);
+  if (pm->f3) dx = std::min(dx, (ms.x3max - ms.x3min)/ms.nx3);
+  if (pm->multilevel) dx /= static_cast<Real>(1 << (pm->max_level - pm->root_level));
+
+  gconst_ = pin->GetOrAddReal("sinks", "gconst", pm->four_pi_G_/(4.0*PI));
+  rho_thr_ = pin->GetReal("sinks", "rho_threshold");
+  r_acc_ = pin->GetOrAddReal("sinks", "r_acc", 2.0*dx);
+  eps_ = pin->GetOrAddReal("sinks", "softening", r_acc_);
+  jeans_cells_ = pin->GetOrAddReal("sinks", "jeans_cells", 4.0);
+  cfl_ = pin->GetOrAddReal("sinks", "cfl", 0.5);
+  max_sinks_ = pin->GetOrAddInteger("sinks", "max_sinks", 1024);
+  if (gconst_ <= 0.0 || rho_thr_ <= 0.0 || r_acc_ <= 0.0 || max_sinks_ < 1) {
+    std::stringstream msg;
+    msg << "### FATAL ERROR in SinkParticles constructor" << std::endl
+        << "<sinks> gconst, rho_threshold, r_acc and max_sinks must be positive; gconst"
+        << " defaults to the value set with SetGravitationalConstant/SetFourPiG."
+        << std::endl;
+    ATHENA_ERROR(msg);
+  }
+
+  const Real xmin[3] = {ms.x1min, ms.x2min, ms.x3min};
+  const Real xmax[3] = {ms.x1max, ms.x2max, ms.x3max};
+  for (int d=0; d<3; ++d) {
+    periodic_[d] = (pm->mesh_bcs[2*d] == BoundaryFlag::periodic);
+    len_[d] = xmax[d] - xmin[d];
+  }
+  sinks.reserve(max_sinks_);
+}
+
+//----------------------------------------------------------------------------------------
+//! \fn void SinkParticles::Update(const Real dt)
+//! \brief accrete onto the sinks over the step dt just taken and post the sums to
+//!        Mesh::preduce; the sinks are updated by FinishUpdate()
+
+void SinkParticles::Update(const Real dt) {
+  const int nsink = static_cast<int>(sinks.size());
+  std::vector<Real> sum(1 + kSumFields*nsink, 0.0);
+  if (nsink > 0) AccreteAndCouple(&sum[1]);
+  FindCandidates();
+  sum[0] = static_cast<Real>(cand_.size()/kCandFields);
+  GlobalReduction *pred = pmy_mesh_->preduce;
+  pred->Resize(slot_, static_cast<int>(sum.size()));
+  pred->Accumulate(slot_, sum.data());
+  dt_ = dt;
+  pending_ = true;
+  return;
+}
+
+//----------------------------------------------------------------------------------------
+//! \fn void SinkParticles::FinishUpdate()
+//! \brief add the reduced sums of Update() to the sinks, move them and create new sinks;
+//!        call after Mesh::preduce has completed (collective if there are candidates)
+
+void SinkParticles::FinishUpdate() {
+  if (!pending_) return;
+  pending_ = false;
+  GlobalReduction *pred = pmy_mesh_->preduce;
+  const int nsink = static_cast<int>(sinks.size());
+  if (nsink > 0) {
+    std::vector<Real> sum(kSumFields*nsink);
+    for (int n=0; n<kSumFields*nsink; ++n)
+      sum[n] = pred->Result(slot_, 1 + n);
+    AddToSinks(sum.data());
+    MoveSinks(dt_);
+  }
+  if (pred->Result(slot_, 0) > 0.0) CreateSinks();
+  cand_.clear();
+  return;
+}
+
+//----------------------------------------------------------------------------------------
+//! \fn Real SinkParticles::NewTimeStep() const
+//! \brief the sinks may neither cross their accretion radius nor change their velocity
+//!        by more than r_acc/dt in one step
+
+Real SinkParticles::NewTimeStep() const {
+  Real dt = std::numeric_limits<Real>::max();
+  for (const SinkParticle &s : sinks) {
+    Real vel = std::sqrt(SQR(s.v1) + SQR(s.v2) + SQR(s.v3));
+    Real acc = std::sqrt(SQR(s.a1) + SQR(s.a2) + SQR(s.a3));
+    if (vel > 0.0) dt = std::min(dt, r_acc_/vel);
+    if (acc > 0.0) dt = std::min(dt, std::sqrt(r_acc_/acc));
+  }
+  return cfl_*dt;
+}
+
+//----------------------------------------------------------------------------------------
+//! \fn Real SinkParticles::GetTotalMass() const
+//! \brief total mass locked up in sinks
+
+Real SinkParticles::GetTotalMass() const {
+  Real mass = 0.0;
+  for (const SinkParticle &s : sinks)
+    mass += s.m;
+  return mass;
+}
+
+//----------------------------------------------------------------------------------------
+//! \fn void SinkParticles::Acceleration(const Real x1, const Real x2, const Real x3,
+//!                                      Real acc[3]) const
+//! \brief Plummer-softened gravitational acceleration of all sinks at (x1,x2,x3)
+
+void SinkParticles::Acceleration(const Real x1, const Real x2, const Real x3,
+                                 Real acc[3]) const {
+  acc[0] = acc[1] = acc[2] = 0.0;
+  for (const SinkParticle &s : sinks) {
+    Real dx[3] = {s.x1 - x1, s.x2 - x2, s.x3 - x3};
+    Separation(dx);
+    Real r2 = SQR(dx[0]) + SQR(dx[1]) + SQR(dx[2]) + SQR(eps_);
+    Real gm_r3 = gconst_*s.m/(r2*std::sqrt(r2));
+    acc[0] += gm_r3*dx[0];
+    acc[1] += gm_r3*dx[1];
+    acc[2] += gm_r3*dx[2];
+  }
+  return;
+}
+
+//----------------------------------------------------------------------------------------
+//! \fn void SinkParticles::Separation(Real dx[3]) const
+//! \brief map a separation vector to the nearest periodic image
+
+void SinkParticles::Separation(Real dx[3]) const {
+  for (int d=0; d<3; ++d) {
+    if (periodic_[d]) {
+      if (dx[d] > 0.5*len_[d]) dx[d] -= len_[d];
+      else if (dx[d] < -0.5*len_[d]) dx[d] += len_[d];
+    }
+  }
+  return;
+}
+
+//----------------------------------------------------------------------------------------
+//! \fn int SinkParticles::NearestSink(const Real x1, const Real x2, const Real x3,
+//!                                    Real dx[3]) const
+//! \brief index of the nearest sink whose accretion radius contains (x1,x2,x3), or -1.
+//!        dx returns the separation from that sink.
+
+int SinkParticles::NearestSink(const Real x1, const Real x2, const Real x3,
+                               Real dx[3]) const {
+  int nearest = -1;
+  Real rmin2 = SQR(r_acc_);
+  for (int n=0; n<static_cast<int>(sinks.size()); ++n) {
+    Real d[3] = {x1 - sinks[n].x1, x2 - sinks[n].x2, x3 - sinks[n].x3};
+    Separation(d);
+    Real r2 = SQR(d[0]) + SQR(d[1]) + SQR(d[2]);
+    if (r2 <= rmin2) {
+      rmin2 = r2;
+      nearest = n;
+      dx[0] = d[0], dx[1] = d[1], dx[2] = d[2];
+    }
+  }
+  return nearest;
+}
+
+//----------------------------------------------------------------------------------------
+//! \fn bool SinkParticles::CreationCriteria(MeshBlock *pmb, const int k, const int j,
+//!                                          const int i) const
+//! \brief a cell above the density threshold may form a sink if it is a local density
+//!        maximum in converging flow whose Jeans length is not resolved by jeans_cells
+
+bool SinkParticles::CreationCriteria(MeshBlock *pmb, const int k, const int j,
+                                     const int i) const {
+  AthenaArray<Real> &w = pmb->phydro->w;
+  Coordinates *pco = pmb->pcoord;
+  const Real rho = w(IDN,k,j,i);
+  if (rho <= rho_thr_) return false;
+
+  const int dk = pmb->pmy_mesh->f3 ? 1 : 0, dj = pmb->pmy_mesh->f2 ? 1 : 0;
+  for (int kk=k-dk; kk<=k+dk; ++kk) {
+    for (int jj=j-dj; jj<=j+dj; ++jj) {
+      for (int ii=i-1; ii<=i+1; ++ii) {
+        if (w(IDN,kk,jj,ii) > rho) return false;
+      }
+    }
+  }
+
+  Real div_v = (w(IVX,k,j,i+1) - w(IVX,k,j,i-1))/(pco->x1v(i+1) - pco->x1v(i-1));
+  Real dx = pco->dx1f(i);
+  if (dj) {
+    div_v += (w(IVY,k,j+1,i) - w(IVY,k,j-1,i))/(pco->x2v(j+1) - pco->x2v(j-1));
+    dx = std::max(dx, pco->dx2f(j));
+  }
+  if (dk) {
+    div_v += (w(IVZ,k+1,j,i) - w(IVZ,k-1,j,i))/(pco->x3v(k+1) - pco->x3v(k-1));
+    dx = std::max(dx, pco->dx3f(k));
+  }
+  if (div_v >= 0.0) return false;
+
+  Real prim[NHYDRO];
+  for (int n=0; n<NHYDRO; ++n)
+    prim[n] = w(n,k,j,i);
+  Real cs2 = NON_BAROTROPIC_EOS ? SQR(pmb->peos->SoundSpeed(prim))
+                                : SQR(pmb->peos->GetIsoSoundSpeed());
+  Real jeans_length = std::sqrt(PI*cs2/(gconst_*rho));
+  return (jeans_length < jeans_cells_*dx);
+}
+
+//----------------------------------------------------------------------------------------
+//! \fn void SinkParticles::FindCandidates()
+//! \brief collect the cells of this rank that may form a sink
+
+void SinkParticles::FindCandidates() {
+  Real dxs[3];
+  cand_.clear();
+  for (int b=0; b<pmy_mesh_->nblocal; ++b) {
+    MeshBlock *pmb = pmy_mesh_->my_blocks(b);
+    AthenaArray<Real> &w = pmb->phydro->w;
+    Coordinates *pco = pmb->pcoord;
+    for (int k=pmb->ks; k<=pmb->ke; ++k) {
+      for (int j=pmb->js; j<=pmb->je; ++j) {
+        for (int i=pmb->is; i<=pmb->ie; ++i) {
+          if (w(IDN,k,j,i) <= rho_thr_
+              || NearestSink(pco->x1v(i), pco->x2v(j), pco->x3v(k), dxs) >= 0
+              || !CreationCriteria(pmb, k, j, i)) continue;
+          const Real c[kCandFields] = {w(IDN,k,j,i), pco->x1v(i), pco->x2v(j),
+                                       pco->x3v(k), w(IVX,k,j,i), w(IVY,k,j,i),
+                                       w(IVZ,k,j,i)};
+          cand_.insert(cand_.end(), c, c + kCandFields);
+        }
+      }
+    }
+  }
+  return;
+}
+
+//----------------------------------------------------------------------------------------
+//! \fn void SinkParticles::CreateSinks()
+//! \brief gather the candidate cells of all ranks and turn them into sinks, densest
+//!        first, unless they lie within the accretion radius of another sink (collective)
+
+void SinkParticles::CreateSinks() {
+  const int nfield = kCandFields;
+  std::vector<Real> cand(cand_);
+  Real dxs[3];
+#ifdef MPI_PARALLEL
+  int mycount = static_cast<int>(cand.size());
+  std::vector<int> counts(Globals::nranks), displs(Globals::nranks);
+  MPI_Allgather(&mycount, 1, MPI_INT, counts.data(), 1, MPI_INT, MPI_COMM_WORLD);
+  int total = 0;
+  for (int n=0; n<Globals::nranks; ++n) {
+    displs[n] = total;
+    total += counts[n];
+  }
+  if (total == 0) return;
+  std::vector<Real> all(total);
+  MPI_Allgatherv(cand.data(), mycount, MPI_ATHENA_REAL, all.data(), counts.data(),
+                 displs.data(), MPI_ATHENA_REAL, MPI_COMM_WORLD);
+  cand.swap(all);
+#endif
+  const int ncand = static_cast<int>(cand.size())/nfield;
+  if (ncand == 0) return;
+
+  // the gathered order is the same on all ranks, so is the stable sort
+  std::vector<int> order(ncand);
+  for (int n=0; n<ncand; ++n)
+    order[n] = n;
+  std::stable_sort(order.begin(), order.end(), [&cand](int a, int b) {
+    return cand[a*nfield] > cand[b*nfield];
+  });
+  for (int n : order) {
+    const Real *c = &cand[n*nfield];
+    if (NearestSink(c[1], c[2], c[3], dxs) >= 0) continue;
+    if (static_cast<int>(sinks.size()) >= max_sinks_) {
+      if (Globals::my_rank == 0) {
+        std::cout << "### Warning in SinkParticles::CreateSinks" << std::endl
+                  << "The maximum number of sinks (" << max_sinks_ << ") is reached; "
+                  << "increase <sinks> max_sinks." << std::endl;
+      }
+      break;
+    }
+    SinkParticle s = {next_id_++, 0.0, c[1], c[2], c[3], c[4], c[5], c[6],
+                      0.0, 0.0, 0.0};
+    sinks.push_back(s);
+  }
+  return;
+}
+
+//----------------------------------------------------------------------------------------
+//! \fn void SinkParticles::AccreteAndCouple(Real *sum)
+//! \brief threshold accretion and gravity of the gas on the sinks. Adds the mass, mass
+//!        moment and momentum removed from the active cells of this rank and the pull of
+//!        their gas to sum[kSumFields*nsink]
+//!
+//! Inside the accretion radius of its nearest sink, the density of a cell is reset to
+//! rho_threshold. Momentum, the hydrodynamic part of the energy and the passive scalars
+//! are removed in the same proportion, so velocity, specific internal energy and
+//! concentrations are unchanged. Ghost cells are updated the same way as the active
+//! cells they copy, so that the next step starts from consistent boundary values; only
+//! active cells are counted in the mass and momentum transferred to the sinks.
+
+void SinkParticles::AccreteAndCouple(Real *sum) {
+  const int nsink = static_cast<int>(sinks.size());
+  const int nsum = kSumFields;  // dm, dm*dx (3), dp (3), gravity of the gas (3)
+
+  for (int b=0; b<pmy_mesh_->nblocal; ++b) {
+    MeshBlock *pmb = pmy_mesh_->my_blocks(b);
+    AthenaArray<Real> &u = pmb->phydro->u, &w = pmb->phydro->w;
+    Coordinates *pco = pmb->pcoord;
+    for (int k=0; k<pmb->ncells3; ++k) {
+      for (int j=0; j<pmb->ncells2; ++j) {
+        for (int i=0; i<pmb->ncells1; ++i) {
+          const bool active = (k >= pmb->ks && k <= pmb->ke && j >= pmb->js
+                               && j <= pmb->je && i >= pmb->is && i <= pmb->ie);
+          const Real vol = pco->dx1f(i)*pco->dx2f(j)*pco->dx3f(k);
+          Real dx[3] = {0.0, 0.0, 0.0};
+          int n = NearestSink(pco->x1v(i), pco->x2v(j), pco->x3v(k), dx);
+          if (n >= 0 && w(IDN,k,j,i) > rho_thr_) {
+            Real f = rho_thr_/w(IDN,k,j,i);
+            Real df = 1.0 - f;
+            if (active) {
+              Real dm = df*u(IDN,k,j,i)*vol;
+              Real *ps = &sum[nsum*n];
+              ps[0] += dm;
+              ps[1] += dm*dx[0];
+              ps[2] += dm*dx[1];
+              ps[3] += dm*dx[2];
+              ps[4] += df*u(IM1,k,j,i)*vol;
+              ps[5] += df*u(IM2,k,j,i)*vol;
+              ps[6] += df*u(IM3,k,j,i)*vol;
+            }
+            u(IDN,k,j,i) *= f;
+            u(IM1,k,j,i) *= f;
+            u(IM2,k,j,i) *= f;
+            u(IM3,k,j,i) *= f;
+            w(IDN,k,j,i) *= f;
+            if (NON_BAROTROPIC_EOS) {
+              Real emag = 0.0;
+              if (MAGNETIC_FIELDS_ENABLED) {
+                AthenaArray<Real> &bcc = pmb->pfield->bcc;
+                emag = 0.5*(SQR(bcc(IB1,k,j,i)) + SQR(bcc(IB2,k,j,i))
+                            + SQR(bcc(IB3,k,j,i)));
+              }
+              u(IEN,k,j,i) = f*(u(IEN,k,j,i) - emag) + emag;
+              w(IPR,k,j,i) *= f;
+            }
+            for (int m=0; m<NSCALARS; ++m)
+              pmb->pscalars->s(m,k,j,i) *= f;
+          }
+          if (!active) continue;
+          // gravity of the (remaining) gas on every sink
+          Real dm = u(IDN,k,j,i)*vol;
+          for (int m=0; m<nsink; ++m) {
+            Real d[3] = {pco->x1v(i) - sinks[m].x1, pco->x2v(j) - sinks[m].x2,
+                         pco->x3v(k) - sinks[m].x3};
+            Separation(d);
+            Real r2 = SQR(d[0]) + SQR(d[1]) + SQR(d[2]) + SQR(eps_);
+            Real gm_r3 = gconst_*dm/(r2*std::sqrt(r2));
+            sum[nsum*m + 7] += gm_r3*d[0];
+            sum[nsum*m + 8] += gm_r3*d[1];
+            sum[nsum*m + 9] += gm_r3*d[2];
+          }
+        }
+      }
+    }
+  }
+
+  return;
+}
+
+//----------------------------------------------------------------------------------------
+//! \fn void SinkParticles::AddToSinks(const Real *sum)
+//! \brief add the mass and momentum accreted on all ranks to the sinks and set their
+//!        acceleration by the gas and the other sinks
+
+void SinkParticles::AddToSinks(const Real *sum) {
+  const int nsink = static_cast<int>(sinks.size());
+  const int nsum = kSumFields;
+  for (int n=0; n<nsink; ++n) {
+    SinkParticle &s = sinks[n];
+    const Real *ps = &sum[nsum*n];
+    Real m = s.m + ps[0];
+    if (m > 0.0) {
+      s.x1 += ps[1]/m;
+      s.x2 += ps[2]/m;
+      s.x3 += ps[3]/m;
+      s.v1 = (s.m*s.v1 + ps[4])/m;
+      s.v2 = (s.m*s.v2 + ps[5])/m;
+      s.v3 = (s.m*s.v3 + ps[6])/m;
+    }
+    s.m = m;
+    s.a1 = ps[7], s.a2 = ps[8], s.a3 = ps[9];
+  }
+
+  // sink-sink gravity
+  for (int n=0; n<nsink; ++n) {
+    for (int m=0; m<nsink; ++m) {
+      if (m == n) continue;
+      Real d[3] = {sinks[m].x1 - sinks[n].x1, sinks[m].x2 - sinks[n].x2,
+                   sinks[m].x3 - sinks[n].x3};
+      Separation(d);
+      Real r2 = SQR(d[0]) + SQR(d[1]) + SQR(d[2]) + SQR(eps_);
+      Real gm_r3 = gconst_*sinks[m].m/(r2*std::sqrt(r2));
+      sinks[n].a1 += gm_r3*d[0];
+      sinks[n].a2 += gm_r3*d[1];
+      sinks[n].a3 += gm_r3*d[2];
+    }
+  }
+  return;
+}
+
+//----------------------------------------------------------------------------------------
+//! \fn void SinkParticles::MoveSinks(const Real dt)
+//! \brief kick-drift of the sinks; periodic images are wrapped, sinks leaving through
+//!        other boundaries are removed
+
+void SinkParticles::MoveSinks(const Real dt) {
+  RegionSize &ms = pmy_mesh_->mesh_size;
+  const Real xmin[3] = {ms.x1min, ms.x2min, ms.x3min};
+  const Real xmax[3] = {ms.x1max, ms.x2max, ms.x3max};
+  const bool active_dir[3] = {true, pmy_mesh_->f2, pmy_mesh_->f3};
+  std::vector<SinkParticle> kept;
+  kept.reserve(sinks.size());
+  for (SinkParticle &s : sinks) {
+    s.v1 += dt*s.a1;
+    s.v2 += dt*s.a2;
+    s.v3 += dt*s.a3;
+    Real x[3] = {s.x1 + dt*s.v1, s.x2 + dt*s.v2, s.x3 + dt*s.v3};
+    bool inside = true;
+    for (int d=0; d<3; ++d) {
+      if (!active_dir[d]) {
+        x[d] = (d == 0) ? s.x1 : ((d == 1) ? s.x2 : s.x3);
+        continue;
+      }
+      if (periodic_[d]) {
+        if (x[d] >= xmax[d]) x[d] -= len_[d];
+        else if (x[d] < xmin[d]) x[d] += len_[d];
+      } else if (x[d] < xmin[d] || x[d] > xmax[d]) {
+        inside = false;
+      }
+    }
+    s.x1 = x[0], s.x2 = x[1], s.x3 = x[2];
+    if (inside) {
+      kept.push_back(s);
+    } else if (Globals::my_rank == 0) {
+      std::cout << "### Warning in SinkParticles::MoveSinks" << std::endl
+                << "Sink " << s.id << " with mass " << s.m << " left the domain at time "
+                << pmy_mesh_->time << " and is removed." << std::endl;
+    }
+  }
+  sinks.swap(kept);
+  return;
+}
+
+//----------------------------------------------------------------------------------------
+//! \fn IOWrapperSizeT SinkParticles::GetRestartRecordSizeInBytes() const
+//! \brief Size of the sink record in the restart file
+//!
+//! Record layout: layout key, next id, ids[max_sinks], Real fields[max_sinks][10].
+//! The record is written once (by rank 0) since the list is the same on all ranks.
+
+IOWrapperSizeT SinkParticles::GetRestartRecordSizeInBytes() const {
+  return kRestartKeys*sizeof(std::int64_t)
+         + max_sinks_*(sizeof(std::int64_t) + kRealFields*sizeof(Real));
+}
+
+//----------------------------------------------------------------------------------------
+//! \fn void SinkParticles::WriteRestartState(IOWrapper &resfile, IOWrapperSizeT offset)
+//! \brief Write the sink list (collective)
+
+void SinkParticles::WriteRestartState(IOWrapper &resfile, IOWrapperSizeT offset) {
+  IOWrapperSizeT recsize = GetRestartRecordSizeInBytes();
+  char *rec = new char[recsize]();
+  char *pdata = rec;
+
+  std::int64_t key[kRestartKeys] = {static_cast<std::int64_t>(recsize), max_sinks_,
+                                    static_cast<std::int64_t>(sinks.size()), next_id_};
+  std::memcpy(pdata, key, sizeof(key));
+  pdata += sizeof(key);
+  for (const SinkParticle &s : sinks) {
+    std::memcpy(pdata, &s.id, sizeof(std::int64_t));
+    pdata += sizeof(std::int64_t);
+  }
+  pdata = rec + sizeof(key) + max_sinks_*sizeof(std::int64_t);
+  for (const SinkParticle &s : sinks) {
+    const Real f[kRealFields] = {s.m, s.x1, s.x2, s.x3, s.v1, s.v2, s.v3,
+                                 s.a1, s.a2, s.a3};
+    std::memcpy(pdata, f, sizeof(f));
+    pdata += sizeof(f);
+  }
+
+  resfile.Write_at_all(rec, recsize, (Globals::my_rank == 0) ? 1 : 0, offset);
+  delete [] rec;
+  return;
+}
+
+//----------------------------------------------------------------------------------------
+//! \fn void SinkParticles::ReadRestartState(IOWrapper &resfile, IOWrapperSizeT offset)
+//! \brief Restore the sink list (collective). Starts without sinks, with a warning, if
+//!        the restart file ends with the MeshBlock data (sinks enabled on restart); a
+//!        record that does not match <sinks> is a fatal error.
+
+void SinkParticles::ReadRestartState(IOWrapper &resfile, IOWrapperSizeT offset) {
+  IOWrapperSizeT recsize = GetRestartRecordSizeInBytes();
+  char *rec = new char[recsize]();
+  char *pdata = rec;
+
+  int found = (resfile.Read_at_all(rec, recsize, 1, offset) == 1);
+  std::int64_t key[kRestartKeys];
+  std::memcpy(key, pdata, sizeof(key));
+  pdata += sizeof(key);
+  int valid = found && key[0] == static_cast<std::int64_t>(recsize)
+              && key[1] == max_sinks_ && key[2] >= 0 && key[2] <= max_sinks_;
+#ifdef MPI_PARALLEL
+  int flags[2] = {found, valid};
+  MPI_Allreduce(MPI_IN_PLACE, flags, 2, MPI_INT, MPI_MIN, MPI_COMM_WORLD);
+  found = flags[0], valid = flags[1];
+#endif
+  if (!found) {
+    if (Globals::my_rank == 0) {
+      std::cout << "### Warning in SinkParticles::ReadRestartState" << std::endl
+                << "No sink particle record in the restart file; "
+                << "the run continues without sinks." << std::endl;
+    }
+    delete [] rec;
+    return;
+  }
+  if (!valid) {
+    delete [] rec;
+    std::stringstream msg;
+    msg << "### FATAL ERROR in SinkParticles::ReadRestartState" << std::endl
+        << "The sink particle record in the restart file does not match <sinks>; "
+        << "max_sinks must not be changed on restart." << std::endl;
+    ATHENA_ERROR(msg);
+  }
+
+  next_id_ = key[3];
+  sinks.resize(key[2]);
+  for (SinkParticle &s : sinks) {
+    std::memcpy(&s.id, pdata, sizeof(std::int64_t));
+    pdata += sizeof(std::int64_t);
+  }
+  pdata = rec + sizeof(key) + max_sinks_*sizeof(std::int64_t);
+  for (SinkParticle &s : sinks) {
+    Real f[kRealFields];
+    std::memcpy(f, pdata, sizeof(f));
+    pdata += sizeof(f);
+    s.m = f[0], s.x1 = f[1], s.x2 = f[2], s.x3 = f[3];
+    s.v1 = f[4], s.v2 = f[5], s.v3 = f[6];
+    s.a1 = f[7], s.a2 = f[8], s.a3 = f[9];
+  }
+  delete [] rec;
+  return;
+}
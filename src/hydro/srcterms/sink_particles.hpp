@@ -0,0 +1,97 @@
+#ifndef HYDRO_SRCTERMS_SINK_PARTICLES_HPP_
+#define HYDRO_SRCTERMS_SINK_PARTICLES_HPP_
+//========================================================================================
+// Athena++ astrophysical MHD code
+// Copyright(C) 2014 James M. Stone <jmstone@princeton.edu> and other code contributors
+// Licensed under the 3-clause BSD License, see LICENSE file for details
+//========================================================================================
+//! \file sink_particles.hpp
+//! \brief defines class SinkParticles
+//!
+//! Sink particles replace gravitationally collapsing gas that is no longer resolved
+//! (Federrath et al. 2010). The list of sinks is small and identical on every rank, so
+//! each rank applies the sinks to the cells it owns and particles never have to be
+//! handed over between MeshBlocks or ranks.
+
+// C headers
+
+// C++ headers
+#include <cstdint>  // int64_t
+#include <vector>
+
+// Athena++ headers
+#include "../../athena.hpp"
+#include "../../outputs/io_wrapper.hpp"
+
+// Forward declarations
+class Mesh;
+class MeshBlock;
+class ParameterInput;
+
+//! \struct SinkParticle
+//! \brief state of a single sink particle
+
+struct SinkParticle {
+  std::int64_t id;
+  Real m;                 // mass
+  Real x1, x2, x3;        // position
+  Real v1, v2, v3;        // velocity
+  Real a1, a2, a3;        // acceleration at the last update (for the time step)
+};
+
+//! \class SinkParticles
+//! \brief creation, accretion and dynamics of sink particles (Cartesian only)
+
+class SinkParticles {
+  friend class MeshCheckpoint;
+
+ public:
+  SinkParticles(Mesh *pm, ParameterInput *pin);
+
+  // data
+  std::vector<SinkParticle> sinks;  // same list on every rank
+
+  // functions
+  void Update(const Real dt);
+  void FinishUpdate();
+  Real NewTimeStep() const;
+  Real GetTotalMass() const;
+  void Acceleration(const Real x1, const Real x2, const Real x3, Real acc[3]) const;
+  // sink list stored right after the MeshBlock data in restarts
+  IOWrapperSizeT GetRestartRecordSizeInBytes() const;
+  void WriteRestartState(IOWrapper &resfile, IOWrapperSizeT offset);
+  void ReadRestartState(IOWrapper &resfile, IOWrapperSizeT offset);
+
+ private:
+  static constexpr int kRestartKeys = 4;
+  static constexpr int kRealFields = 10;  // m, x, v, a
+  static constexpr int kSumFields = 10;   // dm, dm*dx, dp, gravity of the gas
+  static constexpr int kCandFields = 7;   // rho, x, v of a candidate cell
+
+  Mesh *pmy_mesh_;
+  Real gconst_;       // gravitational constant
+  Real rho_thr_;      // density threshold for creation and accretion
+  Real r_acc_;        // accretion radius
+  Real eps_;          // gravitational softening length
+  Real jeans_cells_;  // cells per Jeans length below which gas may form a sink
+  Real cfl_;          // safety factor of the sink time step
+  int max_sinks_;
+  std::int64_t next_id_;
+  bool periodic_[3];
+  Real len_[3];
+  // state between Update() and FinishUpdate()
+  int slot_;                // Mesh::preduce slot: candidates, sums of AccreteAndCouple
+  Real dt_;
+  bool pending_;
+  std::vector<Real> cand_;  // candidate cells of this rank, kCandFields each
+
+  void FindCandidates();
+  void CreateSinks();
+  void AccreteAndCouple(Real *sum);
+  void AddToSinks(const Real *sum);
+  void MoveSinks(const Real dt);
+  bool CreationCriteria(MeshBlock *pmb, const int k, const int j, const int i) const;
+  int NearestSink(const Real x1, const Real x2, const Real x3, Real dx[3]) const;
+  void Separation(Real dx[3]) const;
+};
+#endif // HYDRO_SRCTERMS_SINK_PARTICLES_HPP_
@@ -38,7 +38,12 @@
 #include "globals.hpp"
 #include "gravity/fft_gravity.hpp"
 #include "gravity/mg_gravity.hpp"
+#include "hydro/hydro_diffusion/mg_conduction.hpp"
+#include "hydro/srcterms/physics_modules.hpp"
+#include "hydro/srcterms/sink_particles.hpp"
 #include "mesh/mesh.hpp"
+#include "mesh/mesh_checkpoint.hpp"
+#include "outputs/analysis.hpp"
 #include "outputs/io_wrapper.hpp"
 #include "outputs/outputs.hpp"
 #include "parameter_input.hpp"
@@ -263,6 +268,9 @@ int main(int argc, char *argv[]) {
   //--- Step 4. --------------------------------------------------------------------------
   // Construct and initialize Mesh
 
+  // event counters used in place of per-cell output (before pgens add categories)
+  RuntimeDiagnostics::Initialize(pinput);
+
   Mesh *pmesh;
 #ifdef ENABLE_EXCEPTIONS
   try {
@@ -389,12 +397,17 @@ int main(int argc, char *argv[]) {
   // Change to run directory, initialize outputs object, and make output of ICs
 
   Outputs *pouts;
+  AnalysisPlugins *panalysis;
 #ifdef ENABLE_EXCEPTIONS
   try {
 #endif
     ChangeRunDir(prundir);
     pouts = new Outputs(pmesh, pinput);
-    if (res_flag == 0) pouts->MakeOutputs(pmesh, pinput);
+    panalysis = new AnalysisPlugins(pmesh, pinput);
+    if (res_flag == 0) {
+      pouts->MakeOutputs(pmesh, pinput);
+      panalysis->Execute(pmesh);
+    }
 #ifdef ENABLE_EXCEPTIONS
   }
   catch(std::bad_alloc& ba) {
@@ -432,6 +445,9 @@ int main(int argc, char *argv[]) {
     if (Globals::my_rank == 0)
       pmesh->OutputCycleDiagnostics();
 
+    // in-memory copy of the state to roll back to if a later cycle fails
+    if (pmesh->pckpt != nullptr) pmesh->pckpt->Save();
+
     if (STS_ENABLED) {
       pmesh->sts_loc = TaskType::op_split_before;
       // compute nstages for this STS
@@ -456,6 +472,10 @@ int main(int argc, char *argv[]) {
 
     if (pmesh->turb_flag > 1) pmesh->ptrbd->Driving(); // driven turbulence
 
+    // operator-split physics modules applied before the hydro step
+    if (pmesh->pphys->ApplySplitModules(PhysicsStage::before_step))
+      pmesh->RefreshGhostCells(pmesh->time);
+
     for (int stage=1; stage<=ptlist->nstages; ++stage) {
       ptlist->DoTaskListOneStage(pmesh, stage);
       if (ptlist->CheckNextMainStage(stage)) {
@@ -473,8 +493,39 @@ int main(int argc, char *argv[]) {
         pststlist->DoTaskListOneStage(pmesh, stage);
     }
 
+    // the operator-split updates below change u and w in the active cells only; if any
+    // of them ran, the ghost cells are exchanged again and the MeshBlock time steps
+    // (evaluated at the end of the task list) are computed from the updated state
+    bool split_update = false;
+
+    // implicit thermal conduction (operator split)
+    if (pmesh->pmgcd != nullptr) {
+      pmesh->pmgcd->Update(pmesh->dt);
+      split_update = true;
+    }
+
+    // sink particles: accretion (operator split); the sinks are moved and created once
+    // their sums have been reduced with the new time step, in Mesh::NewTimeStep()
+    if (pmesh->psinks != nullptr) {
+      pmesh->psinks->Update(pmesh->dt);
+      split_update = true;
+    }
+
+    // operator-split physics modules applied after the hydro step
+    if (pmesh->pphys->ApplySplitModules(PhysicsStage::after_step))
+      split_update = true;
+
+    if (split_update) pmesh->RefreshGhostCells(pmesh->time + pmesh->dt);
+
+    // post the global reduction of the new time step (and of any other registered
+    // slots); it overlaps with the rest of the cycle and completes in NewTimeStep()
+    pmesh->StartNewTimeStep(split_update);
+
     pmesh->UserWorkInLoop();
 
+    // retry from the last checkpoint (with reduced CFL) if this cycle failed
+    if (pmesh->pckpt != nullptr && pmesh->pckpt->CheckAndRollback()) continue;
+
     pmesh->ncycle++;
     pmesh->time += pmesh->dt;
     mbcnt += pmesh->nbtotal;
@@ -484,11 +535,15 @@ int main(int argc, char *argv[]) {
 
     pmesh->NewTimeStep();
 
+    // summary of the events counted during the cycle(s), e.g. bad cells
+    RuntimeDiagnostics::Report(pmesh->preduce, pmesh->ncycle, pmesh->time, false);
+
 #ifdef ENABLE_EXCEPTIONS
     try {
 #endif
       if (pmesh->time < pmesh->tlim) // skip the final output as it happens later
         pouts->MakeOutputs(pmesh,pinput);
+      panalysis->Execute(pmesh);
 #ifdef ENABLE_EXCEPTIONS
     }
     catch(std::bad_alloc& ba) {
@@ -524,6 +579,7 @@ int main(int argc, char *argv[]) {
 
   if (Globals::my_rank == 0)
     pmesh->OutputCycleDiagnostics();
+  RuntimeDiagnostics::Report(pmesh->preduce, pmesh->ncycle, pmesh->time, true);
 
   pmesh->UserWorkAfterLoop(pinput);
 
@@ -531,6 +587,7 @@ int main(int argc, char *argv[]) {
   try {
 #endif
     pouts->MakeOutputs(pmesh,pinput,true);
+    panalysis->Execute(pmesh, true);
 #ifdef ENABLE_EXCEPTIONS
   }
   catch(std::bad_alloc& ba) {
@@ -573,6 +630,9 @@ int main(int argc, char *argv[]) {
       std::cout << std::endl << "Number of MeshBlocks = " << pmesh->nbtotal
                 << "; " << pmesh->nbnew << "  created, " << pmesh->nbdel
                 << " destroyed during this simulation." << std::endl;
+      if (pmesh->nbdenied > 0)
+        std::cout << "Refinement requests denied by the AMR budget: "
+                  << pmesh->nbdenied << " (counted at every regrid)" << std::endl;
     }
 
     // Calculate and print the zone-cycles/cpu-second and wall-second
@@ -600,6 +660,7 @@ int main(int argc, char *argv[]) {
   delete pmesh;
   delete ptlist;
   delete pouts;
+  delete panalysis;
 
 #ifdef MPI_PARALLEL
   MPI_Finalize();
@@ -9,11 +9,13 @@
 // C headers
 
 // C++ headers
-#include <algorithm>  // std::sort()
+#include <algorithm>  // std::min(), std::sort(), std::stable_sort()
+#include <cmath>      // std::floor()
 #include <cstdint>
 #include <iostream>
 #include <limits>
 #include <sstream>
+#include <vector>
 
 // Athena++ headers
 #include "../athena.hpp"
@@ -21,6 +23,7 @@
 #include "../field/field.hpp"
 #include "../globals.hpp"
 #include "../hydro/hydro.hpp"
+#include "../parameter_input.hpp"
 #include "../utils/buffer_utils.hpp"
 #include "mesh.hpp"
 #include "mesh_refinement.hpp"
@@ -169,6 +172,36 @@ void Mesh::UpdateCostList() {
   }
 }
 
+//----------------------------------------------------------------------------------------
+//! \fn void Mesh::SetAMRBudget(ParameterInput *pin)
+//! \brief read the budget of AMR from <mesh>: max_blocks_per_rank (on average over the
+//!        ranks) and/or max_cells, both <= 0 for no limit. It caps the total number of
+//!        MeshBlocks; refinements beyond it are denied in UpdateMeshBlockTree().
+
+void Mesh::SetAMRBudget(ParameterInput *pin) {
+  int max_blocks_per_rank = pin->GetOrAddInteger("mesh", "max_blocks_per_rank", -1);
+  Real max_cells = pin->GetOrAddReal("mesh", "max_cells", -1.0);
+  double budget = std::numeric_limits<int>::max();
+  if (max_blocks_per_rank > 0)
+    budget = std::min(budget, static_cast<double>(max_blocks_per_rank)*Globals::nranks);
+  if (max_cells > 0.0) {
+    double block_cells = static_cast<double>(mesh_size.nx1/nrbx1)
+                         *(mesh_size.nx2/nrbx2)*(mesh_size.nx3/nrbx3);
+    budget = std::min(budget, std::floor(max_cells/block_cells));
+  }
+  max_nbtotal_ = (max_blocks_per_rank > 0 || max_cells > 0.0) ?
+                 static_cast<int>(budget) : -1;
+  if (max_nbtotal_ >= 0 && nbtotal >= max_nbtotal_ && Globals::my_rank == 0) {
+    std::cout << "### Warning in Mesh::SetAMRBudget" << std::endl
+              << "The mesh already has " << nbtotal << " MeshBlocks, at or beyond the "
+              << "budget of " << max_nbtotal_ << " set by max_blocks_per_rank and/or "
+              << "max_cells in <mesh>;" << std::endl
+              << "no refinement will be performed until derefinement frees room."
+              << std::endl;
+  }
+  return;
+}
+
 //----------------------------------------------------------------------------------------
 //! \fn void Mesh::UpdateMeshBlockTree(int &nnew, int &ndel)
 //! \brief collect refinement flags and manipulate the MeshBlockTree
@@ -220,19 +253,26 @@ void Mesh::UpdateMeshBlockTree(int &nnew, int &ndel) {
 
   // allocate memory for the location arrays
   LogicalLocation *lref{}, *lderef{}, *clderef{};
-  if (tnref > 0)
+  Real *iref{};
+  if (tnref > 0) {
     lref = new LogicalLocation[tnref];
+    if (max_nbtotal_ >= 0)
+      iref = new Real[tnref];
+  }
   if (tnderef >= nleaf) {
     lderef = new LogicalLocation[tnderef];
     clderef = new LogicalLocation[tnderef/nleaf];
   }
 
   // collect the locations and costs
-  int iref = rdisp[Globals::my_rank], ideref = ddisp[Globals::my_rank];
+  int nr = rdisp[Globals::my_rank], ideref = ddisp[Globals::my_rank];
   for (int i=0; i<nblocal; ++i) {
     MeshBlock *pmb = my_blocks(i);
-    if (pmb->pmr->refine_flag_ ==  1)
-      lref[iref++] = pmb->loc;
+    if (pmb->pmr->refine_flag_ ==  1) {
+      if (max_nbtotal_ >= 0)
+        iref[nr] = pmb->pmr->refine_indicator_;
+      lref[nr++] = pmb->loc;
+    }
     if (pmb->pmr->refine_flag_ == -1 && tnderef >= nleaf)
       lderef[ideref++] = pmb->loc;
   }
@@ -240,6 +280,9 @@ void Mesh::UpdateMeshBlockTree(int &nnew, int &ndel) {
   if (tnref > 0) {
     MPI_Allgatherv(MPI_IN_PLACE, bnref[Globals::my_rank],   MPI_BYTE,
                    lref,   bnref,   brdisp, MPI_BYTE, MPI_COMM_WORLD);
+    if (max_nbtotal_ >= 0)
+      MPI_Allgatherv(MPI_IN_PLACE, nref[Globals::my_rank], MPI_ATHENA_REAL,
+                     iref, nref, rdisp, MPI_ATHENA_REAL, MPI_COMM_WORLD);
   }
   if (tnderef >= nleaf) {
     MPI_Allgatherv(MPI_IN_PLACE, bnderef[Globals::my_rank], MPI_BYTE,
@@ -292,9 +335,44 @@ void Mesh::UpdateMeshBlockTree(int &nnew, int &ndel) {
   // Now the lists of the blocks to be refined and derefined are completed
   // Start tree manipulation
   // Step 1. perform refinement
-  for (int n=0; n<tnref; n++) {
-    MeshBlockTree *bt=tree.FindMeshBlock(lref[n]);
-    bt->Refine(nnew);
+  if (max_nbtotal_ < 0) {
+    for (int n=0; n<tnref; n++) {
+      MeshBlockTree *bt=tree.FindMeshBlock(lref[n]);
+      bt->Refine(nnew);
+    }
+  } else if (tnref > 0) {
+    // within the budget, refine in decreasing order of the refinement indicator. The
+    // check assumes nleaf-1 new blocks per refinement, so the blocks added to keep the
+    // 2:1 level ratio may exceed the budget by a few blocks.
+    std::vector<int> order(tnref);
+    for (int n=0; n<tnref; n++)
+      order[n] = n;
+    std::stable_sort(order.begin(), order.end(),
+                     [iref](int a, int b) {return iref[a] > iref[b];});
+    int ndenied = 0;
+    Real max_denied = 0.0;
+    for (int n : order) {
+      MeshBlockTree *bt=tree.FindMeshBlock(lref[n]);
+      if (bt->pleaf_ != nullptr) continue;  // already refined for the 2:1 ratio
+      if (nbtotal + nnew + nleaf - 1 > max_nbtotal_) {
+        if (ndenied == 0) max_denied = iref[n];
+        ndenied++;
+        continue;
+      }
+      bt->Refine(nnew);
+    }
+    if (ndenied > 0) {
+      if (Globals::my_rank == 0 && (nbdenied == 0 || (ncycle_out > 0
+                                                      && ncycle % ncycle_out == 0))) {
+        std::cout << "### Warning in Mesh::UpdateMeshBlockTree" << std::endl
+                  << "AMR budget of " << max_nbtotal_ << " MeshBlocks reached at cycle "
+                  << ncycle << ": " << ndenied << " of " << tnref
+                  << " refinements denied (largest denied indicator "
+                  << max_denied << ")" << std::endl;
+      }
+      nbdenied += ndenied;
+    }
+    delete [] iref;
   }
   if (tnref != 0)
     delete [] lref;
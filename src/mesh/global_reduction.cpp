@@ -0,0 +1,275 @@
+//========================================================================================
+// Athena++ astrophysical MHD code
+// Copyright(C) 2014 James M. Stone <jmstone@princeton.edu> and other code contributors
+// Licensed under the 3-clause BSD License, see LICENSE file for details
+//========================================================================================
+//! \file global_reduction.cpp
+//! \brief batched non-blocking global reductions
+//!
+//! All slots are packed into one buffer [nsum, nloc, sums..., minloc..., maxima...,
+//! -minima...] that is reduced as a single element of a contiguous datatype with a
+//! user-defined operation, so that one MPI_Iallreduce serves every slot regardless of
+//! its operation. Each minloc slot is packed as [n, key, values...]. A typical
+//! use is to accumulate during the task list, Start() after it and Finish() at the point
+//! where the results are first needed, e.g. Mesh::NewTimeStep().
+
+// C headers
+
+// C++ headers
+#include <algorithm>  // copy, max, min
+#include <limits>     // numeric_limits
+#include <sstream>    // stringstream
+#include <stdexcept>  // runtime_error
+#include <string>
+
+// Athena++ headers
+#include "../athena.hpp"
+#include "global_reduction.hpp"
+
+#ifdef MPI_PARALLEL
+#include <mpi.h>
+#endif
+
+namespace {
+//----------------------------------------------------------------------------------------
+//! \fn Real Identity(ReductionOp op, int i)
+//! \brief initial value of value i of a slot reduced with op
+
+Real Identity(ReductionOp op, int i = 0) {
+  if (op == ReductionOp::min || (op == ReductionOp::minloc && i == 0))
+    return std::numeric_limits<Real>::max();
+  if (op == ReductionOp::max) return std::numeric_limits<Real>::lowest();
+  return 0.0;
+}
+
+#ifdef MPI_PARALLEL
+//----------------------------------------------------------------------------------------
+//! \fn void CombineSlots(void *in, void *inout, int *len, MPI_Datatype *type)
+//! \brief user-defined MPI operation: sum of the first nsum values, the minloc slots
+//!        with the smaller key, max of the rest
+
+void CombineSlots(void *in, void *inout, int *len, MPI_Datatype *type) {
+  int size;
+  MPI_Type_size(*type, &size);
+  int n = size/static_cast<int>(sizeof(Real));
+  const Real *a = static_cast<const Real *>(in);
+  Real *b = static_cast<Real *>(inout);
+  for (int e=0; e<*len; ++e, a+=n, b+=n) {
+    int nsum = static_cast<int>(a[0]), nloc = static_cast<int>(a[1]);
+    for (int i=2; i<nsum+2; ++i)
+      b[i] += a[i];
+    for (int i=nsum+2; i<nsum+nloc+2; ) {
+      int m = static_cast<int>(a[i]);
+      if (a[i+1] < b[i+1]) std::copy(a + i + 1, a + i + 1 + m, b + i + 1);
+      i += m + 1;
+    }
+    for (int i=nsum+nloc+2; i<n; ++i)
+      b[i] = std::max(b[i], a[i]);
+  }
+  return;
+}
+#endif
+} // namespace
+
+//----------------------------------------------------------------------------------------
+//! \fn GlobalReduction::GlobalReduction()
+//! \brief constructor; duplicates MPI_COMM_WORLD so that pending reductions do not
+//!        interfere with other collectives
+
+GlobalReduction::GlobalReduction() : nsum_(0), nloc_(0), buf_(2), pending_(false) {
+#ifdef MPI_PARALLEL
+  MPI_Comm_dup(MPI_COMM_WORLD, &comm_);
+  MPI_Op_create(CombineSlots, 1, &op_);
+  type_ = MPI_DATATYPE_NULL;
+  ntype_ = 0;
+  req_ = MPI_REQUEST_NULL;
+#endif
+}
+
+//----------------------------------------------------------------------------------------
+//! \fn GlobalReduction::~GlobalReduction()
+//! \brief destructor
+
+GlobalReduction::~GlobalReduction() {
+#ifdef MPI_PARALLEL
+  if (pending_) MPI_Wait(&req_, MPI_STATUS_IGNORE);
+  if (type_ != MPI_DATATYPE_NULL) MPI_Type_free(&type_);
+  MPI_Op_free(&op_);
+  MPI_Comm_free(&comm_);
+#endif
+}
+
+//----------------------------------------------------------------------------------------
+//! \fn int GlobalReduction::Register(ReductionOp op, int n)
+//! \brief add a slot of n values reduced with op and return its index. Completes a
+//!        pending reduction first.
+
+int GlobalReduction::Register(ReductionOp op, int n) {
+  if (n < 1) {
+    std::stringstream msg;
+    msg << "### FATAL ERROR in GlobalReduction::Register" << std::endl
+        << "A slot must hold at least one value (n = " << n << ")." << std::endl;
+    ATHENA_ERROR(msg);
+  }
+  Finish();
+  Slot s;
+  s.op = op;
+  s.n = n;
+  s.offset = static_cast<int>(local_.size());
+  slots_.push_back(s);
+  local_.resize(s.offset + n);
+  result_.resize(s.offset + n);
+  for (int i=0; i<n; ++i) {
+    local_[s.offset+i] = Identity(op, i);
+    result_[s.offset+i] = Identity(op, i);
+  }
+  Layout();
+  return static_cast<int>(slots_.size()) - 1;
+}
+
+//----------------------------------------------------------------------------------------
+//! \fn void GlobalReduction::Resize(int slot, int n)
+//! \brief change the number of values of a slot, e.g. a list that grows during the run.
+//!        Kept values are preserved, new ones are set to the identity. Completes a
+//!        pending reduction first.
+
+void GlobalReduction::Resize(int slot, int n) {
+  if (n < 1) {
+    std::stringstream msg;
+    msg << "### FATAL ERROR in GlobalReduction::Resize" << std::endl
+        << "A slot must hold at least one value (n = " << n << ")." << std::endl;
+    ATHENA_ERROR(msg);
+  }
+  Finish();
+  Slot &s = slots_[slot];
+  if (n == s.n) return;
+  std::vector<Real>::iterator lend = local_.begin() + s.offset + s.n,
+                              rend = result_.begin() + s.offset + s.n;
+  if (n > s.n) {
+    local_.insert(lend, n - s.n, Identity(s.op, s.n));
+    result_.insert(rend, n - s.n, Identity(s.op, s.n));
+  } else {
+    local_.erase(lend - (s.n - n), lend);
+    result_.erase(rend - (s.n - n), rend);
+  }
+  int shift = n - s.n;
+  s.n = n;
+  for (int m=slot+1; m<static_cast<int>(slots_.size()); ++m)
+    slots_[m].offset += shift;
+  Layout();
+  return;
+}
+
+//----------------------------------------------------------------------------------------
+//! \fn void GlobalReduction::Layout()
+//! \brief count the values of the sum and minloc slots and size the packed buffer
+
+void GlobalReduction::Layout() {
+  nsum_ = 0, nloc_ = 0;
+  int nsize = 0;
+  for (const Slot &s : slots_) {
+    if (s.op == ReductionOp::sum) nsum_ += s.n;
+    if (s.op == ReductionOp::minloc) nloc_ += s.n + 1, nsize++;
+  }
+  buf_.resize(2 + local_.size() + nsize);
+  return;
+}
+
+//----------------------------------------------------------------------------------------
+//! \fn void GlobalReduction::Accumulate(int slot, const Real *val)
+//! \brief combine the n values of a slot with the local values; may be called from the
+//!        threads of the task list
+
+void GlobalReduction::Accumulate(int slot, const Real *val) {
+  const Slot &s = slots_[slot];
+  Real *p = &local_[s.offset];
+#pragma omp critical (global_reduction)
+  {
+    if (s.op == ReductionOp::sum) {
+      for (int i=0; i<s.n; ++i) p[i] += val[i];
+    } else if (s.op == ReductionOp::min) {
+      for (int i=0; i<s.n; ++i) p[i] = std::min(p[i], val[i]);
+    } else if (s.op == ReductionOp::minloc) {
+      if (val[0] < p[0]) std::copy(val, val + s.n, p);
+    } else {
+      for (int i=0; i<s.n; ++i) p[i] = std::max(p[i], val[i]);
+    }
+  }
+  return;
+}
+
+//----------------------------------------------------------------------------------------
+//! \fn void GlobalReduction::ResetLocal()
+//! \brief set the local values to the identity of their operation
+
+void GlobalReduction::ResetLocal() {
+  for (const Slot &s : slots_) {
+    for (int i=0; i<s.n; ++i) local_[s.offset+i] = Identity(s.op, i);
+  }
+  return;
+}
+
+//----------------------------------------------------------------------------------------
+//! \fn void GlobalReduction::Start()
+//! \brief pack the local values of all slots and post the reduction. A reduction that is
+//!        still pending is completed first.
+
+void GlobalReduction::Start() {
+  Finish();
+  int isum = 2, iloc = nsum_ + 2, imax = nsum_ + nloc_ + 2;
+  buf_[0] = static_cast<Real>(nsum_);
+  buf_[1] = static_cast<Real>(nloc_);
+  for (const Slot &s : slots_) {
+    const Real *p = &local_[s.offset];
+    if (s.op == ReductionOp::sum) {
+      for (int i=0; i<s.n; ++i) buf_[isum++] = p[i];
+    } else if (s.op == ReductionOp::minloc) {
+      buf_[iloc++] = static_cast<Real>(s.n);
+      for (int i=0; i<s.n; ++i) buf_[iloc++] = p[i];
+    } else if (s.op == ReductionOp::max) {
+      for (int i=0; i<s.n; ++i) buf_[imax++] = p[i];
+    } else {
+      for (int i=0; i<s.n; ++i) buf_[imax++] = -p[i];
+    }
+  }
+  ResetLocal();
+  pending_ = true;
+#ifdef MPI_PARALLEL
+  int nbuf = static_cast<int>(buf_.size());
+  if (ntype_ != nbuf) {
+    if (type_ != MPI_DATATYPE_NULL) MPI_Type_free(&type_);
+    MPI_Type_contiguous(nbuf, MPI_ATHENA_REAL, &type_);
+    MPI_Type_commit(&type_);
+    ntype_ = nbuf;
+  }
+  MPI_Iallreduce(MPI_IN_PLACE, buf_.data(), 1, type_, op_, comm_, &req_);
+#endif
+  return;
+}
+
+//----------------------------------------------------------------------------------------
+//! \fn void GlobalReduction::Finish()
+//! \brief wait for the pending reduction and unpack the results of all slots
+
+void GlobalReduction::Finish() {
+  if (!pending_) return;
+#ifdef MPI_PARALLEL
+  MPI_Wait(&req_, MPI_STATUS_IGNORE);
+#endif
+  pending_ = false;
+  int isum = 2, iloc = nsum_ + 2, imax = nsum_ + nloc_ + 2;
+  for (const Slot &s : slots_) {
+    Real *p = &result_[s.offset];
+    if (s.op == ReductionOp::sum) {
+      for (int i=0; i<s.n; ++i) p[i] = buf_[isum++];
+    } else if (s.op == ReductionOp::minloc) {
+      iloc++;
+      for (int i=0; i<s.n; ++i) p[i] = buf_[iloc++];
+    } else if (s.op == ReductionOp::max) {
+      for (int i=0; i<s.n; ++i) p[i] = buf_[imax++];
+    } else {
+      for (int i=0; i<s.n; ++i) p[i] = -buf_[imax++];
+    }
+  }
+  return;
+}
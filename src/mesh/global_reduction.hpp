@@ -0,0 +1,74 @@
+#ifndef MESH_GLOBAL_REDUCTION_HPP_
+#define MESH_GLOBAL_REDUCTION_HPP_
+//========================================================================================
+// Athena++ astrophysical MHD code
+// Copyright(C) 2014 James M. Stone <jmstone@princeton.edu> and other code contributors
+// Licensed under the 3-clause BSD License, see LICENSE file for details
+//========================================================================================
+//! \file global_reduction.hpp
+//! \brief defines class GlobalReduction, which batches global sums, minima and maxima
+//!        into a single non-blocking collective
+
+// C headers
+
+// C++ headers
+#include <vector>
+
+// Athena++ headers
+#include "../athena.hpp"
+
+#ifdef MPI_PARALLEL
+#include <mpi.h>
+#endif
+
+//! operation applied to a GlobalReduction slot. minloc: the first value is a key, the
+//! result is the slot of the rank with the smallest key (e.g. a sample of the lowest
+//! rank that has one)
+enum class ReductionOp {sum, min, max, minloc};
+
+//! \class GlobalReduction
+//! \brief a set of slots (scalars or short vectors), each reduced over all ranks with
+//!        sum, min or max. Values are accumulated locally into the slots, Start() posts
+//!        all of them in one MPI_Iallreduce and Finish() waits for it and delivers the
+//!        results. Slots must be registered in the same order on all ranks.
+
+class GlobalReduction {
+ public:
+  GlobalReduction();
+  ~GlobalReduction();
+
+  // functions
+  int Register(ReductionOp op, int n = 1);  // returns the slot index
+  void Resize(int slot, int n);             // same order on all ranks, like Register
+  int Size(int slot) const { return slots_[slot].n; }
+  void Accumulate(int slot, const Real *val);
+  void Accumulate(int slot, Real val) { Accumulate(slot, &val); }
+  void Start();   // collective; resets the local values
+  void Finish();  // collective; no-op if nothing is pending
+  bool Pending() const { return pending_; }
+  Real Result(int slot, int n = 0) const { return result_[slots_[slot].offset + n]; }
+
+ private:
+  struct Slot {
+    ReductionOp op;
+    int n, offset;  // number of values, offset in local_ and result_
+  };
+  std::vector<Slot> slots_;
+  int nsum_;                  // number of values in sum slots
+  int nloc_;                  // number of values in minloc slots, incl. one size each
+  std::vector<Real> local_;   // local values, slot by slot
+  std::vector<Real> result_;  // reduced values, slot by slot
+  std::vector<Real> buf_;     // packed: nsum_, nloc_, sums, minloc, maxima, -minima
+  bool pending_;
+
+  void ResetLocal();
+  void Layout();  // offsets of the slots and size of the buffers
+#ifdef MPI_PARALLEL
+  MPI_Comm comm_;
+  MPI_Op op_;
+  MPI_Datatype type_;  // the whole of buf_, so that MPI never splits it
+  int ntype_;          // size of type_
+  MPI_Request req_;
+#endif
+};
+#endif // MESH_GLOBAL_REDUCTION_HPP_
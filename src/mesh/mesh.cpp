@@ -29,6 +29,7 @@
 #include "../athena.hpp"
 #include "../athena_arrays.hpp"
 #include "../bvals/bvals.hpp"
+#include "../bvals/bvals_node_shared.hpp"
 #include "../coordinates/coordinates.hpp"
 #include "../eos/eos.hpp"
 #include "../fft/athena_fft.hpp"
@@ -41,6 +42,9 @@
 #include "../gravity/mg_gravity.hpp"
 #include "../hydro/hydro.hpp"
 #include "../hydro/hydro_diffusion/hydro_diffusion.hpp"
+#include "../hydro/hydro_diffusion/mg_conduction.hpp"
+#include "../hydro/srcterms/physics_modules.hpp"
+#include "../hydro/srcterms/sink_particles.hpp"
 #include "../multigrid/multigrid.hpp"
 #include "../orbital_advection/orbital_advection.hpp"
 #include "../outputs/io_wrapper.hpp"
@@ -48,7 +52,10 @@
 #include "../reconstruct/reconstruction.hpp"
 #include "../scalars/scalars.hpp"
 #include "../utils/buffer_utils.hpp"
+#include "../utils/utils.hpp"
+#include "global_reduction.hpp"
 #include "mesh.hpp"
+#include "mesh_checkpoint.hpp"
 #include "mesh_refinement.hpp"
 #include "meshblock_tree.hpp"
 
@@ -57,6 +64,10 @@
 #include <mpi.h>
 #endif
 
+#ifdef OPENMP_PARALLEL
+#include <omp.h>
+#endif
+
 //----------------------------------------------------------------------------------------
 //! Mesh constructor, builds mesh at start of calculation using parameters in input file
 
@@ -91,6 +102,7 @@ Mesh::Mesh(ParameterInput *pin, int mesh_test) :
     tlim(pin->GetReal("time", "tlim")), dt(std::numeric_limits<Real>::max()),
     dt_hyperbolic(dt), dt_parabolic(dt), dt_user(dt),
     cfl_number(pin->GetReal("time", "cfl_number")),
+    ceiling_losses{},
     nlim(pin->GetOrAddInteger("time", "nlim", -1)), ncycle(),
     ncycle_out(pin->GetOrAddInteger("time", "ncycle_out", 1)),
     dt_diagnostics(pin->GetOrAddInteger("time", "dt_diagnostics", -1)),
@@ -98,10 +110,14 @@ Mesh::Mesh(ParameterInput *pin, int mesh_test) :
     sts_max_dt_ratio(pin->GetOrAddReal("time", "sts_max_dt_ratio", -1.0)),
     sts_loc(TaskType::main_int),
     muj(), nuj(), muj_tilde(), gammaj_tilde(),
-    nbnew(), nbdel(),
-    step_since_lb(), gflag(), turb_flag(), amr_updated(multilevel),
+    nbnew(), nbdel(), nbdenied(),
+    step_since_lb(), gflag(), turb_flag(), amr_updated(multilevel), pmgcd(), pnsbuf(),
+    psinks(), pckpt(), preduce(new GlobalReduction()), pphys(new PhysicsModules(this)),
     // private members:
     next_phys_id_(), num_mesh_threads_(pin->GetOrAddInteger("mesh", "num_threads", 1)),
+    num_loop_threads_(pin->GetOrAddInteger("mesh", "num_loop_threads", 1)),
+    dt_slot_(preduce->Register(ReductionOp::min, 4)), dt_started_(false),
+    ceil_slot_(-1),
     gids_(), gide_(),
     tree(this),
     use_uniform_meshgen_fn_{true, true, true},
@@ -111,9 +127,9 @@ Mesh::Mesh(ParameterInput *pin, int mesh_test) :
     MeshGenerator_{UniformMeshGeneratorX1, UniformMeshGeneratorX2,
                    UniformMeshGeneratorX3},
     BoundaryFunction_{nullptr, nullptr, nullptr, nullptr, nullptr, nullptr},
-    AMRFlag_{}, UserSourceTerm_{}, UserTimeStep_{}, ViscosityCoeff_{},
-    ConductionCoeff_{}, FieldDiffusivity_{},
-    OrbitalVelocity_{}, OrbitalVelocityDerivative_{nullptr, nullptr},
+    AMRFlag_{}, UserSourceTerm_{}, UserSourceTermPencil_{}, UserTimeStep_{},
+    UserTimeStepPencil_{}, UserOutputRegion_{}, ViscosityCoeff_{}, ConductionCoeff_{},
+    FieldDiffusivity_{}, OrbitalVelocity_{}, OrbitalVelocityDerivative_{nullptr, nullptr},
     MGGravityBoundaryFunction_{MGPeriodicInnerX1, MGPeriodicOuterX1, MGPeriodicInnerX2,
                                MGPeriodicOuterX2, MGPeriodicInnerX3, MGPeriodicOuterX3} {
   std::stringstream msg;
@@ -138,6 +154,17 @@ Mesh::Mesh(ParameterInput *pin, int mesh_test) :
         << num_mesh_threads_ << std::endl;
     ATHENA_ERROR(msg);
   }
+  if (num_loop_threads_ < 1) {
+    msg << "### FATAL ERROR in Mesh constructor" << std::endl
+        << "Number of OpenMP threads must be >= 1, but num_loop_threads="
+        << num_loop_threads_ << std::endl;
+    ATHENA_ERROR(msg);
+  }
+#ifdef OPENMP_PARALLEL
+  // loop-level teams are nested inside the block-level team in hybrid mode
+  if (num_loop_threads_ > 1 && num_mesh_threads_ > 1)
+    omp_set_max_active_levels(2);
+#endif
 
   // check number of grid cells in root level of mesh from input file.
   if (mesh_size.nx1 < 4) {
@@ -504,6 +531,7 @@ Mesh::Mesh(ParameterInput *pin, int mesh_test) :
     bnderef = new int[Globals::nranks];
     brdisp = new int[Globals::nranks];
     bddisp = new int[Globals::nranks];
+    SetAMRBudget(pin);
   }
 
   // initialize cost array with the simplest estimate; all the blocks are equal
@@ -529,6 +557,9 @@ Mesh::Mesh(ParameterInput *pin, int mesh_test) :
   }
   //  if (SELF_GRAVITY_ENABLED == 2 && ...) // independent allocation
   //    gflag = 2;
+  // MGConductionDriver must be initialized before MeshBlocks as well
+  if (NON_BAROTROPIC_EOS && pin->GetOrAddBoolean("problem", "implicit_conduction", false))
+    pmgcd = new MGConductionDriver(this, pin);
 
   // create MeshBlock list for this process
   gids_ = nslist[Globals::my_rank];
@@ -545,8 +576,23 @@ Mesh::Mesh(ParameterInput *pin, int mesh_test) :
 
   ResetLoadBalanceVariables();
 
+  // the energy removed by the EOS ceilings is reduced together with the time step
+  if (my_blocks(0)->peos->CeilingsEnabled())
+    ceil_slot_ = preduce->Register(ReductionOp::sum, 2);
+
   if (turb_flag > 0) // TurbulenceDriver depends on the MeshBlock ctor
     ptrbd = new TurbulenceDriver(this, pin);
+
+  if (pin->GetOrAddBoolean("sinks", "sink_particles", false))
+    psinks = new SinkParticles(this, pin);
+
+  if (pin->GetOrAddInteger("rollback", "interval", 0) > 0)
+    pckpt = new MeshCheckpoint(this, pin);
+
+#ifdef MPI_PARALLEL
+  if (pin->GetOrAddBoolean("mesh", "shared_memory_comm", false))
+    pnsbuf = new NodeSharedBuffers(this);
+#endif
 }
 
 //----------------------------------------------------------------------------------------
@@ -584,6 +630,7 @@ Mesh::Mesh(ParameterInput *pin, IOWrapper& resfile, int mesh_test) :
     tlim(pin->GetReal("time", "tlim")), dt(std::numeric_limits<Real>::max()),
     dt_hyperbolic(dt), dt_parabolic(dt), dt_user(dt),
     cfl_number(pin->GetReal("time", "cfl_number")),
+    ceiling_losses{},
     nlim(pin->GetOrAddInteger("time", "nlim", -1)), ncycle(),
     ncycle_out(pin->GetOrAddInteger("time", "ncycle_out", 1)),
     dt_diagnostics(pin->GetOrAddInteger("time", "dt_diagnostics", -1)),
@@ -591,10 +638,14 @@ Mesh::Mesh(ParameterInput *pin, IOWrapper& resfile, int mesh_test) :
     sts_max_dt_ratio(pin->GetOrAddReal("time", "sts_max_dt_ratio", -1.0)),
     sts_loc(TaskType::main_int),
     muj(), nuj(), muj_tilde(), gammaj_tilde(),
-    nbnew(), nbdel(),
-    step_since_lb(), gflag(), turb_flag(), amr_updated(multilevel),
+    nbnew(), nbdel(), nbdenied(),
+    step_since_lb(), gflag(), turb_flag(), amr_updated(multilevel), pmgcd(), pnsbuf(),
+    psinks(), pckpt(), preduce(new GlobalReduction()), pphys(new PhysicsModules(this)),
     // private members:
     next_phys_id_(), num_mesh_threads_(pin->GetOrAddInteger("mesh", "num_threads", 1)),
+    num_loop_threads_(pin->GetOrAddInteger("mesh", "num_loop_threads", 1)),
+    dt_slot_(preduce->Register(ReductionOp::min, 4)), dt_started_(false),
+    ceil_slot_(-1),
     gids_(), gide_(),
     tree(this),
     use_uniform_meshgen_fn_{true, true, true},
@@ -604,9 +655,9 @@ Mesh::Mesh(ParameterInput *pin, IOWrapper& resfile, int mesh_test) :
     MeshGenerator_{UniformMeshGeneratorX1, UniformMeshGeneratorX2,
                    UniformMeshGeneratorX3},
     BoundaryFunction_{nullptr, nullptr, nullptr, nullptr, nullptr, nullptr},
-    AMRFlag_{}, UserSourceTerm_{}, UserTimeStep_{}, ViscosityCoeff_{},
-    ConductionCoeff_{}, FieldDiffusivity_{},
-    OrbitalVelocity_{}, OrbitalVelocityDerivative_{nullptr, nullptr},
+    AMRFlag_{}, UserSourceTerm_{}, UserSourceTermPencil_{}, UserTimeStep_{},
+    UserTimeStepPencil_{}, UserOutputRegion_{}, ViscosityCoeff_{}, ConductionCoeff_{},
+    FieldDiffusivity_{}, OrbitalVelocity_{}, OrbitalVelocityDerivative_{nullptr, nullptr},
     MGGravityBoundaryFunction_{MGPeriodicInnerX1, MGPeriodicOuterX1, MGPeriodicInnerX2,
                         MGPeriodicOuterX2, MGPeriodicInnerX3, MGPeriodicOuterX3} {
   std::stringstream msg;
@@ -632,6 +683,17 @@ Mesh::Mesh(ParameterInput *pin, IOWrapper& resfile, int mesh_test) :
         << num_mesh_threads_ << std::endl;
     ATHENA_ERROR(msg);
   }
+  if (num_loop_threads_ < 1) {
+    msg << "### FATAL ERROR in Mesh constructor" << std::endl
+        << "Number of OpenMP threads must be >= 1, but num_loop_threads="
+        << num_loop_threads_ << std::endl;
+    ATHENA_ERROR(msg);
+  }
+#ifdef OPENMP_PARALLEL
+  // loop-level teams are nested inside the block-level team in hybrid mode
+  if (num_loop_threads_ > 1 && num_mesh_threads_ > 1)
+    omp_set_max_active_levels(2);
+#endif
 
   // get the end of the header
   headeroffset = resfile.GetPosition();
@@ -834,6 +896,7 @@ Mesh::Mesh(ParameterInput *pin, IOWrapper& resfile, int mesh_test) :
     bnderef = new int[Globals::nranks];
     brdisp = new int[Globals::nranks];
     bddisp = new int[Globals::nranks];
+    SetAMRBudget(pin);
   }
 
   CalculateLoadBalance(costlist, ranklist, nslist, nblist, nbtotal);
@@ -854,6 +917,8 @@ Mesh::Mesh(ParameterInput *pin, IOWrapper& resfile, int mesh_test) :
   }
   //  if (SELF_GRAVITY_ENABLED == 2 && ...) // independent allocation
   //    gflag=2;
+  if (NON_BAROTROPIC_EOS && pin->GetOrAddBoolean("problem", "implicit_conduction", false))
+    pmgcd = new MGConductionDriver(this, pin);
 
   // allocate data buffer
   nblocal = nblist[Globals::my_rank];
@@ -891,8 +956,36 @@ Mesh::Mesh(ParameterInput *pin, IOWrapper& resfile, int mesh_test) :
   // clean up
   delete [] offset;
 
-  if (turb_flag > 0) // TurbulenceDriver depends on the MeshBlock ctor
+  // the energy removed by the EOS ceilings is reduced together with the time step;
+  // the totals so far are stored with the parameters by RestartOutput
+  if (my_blocks(0)->peos->CeilingsEnabled()) {
+    ceil_slot_ = preduce->Register(ReductionOp::sum, 2);
+    ceiling_losses[0] = pin->GetOrAddReal("hydro", "tceil_losses", 0.0);
+    ceiling_losses[1] = pin->GetOrAddReal("hydro", "vceil_losses", 0.0);
+  }
+
+  // the sink record directly follows the MeshBlock data, so its offset does not depend
+  // on the number of ranks; the per-rank turbulence driving records come last
+  IOWrapperSizeT extoffset = headeroffset + nbtotal*datasize;
+  if (pin->GetOrAddBoolean("sinks", "sink_particles", false)) {
+    psinks = new SinkParticles(this, pin);
+    psinks->ReadRestartState(resfile, extoffset);
+    extoffset += psinks->GetRestartRecordSizeInBytes();
+  }
+
+  if (turb_flag > 0) { // TurbulenceDriver depends on the MeshBlock ctor
     ptrbd = new TurbulenceDriver(this, pin);
+    // continue the OU process and RNG sequence instead of drawing a new spectrum
+    if (turb_flag > 1) ptrbd->ReadRestartState(resfile, extoffset);
+  }
+
+  if (pin->GetOrAddInteger("rollback", "interval", 0) > 0)
+    pckpt = new MeshCheckpoint(this, pin);
+
+#ifdef MPI_PARALLEL
+  if (pin->GetOrAddBoolean("mesh", "shared_memory_comm", false))
+    pnsbuf = new NodeSharedBuffers(this);
+#endif
 }
 
 //----------------------------------------------------------------------------------------
@@ -909,6 +1002,12 @@ Mesh::~Mesh() {
   if (SELF_GRAVITY_ENABLED == 1) delete pfgrd;
   else if (SELF_GRAVITY_ENABLED == 2) delete pmgrd;
   if (turb_flag > 0) delete ptrbd;
+  delete pnsbuf;
+  delete psinks;
+  delete pckpt;
+  delete pmgcd;
+  delete preduce;
+  delete pphys;
   if (adaptive) { // deallocate arrays for AMR
     delete [] nref;
     delete [] nderef;
@@ -1079,40 +1178,72 @@ void Mesh::OutputMeshStructure(int ndim) {
   return;
 }
 
+//----------------------------------------------------------------------------------------
+//! \fn void Mesh::StartNewTimeStep(bool recompute_block_dt)
+//! \brief post the minima of the new MeshBlock time steps on this rank to preduce,
+//!        together with all other slots, so that the reduction overlaps with the work
+//!        before NewTimeStep(); collective. The block time steps are evaluated again if
+//!        u and w were changed after the task list (operator-split updates).
+
+void Mesh::StartNewTimeStep(bool recompute_block_dt) {
+  if (recompute_block_dt) {
+    int nthreads = GetNumMeshThreads();
+#pragma omp parallel for num_threads(nthreads)
+    for (int i=0; i<nblocal; ++i)
+      my_blocks(i)->phydro->NewBlockTimeStep();
+  }
+
+  MeshBlock *pmb = my_blocks(0);
+  Real dt_array[4] = {pmb->new_block_dt_, pmb->new_block_dt_hyperbolic_,
+                      pmb->new_block_dt_parabolic_, pmb->new_block_dt_user_};
+  for (int i=1; i<nblocal; ++i) {
+    pmb = my_blocks(i);
+    dt_array[0] = std::min(dt_array[0], pmb->new_block_dt_);
+    dt_array[1] = std::min(dt_array[1], pmb->new_block_dt_hyperbolic_);
+    dt_array[2] = std::min(dt_array[2], pmb->new_block_dt_parabolic_);
+    dt_array[3] = std::min(dt_array[3], pmb->new_block_dt_user_);
+  }
+  preduce->Accumulate(dt_slot_, dt_array);
+  if (ceil_slot_ >= 0) {
+    Real losses[2] = {0.0, 0.0};
+    for (int i=0; i<nblocal; ++i)
+      my_blocks(i)->peos->TakeCeilingLosses(losses);
+    preduce->Accumulate(ceil_slot_, losses);
+  }
+  RuntimeDiagnostics::Post(preduce);
+  preduce->Start();
+  dt_started_ = true;
+  return;
+}
+
 //----------------------------------------------------------------------------------------
 //! \fn void Mesh::NewTimeStep()
 //! \brief function that loops over all MeshBlocks and find new timestep
-//!        this assumes that phydro->NewBlockTimeStep is already called
+//!        this assumes that phydro->NewBlockTimeStep is already called. Completes the
+//!        reduction posted by StartNewTimeStep(), or posts and completes one if there is
+//!        none (or the MeshBlocks have been reinitialized since)
 
 void Mesh::NewTimeStep() {
-  MeshBlock *pmb = my_blocks(0);
+  if (!dt_started_) StartNewTimeStep();
+  preduce->Finish();
+  dt_started_ = false;
 
   // prevent timestep from growing too fast in between 2x cycles (even if every MeshBlock
   // has new_block_dt > 2.0*dt_old)
-  dt = static_cast<Real>(2.0)*dt;
-  // consider first MeshBlock on this MPI rank's linked list of blocks:
-  dt = std::min(dt, pmb->new_block_dt_);
-  dt_hyperbolic = pmb->new_block_dt_hyperbolic_;
-  dt_parabolic = pmb->new_block_dt_parabolic_;
-  dt_user = pmb->new_block_dt_user_;
-
-  for (int i=0; i<nblocal; ++i) {
-    pmb = my_blocks(i);
-    dt = std::min(dt, pmb->new_block_dt_);
-    dt_hyperbolic  = std::min(dt_hyperbolic, pmb->new_block_dt_hyperbolic_);
-    dt_parabolic  = std::min(dt_parabolic, pmb->new_block_dt_parabolic_);
-    dt_user  = std::min(dt_user, pmb->new_block_dt_user_);
+  dt = std::min(static_cast<Real>(2.0)*dt, preduce->Result(dt_slot_, 0));
+  dt_hyperbolic = preduce->Result(dt_slot_, 1);
+  dt_parabolic  = preduce->Result(dt_slot_, 2);
+  dt_user       = preduce->Result(dt_slot_, 3);
+  if (ceil_slot_ >= 0) {
+    ceiling_losses[0] += preduce->Result(ceil_slot_, 0);
+    ceiling_losses[1] += preduce->Result(ceil_slot_, 1);
   }
 
-#ifdef MPI_PARALLEL
-  // pack array, MPI allreduce over array, then unpack into Mesh variables
-  Real dt_array[4] = {dt, dt_hyperbolic, dt_parabolic, dt_user};
-  MPI_Allreduce(MPI_IN_PLACE, dt_array, 4, MPI_ATHENA_REAL, MPI_MIN, MPI_COMM_WORLD);
-  dt            = dt_array[0];
-  dt_hyperbolic = dt_array[1];
-  dt_parabolic  = dt_array[2];
-  dt_user       = dt_array[3];
-#endif
+  // sink particle state is the same on all ranks
+  if (psinks != nullptr) {
+    psinks->FinishUpdate();
+    dt = std::min(dt, psinks->NewTimeStep());
+  }
 
   if (time < tlim && (tlim - time) < dt) // timestep would take us past desired endpoint
     dt = tlim - time;
@@ -1229,6 +1360,37 @@ void Mesh::EnrollUserExplicitSourceFunction(SrcTermFunc my_func) {
   return;
 }
 
+//----------------------------------------------------------------------------------------
+//! \fn void Mesh::EnrollUserExplicitSourcePencilFunction(SrcTermPencilFunc my_func)
+//! \brief Enroll a user-defined source function acting on a single (k,j) pencil
+//!
+//! Pencil source functions are evaluated inside the fused stage update when
+//! <time>/fused_update = true, and pencil by pencil in AddSourceTerms otherwise.
+
+void Mesh::EnrollUserExplicitSourcePencilFunction(SrcTermPencilFunc my_func) {
+  UserSourceTermPencil_ = my_func;
+  return;
+}
+
+//----------------------------------------------------------------------------------------
+//! \fn void Mesh::EnrollPhysicsModule(const char *name, SrcTermFunc my_func,
+//!                                    PhysicsStage stage, int interval, int reads,
+//!                                    int writes, bool thread_safe)
+//! \brief Enroll a physics module (see PhysicsModules)
+//!
+//! - stage: every_stage (added with the source terms in each stage of the integrator),
+//!   before_step or after_step (operator split, once per `interval` cycles, with dt the
+//!   time since the module was last applied)
+//! - reads, writes: PhysicsVariable masks of the primitives read and the conserved
+//!   variables written; the primitives are recomputed only when needed
+//! - thread_safe: false if the module must not run concurrently on different MeshBlocks
+
+void Mesh::EnrollPhysicsModule(const char *name, SrcTermFunc my_func, PhysicsStage stage,
+                               int interval, int reads, int writes, bool thread_safe) {
+  pphys->Enroll(name, my_func, stage, interval, reads, writes, thread_safe);
+  return;
+}
+
 //----------------------------------------------------------------------------------------
 //! \fn void Mesh::EnrollUserTimeStepFunction(TimeStepFunc my_func)
 //! \brief Enroll a user-defined time step function
@@ -1238,6 +1400,18 @@ void Mesh::EnrollUserTimeStepFunction(TimeStepFunc my_func) {
   return;
 }
 
+//----------------------------------------------------------------------------------------
+//! \fn void Mesh::EnrollUserTimeStepPencilFunction(TimeStepPencilFunc my_func)
+//! \brief Enroll a user-defined time step function acting on a single (k,j) pencil
+//!
+//! Pencil time step functions are evaluated together with the hyperbolic limit, and
+//! inside the final ConservedToPrimitive sweep of the cycle when <time>/fused_dt = true.
+
+void Mesh::EnrollUserTimeStepPencilFunction(TimeStepPencilFunc my_func) {
+  UserTimeStepPencil_ = my_func;
+  return;
+}
+
 //----------------------------------------------------------------------------------------
 //! \fn void Mesh::AllocateUserHistoryOutput(int n)
 //! \brief set the number of user-defined history outputs
@@ -1269,6 +1443,17 @@ void Mesh::EnrollUserHistoryOutput(int i, HistoryOutputFunc my_func, const char
   user_history_ops_[i] = op;
 }
 
+//----------------------------------------------------------------------------------------
+//! \fn void Mesh::EnrollUserOutputRegion(OutputRegionFunc my_func)
+//! \brief Enroll a user-defined selection of the MeshBlocks written by the outputs that
+//!        support regions (vtk, tab, hdf5); called with the number n of the <output[n]>
+//!        block, it returns true for the MeshBlocks to be written
+
+void Mesh::EnrollUserOutputRegion(OutputRegionFunc my_func) {
+  UserOutputRegion_ = my_func;
+  return;
+}
+
 //----------------------------------------------------------------------------------------
 //! \fn void Mesh::EnrollUserMetric(MetricFunc my_func)
 //! \brief Enroll a user-defined metric for arbitrary GR coordinates
@@ -1398,6 +1583,9 @@ void Mesh::Initialize(int res_flag, ParameterInput *pin) {
       if (SELF_GRAVITY_ENABLED == 1)
         pmb->pgrav->gbvar.SetupPersistentMPI();
     }
+    // and slots in the node shared window for on-node neighbors (collective)
+    if (pnsbuf != nullptr)
+      pnsbuf->Setup();
 
     // solve gravity for the first time
     if (SELF_GRAVITY_ENABLED == 1)
@@ -1408,89 +1596,10 @@ void Mesh::Initialize(int res_flag, ParameterInput *pin) {
 #pragma omp parallel num_threads(nthreads)
     {
       MeshBlock *pmb;
-      BoundaryValues *pbval;
-
-      // prepare to receive conserved variables
-#pragma omp for private(pmb,pbval)
-      for (int i=0; i<nblocal; ++i) {
-        pmb = my_blocks(i); pbval = pmb->pbval;
-        if (shear_periodic) {
-          pbval->ComputeShear(time, time);
-        }
-        pbval->StartReceivingSubset(BoundaryCommSubset::mesh_init,
-                                    pbval->bvars_main_int);
-      }
-
-      // send conserved variables
-#pragma omp for private(pmb,pbval)
-      for (int i=0; i<nblocal; ++i) {
-        pmb = my_blocks(i); pbval = pmb->pbval;
-        pmb->phydro->hbvar.SwapHydroQuantity(pmb->phydro->u,
-                                               HydroBoundaryQuantity::cons);
-        pmb->phydro->hbvar.SendBoundaryBuffers();
-        if (MAGNETIC_FIELDS_ENABLED)
-          pmb->pfield->fbvar.SendBoundaryBuffers();
-        // and (conserved variable) passive scalar masses:
-        if (NSCALARS > 0)
-          pmb->pscalars->sbvar.SendBoundaryBuffers();
-      }
-
-      // wait to receive conserved variables
-#pragma omp for private(pmb,pbval)
-      for (int i=0; i<nblocal; ++i) {
-        pmb = my_blocks(i); pbval = pmb->pbval;
-        pmb->phydro->hbvar.ReceiveAndSetBoundariesWithWait();
-        if (MAGNETIC_FIELDS_ENABLED)
-          pmb->pfield->fbvar.ReceiveAndSetBoundariesWithWait();
-        if (NSCALARS > 0)
-          pmb->pscalars->sbvar.ReceiveAndSetBoundariesWithWait();
-        if (shear_periodic && orbital_advection==0) {
-          pmb->phydro->hbvar.AddHydroShearForInit();
-        }
-        pbval->ClearBoundarySubset(BoundaryCommSubset::mesh_init,
-                                   pbval->bvars_main_int);
-      }
-
-      // With AMR/SMR GR send primitives to enable cons->prim before prolongation
-      if (GENERAL_RELATIVITY && multilevel) {
-        // prepare to receive primitives
-#pragma omp for private(pmb,pbval)
-        for (int i=0; i<nblocal; ++i) {
-          pmb = my_blocks(i); pbval = pmb->pbval;
-          pbval->StartReceivingSubset(BoundaryCommSubset::gr_amr,
-                                      pbval->bvars_main_int);
-        }
+      Hydro *ph;
+      Field *pf;
 
-        // send primitives
-#pragma omp for private(pmb,pbval)
-        for (int i=0; i<nblocal; ++i) {
-          pmb = my_blocks(i); pbval = pmb->pbval;
-          pmb->phydro->hbvar.SwapHydroQuantity(pmb->phydro->w,
-                                               HydroBoundaryQuantity::prim);
-          pmb->phydro->hbvar.SendBoundaryBuffers();
-          if (NSCALARS > 0) {
-            pmb->pscalars->sbvar.var_cc = &(pmb->pscalars->r);
-            pmb->pscalars->sbvar.SendBoundaryBuffers();
-          }
-        }
-
-        // wait to receive AMR/SMR GR primitives
-#pragma omp for private(pmb,pbval)
-        for (int i=0; i<nblocal; ++i) {
-          pmb = my_blocks(i); pbval = pmb->pbval;
-          pmb->phydro->hbvar.ReceiveAndSetBoundariesWithWait();
-          if (NSCALARS > 0) {
-            pmb->pscalars->sbvar.ReceiveAndSetBoundariesWithWait();
-          }
-          pbval->ClearBoundarySubset(BoundaryCommSubset::gr_amr,
-                                     pbval->bvars_main_int);
-          pmb->phydro->hbvar.SwapHydroQuantity(pmb->phydro->u,
-                                               HydroBoundaryQuantity::cons);
-          if (NSCALARS > 0) {
-            pmb->pscalars->sbvar.var_cc = &(pmb->pscalars->s);
-          }
-        }
-      } // multilevel
+      ExchangeGhostCells(time);
 
       // perform fourth-order correction of midpoint initial condition:
       // (correct IC on all MeshBlocks or none; switch cannot be toggled independently)
@@ -1509,78 +1618,7 @@ void Mesh::Initialize(int res_flag, ParameterInput *pin) {
         }
       }
 
-      // Now do prolongation, compute primitives, apply BCs
-      Hydro *ph;
-      Field *pf;
-      PassiveScalars *ps;
-#pragma omp for private(pmb,pbval,ph,pf,ps)
-      for (int i=0; i<nblocal; ++i) {
-        pmb = my_blocks(i);
-        pbval = pmb->pbval, ph = pmb->phydro, pf = pmb->pfield, ps = pmb->pscalars;
-        if (multilevel)
-          pbval->ProlongateBoundaries(time, 0.0, pbval->bvars_main_int);
-
-        int il = pmb->is, iu = pmb->ie,
-            jl = pmb->js, ju = pmb->je,
-            kl = pmb->ks, ku = pmb->ke;
-        if (pbval->nblevel[1][1][0] != -1) il -= NGHOST;
-        if (pbval->nblevel[1][1][2] != -1) iu += NGHOST;
-        if (pmb->block_size.nx2 > 1) {
-          if (pbval->nblevel[1][0][1] != -1) jl -= NGHOST;
-          if (pbval->nblevel[1][2][1] != -1) ju += NGHOST;
-        }
-        if (pmb->block_size.nx3 > 1) {
-          if (pbval->nblevel[0][1][1] != -1) kl -= NGHOST;
-          if (pbval->nblevel[2][1][1] != -1) ku += NGHOST;
-        }
-        pmb->peos->ConservedToPrimitive(ph->u, ph->w1, pf->b,
-                                        ph->w, pf->bcc, pmb->pcoord,
-                                        il, iu, jl, ju, kl, ku);
-        if (NSCALARS > 0) {
-          // r1/r_old for GR is currently unused:
-          pmb->peos->PassiveScalarConservedToPrimitive(ps->s, ph->u, ps->r, ps->r,
-                                                       pmb->pcoord,
-                                                       il, iu, jl, ju, kl, ku);
-        }
-        // --------------------------
-        int order = pmb->precon->xorder;
-        if (order == 4) {
-          // fourth-order EOS:
-          // for hydro, shrink buffer by 1 on all sides
-          if (pbval->nblevel[1][1][0] != -1) il += 1;
-          if (pbval->nblevel[1][1][2] != -1) iu -= 1;
-          if (pbval->nblevel[1][0][1] != -1) jl += 1;
-          if (pbval->nblevel[1][2][1] != -1) ju -= 1;
-          if (pbval->nblevel[0][1][1] != -1) kl += 1;
-          if (pbval->nblevel[2][1][1] != -1) ku -= 1;
-          // for MHD, shrink buffer by 3
-          //! \todo (felker):
-          //! * add MHD loop limit calculation for 4th order W(U)
-          // Apply physical boundaries prior to 4th order W(U)
-          ph->hbvar.SwapHydroQuantity(ph->w, HydroBoundaryQuantity::prim);
-          if (NSCALARS > 0)
-            ps->sbvar.var_cc = &(ps->r);
-          pbval->ApplyPhysicalBoundaries(time, 0.0, pbval->bvars_main_int);
-          // Perform 4th order W(U)
-          pmb->peos->ConservedToPrimitiveCellAverage(ph->u, ph->w1, pf->b,
-                                                     ph->w, pf->bcc, pmb->pcoord,
-                                                     il, iu, jl, ju, kl, ku);
-          if (NSCALARS > 0) {
-            pmb->peos->PassiveScalarConservedToPrimitiveCellAverage(
-                ps->s, ps->r, ps->r, pmb->pcoord, il, iu, jl, ju, kl, ku);
-          }
-        }
-        // --------------------------
-        // end fourth-order EOS
-
-        // Swap Hydro and (possibly) passive scalar quantities in BoundaryVariable
-        // interface from conserved to primitive formulations:
-        ph->hbvar.SwapHydroQuantity(ph->w, HydroBoundaryQuantity::prim);
-        if (NSCALARS > 0)
-          ps->sbvar.var_cc = &(ps->r);
-
-        pbval->ApplyPhysicalBoundaries(time, 0.0, pbval->bvars_main_int);
-      }
+      ComputeGhostPrimitives(time);
 
       // Calc initial diffusion coefficients
 #pragma omp for private(pmb,ph,pf)
@@ -1631,6 +1669,17 @@ void Mesh::Initialize(int res_flag, ParameterInput *pin) {
     my_blocks(i)->phydro->NewBlockTimeStep();
   }
 
+  // a reduction posted before the MeshBlocks changed is stale, but it still holds the
+  // energy removed by the ceilings and the sink particle sums of the last cycle
+  if (dt_started_) {
+    preduce->Finish();
+    if (ceil_slot_ >= 0) {
+      ceiling_losses[0] += preduce->Result(ceil_slot_, 0);
+      ceiling_losses[1] += preduce->Result(ceil_slot_, 1);
+    }
+    if (psinks != nullptr) psinks->FinishUpdate();
+  }
+  dt_started_ = false;
   NewTimeStep();
   return;
 }
@@ -1645,6 +1694,200 @@ MeshBlock* Mesh::FindMeshBlock(int tgid) {
   return nullptr;
 }
 
+//----------------------------------------------------------------------------------------
+//! \fn void Mesh::ExchangeGhostCells(Real t)
+//! \brief exchange the conserved variables, the magnetic field and the passive scalars
+//!        of all MeshBlocks at time t. The loops are orphaned OpenMP work-sharing
+//!        constructs: call this from all threads of a parallel region, or serially.
+
+void Mesh::ExchangeGhostCells(Real t) {
+  MeshBlock *pmb;
+  BoundaryValues *pbval;
+  // prepare to receive conserved variables
+#pragma omp for private(pmb,pbval)
+  for (int i=0; i<nblocal; ++i) {
+    pmb = my_blocks(i); pbval = pmb->pbval;
+    if (shear_periodic) {
+      pbval->ComputeShear(t, t);
+    }
+    pbval->StartReceivingSubset(BoundaryCommSubset::mesh_init,
+                                pbval->bvars_main_int);
+  }
+
+  // send conserved variables
+#pragma omp for private(pmb,pbval)
+  for (int i=0; i<nblocal; ++i) {
+    pmb = my_blocks(i); pbval = pmb->pbval;
+    pmb->phydro->hbvar.SwapHydroQuantity(pmb->phydro->u,
+                                         HydroBoundaryQuantity::cons);
+    pmb->phydro->hbvar.SendBoundaryBuffers();
+    if (MAGNETIC_FIELDS_ENABLED)
+      pmb->pfield->fbvar.SendBoundaryBuffers();
+    // and (conserved variable) passive scalar masses:
+    if (NSCALARS > 0)
+      pmb->pscalars->sbvar.SendBoundaryBuffers();
+  }
+
+  // wait to receive conserved variables
+#pragma omp for private(pmb,pbval)
+  for (int i=0; i<nblocal; ++i) {
+    pmb = my_blocks(i); pbval = pmb->pbval;
+    pmb->phydro->hbvar.ReceiveAndSetBoundariesWithWait();
+    if (MAGNETIC_FIELDS_ENABLED)
+      pmb->pfield->fbvar.ReceiveAndSetBoundariesWithWait();
+    if (NSCALARS > 0)
+      pmb->pscalars->sbvar.ReceiveAndSetBoundariesWithWait();
+    if (shear_periodic && orbital_advection==0) {
+      pmb->phydro->hbvar.AddHydroShearForInit();
+    }
+    pbval->ClearBoundarySubset(BoundaryCommSubset::mesh_init,
+                               pbval->bvars_main_int);
+  }
+
+  // With AMR/SMR GR send primitives to enable cons->prim before prolongation
+  if (GENERAL_RELATIVITY && multilevel) {
+    // prepare to receive primitives
+#pragma omp for private(pmb,pbval)
+    for (int i=0; i<nblocal; ++i) {
+      pmb = my_blocks(i); pbval = pmb->pbval;
+      pbval->StartReceivingSubset(BoundaryCommSubset::gr_amr,
+                                  pbval->bvars_main_int);
+    }
+
+    // send primitives
+#pragma omp for private(pmb,pbval)
+    for (int i=0; i<nblocal; ++i) {
+      pmb = my_blocks(i); pbval = pmb->pbval;
+      pmb->phydro->hbvar.SwapHydroQuantity(pmb->phydro->w,
+                                           HydroBoundaryQuantity::prim);
+      pmb->phydro->hbvar.SendBoundaryBuffers();
+      if (NSCALARS > 0) {
+        pmb->pscalars->sbvar.var_cc = &(pmb->pscalars->r);
+        pmb->pscalars->sbvar.SendBoundaryBuffers();
+      }
+    }
+
+    // wait to receive AMR/SMR GR primitives
+#pragma omp for private(pmb,pbval)
+    for (int i=0; i<nblocal; ++i) {
+      pmb = my_blocks(i); pbval = pmb->pbval;
+      pmb->phydro->hbvar.ReceiveAndSetBoundariesWithWait();
+      if (NSCALARS > 0) {
+        pmb->pscalars->sbvar.ReceiveAndSetBoundariesWithWait();
+      }
+      pbval->ClearBoundarySubset(BoundaryCommSubset::gr_amr,
+                                 pbval->bvars_main_int);
+      pmb->phydro->hbvar.SwapHydroQuantity(pmb->phydro->u,
+                                           HydroBoundaryQuantity::cons);
+      if (NSCALARS > 0) {
+        pmb->pscalars->sbvar.var_cc = &(pmb->pscalars->s);
+      }
+    }
+  } // multilevel
+  return;
+}
+
+//----------------------------------------------------------------------------------------
+//! \fn void Mesh::ComputeGhostPrimitives(Real t)
+//! \brief after ExchangeGhostCells(): prolongate, convert the ghost cells to primitives
+//!        and apply the physical boundary conditions at time t. Called like
+//!        ExchangeGhostCells().
+
+void Mesh::ComputeGhostPrimitives(Real t) {
+  MeshBlock *pmb;
+  BoundaryValues *pbval;
+  Hydro *ph;
+  Field *pf;
+  PassiveScalars *ps;
+  // Now do prolongation, compute primitives, apply BCs
+#pragma omp for private(pmb,pbval,ph,pf,ps)
+  for (int i=0; i<nblocal; ++i) {
+    pmb = my_blocks(i);
+    pbval = pmb->pbval, ph = pmb->phydro, pf = pmb->pfield, ps = pmb->pscalars;
+    if (multilevel)
+      pbval->ProlongateBoundaries(t, 0.0, pbval->bvars_main_int);
+
+    int il = pmb->is, iu = pmb->ie,
+        jl = pmb->js, ju = pmb->je,
+        kl = pmb->ks, ku = pmb->ke;
+    if (pbval->nblevel[1][1][0] != -1) il -= NGHOST;
+    if (pbval->nblevel[1][1][2] != -1) iu += NGHOST;
+    if (pmb->block_size.nx2 > 1) {
+      if (pbval->nblevel[1][0][1] != -1) jl -= NGHOST;
+      if (pbval->nblevel[1][2][1] != -1) ju += NGHOST;
+    }
+    if (pmb->block_size.nx3 > 1) {
+      if (pbval->nblevel[0][1][1] != -1) kl -= NGHOST;
+      if (pbval->nblevel[2][1][1] != -1) ku += NGHOST;
+    }
+    pmb->peos->ConservedToPrimitive(ph->u, ph->w1, pf->b,
+                                    ph->w, pf->bcc, pmb->pcoord,
+                                    il, iu, jl, ju, kl, ku);
+    if (NSCALARS > 0) {
+      // r1/r_old for GR is currently unused:
+      pmb->peos->PassiveScalarConservedToPrimitive(ps->s, ph->u, ps->r, ps->r,
+                                                   pmb->pcoord,
+                                                   il, iu, jl, ju, kl, ku);
+    }
+    // --------------------------
+    int order = pmb->precon->xorder;
+    if (order == 4) {
+      // fourth-order EOS:
+      // for hydro, shrink buffer by 1 on all sides
+      if (pbval->nblevel[1][1][0] != -1) il += 1;
+      if (pbval->nblevel[1][1][2] != -1) iu -= 1;
+      if (pbval->nblevel[1][0][1] != -1) jl += 1;
+      if (pbval->nblevel[1][2][1] != -1) ju -= 1;
+      if (pbval->nblevel[0][1][1] != -1) kl += 1;
+      if (pbval->nblevel[2][1][1] != -1) ku -= 1;
+      // for MHD, shrink buffer by 3
+      //! \todo (felker):
+      //! * add MHD loop limit calculation for 4th order W(U)
+      // Apply physical boundaries prior to 4th order W(U)
+      ph->hbvar.SwapHydroQuantity(ph->w, HydroBoundaryQuantity::prim);
+      if (NSCALARS > 0)
+        ps->sbvar.var_cc = &(ps->r);
+      pbval->ApplyPhysicalBoundaries(t, 0.0, pbval->bvars_main_int);
+      // Perform 4th order W(U)
+      pmb->peos->ConservedToPrimitiveCellAverage(ph->u, ph->w1, pf->b,
+                                                 ph->w, pf->bcc, pmb->pcoord,
+                                                 il, iu, jl, ju, kl, ku);
+      if (NSCALARS > 0) {
+        pmb->peos->PassiveScalarConservedToPrimitiveCellAverage(
+            ps->s, ps->r, ps->r, pmb->pcoord, il, iu, jl, ju, kl, ku);
+      }
+    }
+    // --------------------------
+    // end fourth-order EOS
+
+    // Swap Hydro and (possibly) passive scalar quantities in BoundaryVariable
+    // interface from conserved to primitive formulations:
+    ph->hbvar.SwapHydroQuantity(ph->w, HydroBoundaryQuantity::prim);
+    if (NSCALARS > 0)
+      ps->sbvar.var_cc = &(ps->r);
+
+    pbval->ApplyPhysicalBoundaries(t, 0.0, pbval->bvars_main_int);
+  }
+  return;
+}
+
+//----------------------------------------------------------------------------------------
+//! \fn void Mesh::RefreshGhostCells(Real t)
+//! \brief refresh the ghost cells of all MeshBlocks at time t, after an operator-split
+//!        update changed u and w in the active cells only. Otherwise the two MeshBlocks
+//!        on either side of a face reconstruct from different states in the first stage
+//!        of the next integration step and their fluxes do not match.
+
+void Mesh::RefreshGhostCells(Real t) {
+  int nthreads = GetNumMeshThreads();
+#pragma omp parallel num_threads(nthreads)
+  {
+    ExchangeGhostCells(t);
+    ComputeGhostPrimitives(t);
+  }
+  return;
+}
+
 //----------------------------------------------------------------------------------------
 //! \fn void Mesh::SetBlockSizeAndBoundaries(LogicalLocation loc,
 //!                RegionSize &block_size, BundaryFlag *block_bcs)
@@ -1933,7 +2176,7 @@ void Mesh::OutputCycleDiagnostics() {
                 << " time=" << time << " dt=" << dt;
       if (dt_diagnostics != -1) {
         if (STS_ENABLED) {
-          if (UserTimeStep_ == nullptr)
+          if (UserTimeStep_ == nullptr && UserTimeStepPencil_ == nullptr)
             std::cout << "=dt_hyperbolic";
           // remaining dt_parabolic diagnostic output handled in STS StartupTaskList
         } else {
@@ -1946,7 +2189,7 @@ void Mesh::OutputCycleDiagnostics() {
                     << std::setprecision(ratio_precision) << ratio
                     << std::setprecision(dt_precision);
         }
-        if (UserTimeStep_ != nullptr) {
+        if (UserTimeStep_ != nullptr || UserTimeStepPencil_ != nullptr) {
           Real ratio = dt / dt_user;
           std::cout << "\ndt_user=" << dt_user << " ratio="
                     << std::setprecision(ratio_precision) << ratio
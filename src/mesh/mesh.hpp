@@ -48,11 +48,18 @@ class PassiveScalars;
 class Gravity;
 class MGGravity;
 class MGGravityDriver;
+class MGConduction;
+class MGConductionDriver;
 class EquationOfState;
 class FFTDriver;
 class FFTGravityDriver;
 class TurbulenceDriver;
+class SinkParticles;
+class MeshCheckpoint;
+class GlobalReduction;
+class PhysicsModules;
 class OrbitalAdvection;
+class NodeSharedBuffers;
 
 FluidFormulation GetFluidFormulation(const std::string& input_string);
 
@@ -68,6 +75,7 @@ class MeshBlock {
   friend class Mesh;
   friend class Hydro;
   friend class TaskList;
+  friend class MeshCheckpoint;
 #ifdef HDF5OUTPUT
   friend class ATHDF5Output;
 #endif
@@ -115,6 +123,7 @@ class MeshBlock {
   Field *pfield;
   Gravity *pgrav;
   MGGravity* pmg;
+  MGConduction *pmgcnd;  // implicit conduction, nullptr if off
   PassiveScalars *pscalars;
   EquationOfState *peos;
   OrbitalAdvection *porb;
@@ -132,6 +141,11 @@ class MeshBlock {
                    FaceField &b_in1, FaceField &b_in2,
                    FaceField &b_in3, FaceField &b_in4,
                    const Real wght[5]);
+  void WeightedAvePencil(AthenaArray<Real> &u_out,
+                         AthenaArray<Real> &u_in1, AthenaArray<Real> &u_in2,
+                         const Real wght[3], const int k, const int j);
+  // part of the (k,j) loops handled by the calling thread of a loop-level team
+  void LoopThreadRange(int &jl, int &ju, int &kl, int &ku) const;
 
   // inform MeshBlock which arrays contained in member Hydro, Field, Particles,
   // ... etc. classes are the "primary" representations of a quantity. when registered,
@@ -147,6 +161,9 @@ class MeshBlock {
   // data
   Real new_block_dt_, new_block_dt_hyperbolic_, new_block_dt_parabolic_,
     new_block_dt_user_;
+  // cleared by the default (empty) UserWorkInLoop(); a user override may change u and w
+  // after the final W(U), so the time step must then be evaluated in its own pass
+  bool user_work_in_loop_{true};
   //! \todo(felker):
   //! * make global TaskList a member of MeshBlock, store TaskStates in list
   //!   shared by main integrator + FFT gravity task lists.
@@ -195,12 +212,18 @@ class Mesh {
   friend class FFTDriver;
   friend class FFTGravityDriver;
   friend class TurbulenceDriver;
+  friend class SinkParticles;
+  friend class MeshCheckpoint;
   friend class MultigridDriver;
   friend class MGGravityDriver;
+  friend class MGConductionDriver;
   friend class Gravity;
   friend class HydroDiffusion;
   friend class FieldDiffusion;
   friend class OrbitalAdvection;
+  friend class AnalysisContext;
+  friend class Outputs;
+  friend class OutputType;
 #ifdef HDF5OUTPUT
   friend class ATHDF5Output;
 #endif
@@ -213,6 +236,8 @@ class Mesh {
 
   // accessors
   int GetNumMeshThreads() const {return num_mesh_threads_;}
+  int GetNumLoopThreads() const {return num_loop_threads_;}
+  bool CeilingsEnabled() const {return ceil_slot_ >= 0;}
   std::int64_t GetTotalCells() {return static_cast<std::int64_t> (nbtotal)*
   my_blocks(0)->block_size.nx1*my_blocks(0)->block_size.nx2*my_blocks(0)->block_size.nx3;}
 
@@ -226,12 +251,14 @@ class Mesh {
   const bool shear_periodic;         // flag of shear periodic b.c.
   const FluidFormulation fluid_setup;
   Real start_time, time, tlim, dt, dt_hyperbolic, dt_parabolic, dt_user, cfl_number;
+  Real ceiling_losses[2];  // thermal and kinetic energy removed by the EOS ceilings
   int nlim, ncycle, ncycle_out, dt_diagnostics;
   std::string sts_integrator;
   Real sts_max_dt_ratio;
   TaskType sts_loc;
   Real muj, nuj, muj_tilde, gammaj_tilde;
   int nbtotal, nblocal, nbnew, nbdel;
+  int nbdenied;  // refinements denied by the AMR budget
 
   int step_since_lb;
   int gflag;
@@ -244,6 +271,12 @@ class Mesh {
   TurbulenceDriver *ptrbd;
   FFTGravityDriver *pfgrd;
   MGGravityDriver *pmgrd;
+  MGConductionDriver *pmgcd;  // implicit conduction, nullptr if off
+  NodeSharedBuffers *pnsbuf;  // on-node shared-memory ghost exchange, nullptr if off
+  SinkParticles *psinks;      // sink particles, nullptr if off
+  MeshCheckpoint *pckpt;      // in-memory rollback checkpoint, nullptr if off
+  GlobalReduction *preduce;   // per-cycle batched reductions, completed in NewTimeStep
+  PhysicsModules *pphys;      // physics modules enrolled in InitUserMeshData
 
   AthenaArray<Real> *ruser_mesh_data;
   AthenaArray<int> *iuser_mesh_data;
@@ -252,12 +285,14 @@ class Mesh {
   void Initialize(int res_flag, ParameterInput *pin);
   void SetBlockSizeAndBoundaries(LogicalLocation loc, RegionSize &block_size,
                                  BoundaryFlag *block_bcs);
+  void StartNewTimeStep(bool recompute_block_dt = false);
   void NewTimeStep();
   void OutputCycleDiagnostics();
   void LoadBalancingAndAdaptiveMeshRefinement(ParameterInput *pin);
   int CreateAMRMPITag(int lid, int ox1, int ox2, int ox3);
   MeshBlock* FindMeshBlock(int tgid);
   void ApplyUserWorkBeforeOutput(ParameterInput *pin);
+  void RefreshGhostCells(Real t);
 
   // function for distributing unique "phys" bitfield IDs to BoundaryVariable objects and
   // other categories of MPI communication for generating unique MPI_TAGs
@@ -271,7 +306,11 @@ class Mesh {
   // data
   int next_phys_id_; // next unused value for encoding final component of MPI tag bitfield
   int root_level, max_level, current_level;
-  int num_mesh_threads_;
+  int num_mesh_threads_;   // threads working on different MeshBlocks
+  int num_loop_threads_;   // threads sharing the k/j loops of one MeshBlock
+  int dt_slot_;            // slot of the new time steps in preduce
+  bool dt_started_;        // the reduction of the new time steps has been posted
+  int ceil_slot_;          // slot of the energy removed by the ceilings, -1 if none
   int gids_, gide_;
   int *nslist, *ranklist, *nblist;
   double *costlist;
@@ -281,6 +320,7 @@ class Mesh {
   int *bnref, *bnderef;
   int *brdisp, *bddisp;
   // the last 4x should be std::size_t, but are limited to int by MPI
+  int max_nbtotal_;  // AMR budget: maximum number of MeshBlocks, -1 if none
 
   LogicalLocation *loclist;
   MeshBlockTree tree;
@@ -312,8 +352,11 @@ class Mesh {
   BValFunc BoundaryFunction_[6];
   AMRFlagFunc AMRFlag_;
   SrcTermFunc UserSourceTerm_;
+  SrcTermPencilFunc UserSourceTermPencil_;
   TimeStepFunc UserTimeStep_;
+  TimeStepPencilFunc UserTimeStepPencil_;
   HistoryOutputFunc *user_history_func_;
+  OutputRegionFunc UserOutputRegion_;
   MetricFunc UserMetric_;
   ViscosityCoeffFunc ViscosityCoeff_;
   ConductionCoeffFunc ConductionCoeff_;
@@ -328,9 +371,12 @@ class Mesh {
   void ResetLoadBalanceVariables();
 
   void CorrectMidpointInitialCondition();
+  void ExchangeGhostCells(Real t);
+  void ComputeGhostPrimitives(Real t);
   void ReserveMeshBlockPhysIDs();
 
   // Mesh::LoadBalancingAndAdaptiveMeshRefinement() helper functions:
+  void SetAMRBudget(ParameterInput *pin);
   void UpdateCostList();
   void UpdateMeshBlockTree(int &nnew, int &ndel);
   bool GatherCostListAndCheckBalance();
@@ -365,10 +411,16 @@ class Mesh {
   void EnrollUserRefinementCondition(AMRFlagFunc amrflag);
   void EnrollUserMeshGenerator(CoordinateDirection dir, MeshGenFunc my_mg);
   void EnrollUserExplicitSourceFunction(SrcTermFunc my_func);
+  void EnrollUserExplicitSourcePencilFunction(SrcTermPencilFunc my_func);
   void EnrollUserTimeStepFunction(TimeStepFunc my_func);
+  void EnrollUserTimeStepPencilFunction(TimeStepPencilFunc my_func);
+  void EnrollPhysicsModule(const char *name, SrcTermFunc my_func, PhysicsStage stage,
+                           int interval=1, int reads=kPhysAll, int writes=kPhysAll,
+                           bool thread_safe=true);
   void AllocateUserHistoryOutput(int n);
   void EnrollUserHistoryOutput(int i, HistoryOutputFunc my_func, const char *name,
                                UserHistoryOperation op=UserHistoryOperation::sum);
+  void EnrollUserOutputRegion(OutputRegionFunc my_func);
   void EnrollUserMetric(MetricFunc my_func);
   void EnrollViscosityCoefficient(ViscosityCoeffFunc my_func);
   void EnrollConductionCoefficient(ConductionCoeffFunc my_func);
@@ -0,0 +1,307 @@
+//========================================================================================
+// Athena++ astrophysical MHD code
+// Copyright(C) 2014 James M. Stone <jmstone@princeton.edu> and other code contributors
+// Licensed under the 3-clause BSD License, see LICENSE file for details
+//========================================================================================
+//! \file mesh_checkpoint.cpp
+//! \brief in-memory checkpoints, health check and rollback of failed cycles
+//!
+//! Parameters in the <rollback> block:
+//! - interval:     cycles between checkpoints (default 0 = off)
+//! - retry_cycles: cycles repeated with the reduced CFL number after a rollback
+//!                 (default 10)
+//! - max_retries:  consecutive rollbacks before the run is aborted (default 3)
+//! - cfl_factor:   factor applied to the CFL number for each rollback (default 0.5)
+//! - first_order:  use first-order reconstruction while retrying (default true)
+//! - check_floors: count cells at the density or pressure floor as failures, e.g. cells
+//!                 where the EOS has replaced a negative pressure (default true; if
+//!                 false, only NaNs and non-positive density/pressure count)
+//!
+//! A new checkpoint is also taken whenever AMR or load balancing has changed the
+//! MeshBlocks since the last one. Outputs of the cycles between the checkpoint and the
+//! failed cycle (which all passed the check) are kept; outputs that fall due again while
+//! retrying are rewritten, and athena_read.hst drops the superseded history rows as
+//! after a restart. The random forcing of the turbulence driver is not rewound.
+
+// C headers
+
+// C++ headers
+#include <algorithm>  // copy
+#include <cmath>      // isfinite, pow
+#include <iostream>   // cout, endl
+#include <sstream>    // stringstream
+#include <stdexcept>  // runtime_error
+#include <vector>
+
+// Athena++ headers
+#include "../athena.hpp"
+#include "../athena_arrays.hpp"
+#include "../eos/eos.hpp"
+#include "../field/field.hpp"
+#include "../globals.hpp"
+#include "../hydro/hydro.hpp"
+#include "../hydro/srcterms/sink_particles.hpp"
+#include "../parameter_input.hpp"
+#include "../reconstruct/reconstruction.hpp"
+#include "../scalars/scalars.hpp"
+#include "mesh.hpp"
+#include "mesh_checkpoint.hpp"
+
+#ifdef MPI_PARALLEL
+#include <mpi.h>
+#endif
+
+//----------------------------------------------------------------------------------------
+//! \fn MeshCheckpoint::MeshCheckpoint(Mesh *pm, ParameterInput *pin)
+//! \brief read the <rollback> block
+
+MeshCheckpoint::MeshCheckpoint(Mesh *pm, ParameterInput *pin) : pmy_mesh_(pm),
+    interval_(pin->GetInteger("rollback", "interval")),
+    retry_cycles_(pin->GetOrAddInteger("rollback", "retry_cycles", 10)),
+    max_retries_(pin->GetOrAddInteger("rollback", "max_retries", 3)),
+    cfl_factor_(pin->GetOrAddReal("rollback", "cfl_factor", 0.5)),
+    first_order_(pin->GetOrAddBoolean("rollback", "first_order", true)),
+    check_floors_(pin->GetOrAddBoolean("rollback", "check_floors", true)),
+    valid_(false), saved_cycle_(), saved_time_(), saved_dt_(), sink_next_id_(),
+    ceiling_losses_(),
+    nretry_(), retry_left_(), cfl_number_(pm->cfl_number), xorder_(1) {
+  if (interval_ < 1 || retry_cycles_ < 1 || max_retries_ < 1
+      || cfl_factor_ <= 0.0 || cfl_factor_ >= 1.0) {
+    std::stringstream msg;
+    msg << "### FATAL ERROR in MeshCheckpoint constructor" << std::endl
+        << "<rollback> requires interval, retry_cycles, max_retries >= 1 and "
+        << "0 < cfl_factor < 1." << std::endl;
+    ATHENA_ERROR(msg);
+  }
+  if (pm->nblocal > 0) xorder_ = pm->my_blocks(0)->precon->xorder;
+  // the fourth-order solver keeps its own cell-average/point-value arrays
+  if (xorder_ == 4) first_order_ = false;
+}
+
+//----------------------------------------------------------------------------------------
+//! \fn void MeshCheckpoint::BlockArrays(MeshBlock *pmb,
+//!                                      std::vector<AthenaArray<Real>*> &arrays)
+//! \brief list the real-valued arrays of a MeshBlock that make up its state
+
+void MeshCheckpoint::BlockArrays(MeshBlock *pmb,
+                                 std::vector<AthenaArray<Real>*> &arrays) {
+  arrays.clear();
+  arrays.push_back(&(pmb->phydro->u));
+  arrays.push_back(&(pmb->phydro->w));
+  if (MAGNETIC_FIELDS_ENABLED) {
+    arrays.push_back(&(pmb->pfield->b.x1f));
+    arrays.push_back(&(pmb->pfield->b.x2f));
+    arrays.push_back(&(pmb->pfield->b.x3f));
+    arrays.push_back(&(pmb->pfield->bcc));
+  }
+  if (NSCALARS > 0) {
+    arrays.push_back(&(pmb->pscalars->s));
+    arrays.push_back(&(pmb->pscalars->r));
+  }
+  for (int n=0; n<pmb->nreal_user_meshblock_data_; ++n)
+    arrays.push_back(&(pmb->ruser_meshblock_data[n]));
+  return;
+}
+
+//----------------------------------------------------------------------------------------
+//! \fn void MeshCheckpoint::Save()
+//! \brief copy the state if the interval has passed (not while retrying) or if the
+//!        MeshBlocks have changed since the last checkpoint. Local, but every rank makes
+//!        the same decision.
+
+void MeshCheckpoint::Save() {
+  Mesh *pm = pmy_mesh_;
+  if (valid_ && pm->step_since_lb != 0
+      && (retry_left_ > 0 || pm->ncycle - saved_cycle_ < interval_)) return;
+
+  std::vector<AthenaArray<Real>*> arrays;
+  block_data_.resize(pm->nblocal);
+  block_idata_.resize(pm->nblocal);
+  for (int b=0; b<pm->nblocal; ++b) {
+    MeshBlock *pmb = pm->my_blocks(b);
+    BlockArrays(pmb, arrays);
+    std::size_t size = 0;
+    for (AthenaArray<Real> *parr : arrays) size += parr->GetSize();
+    std::vector<Real> &data = block_data_[b];
+    data.resize(size);
+    Real *pdata = data.data();
+    for (AthenaArray<Real> *parr : arrays) {
+      std::copy(parr->data(), parr->data() + parr->GetSize(), pdata);
+      pdata += parr->GetSize();
+    }
+    std::vector<int> &idata = block_idata_[b];
+    idata.clear();
+    for (int n=0; n<pmb->nint_user_meshblock_data_; ++n) {
+      AthenaArray<int> &iarr = pmb->iuser_meshblock_data[n];
+      idata.insert(idata.end(), iarr.data(), iarr.data() + iarr.GetSize());
+    }
+  }
+
+  mesh_data_.clear();
+  for (int n=0; n<pm->nreal_user_mesh_data_; ++n) {
+    AthenaArray<Real> &arr = pm->ruser_mesh_data[n];
+    mesh_data_.insert(mesh_data_.end(), arr.data(), arr.data() + arr.GetSize());
+  }
+  mesh_idata_.clear();
+  for (int n=0; n<pm->nint_user_mesh_data_; ++n) {
+    AthenaArray<int> &iarr = pm->iuser_mesh_data[n];
+    mesh_idata_.insert(mesh_idata_.end(), iarr.data(), iarr.data() + iarr.GetSize());
+  }
+  if (pm->psinks != nullptr) {
+    sinks_ = pm->psinks->sinks;
+    sink_next_id_ = pm->psinks->next_id_;
+  }
+  ceiling_losses_[0] = pm->ceiling_losses[0];
+  ceiling_losses_[1] = pm->ceiling_losses[1];
+
+  // time steps for the input CFL number (checkpoints may be taken while retrying)
+  Real factor = cfl_number_/pm->cfl_number;
+  saved_cycle_ = pm->ncycle;
+  saved_time_ = pm->time;
+  saved_dt_[0] = factor*pm->dt;
+  saved_dt_[1] = factor*pm->dt_hyperbolic;
+  saved_dt_[2] = factor*pm->dt_parabolic;
+  valid_ = true;
+  return;
+}
+
+//----------------------------------------------------------------------------------------
+//! \fn bool MeshCheckpoint::Healthy()
+//! \brief check the active cells of all MeshBlocks for NaNs and non-positive (or, with
+//!        check_floors, floored) density and pressure; collective
+
+bool MeshCheckpoint::Healthy() {
+  Mesh *pm = pmy_mesh_;
+  int nbad = 0;
+  for (int b=0; b<pm->nblocal; ++b) {
+    MeshBlock *pmb = pm->my_blocks(b);
+    AthenaArray<Real> &u = pmb->phydro->u, &w = pmb->phydro->w;
+    Real dfloor = 0.0, pfloor = 0.0;
+    if (check_floors_) {
+      dfloor = pmb->peos->GetDensityFloor();
+      pfloor = pmb->peos->GetPressureFloor();
+    }
+    for (int k=pmb->ks; k<=pmb->ke; ++k) {
+      for (int j=pmb->js; j<=pmb->je; ++j) {
+#pragma omp simd reduction(+:nbad)
+        for (int i=pmb->is; i<=pmb->ie; ++i) {
+          // written so that NaNs fail the comparisons
+          bool ok = (u(IDN,k,j,i) > 0.0) && (w(IDN,k,j,i) > dfloor)
+                    && std::isfinite(u(IM1,k,j,i) + u(IM2,k,j,i) + u(IM3,k,j,i));
+          if (NON_BAROTROPIC_EOS)
+            ok = ok && std::isfinite(u(IEN,k,j,i)) && (w(IPR,k,j,i) > pfloor);
+          nbad += ok ? 0 : 1;
+        }
+      }
+    }
+  }
+#ifdef MPI_PARALLEL
+  MPI_Allreduce(MPI_IN_PLACE, &nbad, 1, MPI_INT, MPI_SUM, MPI_COMM_WORLD);
+#endif
+  return (nbad == 0);
+}
+
+//----------------------------------------------------------------------------------------
+//! \fn void MeshCheckpoint::Restore()
+//! \brief copy the checkpoint back into the MeshBlocks and the Mesh
+
+void MeshCheckpoint::Restore() {
+  Mesh *pm = pmy_mesh_;
+  std::vector<AthenaArray<Real>*> arrays;
+  for (int b=0; b<pm->nblocal; ++b) {
+    MeshBlock *pmb = pm->my_blocks(b);
+    BlockArrays(pmb, arrays);
+    const Real *pdata = block_data_[b].data();
+    for (AthenaArray<Real> *parr : arrays) {
+      std::copy(pdata, pdata + parr->GetSize(), parr->data());
+      pdata += parr->GetSize();
+    }
+    const int *pidata = block_idata_[b].data();
+    for (int n=0; n<pmb->nint_user_meshblock_data_; ++n) {
+      AthenaArray<int> &iarr = pmb->iuser_meshblock_data[n];
+      std::copy(pidata, pidata + iarr.GetSize(), iarr.data());
+      pidata += iarr.GetSize();
+    }
+    // drop the energy removed by the ceilings in the cycles that are undone
+    Real losses[2] = {0.0, 0.0};
+    pmb->peos->TakeCeilingLosses(losses);
+  }
+
+  const Real *pdata = mesh_data_.data();
+  for (int n=0; n<pm->nreal_user_mesh_data_; ++n) {
+    AthenaArray<Real> &arr = pm->ruser_mesh_data[n];
+    std::copy(pdata, pdata + arr.GetSize(), arr.data());
+    pdata += arr.GetSize();
+  }
+  const int *pidata = mesh_idata_.data();
+  for (int n=0; n<pm->nint_user_mesh_data_; ++n) {
+    AthenaArray<int> &iarr = pm->iuser_mesh_data[n];
+    std::copy(pidata, pidata + iarr.GetSize(), iarr.data());
+    pidata += iarr.GetSize();
+  }
+  if (pm->psinks != nullptr) {
+    pm->psinks->sinks = sinks_;
+    pm->psinks->next_id_ = sink_next_id_;
+    pm->psinks->pending_ = false;  // drop the accretion of the cycle that is undone
+  }
+  pm->ceiling_losses[0] = ceiling_losses_[0];
+  pm->ceiling_losses[1] = ceiling_losses_[1];
+
+  // retry with the CFL number reduced once per consecutive rollback
+  Real factor = std::pow(cfl_factor_, nretry_);
+  pm->ncycle = saved_cycle_;
+  pm->time = saved_time_;
+  pm->dt = factor*saved_dt_[0];
+  pm->dt_hyperbolic = factor*saved_dt_[1];
+  pm->dt_parabolic = factor*saved_dt_[2];
+  pm->cfl_number = factor*cfl_number_;
+  return;
+}
+
+//----------------------------------------------------------------------------------------
+//! \fn bool MeshCheckpoint::CheckAndRollback()
+//! \brief call after each cycle, before time and ncycle are advanced. Returns true if the
+//!        cycle failed and the Mesh was rolled back to the last checkpoint; collective
+
+bool MeshCheckpoint::CheckAndRollback() {
+  Mesh *pm = pmy_mesh_;
+  if (Healthy()) {
+    // after retry_cycles good cycles, return to the normal CFL number and order
+    if (retry_left_ > 0 && --retry_left_ == 0) {
+      nretry_ = 0;
+      pm->cfl_number = cfl_number_;
+      for (int b=0; b<pm->nblocal; ++b)
+        pm->my_blocks(b)->precon->xorder = xorder_;
+      if (Globals::my_rank == 0)
+        std::cout << "Rollback: resuming normal stepping at cycle " << pm->ncycle + 1
+                  << std::endl;
+    }
+    return false;
+  }
+
+  int failed_cycle = pm->ncycle;
+  if (!valid_ || ++nretry_ > max_retries_) {
+    std::stringstream msg;
+    msg << "### FATAL ERROR in MeshCheckpoint::CheckAndRollback" << std::endl
+        << "Cycle " << failed_cycle << " failed the health check";
+    if (valid_)
+      msg << " after " << max_retries_ << " rollbacks to cycle " << saved_cycle_;
+    msg << "." << std::endl;
+    ATHENA_ERROR(msg);
+  }
+
+  Restore();
+  retry_left_ = retry_cycles_;
+  if (first_order_) {
+    for (int b=0; b<pm->nblocal; ++b)
+      pm->my_blocks(b)->precon->xorder = 1;
+  }
+  if (Globals::my_rank == 0) {
+    std::cout << "### Warning in MeshCheckpoint::CheckAndRollback" << std::endl
+              << "Cycle " << failed_cycle << " failed the health check; rolling back to "
+              << "cycle " << saved_cycle_ << " (time=" << saved_time_ << ") and retrying "
+              << retry_cycles_ << " cycles with cfl_number=" << pm->cfl_number
+              << (first_order_ ? " and first-order reconstruction" : "") << std::endl;
+  }
+  return true;
+}
@@ -0,0 +1,74 @@
+#ifndef MESH_MESH_CHECKPOINT_HPP_
+#define MESH_MESH_CHECKPOINT_HPP_
+//========================================================================================
+// Athena++ astrophysical MHD code
+// Copyright(C) 2014 James M. Stone <jmstone@princeton.edu> and other code contributors
+// Licensed under the 3-clause BSD License, see LICENSE file for details
+//========================================================================================
+//! \file mesh_checkpoint.hpp
+//! \brief defines class MeshCheckpoint, an in-memory copy of the solution used to roll
+//!        back and retry cycles that produce unphysical states
+
+// C headers
+
+// C++ headers
+#include <cstdint>  // int64_t
+#include <vector>
+
+// Athena++ headers
+#include "../athena.hpp"
+#include "../athena_arrays.hpp"
+#include "../hydro/srcterms/sink_particles.hpp"
+
+// Forward declarations
+class Mesh;
+class MeshBlock;
+class ParameterInput;
+
+//! \class MeshCheckpoint
+//! \brief keeps a copy of the conserved and primitive variables (including ghost zones),
+//!        the magnetic field, passive scalars, user data and sink particles of every
+//!        local MeshBlock. If a cycle fails the health check on any rank, every rank
+//!        restores the copy and repeats the cycles with a reduced CFL number (and
+//!        optionally first-order reconstruction).
+
+class MeshCheckpoint {
+ public:
+  MeshCheckpoint(Mesh *pm, ParameterInput *pin);
+
+  // functions
+  void Save();              // at the start of a cycle; copies the state if one is due
+  bool CheckAndRollback();  // after a cycle; collective; true if the cycle was undone
+
+ private:
+  Mesh *pmy_mesh_;
+  int interval_;       // cycles between checkpoints
+  int retry_cycles_;   // cycles taken with the reduced CFL number after a rollback
+  int max_retries_;    // consecutive rollbacks before the run is aborted
+  Real cfl_factor_;    // factor applied to the CFL number for each retry
+  bool first_order_;   // also fall back to first-order reconstruction while retrying
+  bool check_floors_;  // count cells at the density/pressure floor as failures
+
+  // state saved with the checkpoint
+  bool valid_;
+  int saved_cycle_;
+  Real saved_time_, saved_dt_[3];  // time; dt, dt_hyperbolic, dt_parabolic
+  std::vector<std::vector<Real>> block_data_;  // [lid][all arrays of the block]
+  std::vector<std::vector<int>> block_idata_;  // [lid][integer user data]
+  std::vector<Real> mesh_data_;
+  std::vector<int> mesh_idata_;
+  std::vector<SinkParticle> sinks_;
+  std::int64_t sink_next_id_;
+  Real ceiling_losses_[2];  // Mesh::ceiling_losses
+
+  // retry bookkeeping
+  int nretry_;      // consecutive rollbacks to the current checkpoint
+  int retry_left_;  // cycles left with the reduced CFL number
+  Real cfl_number_;  // CFL number of the input file
+  int xorder_;       // reconstruction order of the input file
+
+  void BlockArrays(MeshBlock *pmb, std::vector<AthenaArray<Real>*> &arrays);
+  bool Healthy();
+  void Restore();
+};
+#endif // MESH_MESH_CHECKPOINT_HPP_
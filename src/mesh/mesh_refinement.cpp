@@ -35,7 +35,7 @@
 MeshRefinement::MeshRefinement(MeshBlock *pmb, ParameterInput *pin) :
     pmy_block_(pmb), deref_count_(0),
     deref_threshold_(pin->GetOrAddInteger("mesh", "derefine_count", 10)),
-    AMRFlag_(pmb->pmy_mesh->AMRFlag_) {
+    refine_indicator_(), AMRFlag_(pmb->pmy_mesh->AMRFlag_) {
   // Create coarse mesh object for parent grid
   if (std::strcmp(COORDINATE_SYSTEM, "cartesian") == 0) {
     pcoarsec = new Cartesian(pmb, pin, true);
@@ -978,6 +978,7 @@ void MeshRefinement::CheckRefinementCondition() {
   MeshBlock *pmb = pmy_block_;
   int ret = 0, aret = -1;
   refine_flag_ = 0;
+  refine_indicator_ = 0.0;
 
   //! \todo **should be implemented later:**
   //! loop-over refinement criteria
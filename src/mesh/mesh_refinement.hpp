@@ -70,6 +70,9 @@ class MeshRefinement {
   void ProlongateInternalField(FaceField &fine,
                                int si, int ei, int sj, int ej, int sk, int ek);
   void CheckRefinementCondition();
+  // magnitude of the refinement criterion, set by the user refinement condition; used to
+  // rank the requests for refinement when the AMR budget in <mesh> is reached
+  void SetRefinementIndicator(Real indicator) {refine_indicator_ = indicator;}
 
   // setter functions for "enrolling" variable arrays in refinement via Mesh::AMR()
   // and/or in BoundaryValues::ProlongateBoundaries() (for SMR and AMR)
@@ -86,6 +89,7 @@ class MeshRefinement {
 
   AthenaArray<Real> fvol_[2][2], sarea_x1_[2][2], sarea_x2_[2][3], sarea_x3_[3][2];
   int refine_flag_, neighbor_rflag_, deref_count_, deref_threshold_;
+  Real refine_indicator_;
 
   // functions
   AMRFlagFunc AMRFlag_; // duplicate of Mesh class member
@@ -31,6 +31,7 @@
 #include "../gravity/gravity.hpp"
 #include "../gravity/mg_gravity.hpp"
 #include "../hydro/hydro.hpp"
+#include "../hydro/hydro_diffusion/mg_conduction.hpp"
 #include "../orbital_advection/orbital_advection.hpp"
 #include "../parameter_input.hpp"
 #include "../reconstruct/reconstruction.hpp"
@@ -40,6 +41,11 @@
 #include "mesh_refinement.hpp"
 #include "meshblock_tree.hpp"
 
+// OpenMP header
+#ifdef OPENMP_PARALLEL
+#include <omp.h>
+#endif
+
 //----------------------------------------------------------------------------------------
 //! MeshBlock constructor: constructs coordinate, boundary condition, hydro, field
 //!                        and mesh refinement objects.
@@ -159,6 +165,9 @@ MeshBlock::MeshBlock(int igid, int ilid, LogicalLocation iloc, RegionSize input_
     if (SELF_GRAVITY_ENABLED == 2)
       pmg = new MGGravity(pmy_mesh->pmgrd, this);
   }
+  pmgcnd = nullptr;
+  if (pmy_mesh->pmgcd != nullptr)
+    pmgcnd = new MGConduction(pmy_mesh->pmgcd, this);
   if (NSCALARS > 0) {
     // if (this->scalars_block)
     pscalars = new PassiveScalars(this, pin);
@@ -285,6 +294,9 @@ MeshBlock::MeshBlock(int igid, int ilid, Mesh *pm, ParameterInput *pin,
     if (SELF_GRAVITY_ENABLED == 2)
       pmg = new MGGravity(pmy_mesh->pmgrd, this);
   }
+  pmgcnd = nullptr;
+  if (pmy_mesh->pmgcd != nullptr)
+    pmgcnd = new MGConduction(pmy_mesh->pmgcd, this);
 
   if (NSCALARS > 0) {
     // if (this->scalars_block)
@@ -355,6 +367,7 @@ MeshBlock::~MeshBlock() {
   delete porb;
   if (SELF_GRAVITY_ENABLED) delete pgrav;
   if (NSCALARS > 0) delete pscalars;
+  delete pmgcnd;
 
   // BoundaryValues should be destructed AFTER all BoundaryVariable objects are destroyed
   delete pbval;
@@ -511,6 +524,39 @@ void MeshBlock::StopTimeMeasurement() {
   }
 }
 
+//----------------------------------------------------------------------------------------
+//! \fn void MeshBlock::LoopThreadRange(int &jl, int &ju, int &kl, int &ku) const
+//! \brief narrow the (k,j) loop limits to the part handled by the calling thread of a
+//!        loop-level team (<mesh> num_loop_threads); no-op outside such a team
+//!
+//! All loop-threaded kernels use the same partition: the active cells along the
+//! outermost dimension (x3 in 3D, x2 in 2D) are split into equal contiguous slabs in
+//! thread order, and the ghost cells (and faces) below and above the active range go to
+//! the first and last thread. Any (sub)range is split along the same boundaries, so a
+//! cell is always updated by the same thread. 1D MeshBlocks are not split. The ghost
+//! buffer Pack/Unpack loops split by (n,k) planes instead.
+//!
+//! The arrays are zero-filled by the allocating thread, so this gives cache reuse between
+//! kernels but no first-touch NUMA placement: a loop team should stay within one NUMA
+//! domain (e.g. one MPI rank per domain).
+
+void MeshBlock::LoopThreadRange(int &jl, int &ju, int &kl, int &ku) const {
+#ifdef OPENMP_PARALLEL
+  const int nt = omp_get_num_threads(), t = omp_get_thread_num();
+  if (nt == 1) return;
+  if (block_size.nx2 == 1) {
+    if (t > 0) ku = kl - 1;  // nothing to do on the other threads
+    return;
+  }
+  const bool split_k = (block_size.nx3 > 1);
+  const int s = split_k ? ks : js, n = split_k ? (ke - ks + 1) : (je - js + 1);
+  int &l = split_k ? kl : jl, &u = split_k ? ku : ju;
+  if (t > 0) l = std::max(l, s + (t*n)/nt);
+  if (t < nt - 1) u = std::min(u, s + ((t+1)*n)/nt - 1);
+#endif
+  return;
+}
+
 
 void MeshBlock::RegisterMeshBlockData(AthenaArray<Real> &pvar_cc) {
   vars_cc_.push_back(pvar_cc);
@@ -229,6 +229,84 @@ void MeshBlock::WeightedAve(AthenaArray<Real> &u_out, AthenaArray<Real> &u_in1,
 }
 
 
+//----------------------------------------------------------------------------------------
+//! \fn void MeshBlock::WeightedAvePencil(AthenaArray<Real> &u_out,
+//!                                       AthenaArray<Real> &u_in1,
+//!                                       AthenaArray<Real> &u_in2,
+//!                                       const Real wght[3], const int k, const int j)
+//! \brief Weighted average U = a*U + b*U1 + c*U2 restricted to the (k,j) pencil
+//!
+//! * used by the fused stage update, which applies the register averaging, the flux
+//!   divergence and the pencil source terms in a single sweep over the MeshBlock
+//! * the branches and the order of operations mirror WeightedAve() so that the fused
+//!   and the unfused updates are bitwise identical
+
+void MeshBlock::WeightedAvePencil(AthenaArray<Real> &u_out, AthenaArray<Real> &u_in1,
+                                  AthenaArray<Real> &u_in2, const Real wght[3],
+                                  const int k, const int j) {
+  const int nu = u_out.GetDim4() - 1;
+
+  // u_in2 may be an unallocated AthenaArray if using a 2S time integrator
+  if (wght[0] == 1.0) {
+    if (wght[2] != 0.0) {
+      for (int n=0; n<=nu; ++n) {
+#pragma omp simd
+        for (int i=is; i<=ie; ++i) {
+          u_out(n,k,j,i) += wght[1]*u_in1(n,k,j,i) + wght[2]*u_in2(n,k,j,i);
+        }
+      }
+    } else if (wght[1] != 0.0) {
+      for (int n=0; n<=nu; ++n) {
+#pragma omp simd
+        for (int i=is; i<=ie; ++i) {
+          u_out(n,k,j,i) += wght[1]*u_in1(n,k,j,i);
+        }
+      }
+    }
+  } else if (wght[0] == 0.0) {
+    if (wght[2] != 0.0) {
+      for (int n=0; n<=nu; ++n) {
+#pragma omp simd
+        for (int i=is; i<=ie; ++i) {
+          u_out(n,k,j,i) = wght[1]*u_in1(n,k,j,i) + wght[2]*u_in2(n,k,j,i);
+        }
+      }
+    } else {
+      for (int n=0; n<=nu; ++n) {
+#pragma omp simd
+        for (int i=is; i<=ie; ++i) {
+          u_out(n,k,j,i) = wght[1]*u_in1(n,k,j,i);
+        }
+      }
+    }
+  } else {
+    if (wght[2] != 0.0) {
+      for (int n=0; n<=nu; ++n) {
+#pragma omp simd
+        for (int i=is; i<=ie; ++i) {
+          u_out(n,k,j,i) = wght[0]*u_out(n,k,j,i) + wght[1]*u_in1(n,k,j,i)
+                           + wght[2]*u_in2(n,k,j,i);
+        }
+      }
+    } else if (wght[1] != 0.0) {
+      for (int n=0; n<=nu; ++n) {
+#pragma omp simd
+        for (int i=is; i<=ie; ++i) {
+          u_out(n,k,j,i) = wght[0]*u_out(n,k,j,i) + wght[1]*u_in1(n,k,j,i);
+        }
+      }
+    } else {
+      for (int n=0; n<=nu; ++n) {
+#pragma omp simd
+        for (int i=is; i<=ie; ++i) {
+          u_out(n,k,j,i) *= wght[0];
+        }
+      }
+    }
+  }
+  return;
+}
+
 //----------------------------------------------------------------------------------------
 //! \fn void MeshBlock::WeightedAve(FaceField &b_out, FaceField &b_in1,
 //!                                 FaceField &b_in2, FaceField &b_in3,
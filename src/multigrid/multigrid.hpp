@@ -124,6 +124,7 @@ class Multigrid {
   friend class MGBoundaryValues;
   friend class MGGravityBoundaryValues;
   friend class MGGravityDriver;
+  friend class MGConductionDriver;
 
  protected:
   MultigridDriver *pmy_driver_;
@@ -145,7 +146,7 @@ class Multigrid {
 
 class MultigridDriver {
  public:
-  MultigridDriver(Mesh *pm, MGBoundaryFunc *MGBoundary, int invar);
+  MultigridDriver(Mesh *pm, MGBoundaryFunc *MGBoundary, int invar, bool fas = false);
   virtual ~MultigridDriver();
   void SubtractAverage(MGVariable type);
   void SetupMultigrid();
@@ -195,6 +196,7 @@ class MultigridDriver {
   friend class Multigrid;
   friend class MultigridTaskList;
   friend class MGGravity;
+  friend class MGConduction;
   friend class MGBoundaryValues;
   friend class MGGravityBoundaryValues;
 
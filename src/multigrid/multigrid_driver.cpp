@@ -32,13 +32,15 @@
 #endif
 
 // constructor, initializes data structures and parameters
+// fas = true forces the Full Approximation Scheme also without mesh refinement
 
-MultigridDriver::MultigridDriver(Mesh *pm, MGBoundaryFunc *MGBoundary, int invar) :
+MultigridDriver::MultigridDriver(Mesh *pm, MGBoundaryFunc *MGBoundary, int invar,
+                                 bool fas) :
     nvar_(invar),
     mode_(0), // 0: V(1,1) FMG one sweep, 1: FMG + iterative, 2: V(1,1) iterative
     maxreflevel_(pm->multilevel?pm->max_level-pm->root_level:0),
     nrbx1_(pm->nrbx1), nrbx2_(pm->nrbx2), nrbx3_(pm->nrbx3), pmy_mesh_(pm),
-    fsubtract_average_(false), ffas_(pm->multilevel), eps_(-1.0),
+    fsubtract_average_(false), ffas_(pm->multilevel || fas), eps_(-1.0),
     cbuf_(nvar_,3,3,3), cbufold_(nvar_,3,3,3) {
   if (pmy_mesh_->mesh_size.nx2==1 || pmy_mesh_->mesh_size.nx3==1) {
     std::stringstream msg;
@@ -0,0 +1,203 @@
+//========================================================================================
+// Athena++ astrophysical MHD code
+// Copyright(C) 2014 James M. Stone <jmstone@princeton.edu> and other code contributors
+// Licensed under the 3-clause BSD License, see LICENSE file for details
+//========================================================================================
+//! \file analysis.cpp
+//! \brief implements the loading and calling of the in-situ analysis plugins
+
+// C headers
+
+// C++ headers
+#include <cstdio>     // fflush(), fopen(), fputs()
+#include <sstream>    // stringstream
+#include <stdexcept>  // runtime_error
+#include <string>     // string
+#include <utility>    // move()
+
+// Athena++ headers
+#include "../athena.hpp"
+#include "../globals.hpp"
+#include "../mesh/global_reduction.hpp"
+#include "../mesh/mesh.hpp"
+#include "../parameter_input.hpp"
+#include "analysis.hpp"
+
+// dynamic loading is only needed if analysis plugins are enabled
+#ifdef ANALYSIS_PLUGINS
+#include <dlfcn.h>    // dlclose(), dlerror(), dlopen(), dlsym()
+#endif
+
+//----------------------------------------------------------------------------------------
+//! AnalysisPlugins constructor: load the libraries of the <analysis[n]> blocks
+
+AnalysisPlugins::AnalysisPlugins(Mesh *pm, ParameterInput *pin) {
+  std::stringstream msg;
+  for (InputBlock *pib = pin->pfirst_block; pib != nullptr; pib = pib->pnext) {
+    if (pib->block_name.compare(0, 8, "analysis") != 0) continue;
+    Plugin plugin;
+    plugin.block_name = pib->block_name;
+    std::string library = pin->GetString(pib->block_name, "library");
+    plugin.dcycle = pin->GetOrAddInteger(pib->block_name, "dcycle", 1);
+    std::string id = pin->GetOrAddString(pib->block_name, "id",
+                                         "an" + pib->block_name.substr(8));
+    if (plugin.dcycle < 1) {
+      msg << "### FATAL ERROR in AnalysisPlugins constructor" << std::endl
+          << "dcycle must be >= 1 in block <" << pib->block_name << ">" << std::endl;
+      ATHENA_ERROR(msg);
+    }
+#ifdef ANALYSIS_PLUGINS
+    plugin.handle = dlopen(library.c_str(), RTLD_NOW | RTLD_LOCAL);
+    if (plugin.handle == nullptr) {
+      msg << "### FATAL ERROR in AnalysisPlugins constructor" << std::endl
+          << "cannot load plugin '" << library << "': " << dlerror() << std::endl;
+      ATHENA_ERROR(msg);
+    }
+    AnalysisPluginFactory create = reinterpret_cast<AnalysisPluginFactory>(
+        dlsym(plugin.handle, "CreateAnalysisPlugin"));
+    if (create == nullptr) {
+      msg << "### FATAL ERROR in AnalysisPlugins constructor" << std::endl
+          << "plugin '" << library << "' does not define CreateAnalysisPlugin; "
+          << "use ATHENA_ANALYSIS_PLUGIN()" << std::endl;
+      ATHENA_ERROR(msg);
+    }
+    plugin.pplugin = create(pin, pib->block_name);
+    plugin.pctx = new AnalysisContext(
+        pm, pin->GetString("job", "problem_id") + "." + id + ".txt");
+    plugins_.push_back(std::move(plugin));
+#else
+    msg << "### FATAL ERROR in AnalysisPlugins constructor" << std::endl
+        << "block <" << pib->block_name << "> requires analysis plugins;" << std::endl
+        << "configure with -plugins" << std::endl;
+    ATHENA_ERROR(msg);
+#endif
+  }
+}
+
+// destructor
+
+AnalysisPlugins::~AnalysisPlugins() {
+  for (Plugin &plugin : plugins_) {
+    delete plugin.pctx;
+    // the code of the destructor lives in the library
+    delete plugin.pplugin;
+#ifdef ANALYSIS_PLUGINS
+    dlclose(plugin.handle);
+#endif
+  }
+}
+
+//----------------------------------------------------------------------------------------
+//! \fn void AnalysisPlugins::Execute(Mesh *pm, bool final)
+//! \brief call the plugins that are due in this cycle, or Finalize() all of them at the
+//!        end of the run
+
+void AnalysisPlugins::Execute(Mesh *pm, bool final) {
+  for (Plugin &plugin : plugins_) {
+    if (final) {
+      plugin.pctx->Update(pm);
+      plugin.pplugin->Finalize(plugin.pctx);
+    } else if (pm->ncycle % plugin.dcycle == 0) {
+      plugin.pctx->Update(pm);
+      plugin.pplugin->Analyze(plugin.pctx);
+    }
+  }
+  return;
+}
+
+//----------------------------------------------------------------------------------------
+//! AnalysisContext constructor
+
+AnalysisContext::AnalysisContext(Mesh *pm, std::string fname) :
+    time(pm->time), dt(pm->dt), ncycle(pm->ncycle), nbtotal(pm->nbtotal),
+    fname_(fname), pfile_(nullptr) {}
+
+// destructor
+
+AnalysisContext::~AnalysisContext() {
+  if (pfile_ != nullptr) std::fclose(pfile_);
+}
+
+//----------------------------------------------------------------------------------------
+//! \fn void AnalysisContext::Update(Mesh *pm)
+//! \brief refresh the state of the run and the views of the MeshBlocks, which change
+//!        with AMR and load balancing
+
+void AnalysisContext::Update(Mesh *pm) {
+  time = pm->time;
+  dt = pm->dt;
+  ncycle = pm->ncycle;
+  nbtotal = pm->nbtotal;
+  blocks_.clear();
+  for (int b=0; b<pm->nblocal; ++b)
+    blocks_.emplace_back(pm->my_blocks(b), pm->root_level);
+  return;
+}
+
+//----------------------------------------------------------------------------------------
+//! \fn Real AnalysisContext::Sum(Real val)
+//! \brief sum of val over all ranks
+
+Real AnalysisContext::Sum(Real val) {
+  Sum(&val, 1);
+  return val;
+}
+
+//----------------------------------------------------------------------------------------
+//! \fn void AnalysisContext::Sum(Real *val, int n)
+//! \brief sums of the n values over all ranks, in place
+
+void AnalysisContext::Sum(Real *val, int n) {
+  GlobalReduction red;
+  int slot = red.Register(ReductionOp::sum, n);
+  red.Accumulate(slot, val);
+  red.Start();
+  red.Finish();
+  for (int m=0; m<n; ++m)
+    val[m] = red.Result(slot, m);
+  return;
+}
+
+//----------------------------------------------------------------------------------------
+//! \fn Real AnalysisContext::Min(Real val)
+//! \brief minimum of val over all ranks
+
+Real AnalysisContext::Min(Real val) {
+  GlobalReduction red;
+  int slot = red.Register(ReductionOp::min);
+  red.Accumulate(slot, val);
+  red.Start();
+  red.Finish();
+  return red.Result(slot);
+}
+
+//----------------------------------------------------------------------------------------
+//! \fn Real AnalysisContext::Max(Real val)
+//! \brief maximum of val over all ranks
+
+Real AnalysisContext::Max(Real val) {
+  GlobalReduction red;
+  int slot = red.Register(ReductionOp::max);
+  red.Accumulate(slot, val);
+  red.Start();
+  red.Finish();
+  return red.Result(slot);
+}
+
+//----------------------------------------------------------------------------------------
+//! \fn void AnalysisContext::Write(const std::string &text)
+//! \brief append text to <problem_id>.<id>.txt on rank 0. The file is opened in append
+//!        mode, like the history file, so that restarted runs continue it.
+
+void AnalysisContext::Write(const std::string &text) {
+  if (Globals::my_rank != 0) return;
+  if (pfile_ == nullptr && (pfile_ = std::fopen(fname_.c_str(), "a")) == nullptr) {
+    std::stringstream msg;
+    msg << "### FATAL ERROR in function [AnalysisContext::Write]" << std::endl
+        << "Output file '" << fname_ << "' could not be opened" << std::endl;
+    ATHENA_ERROR(msg);
+  }
+  std::fputs(text.c_str(), pfile_);
+  std::fflush(pfile_);
+  return;
+}
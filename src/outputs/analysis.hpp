@@ -0,0 +1,153 @@
+#ifndef OUTPUTS_ANALYSIS_HPP_
+#define OUTPUTS_ANALYSIS_HPP_
+//========================================================================================
+// Athena++ astrophysical MHD code
+// Copyright(C) 2014 James M. Stone <jmstone@princeton.edu> and other code contributors
+// Licensed under the 3-clause BSD License, see LICENSE file for details
+//========================================================================================
+//! \file analysis.hpp
+//! \brief defines the interface of the in-situ analysis plugins and class
+//!        AnalysisPlugins, which loads them and calls them during the run
+//!
+//! A plugin is a shared library, built against the same configured source tree, that
+//! defines a class derived from AnalysisPlugin and exports its factory with
+//! ATHENA_ANALYSIS_PLUGIN(MyClass). Plugins are listed in <analysis[n]> blocks:
+//!
+//!     <analysis1>
+//!     library = ./mass_pdf.so  # shared library (required)
+//!     dcycle  = 10             # cycles between calls (default 1)
+//!     id      = pdf            # file name: <problem_id>.<id>.txt (default an<n>)
+//!
+//! together with any parameters of the plugin itself. Analyze() is called on all ranks
+//! after the initial outputs and every dcycle cycles after the outputs, with read-only
+//! views of the local MeshBlocks, and Finalize() once at the end of the run. The code
+//! must be configured with -plugins.
+
+// C headers
+
+// C++ headers
+#include <cstdio>     // FILE
+#include <string>
+#include <vector>
+
+// Athena++ headers
+#include "../athena.hpp"
+#include "../athena_arrays.hpp"
+#include "../coordinates/coordinates.hpp"
+#include "../field/field.hpp"
+#include "../hydro/hydro.hpp"
+#include "../mesh/mesh.hpp"
+#include "../scalars/scalars.hpp"
+
+class ParameterInput;
+
+//----------------------------------------------------------------------------------------
+//! \class AnalysisBlock
+//! \brief read-only view of a MeshBlock; bcc and r are null without magnetic fields or
+//!        passive scalars
+
+class AnalysisBlock {
+ public:
+  AnalysisBlock(MeshBlock *pmb, int root_level) :
+      gid(pmb->gid), level(pmb->loc.level - root_level),
+      is(pmb->is), ie(pmb->ie), js(pmb->js), je(pmb->je), ks(pmb->ks), ke(pmb->ke),
+      block_size(pmb->block_size), prim(pmb->phydro->w), cons(pmb->phydro->u),
+      bcc(MAGNETIC_FIELDS_ENABLED ? &pmb->pfield->bcc : nullptr),
+      r(NSCALARS > 0 ? &pmb->pscalars->r : nullptr),
+      x1v(pmb->pcoord->x1v), x2v(pmb->pcoord->x2v), x3v(pmb->pcoord->x3v),
+      x1f(pmb->pcoord->x1f), x2f(pmb->pcoord->x2f), x3f(pmb->pcoord->x3f),
+      pmb_(pmb) {}
+
+  const int gid, level;                 // global id, level relative to the root grid
+  const int is, ie, js, je, ks, ke;     // active cells
+  const RegionSize &block_size;
+  const AthenaArray<Real> &prim, &cons;
+  const AthenaArray<Real> *bcc, *r;
+  const AthenaArray<Real> &x1v, &x2v, &x3v, &x1f, &x2f, &x3f;
+
+  Real CellVolume(int k, int j, int i) const {
+    return pmb_->pcoord->GetCellVolume(k, j, i);
+  }
+
+ private:
+  MeshBlock *pmb_;
+};
+
+//----------------------------------------------------------------------------------------
+//! \class AnalysisContext
+//! \brief what a plugin sees in a call: the state of the run, the local MeshBlocks,
+//!        reductions over all ranks and an output file
+
+class AnalysisContext {
+ public:
+  AnalysisContext(Mesh *pm, std::string fname);
+  ~AnalysisContext();
+
+  Real time, dt;
+  int ncycle;
+  int nbtotal;  // total number of MeshBlocks
+  int NumBlocks() const {return static_cast<int>(blocks_.size());}
+  const AnalysisBlock &Block(int b) const {return blocks_[b];}
+
+  // reductions over all ranks; collective, so call them on all ranks in the same order
+  Real Sum(Real val);
+  Real Min(Real val);
+  Real Max(Real val);
+  void Sum(Real *val, int n);  // in place
+
+  // append text to the output file of the plugin; ignored except on rank 0
+  void Write(const std::string &text);
+
+ private:
+  friend class AnalysisPlugins;
+  std::vector<AnalysisBlock> blocks_;
+  std::string fname_;
+  std::FILE *pfile_;
+  void Update(Mesh *pm);
+};
+
+//----------------------------------------------------------------------------------------
+//! \class AnalysisPlugin
+//! \brief base class of the plugins. The constructor receives the input and the name of
+//!        the <analysis[n]> block, from which it can read its own parameters.
+
+class AnalysisPlugin {
+ public:
+  virtual ~AnalysisPlugin() = default;
+  virtual void Analyze(AnalysisContext *pctx) = 0;
+  virtual void Finalize(AnalysisContext *pctx) {}
+};
+
+using AnalysisPluginFactory = AnalysisPlugin *(*)(ParameterInput *pin,
+                                                  const std::string &block_name);
+
+//! exports the factory of plugin class `cls`, constructed from (pin, block_name)
+#define ATHENA_ANALYSIS_PLUGIN(cls)                                              \
+  extern "C" AnalysisPlugin *CreateAnalysisPlugin(ParameterInput *pin,          \
+                                                  const std::string &block_name) { \
+    return new cls(pin, block_name);                                             \
+  }
+
+//----------------------------------------------------------------------------------------
+//! \class AnalysisPlugins
+//! \brief the plugins listed in the input file
+
+class AnalysisPlugins {
+ public:
+  AnalysisPlugins(Mesh *pm, ParameterInput *pin);
+  ~AnalysisPlugins();
+
+  void Execute(Mesh *pm, bool final = false);
+
+ private:
+  struct Plugin {
+    std::string block_name;
+    int dcycle;
+    void *handle;            // from dlopen()
+    AnalysisPlugin *pplugin;
+    AnalysisContext *pctx;
+  };
+  std::vector<Plugin> plugins_;
+};
+
+#endif // OUTPUTS_ANALYSIS_HPP_
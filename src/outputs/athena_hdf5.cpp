@@ -17,6 +17,7 @@
 #include <sstream>    // stringstream
 #include <stdexcept>  // runtime_error
 #include <string>     // string
+#include <vector>
 
 // Athena++ headers
 #include "../athena.hpp"
@@ -51,11 +52,101 @@ using H5Real = float;
 #define H5T_NATIVE_REAL H5T_NATIVE_FLOAT
 #endif
 
+namespace {
+//----------------------------------------------------------------------------------------
+//! \fn void RestrictBlock(const H5Real *src, const Real *vol_src, int nvar, int nblocks,
+//!          int b, const int n[3], const int f[3], H5Real *dst, Real *vol_dst)
+//! \brief volume-weighted average over f[0]*f[1]*f[2] cells of MeshBlock b of all nvar
+//!        variables, stored as [nvar][nblocks][n[2]][n[1]][n[0]]. vol_src holds the
+//!        cell volumes of the block, vol_dst receives those of the coarse cells.
+
+void RestrictBlock(const H5Real *src, const Real *vol_src, int nvar, int nblocks, int b,
+                   const int n[3], const int f[3], H5Real *dst, Real *vol_dst) {
+  const int c1 = n[0]/f[0], c2 = n[1]/f[1], c3 = n[2]/f[2];
+  for (int k=0; k<c3; ++k) {
+    for (int j=0; j<c2; ++j) {
+      for (int i=0; i<c1; ++i) {
+        Real vol = 0.0;
+        for (int fk=k*f[2]; fk<(k+1)*f[2]; ++fk) {
+          for (int fj=j*f[1]; fj<(j+1)*f[1]; ++fj) {
+            for (int fi=i*f[0]; fi<(i+1)*f[0]; ++fi)
+              vol += vol_src[(fk*n[1] + fj)*n[0] + fi];
+          }
+        }
+        vol_dst[(k*c2 + j)*c1 + i] = vol;
+      }
+    }
+  }
+  for (int v=0; v<nvar; ++v) {
+    const H5Real *s = src + static_cast<std::size_t>(v*nblocks + b)*n[2]*n[1]*n[0];
+    H5Real *d = dst + static_cast<std::size_t>(v*nblocks + b)*c3*c2*c1;
+    for (int k=0; k<c3; ++k) {
+      for (int j=0; j<c2; ++j) {
+        for (int i=0; i<c1; ++i) {
+          Real sum = 0.0;
+          for (int fk=k*f[2]; fk<(k+1)*f[2]; ++fk) {
+            for (int fj=j*f[1]; fj<(j+1)*f[1]; ++fj) {
+              for (int fi=i*f[0]; fi<(i+1)*f[0]; ++fi) {
+                int m = (fk*n[1] + fj)*n[0] + fi;
+                sum += vol_src[m]*s[m];
+              }
+            }
+          }
+          d[(k*c2 + j)*c1 + i] = static_cast<H5Real>(sum/vol_dst[(k*c2 + j)*c1 + i]);
+        }
+      }
+    }
+  }
+  return;
+}
+
+//----------------------------------------------------------------------------------------
+//! \fn void WriteBlockArray(hid_t loc, const char *name, int rank, hsize_t *dims,
+//!          int block_dim, int first_block, int num_blocks_local, const H5Real *buf,
+//!          hid_t property_list)
+//! \brief create dataset `name` of size dims in loc and write the MeshBlocks of this
+//!        rank, which are contiguous along dimension block_dim
+
+void WriteBlockArray(hid_t loc, const char *name, int rank, hsize_t *dims, int block_dim,
+                     int first_block, int num_blocks_local, const H5Real *buf,
+                     hid_t property_list) {
+  hsize_t start[5], count[5];
+  for (int d=0; d<rank; ++d) {
+    start[d] = 0;
+    count[d] = dims[d];
+  }
+  start[block_dim] = first_block;
+  count[block_dim] = num_blocks_local;
+  hid_t filespace = H5Screate_simple(rank, dims, NULL);
+  H5Sselect_hyperslab(filespace, H5S_SELECT_SET, start, NULL, count, NULL);
+  hid_t memspace = H5Screate_simple(rank, count, NULL);
+  hid_t dataset = H5Dcreate(loc, name, H5T_NATIVE_REAL, filespace, H5P_DEFAULT,
+                            H5P_DEFAULT, H5P_DEFAULT);
+  H5Dwrite(dataset, H5T_NATIVE_REAL, memspace, filespace, property_list, buf);
+  H5Dclose(dataset);
+  H5Sclose(memspace);
+  H5Sclose(filespace);
+  return;
+}
+} // namespace
+
 
 //----------------------------------------------------------------------------------------
 //! \fn void ATHDF5Output:::WriteOutputFile(Mesh *pm, ParameterInput *pin, bool flag)
 //! \brief Cycles over all MeshBlocks and writes OutputData in the Athena++ HDF5 format,
 //!        one file per output using parallel IO.
+//!
+//! With pyramid_levels = L > 0 in the <output> block, the cell data are also written
+//! restricted by factors 2, 4, ..., 2^L in each dimension with more than one cell, in
+//! groups /Pyramid2, /Pyramid4, ... of the same file. Each group holds the coordinates
+//! (x1f, ..., x3v) and cell datasets of the coarse MeshBlocks and the attributes Factor,
+//! MeshBlockSize and RootGridSize; Levels and LogicalLocations are those of the root.
+//! The coarse values are volume-weighted averages of the output data, computed in situ
+//! block by block, and the coarse cell centers are the midpoints of their faces.
+//!
+//! With a region of interest (x1min, x1max, ... in the <output> block), only the
+//! MeshBlocks intersecting it are written, whole, and the region is stored in the
+//! attributes RegionX1, RegionX2, RegionX3.
 
 void ATHDF5Output::WriteOutputFile(Mesh *pm, ParameterInput *pin, bool flag) {
   // HDF5 structures
@@ -196,12 +287,14 @@ void ATHDF5Output::WriteOutputFile(Mesh *pm, ParameterInput *pin, bool flag) {
 
   ClearOutputData();
 
-  // count the number of active blocks if slicing
+  // count the number of active blocks if slicing or restricted to a region
   if (output_params.output_slicex1 || output_params.output_slicex2
-      || output_params.output_slicex3) {
+      || output_params.output_slicex3 || output_params.output_region) {
     int nb = 0, nba = 0;
     for (int b=0; b<pm->nblocal; ++b) {
       pmb = pm->my_blocks(b);
+      if (!InOutputRegion(pmb))
+        active_flags[nb] = false;
       if (output_params.output_slicex1) {
         if (pmb->block_size.x1min >  output_params.x1_slice
             || pmb->block_size.x1max <= output_params.x1_slice)
@@ -270,6 +363,26 @@ void ATHDF5Output::WriteOutputFile(Mesh *pm, ParameterInput *pin, bool flag) {
   for (int n = 0; n < num_datasets; ++n)
     data_buffers[n] = new H5Real[num_variables[n]*num_blocks_local*nx3*nx2*nx1];
 
+  // restricted copies of the cell data, level by level; the factors are 1 along
+  // dimensions with a single cell
+  const int npyramid = output_params.pyramid_levels;
+  const int pf[3] = {(nx1 > 1) ? 2 : 1, (nx2 > 1) ? 2 : 1, (nx3 > 1) ? 2 : 1};
+  std::vector<std::vector<H5Real>> pyramid_buffers(npyramid*num_datasets);
+  std::vector<Real> vol_fine, vol_coarse;
+  if (npyramid > 0) {
+    vol_fine.resize(nx3*nx2*nx1);
+    vol_coarse.resize(nx3*nx2*nx1);
+    int n3 = nx3, n2 = nx2, n1 = nx1;
+    for (int l = 0; l < npyramid; ++l) {
+      n3 /= pf[2];
+      n2 /= pf[1];
+      n1 /= pf[0];
+      for (int n = 0; n < num_datasets; ++n)
+        pyramid_buffers[l*num_datasets + n].resize(
+            static_cast<std::size_t>(num_variables[n])*num_blocks_local*n3*n2*n1);
+    }
+  }
+
   int nb = 0, nba = 0;
   for (int b=0; b<pm->nblocal; ++b) {
     pmb = pm->my_blocks(b);
@@ -409,6 +522,29 @@ void ATHDF5Output::WriteOutputFile(Mesh *pm, ParameterInput *pin, bool flag) {
           pod = pod->pnext;
         }
       }
+
+      // restrict this block level by level
+      if (npyramid > 0) {
+        for (int k = out_ks, index = 0; k <= out_ke; k++) {
+          for (int j = out_js; j <= out_je; j++) {
+            for (int i = out_is; i <= out_ie; i++, index++)
+              vol_fine[index] = pmb->pcoord->GetCellVolume(k, j, i);
+          }
+        }
+        int n[3] = {nx1, nx2, nx3};
+        for (int l = 0; l < npyramid; ++l) {
+          for (int d = 0; d < num_datasets; ++d) {
+            const H5Real *src = (l == 0) ? data_buffers[d]
+                                : pyramid_buffers[(l-1)*num_datasets + d].data();
+            RestrictBlock(src, vol_fine.data(), num_variables[d], num_blocks_local, nba,
+                          n, pf, pyramid_buffers[l*num_datasets + d].data(),
+                          vol_coarse.data());
+          }
+          vol_fine.swap(vol_coarse);
+          for (int dim = 0; dim < 3; ++dim)
+            n[dim] /= pf[dim];
+        }
+      }
       nba++;
       ClearOutputData();  // required when LoadOutputData() is used.
     }
@@ -507,6 +643,21 @@ void ATHDF5Output::WriteOutputFile(Mesh *pm, ParameterInput *pin, bool flag) {
   H5Awrite(attribute, H5T_NATIVE_DOUBLE, coord_range);
   H5Aclose(attribute);
 
+  // Write region of interest, if any
+  if (output_params.output_region) {
+    dims_count[0] = 2;
+    hid_t dataspace_pair = H5Screate_simple(1, dims_count, NULL);
+    const char *region_names[3] = {"RegionX1", "RegionX2", "RegionX3"};
+    for (int d = 0; d < 3; ++d) {
+      double region[2] = {output_params.region_min[d], output_params.region_max[d]};
+      attribute = H5Acreate2(file, region_names[d], H5T_NATIVE_REAL, dataspace_pair,
+                             H5P_DEFAULT, H5P_DEFAULT);
+      H5Awrite(attribute, H5T_NATIVE_DOUBLE, region);
+      H5Aclose(attribute);
+    }
+    H5Sclose(dataspace_pair);
+  }
+
   // Write root grid size
   int root_grid_size[3];
   root_grid_size[0] = pm->mesh_size.nx1;
@@ -717,6 +868,73 @@ void ATHDF5Output::WriteOutputFile(Mesh *pm, ParameterInput *pin, bool flag) {
              memspaces_vars_blocks_nx3_nx2_nx1[n], filespaces_vars_blocks_nx3_nx2_nx1[n],
              property_list, data_buffers[n]);
 
+  // Write restricted copies of the cell data
+  for (int l = 0, n1 = nx1, n2 = nx2, n3 = nx3; l < npyramid; ++l) {
+    const int f = 2 << l;
+    const int c1 = n1/pf[0], c2 = n2/pf[1], c3 = n3/pf[2];
+    std::string group_name = "Pyramid" + std::to_string(f);
+    hid_t group = H5Gcreate(file, group_name.c_str(), H5P_DEFAULT, H5P_DEFAULT,
+                            H5P_DEFAULT);
+    hid_t dataspace_scalar_p = H5Screate(H5S_SCALAR);
+    dims_count[0] = 3;
+    hid_t dataspace_triple_p = H5Screate_simple(1, dims_count, NULL);
+    attribute = H5Acreate2(group, "Factor", H5T_STD_I32BE, dataspace_scalar_p,
+                           H5P_DEFAULT, H5P_DEFAULT);
+    H5Awrite(attribute, H5T_NATIVE_INT, &f);
+    H5Aclose(attribute);
+    int coarse_size[3] = {c1, c2, c3};
+    attribute = H5Acreate2(group, "MeshBlockSize", H5T_STD_I32BE, dataspace_triple_p,
+                           H5P_DEFAULT, H5P_DEFAULT);
+    H5Awrite(attribute, H5T_NATIVE_INT, coarse_size);
+    H5Aclose(attribute);
+    coarse_size[0] = root_grid_size[0]/(c1 < nx1 ? nx1/c1 : 1);
+    coarse_size[1] = root_grid_size[1]/(c2 < nx2 ? nx2/c2 : 1);
+    coarse_size[2] = root_grid_size[2]/(c3 < nx3 ? nx3/c3 : 1);
+    attribute = H5Acreate2(group, "RootGridSize", H5T_STD_I32BE, dataspace_triple_p,
+                           H5P_DEFAULT, H5P_DEFAULT);
+    H5Awrite(attribute, H5T_NATIVE_INT, coarse_size);
+    H5Aclose(attribute);
+    H5Sclose(dataspace_scalar_p);
+    H5Sclose(dataspace_triple_p);
+
+    // coordinates: every (nx/c)-th face of the output, centers at the face midpoints
+    const int cs[3] = {c1, c2, c3}, ns[3] = {nx1, nx2, nx3};
+    const H5Real *xf_mesh[3] = {x1f_mesh, x2f_mesh, x3f_mesh};
+    const char *xf_names[3] = {"x1f", "x2f", "x3f"};
+    const char *xv_names[3] = {"x1v", "x2v", "x3v"};
+    for (int d = 0; d < 3; ++d) {
+      const int c = cs[d], stride = ns[d]/cs[d];
+      std::vector<H5Real> xf(num_blocks_local*(c+1)), xv(num_blocks_local*c);
+      for (int b = 0; b < num_blocks_local; ++b) {
+        for (int i = 0; i <= c; ++i)
+          xf[b*(c+1) + i] = xf_mesh[d][b*(ns[d]+1) + i*stride];
+        for (int i = 0; i < c; ++i)
+          xv[b*c + i] = static_cast<H5Real>(0.5*(xf[b*(c+1) + i] + xf[b*(c+1) + i+1]));
+      }
+      dims_count[0] = num_blocks_global;
+      dims_count[1] = c + 1;
+      WriteBlockArray(group, xf_names[d], 2, dims_count, 0, first_block,
+                      num_blocks_local, xf.data(), property_list);
+      dims_count[1] = c;
+      WriteBlockArray(group, xv_names[d], 2, dims_count, 0, first_block,
+                      num_blocks_local, xv.data(), property_list);
+    }
+    for (int n = 0; n < num_datasets; ++n) {
+      dims_count[0] = num_variables[n];
+      dims_count[1] = num_blocks_global;
+      dims_count[2] = c3;
+      dims_count[3] = c2;
+      dims_count[4] = c1;
+      WriteBlockArray(group, dataset_names[n], 5, dims_count, 1, first_block,
+                      num_blocks_local, pyramid_buffers[l*num_datasets + n].data(),
+                      property_list);
+    }
+    H5Gclose(group);
+    n1 = c1;
+    n2 = c2;
+    n3 = c3;
+  }
+
 
   // Close property list
   H5Pclose(property_list);
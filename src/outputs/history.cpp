@@ -28,6 +28,7 @@
 #include "../globals.hpp"
 #include "../gravity/gravity.hpp"
 #include "../hydro/hydro.hpp"
+#include "../hydro/srcterms/sink_particles.hpp"
 #include "../mesh/mesh.hpp"
 #include "../orbital_advection/orbital_advection.hpp"
 #include "../scalars/scalars.hpp"
@@ -278,6 +279,14 @@ void HistoryOutput::WriteOutputFile(Mesh *pm, ParameterInput *pin, bool flag) {
       for (int n=0; n<pm->nuser_history_output_; n++)
         std::fprintf(pfile,"[%d]=%-7s ", iout++,
                      pm->user_history_output_names_[n].c_str());
+      if (pm->psinks != nullptr) {
+        std::fprintf(pfile,"[%d]=sink-N   ", iout++);
+        std::fprintf(pfile,"[%d]=sink-mass ", iout++);
+      }
+      if (pm->CeilingsEnabled()) {
+        std::fprintf(pfile,"[%d]=tceil-E  ", iout++);
+        std::fprintf(pfile,"[%d]=vceil-E  ", iout++);
+      }
       std::fprintf(pfile,"\n");                              // terminate line
     }
 
@@ -286,6 +295,18 @@ void HistoryOutput::WriteOutputFile(Mesh *pm, ParameterInput *pin, bool flag) {
     std::fprintf(pfile, output_params.data_format.c_str(), pm->dt);
     for (int n=0; n<nhistory_output; ++n)
       std::fprintf(pfile, output_params.data_format.c_str(), hst_data[n]);
+    // the sink list is the same on all ranks
+    if (pm->psinks != nullptr) {
+      std::fprintf(pfile, output_params.data_format.c_str(),
+                   static_cast<Real>(pm->psinks->sinks.size()));
+      std::fprintf(pfile, output_params.data_format.c_str(),
+                   pm->psinks->GetTotalMass());
+    }
+    // total energy removed by the EOS ceilings, already reduced over all ranks
+    if (pm->CeilingsEnabled()) {
+      std::fprintf(pfile, output_params.data_format.c_str(), pm->ceiling_losses[0]);
+      std::fprintf(pfile, output_params.data_format.c_str(), pm->ceiling_losses[1]);
+    }
     std::fprintf(pfile,"\n"); // terminate line
     std::fclose(pfile);
   }
@@ -33,6 +33,13 @@
 //!     x2_slice    = 0.0       # slice in x2
 //!     x3_slice    = 0.0       # slice in x3
 //!
+//! The optional parameters x1min, x1max, x2min, ... restrict the vtk, tab, and hdf5
+//! outputs to a region of interest: only the MeshBlocks intersecting it are written.
+//! The vtk and tab outputs are trimmed to the cells intersecting the region, while the
+//! hdf5 outputs contain whole MeshBlocks and record the region in the RegionX1, ...
+//! attributes, which athena_read.athdf() uses as the default selection. A predicate
+//! enrolled with Mesh::EnrollUserOutputRegion() can further select the MeshBlocks.
+//!
 //!
 //! Each <output[n]> block will result in a new node being created in a linked list of
 //! OutputType stored in the Outputs class.  During a simulation, outputs are made when
@@ -77,6 +84,7 @@
 // C headers
 
 // C++ headers
+#include <algorithm>  // max(), min()
 #include <cstdio>
 #include <cstdlib>
 #include <cstring>    // strcmp
@@ -223,6 +231,42 @@ Outputs::Outputs(Mesh *pm, ParameterInput *pin) {
           ATHENA_ERROR(msg);
         }
 
+        // read region of interest.  Check that it intersects the mesh and the slices
+        Real mesh_min[3] = {pm->mesh_size.x1min, pm->mesh_size.x2min,
+                            pm->mesh_size.x3min};
+        Real mesh_max[3] = {pm->mesh_size.x1max, pm->mesh_size.x2max,
+                            pm->mesh_size.x3max};
+        bool slice[3] = {op.output_slicex1, op.output_slicex2, op.output_slicex3};
+        Real xslice[3] = {op.x1_slice, op.x2_slice, op.x3_slice};
+        for (int d=0; d<3; ++d) {
+          std::string xmin = "x" + std::to_string(d+1) + "min";
+          std::string xmax = "x" + std::to_string(d+1) + "max";
+          op.region_min[d] = mesh_min[d];
+          op.region_max[d] = mesh_max[d];
+          if (pin->DoesParameterExist(op.block_name, xmin)) {
+            op.region_min[d] = std::max(pin->GetReal(op.block_name, xmin), mesh_min[d]);
+            op.output_region = true;
+          }
+          if (pin->DoesParameterExist(op.block_name, xmax)) {
+            op.region_max[d] = std::min(pin->GetReal(op.block_name, xmax), mesh_max[d]);
+            op.output_region = true;
+          }
+          if (op.region_min[d] >= op.region_max[d]) {
+            msg << "### FATAL ERROR in Outputs constructor" << std::endl
+                << "Region " << xmin << " to " << xmax << " in output block '"
+                << op.block_name << "' does not intersect the Mesh" << std::endl;
+            ATHENA_ERROR(msg);
+          }
+          if (slice[d] && (xslice[d] < op.region_min[d]
+                           || xslice[d] >= op.region_max[d])) {
+            msg << "### FATAL ERROR in Outputs constructor" << std::endl
+                << "Slice at x" << d+1 << "=" << xslice[d] << " in output block '"
+                << op.block_name << "' is out of the region" << std::endl;
+            ATHENA_ERROR(msg);
+          }
+        }
+        if (pm->UserOutputRegion_ != nullptr) op.output_region = true;
+
         // read ghost cell option
         op.include_ghost_zones = pin->GetOrAddBoolean(op.block_name, "ghost_zones",
                                                       false);
@@ -261,6 +305,34 @@ Outputs::Outputs(Mesh *pm, ParameterInput *pin) {
         } else if (op.file_type.compare("ath5") == 0
                    || op.file_type.compare("hdf5") == 0) {
 #ifdef HDF5OUTPUT
+          // optional copies of the cell data restricted by factors 2, 4, ...
+          op.pyramid_levels = pin->GetOrAddInteger(op.block_name, "pyramid_levels", 0);
+          if (op.pyramid_levels > 0) {
+            RegionSize &bs = pm->my_blocks(0)->block_size;
+            int factor = 1 << op.pyramid_levels;
+            if (op.output_slicex1 || op.output_slicex2 || op.output_slicex3
+                || op.output_sumx1 || op.output_sumx2 || op.output_sumx3
+                || op.include_ghost_zones) {
+              msg << "### FATAL ERROR in Outputs constructor" << std::endl
+                  << "pyramid_levels cannot be combined with slices, sums or ghost "
+                  << "zones in output block '" << op.block_name << "'" << std::endl;
+              ATHENA_ERROR(msg);
+            }
+            if (op.pyramid_levels > 10 || bs.nx1 % factor != 0
+                || (bs.nx2 > 1 && bs.nx2 % factor != 0)
+                || (bs.nx3 > 1 && bs.nx3 % factor != 0)) {
+              msg << "### FATAL ERROR in Outputs constructor" << std::endl
+                  << "pyramid_levels = " << op.pyramid_levels << " in output block '"
+                  << op.block_name << "' requires MeshBlock sizes divisible by "
+                  << factor << std::endl;
+              ATHENA_ERROR(msg);
+            }
+          } else if (op.pyramid_levels < 0) {
+            msg << "### FATAL ERROR in Outputs constructor" << std::endl
+                << "pyramid_levels must be >= 0 in output block '" << op.block_name
+                << "'" << std::endl;
+            ATHENA_ERROR(msg);
+          }
           pnew_type = new ATHDF5Output(op);
 #else
           msg << "### FATAL ERROR in Outputs constructor" << std::endl
@@ -801,6 +873,9 @@ void Outputs::MakeOutputs(Mesh *pm, ParameterInput *pin, bool wtflag) {
 
 bool OutputType::TransformOutputData(MeshBlock *pmb) {
   bool flag = true;
+  if (output_params.output_region) {
+    if (!ClipOutputData(pmb)) return false;
+  }
   if (output_params.output_slicex3) {
     bool ret = SliceOutputData(pmb,3);
     if (!ret) flag = false;
@@ -825,6 +900,51 @@ bool OutputType::TransformOutputData(MeshBlock *pmb) {
   return flag;
 }
 
+//----------------------------------------------------------------------------------------
+//! \fn bool OutputType::InOutputRegion(MeshBlock *pmb)
+//! \brief true if the MeshBlock intersects the region of interest and is selected by the
+//!        user-defined predicate, if any
+
+bool OutputType::InOutputRegion(MeshBlock *pmb) {
+  if (!output_params.output_region) return true;
+  const RegionSize &bs = pmb->block_size;
+  Real bmin[3] = {bs.x1min, bs.x2min, bs.x3min};
+  Real bmax[3] = {bs.x1max, bs.x2max, bs.x3max};
+  for (int d=0; d<3; ++d) {
+    if (bmax[d] <= output_params.region_min[d] || bmin[d] >= output_params.region_max[d])
+      return false;
+  }
+  OutputRegionFunc UserOutputRegion = pmb->pmy_mesh->UserOutputRegion_;
+  if (UserOutputRegion != nullptr && !UserOutputRegion(pmb, output_params.block_number))
+    return false;
+  return true;
+}
+
+//----------------------------------------------------------------------------------------
+//! \fn bool OutputType::ClipOutputData(MeshBlock *pmb)
+//! \brief returns false if the MeshBlock is not in the region of interest; otherwise
+//!        trims the output index range to the cells intersecting the region. The hdf5
+//!        outputs keep whole MeshBlocks, since all of them must have the same size, and
+//!        so do outputs with ghost zones.
+
+bool OutputType::ClipOutputData(MeshBlock *pmb) {
+  if (!InOutputRegion(pmb)) return false;
+  if (output_params.file_type.compare("hdf5") == 0
+      || output_params.file_type.compare("ath5") == 0
+      || output_params.include_ghost_zones)
+    return true;
+
+  Coordinates *pco = pmb->pcoord;
+  const Real *rmin = output_params.region_min, *rmax = output_params.region_max;
+  while (out_is < out_ie && pco->x1f(out_is+1) <= rmin[0]) out_is++;
+  while (out_ie > out_is && pco->x1f(out_ie) >= rmax[0]) out_ie--;
+  while (out_js < out_je && pco->x2f(out_js+1) <= rmin[1]) out_js++;
+  while (out_je > out_js && pco->x2f(out_je) >= rmax[1]) out_je--;
+  while (out_ks < out_ke && pco->x3f(out_ks+1) <= rmin[2]) out_ks++;
+  while (out_ke > out_ks && pco->x3f(out_ke) >= rmax[2]) out_ke--;
+  return true;
+}
+
 //----------------------------------------------------------------------------------------
 //! \fn bool OutputType::SliceOutputData(MeshBlock *pmb, int dim)
 //! \brief perform data slicing and update the data list
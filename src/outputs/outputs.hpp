@@ -48,12 +48,16 @@ struct OutputParameters {
   bool orbital_system_output;
   int islice, jslice, kslice;
   Real x1_slice, x2_slice, x3_slice;
+  bool output_region;  // only MeshBlocks intersecting the region are written
+  Real region_min[3], region_max[3];
+  int pyramid_levels;  // number of coarsened copies in HDF5 outputs
   // TODO(felker): some of the parameters in this class are not initialized in constructor
   OutputParameters() : block_number(0), next_time(0.0), dt(0.0), file_number(0),
                        output_slicex1(false),output_slicex2(false),output_slicex3(false),
                        output_sumx1(false), output_sumx2(false), output_sumx3(false),
                        include_ghost_zones(false), cartesian_vector(false),
-                       islice(0), jslice(0), kslice(0) {}
+                       islice(0), jslice(0), kslice(0), output_region(false),
+                       region_min{}, region_max{}, pyramid_levels(0) {}
 };
 
 //----------------------------------------------------------------------------------------
@@ -101,6 +105,8 @@ class OutputType {
   void ReplaceOutputDataNode(OutputData *pold, OutputData *pnew);
   void ClearOutputData();
   bool TransformOutputData(MeshBlock *pmb);
+  bool InOutputRegion(MeshBlock *pmb);
+  bool ClipOutputData(MeshBlock *pmb);
   bool SliceOutputData(MeshBlock *pmb, int dim);
   void SumOutputData(MeshBlock *pmb, int dim);
   void CalculateCartesianVector(AthenaArray<Real> &src, AthenaArray<Real> &dst,
@@ -0,0 +1,92 @@
+//========================================================================================
+// Athena++ astrophysical MHD code
+// Copyright(C) 2014 James M. Stone <jmstone@princeton.edu> and other code contributors
+// Licensed under the 3-clause BSD License, see LICENSE file for details
+//========================================================================================
+//! \file density_pdf.cpp
+//! \brief example analysis plugin: volume-weighted PDF of log10(rho) and total mass
+//!
+//! Build it with the compiler and flags of the configured code (mpicxx with -mpi),
+//! from the top-level directory:
+//!
+//!     g++ -O3 -std=c++11 -shared -fPIC -o density_pdf.so \
+//!         src/outputs/plugins/density_pdf.cpp
+//!
+//! Parameters in its <analysis[n]> block: nbins (default 32), rho_min and rho_max
+//! (defaults 1e-3 and 1e3). Each call appends a line with time, total mass and the
+//! volume fraction in each bin; the final call appends the time-averaged PDF.
+
+// C headers
+
+// C++ headers
+#include <cmath>      // floor(), log10()
+#include <sstream>    // stringstream
+#include <string>
+#include <vector>
+
+// Athena++ headers
+#include "../../athena.hpp"
+#include "../../parameter_input.hpp"
+#include "../analysis.hpp"
+
+class DensityPdf : public AnalysisPlugin {
+ public:
+  DensityPdf(ParameterInput *pin, const std::string &block_name) : ncalls_(0) {
+    nbins_ = pin->GetOrAddInteger(block_name, "nbins", 32);
+    lmin_ = std::log10(pin->GetOrAddReal(block_name, "rho_min", 1e-3));
+    lmax_ = std::log10(pin->GetOrAddReal(block_name, "rho_max", 1e3));
+    sum_.assign(nbins_, 0.0);
+  }
+
+  void Analyze(AnalysisContext *pctx) override {
+    // local volumes per bin, followed by the mass and the total volume
+    std::vector<Real> local(nbins_ + 2, 0.0);
+    for (int b=0; b<pctx->NumBlocks(); ++b) {
+      const AnalysisBlock &blk = pctx->Block(b);
+      for (int k=blk.ks; k<=blk.ke; ++k) {
+        for (int j=blk.js; j<=blk.je; ++j) {
+          for (int i=blk.is; i<=blk.ie; ++i) {
+            Real vol = blk.CellVolume(k, j, i);
+            Real rho = blk.prim(IDN,k,j,i);
+            int n = static_cast<int>(std::floor((std::log10(rho) - lmin_)
+                                                / (lmax_ - lmin_)*nbins_));
+            if (n >= 0 && n < nbins_) local[n] += vol;
+            local[nbins_] += vol*rho;
+            local[nbins_+1] += vol;
+          }
+        }
+      }
+    }
+    pctx->Sum(local.data(), nbins_ + 2);
+
+    std::stringstream line;
+    line.precision(8);
+    line << pctx->time << " " << local[nbins_];
+    for (int n=0; n<nbins_; ++n) {
+      Real f = local[n]/local[nbins_+1];
+      sum_[n] += f;
+      line << " " << f;
+    }
+    line << "\n";
+    pctx->Write(line.str());
+    ncalls_++;
+  }
+
+  void Finalize(AnalysisContext *pctx) override {
+    if (ncalls_ == 0) return;
+    std::stringstream line;
+    line.precision(8);
+    line << "# mean PDF over " << ncalls_ << " calls:";
+    for (int n=0; n<nbins_; ++n)
+      line << " " << sum_[n]/ncalls_;
+    line << "\n";
+    pctx->Write(line.str());
+  }
+
+ private:
+  int nbins_, ncalls_;
+  Real lmin_, lmax_;
+  std::vector<Real> sum_;
+};
+
+ATHENA_ANALYSIS_PLUGIN(DensityPdf)
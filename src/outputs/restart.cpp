@@ -21,9 +21,11 @@
 // Athena++ headers
 #include "../athena.hpp"
 #include "../athena_arrays.hpp"
+#include "../fft/turbulence.hpp"
 #include "../field/field.hpp"
 #include "../globals.hpp"
 #include "../hydro/hydro.hpp"
+#include "../hydro/srcterms/sink_particles.hpp"
 #include "../mesh/mesh.hpp"
 #include "../parameter_input.hpp"
 #include "../scalars/scalars.hpp"
@@ -64,6 +66,12 @@ void RestartOutput::WriteOutputFile(Mesh *pm, ParameterInput *pin, bool force_wr
   }
   resfile.Open(fname.c_str(), IOWrapper::FileMode::write);
 
+  // the energy removed by the EOS ceilings so far is kept with the input parameters
+  if (pm->CeilingsEnabled()) {
+    pin->SetReal("hydro", "tceil_losses", pm->ceiling_losses[0]);
+    pin->SetReal("hydro", "vceil_losses", pm->ceiling_losses[1]);
+  }
+
   // prepare the input parameters
   std::stringstream ost;
   pin->ParameterDump(ost);
@@ -202,6 +210,15 @@ void RestartOutput::WriteOutputFile(Mesh *pm, ParameterInput *pin, bool force_wr
   // now write restart data in parallel
   myoffset = headeroffset + listsize*nbtotal + datasize*myns;
   resfile.Write_at_all(data, datasize, mynb, myoffset);
+  // the sink particles follow the MeshBlock data, then the per-rank state of the
+  // turbulence driving (OU process, RNG)
+  IOWrapperSizeT extoffset = headeroffset + listsize*nbtotal + datasize*nbtotal;
+  if (pm->psinks != nullptr) {
+    pm->psinks->WriteRestartState(resfile, extoffset);
+    extoffset += pm->psinks->GetRestartRecordSizeInBytes();
+  }
+  if (pm->turb_flag > 1)
+    pm->ptrbd->WriteRestartState(resfile, extoffset);
   resfile.Close();
   delete [] data;
 }
@@ -3,6 +3,7 @@
 // C++ headers
 #include <algorithm>  // min()
 #include <cmath>      // abs(), pow(), sqrt()
+#include <limits>     // numeric_limits
 #include <sstream>    // stringstream
 #include <stdexcept>  // runtime_error
 #include <string>     // string
@@ -48,14 +49,25 @@ static Real rho0, pgas0;
 static Real vcir, R0;
 
 static Cooling cooler;
+static int bad_cell_diag; // RuntimeDiagnostics category of cells with tcool <= 1e-10
 
 static SNInj injector;
 static std::vector<Real> sn_times;
-static std::vector<Real>::iterator next_sn_idx;
 static Real r_inj,e_sn,m_ej;
 
 static Real tracer_injection_time;
-static bool tracer_injection_flag;
+
+// SN scheduler and tracer state, kept in iuser_mesh_data[0] so that it is written to
+// and restored from restart files: index of the next SN in sn_times, and whether
+// tracers are still to be injected
+enum SchedulerState {kNextSN = 0, kTracerFlag = 1};
+
+// time of the next SN; never reached once the table is exhausted, e.g. after the last SN
+// or on a restart with a shorter tlim, which regenerates a shorter table
+static Real NextSNTime(const AthenaArray<int> &sched) {
+  const std::size_t n = static_cast<std::size_t>(sched(kNextSN));
+  return (n < sn_times.size()) ? sn_times[n] : std::numeric_limits<Real>::max();
+}
 
 // User defined boundary conditions 
 void NoInflowInnerX3(MeshBlock *pmb, Coordinates *pco,
@@ -71,16 +83,32 @@ void NoInflowOuterX3(MeshBlock *pmb, Coordinates *pco,
                      int il, int iu, int jl, int ju, 
                      int kl, int ku, int ngh);
 
-// User defined source functions
-void SourceFunctions(MeshBlock *pmb, const Real time, const Real dt,
-                     const AthenaArray<Real> &prim,
-                     const AthenaArray<Real> &prim_scalar,
-                     const AthenaArray<Real> &bcc,
-                     AthenaArray<Real> &cons,
-                     AthenaArray<Real> &cons_scalar);
-void GravitySource(MeshBlock *pmb, const Real dt, 
-                   const AthenaArray<Real> &prim, 
-                   AthenaArray<Real> &cons);
+// User defined source functions and physics modules
+void CoolingModule(MeshBlock *pmb, const Real time, const Real dt,
+                   const AthenaArray<Real> &prim,
+                   const AthenaArray<Real> &prim_scalar,
+                   const AthenaArray<Real> &bcc,
+                   AthenaArray<Real> &cons,
+                   AthenaArray<Real> &cons_scalar);
+void SNModule(MeshBlock *pmb, const Real time, const Real dt,
+              const AthenaArray<Real> &prim,
+              const AthenaArray<Real> &prim_scalar,
+              const AthenaArray<Real> &bcc,
+              AthenaArray<Real> &cons,
+              AthenaArray<Real> &cons_scalar);
+void TracerModule(MeshBlock *pmb, const Real time, const Real dt,
+                  const AthenaArray<Real> &prim,
+                  const AthenaArray<Real> &prim_scalar,
+                  const AthenaArray<Real> &bcc,
+                  AthenaArray<Real> &cons,
+                  AthenaArray<Real> &cons_scalar);
+void GravitySource(MeshBlock *pmb, const int k, const int j,
+                   const Real time, const Real dt,
+                   const AthenaArray<Real> &prim,
+                   const AthenaArray<Real> &prim_scalar,
+                   const AthenaArray<Real> &bcc,
+                   AthenaArray<Real> &cons,
+                   AthenaArray<Real> &cons_scalar);
 Real GravAccel(Real z);
 void CoolingSource(MeshBlock *pmb, const Real dt, 
                    const AthenaArray<Real> &prim, 
@@ -116,7 +144,8 @@ Real CalculateTotalCooling(MeshBlock *pmb, int iout);
 
 // Misc
 void AssertCondition(bool condition, std::string msg);
-static Real CoolingTimestep(MeshBlock *pmb); // User defined time step
+static Real CoolingTimestep(MeshBlock *pmb, const int k, const int j,
+                            const AthenaArray<Real> &prim); // User defined time step
 Real CellTemperature(const int k, const int j, const int i,
                      MeshBlock *pmb,
                      const AthenaArray<Real> &cons,
@@ -146,6 +175,8 @@ void Mesh::InitUserMeshData(ParameterInput *pin) {
 
   // Initialize cooling, SN injection, and turbulence
   cooler    = Cooling(pin->GetString("cooling","cooling_table"));
+  bad_cell_diag = RuntimeDiagnostics::AddCategory("Bad Cell (cooling time <= 1e-10)",
+                                                  "density,pressure,tcool,z");
   injector  = SNInj();
   turb_flag = pin->GetInteger("problem","turb_flag");
 
@@ -155,7 +186,11 @@ void Mesh::InitUserMeshData(ParameterInput *pin) {
                                  pin->GetReal("SN","tstart"), 
                                  pin->GetReal("time","tlim"),
                                  unit_time);
-  next_sn_idx = std::lower_bound(sn_times.begin(), sn_times.end(), time);
+  // (on restart, overwritten by the scheduler state stored in the restart file)
+  AllocateIntUserMeshDataField(1);
+  iuser_mesh_data[0].NewAthenaArray(2);
+  iuser_mesh_data[0](kNextSN) = static_cast<int>(
+      std::lower_bound(sn_times.begin(), sn_times.end(), time) - sn_times.begin());
 
   // Compute energy and mass injection densities
   r_inj = pin->GetReal("SN","r_inj"); // Input in code unis
@@ -168,17 +203,28 @@ void Mesh::InitUserMeshData(ParameterInput *pin) {
 
   // Set tracer injection time and flag
   tracer_injection_time = pin->GetReal("problem","tinj");
-  tracer_injection_flag = (time < tracer_injection_time);
+  iuser_mesh_data[0](kTracerFlag) = (time < tracer_injection_time);
 
   // Enroll user-defined physical source terms
-  EnrollUserExplicitSourceFunction(SourceFunctions);
+  // (gravity is pencil-local and can be fused into the stage update)
+  EnrollUserExplicitSourcePencilFunction(GravitySource);
+
+  // Cooling, SN injection and tracers are operator split and applied once per step
+  // after the hydro step. They read the conserved variables only; the cooling
+  // integrator keeps scratch tables in the Cooling object and is not thread safe.
+  EnrollPhysicsModule("cooling", CoolingModule, PhysicsStage::after_step, 1,
+                      kPhysNone, kPhysHydro, false);
+  EnrollPhysicsModule("sn_injection", SNModule, PhysicsStage::after_step, 1,
+                      kPhysNone, kPhysAll);
+  EnrollPhysicsModule("tracers", TracerModule, PhysicsStage::after_step, 1,
+                      kPhysNone, kPhysScalars);
 
   // Enroll user-defined boundary conditions
   EnrollUserBoundaryFunction(BoundaryFace::inner_x3, NoInflowInnerX3);
   EnrollUserBoundaryFunction(BoundaryFace::outer_x3, NoInflowOuterX3);
 
   // Enroll timestep so that dt <= min(t_cool)
-  EnrollUserTimeStepFunction(CoolingTimestep);
+  EnrollUserTimeStepPencilFunction(CoolingTimestep);
 
   // Enroll user-defined history outputs
   AllocateUserHistoryOutput(11);
@@ -232,10 +278,12 @@ void Mesh::InitUserMeshData(ParameterInput *pin) {
               << pin->GetString("cooling","cooling_table")     << std::endl;
     std::cout << "Cluster Mass     : " << cluster_mass        
                                        << " Solar Masses"      << std::endl;
-    std::cout << "First SN at      : " << sn_times.at(0)       
-                                       << " Code Units"        << std::endl;
-    std::cout << "Last SN at       : " << sn_times.rbegin()[1] 
-                                       << " Code Units"        << std::endl;
+    if (sn_times.size() > 1) {  // the last entry is a dummy SN at t = 1e20
+      std::cout << "First SN at      : " << sn_times.at(0)
+                                         << " Code Units"        << std::endl;
+      std::cout << "Last SN at       : " << sn_times.rbegin()[1]
+                                         << " Code Units"        << std::endl;
+    }
     std::cout << "No. of SN        : " << sn_times.size()-1    << std::endl;
     std::cout << "Energy per SN    : " << e_sn*sphere_vol*unit_engy      
                                        << " ergs"              << std::endl;
@@ -439,27 +487,41 @@ void NoInflowInnerX3(MeshBlock *pmb, Coordinates *pco,
 //===========================================================================//
 //                              Source Terms                                 //
 //===========================================================================//
-// Source terms
-void SourceFunctions(MeshBlock *pmb, const Real time, const Real dt,
-                    const AthenaArray<Real> &prim, 
-                    const AthenaArray<Real> &prim_scalar,
-                    const AthenaArray<Real> &bcc, 
-                    AthenaArray<Real> &cons,
-                    AthenaArray<Real> &cons_scalar) {
-  // Vertical gravity
-  GravitySource(pmb,dt,prim,cons);
-
-  // Radiative cooling
+// Radiative cooling over the whole step
+void CoolingModule(MeshBlock *pmb, const Real time, const Real dt,
+                   const AthenaArray<Real> &prim,
+                   const AthenaArray<Real> &prim_scalar,
+                   const AthenaArray<Real> &bcc,
+                   AthenaArray<Real> &cons,
+                   AthenaArray<Real> &cons_scalar) {
   CoolingSource(pmb,dt,prim,cons,bcc);
+  return;
+}
 
-  // SNe injection
-  if (time > *next_sn_idx) { // Step through list of SN times
+// SNe injection; the scheduler is advanced once per step in Mesh::UserWorkInLoop
+void SNModule(MeshBlock *pmb, const Real time, const Real dt,
+              const AthenaArray<Real> &prim,
+              const AthenaArray<Real> &prim_scalar,
+              const AthenaArray<Real> &bcc,
+              AthenaArray<Real> &cons,
+              AthenaArray<Real> &cons_scalar) {
+  AthenaArray<int> &sched = pmb->pmy_mesh->iuser_mesh_data[0];
+  if (time + dt > NextSNTime(sched)) { // Step through list of SN times
     SNSource(pmb,dt,prim,cons,cons_scalar);
-    next_sn_idx++;
   }
+  return;
+}
 
+// Tracers
+void TracerModule(MeshBlock *pmb, const Real time, const Real dt,
+                  const AthenaArray<Real> &prim,
+                  const AthenaArray<Real> &prim_scalar,
+                  const AthenaArray<Real> &bcc,
+                  AthenaArray<Real> &cons,
+                  AthenaArray<Real> &cons_scalar) {
   // Tracer injection in COLD and COOL gas phases
-  if (pmb->pmy_mesh->time > tracer_injection_time && tracer_injection_flag) {
+  AthenaArray<int> &sched = pmb->pmy_mesh->iuser_mesh_data[0];
+  if (time > tracer_injection_time && sched(kTracerFlag)) {
     TracerInjection(pmb,dt,prim,bcc,cons,cons_scalar);
   }
 
@@ -469,23 +531,22 @@ void SourceFunctions(MeshBlock *pmb, const Real time, const Real dt,
   return;
 }
 
-// Gravity source term
-void GravitySource(MeshBlock *pmb, const Real dt, 
-                   const AthenaArray<Real> &prim, 
-                   AthenaArray<Real> &cons) {
-  for (int k=pmb->ks; k<=pmb->ke; k++) {
-    Real z = pmb->pcoord->x3v(k);
-    for (int j=pmb->js; j<=pmb->je; j++) {
-      for (int i=pmb->is; i<=pmb->ie; i++) {
-        Real den = prim(IDN,k,j,i);
-        Real vz  = prim(IVZ,k,j,i);
-        
-        Real dvz = dt*GravAccel(z);
-
-        cons(IM3,k,j,i) -= den*dvz;
-        cons(IEN,k,j,i) -= 0.5*den*(2*dvz*vz - SQR(dvz));
-      }
-    }
+// Gravity source term (applied to a single (k,j) pencil)
+void GravitySource(MeshBlock *pmb, const int k, const int j,
+                   const Real time, const Real dt,
+                   const AthenaArray<Real> &prim,
+                   const AthenaArray<Real> &prim_scalar,
+                   const AthenaArray<Real> &bcc,
+                   AthenaArray<Real> &cons,
+                   AthenaArray<Real> &cons_scalar) {
+  Real z = pmb->pcoord->x3v(k);
+  Real dvz = dt*GravAccel(z);
+  for (int i=pmb->is; i<=pmb->ie; i++) {
+    Real den = prim(IDN,k,j,i);
+    Real vz  = prim(IVZ,k,j,i);
+
+    cons(IM3,k,j,i) -= den*dvz;
+    cons(IEN,k,j,i) -= 0.5*den*(2*dvz*vz - SQR(dvz));
   }
 
   return;
@@ -645,8 +706,12 @@ void TracerSource(MeshBlock *pmb, const Real dt,
 //                               User Work                                   //
 //===========================================================================//
 void Mesh::UserWorkInLoop() {
-  if (time > tracer_injection_time && tracer_injection_flag) {
-    tracer_injection_flag = false;
+  // SNe injected by SNModule in this step
+  if (time + dt > NextSNTime(iuser_mesh_data[0])) {
+    iuser_mesh_data[0](kNextSN)++;
+  }
+  if (time > tracer_injection_time && iuser_mesh_data[0](kTracerFlag)) {
+    iuser_mesh_data[0](kTracerFlag) = 0;
   }
 }
 
@@ -866,25 +931,19 @@ void AssertCondition(bool condition, std::string error_message) {
 }
 
 // Compute the minimum cooling timstep
-Real CoolingTimestep(MeshBlock *pmb) {
+Real CoolingTimestep(MeshBlock *pmb, const int k, const int j,
+                     const AthenaArray<Real> &prim) {
   Real min_dt = 1.0e10;
-  for (int k=pmb->ks; k<=pmb->ke; k++) {
-    for (int j=pmb->js; j<=pmb->je; j++) {
-      for (int i=pmb->is; i<=pmb->ie; i++) {
-        Real T = unit_temp*pmb->phydro->w(IPR,k,j,i)/pmb->phydro->w(IDN,k,j,i);
-        Real rho = unit_rho*pmb->phydro->w(IDN,k,j,i);
-        Real tcool = cooler.single_point_cooling_time(T, rho)/unit_time;
- 
-        if (tcool > 1e-10) {
-          min_dt = std::fmin(min_dt, tcool);
-        } else {
-          std::cout << "Bad Cell, Density: " << pmb->phydro->w(IDN,k,j,i) 
-                    <<       "  Pressure : " << pmb->phydro->w(IPR,k,j,i) 
-                    <<  "   Cooling Time : " << tcool 
-                    <<               "  z: " << pmb->pcoord->x3v(k) 
-                                             << std::endl;
-        }
-      }
+  for (int i=pmb->is; i<=pmb->ie; i++) {
+    Real T = unit_temp*prim(IPR,k,j,i)/prim(IDN,k,j,i);
+    Real rho = unit_rho*prim(IDN,k,j,i);
+    Real tcool = cooler.single_point_cooling_time(T, rho)/unit_time;
+
+    if (tcool > 1e-10) {
+      min_dt = std::fmin(min_dt, tcool);
+    } else {
+      RuntimeDiagnostics::Record(bad_cell_diag, prim(IDN,k,j,i), prim(IPR,k,j,i),
+                                 tcool, pmb->pcoord->x3v(k));
     }
   }
 
@@ -31,6 +31,7 @@
 #include "../globals.hpp"
 #include "../hydro/hydro.hpp"
 #include "../mesh/mesh.hpp"
+#include "../mesh/mesh_refinement.hpp"
 #include "../parameter_input.hpp"
 
 Real threshold;
@@ -437,6 +438,8 @@ int RefinementCondition(MeshBlock *pmb) {
     return 0;
   }
 
+  // refinements with the steepest pressure jumps go first if the AMR budget is reached
+  pmb->pmr->SetRefinementIndicator(maxeps);
   if (maxeps > threshold) return 1;
   if (maxeps < 0.25*threshold) return -1;
   return 0;
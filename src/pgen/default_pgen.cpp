@@ -95,7 +95,8 @@ void __attribute__((weak)) MeshBlock::ProblemGenerator(ParameterInput *pin) {
 //========================================================================================
 
 void __attribute__((weak)) MeshBlock::UserWorkInLoop() {
-  // do nothing
+  // do nothing; the time step may then be reduced during the final W(U) sweep
+  user_work_in_loop_ = false;
   return;
 }
 
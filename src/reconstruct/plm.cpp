@@ -30,8 +30,9 @@ void Reconstruction::PiecewiseLinearX1(
     AthenaArray<Real> &wl, AthenaArray<Real> &wr) {
   Coordinates *pco = pmy_block_->pcoord;
   // set work arrays to shallow copies of scratch arrays
-  AthenaArray<Real> &bx = scr01_i_, &wc = scr1_ni_, &dwl = scr2_ni_, &dwr = scr3_ni_,
-                   &dwm = scr4_ni_;
+  ScratchArrays &s = Scratch();
+  AthenaArray<Real> &bx = s.scr01_i, &wc = s.scr1_ni, &dwl = s.scr2_ni, &dwr = s.scr3_ni,
+                   &dwm = s.scr4_ni;
 
   // compute L/R slopes for each variable
   for (int n=0; n<NHYDRO; ++n) {
@@ -143,8 +144,9 @@ void Reconstruction::PiecewiseLinearX2(
     AthenaArray<Real> &wl, AthenaArray<Real> &wr) {
   Coordinates *pco = pmy_block_->pcoord;
   // set work arrays to shallow copies of scratch arrays
-  AthenaArray<Real> &bx = scr01_i_, &wc = scr1_ni_, &dwl = scr2_ni_,
-                   &dwr = scr3_ni_, &dwm = scr4_ni_;
+  ScratchArrays &s = Scratch();
+  AthenaArray<Real> &bx = s.scr01_i, &wc = s.scr1_ni, &dwl = s.scr2_ni,
+                   &dwr = s.scr3_ni, &dwm = s.scr4_ni;
 
   // compute L/R slopes for each variable
   for (int n=0; n<NHYDRO; ++n) {
@@ -257,8 +259,9 @@ void Reconstruction::PiecewiseLinearX3(
     AthenaArray<Real> &wl, AthenaArray<Real> &wr) {
   Coordinates *pco = pmy_block_->pcoord;
   // set work arrays to shallow copies of scratch arrays
-  AthenaArray<Real> &bx = scr01_i_, &wc = scr1_ni_, &dwl = scr2_ni_, &dwr = scr3_ni_,
-                   &dwm = scr4_ni_;
+  ScratchArrays &s = Scratch();
+  AthenaArray<Real> &bx = s.scr01_i, &wc = s.scr1_ni, &dwl = s.scr2_ni, &dwr = s.scr3_ni,
+                   &dwm = s.scr4_ni;
 
   // compute L/R slopes for each variable
   for (int n=0; n<NHYDRO; ++n) {
@@ -37,8 +37,9 @@ void Reconstruction::PiecewiseLinearX1(
     AthenaArray<Real> &ql, AthenaArray<Real> &qr) {
   Coordinates *pco = pmy_block_->pcoord;
   // set work arrays to shallow copies of scratch arrays
-  AthenaArray<Real> &qc = scr1_ni_, &dql = scr2_ni_, &dqr = scr3_ni_,
-                   &dqm = scr4_ni_;
+  ScratchArrays &s = Scratch();
+  AthenaArray<Real> &qc = s.scr1_ni, &dql = s.scr2_ni, &dqr = s.scr3_ni,
+                   &dqm = s.scr4_ni;
   const int nu = q.GetDim4() - 1;
 
   // compute L/R slopes for each variable
@@ -117,8 +118,9 @@ void Reconstruction::PiecewiseLinearX2(
     AthenaArray<Real> &ql, AthenaArray<Real> &qr) {
   Coordinates *pco = pmy_block_->pcoord;
   // set work arrays to shallow copies of scratch arrays
-  AthenaArray<Real> &qc = scr1_ni_, &dql = scr2_ni_,
-                   &dqr = scr3_ni_, &dqm = scr4_ni_;
+  ScratchArrays &s = Scratch();
+  AthenaArray<Real> &qc = s.scr1_ni, &dql = s.scr2_ni,
+                   &dqr = s.scr3_ni, &dqm = s.scr4_ni;
   const int nu = q.GetDim4() - 1;
 
   // compute L/R slopes for each variable
@@ -196,8 +198,9 @@ void Reconstruction::PiecewiseLinearX3(
     AthenaArray<Real> &ql, AthenaArray<Real> &qr) {
   Coordinates *pco = pmy_block_->pcoord;
   // set work arrays to shallow copies of scratch arrays
-  AthenaArray<Real> &qc = scr1_ni_, &dql = scr2_ni_, &dqr = scr3_ni_,
-                   &dqm = scr4_ni_;
+  ScratchArrays &s = Scratch();
+  AthenaArray<Real> &qc = s.scr1_ni, &dql = s.scr2_ni, &dqr = s.scr3_ni,
+                   &dqm = s.scr4_ni;
   const int nu = q.GetDim4() - 1;
 
   // compute L/R slopes for each variable
@@ -49,19 +49,20 @@ void Reconstruction::PiecewiseParabolicX1(
   const Real C2 = 1.25;
 
   // set work arrays used for primitive/characterstic cell-averages to scratch
-  AthenaArray<Real> &bx = scr01_i_, &wc = scr1_ni_, &q_im2 = scr2_ni_, &q_im1 = scr3_ni_,
-                     &q = scr4_ni_, &q_ip1 = scr5_ni_, &q_ip2 = scr6_ni_,
-                &qr_imh = scr7_ni_, &ql_iph = scr8_ni_;
+  ScratchArrays &s = Scratch();
+  AthenaArray<Real> &bx = s.scr01_i, &wc = s.scr1_ni, &q_im2 = s.scr2_ni,
+                   &q_im1 = s.scr3_ni, &q = s.scr4_ni, &q_ip1 = s.scr5_ni,
+                   &q_ip2 = s.scr6_ni, &qr_imh = s.scr7_ni, &ql_iph = s.scr8_ni;
 
   // set work PPM work arrays to shallow copies of scratch arrays:
-  AthenaArray<Real> &dd = scr02_i_, &dd_im1 = scr03_i_, &dd_ip1 = scr04_i_,
-                   &dph = scr05_i_, &dph_ip1 = scr06_i_;
+  AthenaArray<Real> &dd = s.scr02_i, &dd_im1 = s.scr03_i, &dd_ip1 = s.scr04_i,
+                   &dph = s.scr05_i, &dph_ip1 = s.scr06_i;
 
-  AthenaArray<Real> &d2qc_im1 = scr07_i_, &d2qc = scr08_i_, &d2qc_ip1 = scr09_i_,
-                        &d2qf = scr10_i_;
+  AthenaArray<Real> &d2qc_im1 = s.scr07_i, &d2qc = s.scr08_i, &d2qc_ip1 = s.scr09_i,
+                        &d2qf = s.scr10_i;
 
-  AthenaArray<Real> &qplus = scr11_i_, &qminus = scr12_i_, &dqf_plus = scr13_i_,
-                &dqf_minus = scr14_i_;
+  AthenaArray<Real> &qplus = s.scr11_i, &qminus = s.scr12_i, &dqf_plus = s.scr13_i,
+                &dqf_minus = s.scr14_i;
 
   // cache the x1-sliced primitive states for eigensystem calculation
   for (int n=0; n<NHYDRO; ++n) {
@@ -349,19 +350,20 @@ void Reconstruction::PiecewiseParabolicX2(
   const Real C2 = 1.25;
 
   // set work arrays used for primitive/characterstic cell-averages to scratch
-  AthenaArray<Real> &bx = scr01_i_, &wc = scr1_ni_, &q_jm2 = scr2_ni_, &q_jm1 = scr3_ni_,
-                     &q = scr4_ni_, &q_jp1 = scr5_ni_, &q_jp2 = scr6_ni_,
-                &qr_jmh = scr7_ni_, &ql_jph = scr8_ni_;
+  ScratchArrays &s = Scratch();
+  AthenaArray<Real> &bx = s.scr01_i, &wc = s.scr1_ni, &q_jm2 = s.scr2_ni,
+                   &q_jm1 = s.scr3_ni, &q = s.scr4_ni, &q_jp1 = s.scr5_ni,
+                   &q_jp2 = s.scr6_ni, &qr_jmh = s.scr7_ni, &ql_jph = s.scr8_ni;
 
   // set work PPM work arrays to shallow copies of scratch arrays:
-  AthenaArray<Real> &dd = scr02_i_, &dd_jm1 = scr03_i_, &dd_jp1 = scr04_i_,
-                   &dph = scr05_i_, &dph_jp1 = scr06_i_;
+  AthenaArray<Real> &dd = s.scr02_i, &dd_jm1 = s.scr03_i, &dd_jp1 = s.scr04_i,
+                   &dph = s.scr05_i, &dph_jp1 = s.scr06_i;
 
-  AthenaArray<Real> &d2qc_jm1 = scr07_i_, &d2qc = scr08_i_, &d2qc_jp1 = scr09_i_,
-                        &d2qf = scr10_i_;
+  AthenaArray<Real> &d2qc_jm1 = s.scr07_i, &d2qc = s.scr08_i, &d2qc_jp1 = s.scr09_i,
+                        &d2qf = s.scr10_i;
 
-  AthenaArray<Real> &qplus = scr11_i_, &qminus = scr12_i_, &dqf_plus = scr13_i_,
-                &dqf_minus = scr14_i_;
+  AthenaArray<Real> &qplus = s.scr11_i, &qminus = s.scr12_i, &dqf_plus = s.scr13_i,
+                &dqf_minus = s.scr14_i;
 
   // cache the x1-sliced primitive states for eigensystem calculation
   for (int n=0; n<NHYDRO; ++n) {
@@ -647,19 +649,20 @@ void Reconstruction::PiecewiseParabolicX3(
   const Real C2 = 1.25;
 
   // set work arrays used for primitive/characterstic cell-averages to scratch
-  AthenaArray<Real> &bx = scr01_i_, &wc = scr1_ni_, &q_km2 = scr2_ni_, &q_km1 = scr3_ni_,
-                     &q = scr4_ni_, &q_kp1 = scr5_ni_, &q_kp2 = scr6_ni_,
-                &qr_kmh = scr7_ni_, &ql_kph = scr8_ni_;
+  ScratchArrays &s = Scratch();
+  AthenaArray<Real> &bx = s.scr01_i, &wc = s.scr1_ni, &q_km2 = s.scr2_ni,
+                   &q_km1 = s.scr3_ni, &q = s.scr4_ni, &q_kp1 = s.scr5_ni,
+                   &q_kp2 = s.scr6_ni, &qr_kmh = s.scr7_ni, &ql_kph = s.scr8_ni;
 
   // set work PPM work arrays to shallow copies of scratch arrays:
-  AthenaArray<Real> &dd = scr02_i_, &dd_km1 = scr03_i_, &dd_kp1 = scr04_i_,
-                   &dph = scr05_i_, &dph_kp1 = scr06_i_;
+  AthenaArray<Real> &dd = s.scr02_i, &dd_km1 = s.scr03_i, &dd_kp1 = s.scr04_i,
+                   &dph = s.scr05_i, &dph_kp1 = s.scr06_i;
 
-  AthenaArray<Real> &d2qc_km1 = scr07_i_, &d2qc = scr08_i_,
-                    &d2qc_kp1 = scr09_i_, &d2qf = scr10_i_;
+  AthenaArray<Real> &d2qc_km1 = s.scr07_i, &d2qc = s.scr08_i,
+                    &d2qc_kp1 = s.scr09_i, &d2qf = s.scr10_i;
 
-  AthenaArray<Real> &qplus = scr11_i_, &qminus = scr12_i_, &dqf_plus = scr13_i_,
-                &dqf_minus = scr14_i_;
+  AthenaArray<Real> &qplus = s.scr11_i, &qminus = s.scr12_i, &dqf_plus = s.scr13_i,
+                &dqf_minus = s.scr14_i;
 
   // cache the x1-sliced primitive states for eigensystem calculation
   for (int n=0; n<NHYDRO; ++n) {
@@ -217,36 +217,42 @@ Reconstruction::Reconstruction(MeshBlock *pmb, ParameterInput *pin) :
   // TODO(c-white): use modified version of curvilinear PPM reconstruction weights and
   // limiter formulations for Schwarzschild, Kerr metrics instead of Cartesian-like wghts
 
-  // Allocate memory for scratch arrays used in PLM and PPM
+  // Allocate memory for scratch arrays used in PLM and PPM, one set per loop thread
   int nc1 = pmb->ncells1;
-  scr01_i_.NewAthenaArray(nc1);
-  scr02_i_.NewAthenaArray(nc1);
-
-  scr1_ni_.NewAthenaArray(std::max(NWAVE, NSCALARS), nc1);
-  scr2_ni_.NewAthenaArray(std::max(NWAVE, NSCALARS), nc1);
-  scr3_ni_.NewAthenaArray(std::max(NWAVE, NSCALARS), nc1);
-  scr4_ni_.NewAthenaArray(std::max(NWAVE, NSCALARS), nc1);
+  int nvar = std::max(NWAVE, NSCALARS);
+  scratch_.resize(pmb->pmy_mesh->GetNumLoopThreads());
+  for (ScratchArrays &s : scratch_) {
+    s.scr01_i.NewAthenaArray(nc1);
+    s.scr02_i.NewAthenaArray(nc1);
+
+    s.scr1_ni.NewAthenaArray(nvar, nc1);
+    s.scr2_ni.NewAthenaArray(nvar, nc1);
+    s.scr3_ni.NewAthenaArray(nvar, nc1);
+    s.scr4_ni.NewAthenaArray(nvar, nc1);
+
+    if ((xorder == 3) || (xorder == 4)) {
+      s.scr03_i.NewAthenaArray(nc1);
+      s.scr04_i.NewAthenaArray(nc1);
+      s.scr05_i.NewAthenaArray(nc1);
+      s.scr06_i.NewAthenaArray(nc1);
+      s.scr07_i.NewAthenaArray(nc1);
+      s.scr08_i.NewAthenaArray(nc1);
+      s.scr09_i.NewAthenaArray(nc1);
+      s.scr10_i.NewAthenaArray(nc1);
+      s.scr11_i.NewAthenaArray(nc1);
+      s.scr12_i.NewAthenaArray(nc1);
+      s.scr13_i.NewAthenaArray(nc1);
+      s.scr14_i.NewAthenaArray(nc1);
+
+      s.scr5_ni.NewAthenaArray(nvar, nc1);
+      s.scr6_ni.NewAthenaArray(nvar, nc1);
+      s.scr7_ni.NewAthenaArray(nvar, nc1);
+      s.scr8_ni.NewAthenaArray(nvar, nc1);
+    }
+  }
 
   if ((xorder == 3) || (xorder == 4)) {
     Coordinates *pco = pmb->pcoord;
-    scr03_i_.NewAthenaArray(nc1);
-    scr04_i_.NewAthenaArray(nc1);
-    scr05_i_.NewAthenaArray(nc1);
-    scr06_i_.NewAthenaArray(nc1);
-    scr07_i_.NewAthenaArray(nc1);
-    scr08_i_.NewAthenaArray(nc1);
-    scr09_i_.NewAthenaArray(nc1);
-    scr10_i_.NewAthenaArray(nc1);
-    scr11_i_.NewAthenaArray(nc1);
-    scr12_i_.NewAthenaArray(nc1);
-    scr13_i_.NewAthenaArray(nc1);
-    scr14_i_.NewAthenaArray(nc1);
-
-    scr5_ni_.NewAthenaArray(std::max(NWAVE, NSCALARS), nc1);
-    scr6_ni_.NewAthenaArray(std::max(NWAVE, NSCALARS), nc1);
-    scr7_ni_.NewAthenaArray(std::max(NWAVE, NSCALARS), nc1);
-    scr8_ni_.NewAthenaArray(std::max(NWAVE, NSCALARS), nc1);
-
     // Precompute PPM coefficients in x1-direction ---------------------------------------
     c1i.NewAthenaArray(nc1);
     c2i.NewAthenaArray(nc1);
@@ -11,10 +11,12 @@
 // C headers
 
 // C++ headers
+#include <vector>
 
 // Athena++ headers
 #include "../athena.hpp"
 #include "../athena_arrays.hpp"
+#include "../utils/utils.hpp"
 
 // Forward declarations
 class MeshBlock;
@@ -133,10 +135,16 @@ class Reconstruction {
   MeshBlock* pmy_block_;  // ptr to MeshBlock containing this Reconstruction
 
   // scratch arrays used in PLM and PPM reconstruction functions
-  AthenaArray<Real> scr01_i_, scr02_i_, scr03_i_, scr04_i_, scr05_i_;
-  AthenaArray<Real> scr06_i_, scr07_i_, scr08_i_, scr09_i_, scr10_i_;
-  AthenaArray<Real> scr11_i_, scr12_i_, scr13_i_, scr14_i_;
-  AthenaArray<Real> scr1_ni_, scr2_ni_, scr3_ni_, scr4_ni_, scr5_ni_;
-  AthenaArray<Real> scr6_ni_, scr7_ni_, scr8_ni_;
+  struct ScratchArrays {
+    AthenaArray<Real> scr01_i, scr02_i, scr03_i, scr04_i, scr05_i;
+    AthenaArray<Real> scr06_i, scr07_i, scr08_i, scr09_i, scr10_i;
+    AthenaArray<Real> scr11_i, scr12_i, scr13_i, scr14_i;
+    AthenaArray<Real> scr1_ni, scr2_ni, scr3_ni, scr4_ni, scr5_ni;
+    AthenaArray<Real> scr6_ni, scr7_ni, scr8_ni;
+  };
+  std::vector<ScratchArrays> scratch_;  // one set per loop-level OpenMP thread
+  ScratchArrays &Scratch() {
+    return scratch_[LoopThreadNum(static_cast<int>(scratch_.size()))];
+  }
 };
 #endif // RECONSTRUCT_RECONSTRUCTION_HPP_
@@ -41,58 +41,88 @@
 
 void PassiveScalars::AddFluxDivergence(const Real wght, AthenaArray<Real> &s_out) {
   MeshBlock *pmb = pmy_block;
+  for (int k=pmb->ks; k<=pmb->ke; ++k) {
+    for (int j=pmb->js; j<=pmb->je; ++j) {
+      AddFluxDivergencePencil(k, j, wght, s_out);
+    }
+  }
+  return;
+}
+
+//----------------------------------------------------------------------------------------
+//! \fn  void PassiveScalars::AddFluxDivergenceFused
+//! \brief Single-sweep stage update of the passive scalars; the counterpart of
+//! Hydro::AddFluxDivergenceFused() (scalar source terms are enrolled with the hydro)
+
+void PassiveScalars::AddFluxDivergenceFused(const Real wght, const Real delta,
+                                            const Real ave_wghts[3]) {
+  MeshBlock *pmb = pmy_block;
+  const Real delta_wghts[3] = {1.0, delta, 0.0};
+
+  for (int k=pmb->ks; k<=pmb->ke; ++k) {
+    for (int j=pmb->js; j<=pmb->je; ++j) {
+      pmb->WeightedAvePencil(s1, s, s2, delta_wghts, k, j);
+      pmb->WeightedAvePencil(s, s1, s2, ave_wghts, k, j);
+      AddFluxDivergencePencil(k, j, wght, s);
+    }
+  }
+  return;
+}
+
+//----------------------------------------------------------------------------------------
+//! \fn  void PassiveScalars::AddFluxDivergencePencil
+//! \brief Adds scalar flux divergence to the conserved scalars on a single (k,j) pencil
+
+void PassiveScalars::AddFluxDivergencePencil(const int k, const int j, const Real wght,
+                                             AthenaArray<Real> &s_out) {
+  MeshBlock *pmb = pmy_block;
   AthenaArray<Real> &x1flux = s_flux[X1DIR];
   AthenaArray<Real> &x2flux = s_flux[X2DIR];
   AthenaArray<Real> &x3flux = s_flux[X3DIR];
-  int is = pmb->is; int js = pmb->js; int ks = pmb->ks;
-  int ie = pmb->ie; int je = pmb->je; int ke = pmb->ke;
+  int is = pmb->is; int ie = pmb->ie;
   AthenaArray<Real> &x1area = x1face_area_, &x2area = x2face_area_,
                  &x2area_p1 = x2face_area_p1_, &x3area = x3face_area_,
                  &x3area_p1 = x3face_area_p1_, &vol = cell_volume_, &dflx = dflx_;
 
-  for (int k=ks; k<=ke; ++k) {
-    for (int j=js; j<=je; ++j) {
-      // calculate x1-flux divergence
-      pmb->pcoord->Face1Area(k, j, is, ie+1, x1area);
-      for (int n=0; n<NSCALARS; ++n) {
+  // calculate x1-flux divergence
+  pmb->pcoord->Face1Area(k, j, is, ie+1, x1area);
+  for (int n=0; n<NSCALARS; ++n) {
 #pragma omp simd
-        for (int i=is; i<=ie; ++i) {
-          dflx(n,i) = (x1area(i+1)*x1flux(n,k,j,i+1) - x1area(i)*x1flux(n,k,j,i));
-        }
-      }
+    for (int i=is; i<=ie; ++i) {
+      dflx(n,i) = (x1area(i+1)*x1flux(n,k,j,i+1) - x1area(i)*x1flux(n,k,j,i));
+    }
+  }
 
-      // calculate x2-flux divergence
-      if (pmb->block_size.nx2 > 1) {
-        pmb->pcoord->Face2Area(k, j  , is, ie, x2area   );
-        pmb->pcoord->Face2Area(k, j+1, is, ie, x2area_p1);
-        for (int n=0; n<NSCALARS; ++n) {
+  // calculate x2-flux divergence
+  if (pmb->block_size.nx2 > 1) {
+    pmb->pcoord->Face2Area(k, j  , is, ie, x2area   );
+    pmb->pcoord->Face2Area(k, j+1, is, ie, x2area_p1);
+    for (int n=0; n<NSCALARS; ++n) {
 #pragma omp simd
-          for (int i=is; i<=ie; ++i) {
-            dflx(n,i) += (x2area_p1(i)*x2flux(n,k,j+1,i) - x2area(i)*x2flux(n,k,j,i));
-          }
-        }
+      for (int i=is; i<=ie; ++i) {
+        dflx(n,i) += (x2area_p1(i)*x2flux(n,k,j+1,i) - x2area(i)*x2flux(n,k,j,i));
       }
+    }
+  }
 
-      // calculate x3-flux divergence
-      if (pmb->block_size.nx3 > 1) {
-        pmb->pcoord->Face3Area(k  , j, is, ie, x3area   );
-        pmb->pcoord->Face3Area(k+1, j, is, ie, x3area_p1);
-        for (int n=0; n<NSCALARS; ++n) {
+  // calculate x3-flux divergence
+  if (pmb->block_size.nx3 > 1) {
+    pmb->pcoord->Face3Area(k  , j, is, ie, x3area   );
+    pmb->pcoord->Face3Area(k+1, j, is, ie, x3area_p1);
+    for (int n=0; n<NSCALARS; ++n) {
 #pragma omp simd
-          for (int i=is; i<=ie; ++i) {
-            dflx(n,i) += (x3area_p1(i)*x3flux(n,k+1,j,i) - x3area(i)*x3flux(n,k,j,i));
-          }
-        }
+      for (int i=is; i<=ie; ++i) {
+        dflx(n,i) += (x3area_p1(i)*x3flux(n,k+1,j,i) - x3area(i)*x3flux(n,k,j,i));
       }
+    }
+  }
 
-      // update conserved variables
-      pmb->pcoord->CellVolume(k, j, is, ie, vol);
-      for (int n=0; n<NSCALARS; ++n) {
+  // update conserved variables
+  pmb->pcoord->CellVolume(k, j, is, ie, vol);
+  for (int n=0; n<NSCALARS; ++n) {
 #pragma omp simd
-        for (int i=is; i<=ie; ++i) {
-          s_out(n,k,j,i) -= wght*dflx(n,i)/vol(i);
-        }
-      }
+    for (int i=is; i<=ie; ++i) {
+      s_out(n,k,j,i) -= wght*dflx(n,i)/vol(i);
     }
   }
   return;
@@ -90,6 +90,8 @@ void PassiveScalars::CalculateFluxes(AthenaArray<Real> &r, const int order) {
       }
 
       ComputeUpwindFlux(k, j, is, ie+1, rl_, rr_, mass_flux, x1flux);
+      if (order != 4)
+        AddDiffusiveFluxX1(diffuse_idx_, k, j, is, ie+1, r, hyd.w, x1flux);
 
       if (order == 4) {
         for (int n=0; n<NSCALARS; n++) {
@@ -194,6 +196,8 @@ void PassiveScalars::CalculateFluxes(AthenaArray<Real> &r, const int order) {
         }
 
         ComputeUpwindFlux(k, j, il, iu, rl_, rr_, mass_flux, x2flux);
+        if (order != 4)
+          AddDiffusiveFluxX2(diffuse_idx_, k, j, il, iu, r, hyd.w, x2flux);
 
         if (order == 4) {
           for (int n=0; n<NSCALARS; n++) {
@@ -295,6 +299,8 @@ void PassiveScalars::CalculateFluxes(AthenaArray<Real> &r, const int order) {
         }
 
         ComputeUpwindFlux(k, j, il, iu, rl_, rr_, mass_flux, x3flux);
+        if (order != 4)
+          AddDiffusiveFluxX3(diffuse_idx_, k, j, il, iu, r, hyd.w, x3flux);
 
         if (order == 4) {
           for (int n=0; n<NSCALARS; n++) {
@@ -349,8 +355,25 @@ void PassiveScalars::CalculateFluxes(AthenaArray<Real> &r, const int order) {
     } // end if (order == 4)
   }
 
-  if (!STS_ENABLED) {
-    AddDiffusionFluxes();
+  // diffusion of the scalars evolved by the main integrator is added in the pencil
+  // sweeps above, except at fourth order where the fluxes are only final here
+  if (order == 4 && !diffuse_idx_.empty()) {
+    for (int k=ks; k<=ke; ++k) {
+      for (int j=js; j<=je; ++j)
+        AddDiffusiveFluxX1(diffuse_idx_, k, j, is, ie+1, r, hyd.w, x1flux);
+    }
+    if (pmb->pmy_mesh->f2) {
+      for (int k=ks; k<=ke; ++k) {
+        for (int j=js; j<=je+1; ++j)
+          AddDiffusiveFluxX2(diffuse_idx_, k, j, is, ie, r, hyd.w, s_flux[X2DIR]);
+      }
+    }
+    if (pmb->pmy_mesh->f3) {
+      for (int k=ks; k<=ke+1; ++k) {
+        for (int j=js; j<=je; ++j)
+          AddDiffusiveFluxX3(diffuse_idx_, k, j, is, ie, r, hyd.w, s_flux[X3DIR]);
+      }
+    }
   }
   return;
 }
@@ -11,11 +11,13 @@
 // C++ headers
 #include <algorithm>   // min,max
 #include <limits>
+#include <vector>
 
 // Athena++ headers
 #include "../athena.hpp"
 #include "../athena_arrays.hpp"
 #include "../coordinates/coordinates.hpp"
+#include "../mesh/mesh.hpp"
 #include "scalars.hpp"
 
 // OpenMP header
@@ -34,7 +36,7 @@
 //! 2x HydroDiffusion::AddDiffusion*Flux(), FieldDiffusion::AddPoyntingFlux
 
 void PassiveScalars::AddDiffusionFluxes() {
-  if (scalar_diffusion_defined) {
+  if (scalar_diffusion_sts) {
     // if (nu_scalar_iso > 0.0 || nu_scalar_aniso > 0.0)
     // AddDiffusionFlux(diffusion_flx, flux);
 
@@ -62,20 +64,18 @@ void PassiveScalars::AddDiffusionFluxes() {
 
 //----------------------------------------------------------------------------------------
 //! \fn void PassiveScalars::DiffusiveFluxIso
-//! \brief
+//! \brief isotropic diffusive fluxes of the STS-integrated scalars in flx_out
 
 void PassiveScalars::DiffusiveFluxIso(const AthenaArray<Real> &prim_r,
                                       const AthenaArray<Real> &w,
                                       AthenaArray<Real> *flx_out) {
   MeshBlock *pmb = pmy_block;
-  Coordinates *pco = pmb->pcoord;
   const bool f2 = pmb->pmy_mesh->f2;
   const bool f3 = pmb->pmy_mesh->f3;
-  AthenaArray<Real> &x1flux = flx_out[X1DIR];
+  const std::vector<int> &idx = diffuse_sts_idx_;
   int il, iu, jl, ju, kl, ku;
   int is = pmb->is; int js = pmb->js; int ks = pmb->ks;
   int ie = pmb->ie; int je = pmb->je; int ke = pmb->ke;
-  Real nu_face, rho_face, dprim_r_dx, dprim_r_dy, dprim_r_dz;
 
   // i-direction
   jl = js, ju = je, kl = ks, ku = ke;
@@ -87,18 +87,9 @@ void PassiveScalars::DiffusiveFluxIso(const AthenaArray<Real> &prim_r,
         jl = js - 1, ju = je + 1, kl = ks - 1, ku = ke + 1;
     }
   }
-  for (int n=0; n<NSCALARS; n++) {
-    for (int k=kl; k<=ku; ++k) {
-      for (int j=jl; j<=ju; ++j) {
-#pragma omp simd
-        for (int i=is; i<=ie+1; ++i) {
-          nu_face = nu_scalar_iso;
-          // = 0.5*(kappa(DiffProcess::iso,k,j,i) + kappa(DiffProcess::iso,k,j,i-1));
-          rho_face = 0.5*(w(IDN,k,j,i) + w(IDN,k,j,i-1));
-          dprim_r_dx = (prim_r(n,k,j,i) - prim_r(n,k,j,i-1))/pco->dx1v(i-1);
-          x1flux(n,k,j,i) -= nu_face*rho_face*dprim_r_dx;
-        }
-      }
+  for (int k=kl; k<=ku; ++k) {
+    for (int j=jl; j<=ju; ++j) {
+      AddDiffusiveFluxX1(idx, k, j, is, ie+1, prim_r, w, flx_out[X1DIR]);
     }
   }
 
@@ -111,19 +102,9 @@ void PassiveScalars::DiffusiveFluxIso(const AthenaArray<Real> &prim_r,
       il = is - 1, iu = ie + 1, kl = ks - 1, ku = ke + 1;
   }
   if (f2) { // 2D or 3D
-    AthenaArray<Real> &x2flux = flx_out[X2DIR];
-    for (int n=0; n<NSCALARS; n++) {
-      for (int k=kl; k<=ku; ++k) {
-        for (int j=js; j<=je+1; ++j) {
-#pragma omp simd
-          for (int i=il; i<=iu; ++i) {
-            nu_face = nu_scalar_iso;
-            // = 0.5*(kappa(DiffProcess::iso,k,j,i) + kappa(DiffProcess::iso,k,j-1,i));
-            rho_face = 0.5*(w(IDN,k,j,i) + w(IDN,k,j-1,i));
-            dprim_r_dy = (prim_r(n,k,j,i) - prim_r(n,k,j-1,i))/pco->h2v(i)/pco->dx2v(j-1);
-            x2flux(n,k,j,i) -= nu_face*rho_face*dprim_r_dy;
-          }
-        }
+    for (int k=kl; k<=ku; ++k) {
+      for (int j=js; j<=je+1; ++j) {
+        AddDiffusiveFluxX2(idx, k, j, il, iu, prim_r, w, flx_out[X2DIR]);
       }
     } // zero flux for 1D
   }
@@ -137,20 +118,9 @@ void PassiveScalars::DiffusiveFluxIso(const AthenaArray<Real> &prim_r,
       il = is - 1, iu = ie + 1;
   }
   if (f3) { // 3D
-    AthenaArray<Real> &x3flux = flx_out[X3DIR];
-    for (int n=0; n<NSCALARS; n++) {
-      for (int k=ks; k<=ke+1; ++k) {
-        for (int j=jl; j<=ju; ++j) {
-#pragma omp simd
-          for (int i=il; i<=iu; ++i) {
-            nu_face = nu_scalar_iso;
-            // = 0.5*(kappa(DiffProcess::iso,k,j,i) + kappa(DiffProcess::iso,k-1,j,i));
-            rho_face = 0.5*(w(IDN,k,j,i) + w(IDN,k-1,j,i));
-            dprim_r_dz = (prim_r(n,k,j,i) - prim_r(n,k-1,j,i))/pco->dx3v(k-1)/pco->h31v(i)
-                         /pco->h32v(j);
-            x3flux(n,k,j,i) -= nu_face*rho_face*dprim_r_dz;
-          }
-        }
+    for (int k=ks; k<=ke+1; ++k) {
+      for (int j=jl; j<=ju; ++j) {
+        AddDiffusiveFluxX3(idx, k, j, il, iu, prim_r, w, flx_out[X3DIR]);
       }
     } // zero flux for 1D/2D
   }
@@ -158,10 +128,85 @@ void PassiveScalars::DiffusiveFluxIso(const AthenaArray<Real> &prim_r,
 }
 
 //----------------------------------------------------------------------------------------
-//! \fn void PassiveScalars::NewDiffusionDt
-//! \brief
+//! \fn void PassiveScalars::AddDiffusiveFluxX1
+//! \brief add the isotropic diffusive x1-fluxes of the scalars listed in idx along a
+//!        single (k,j) pencil of faces il..iu
+
+void PassiveScalars::AddDiffusiveFluxX1(const std::vector<int> &idx, const int k,
+                                        const int j, const int il, const int iu,
+                                        const AthenaArray<Real> &prim_r,
+                                        const AthenaArray<Real> &w,
+                                        AthenaArray<Real> &x1flux) {
+  Coordinates *pco = pmy_block->pcoord;
+  for (std::size_t m=0; m<idx.size(); ++m) {
+    const int n = idx[m];
+    const Real nu_face = nu_scalar[n];
+#pragma omp simd
+    for (int i=il; i<=iu; ++i) {
+      // = 0.5*(kappa(DiffProcess::iso,k,j,i) + kappa(DiffProcess::iso,k,j,i-1));
+      Real rho_face = 0.5*(w(IDN,k,j,i) + w(IDN,k,j,i-1));
+      Real dprim_r_dx = (prim_r(n,k,j,i) - prim_r(n,k,j,i-1))/pco->dx1v(i-1);
+      x1flux(n,k,j,i) -= nu_face*rho_face*dprim_r_dx;
+    }
+  }
+  return;
+}
+
+//----------------------------------------------------------------------------------------
+//! \fn void PassiveScalars::AddDiffusiveFluxX2
+//! \brief add the isotropic diffusive x2-fluxes of the scalars listed in idx along a
+//!        single (k,j) pencil of faces il..iu
+
+void PassiveScalars::AddDiffusiveFluxX2(const std::vector<int> &idx, const int k,
+                                        const int j, const int il, const int iu,
+                                        const AthenaArray<Real> &prim_r,
+                                        const AthenaArray<Real> &w,
+                                        AthenaArray<Real> &x2flux) {
+  Coordinates *pco = pmy_block->pcoord;
+  for (std::size_t m=0; m<idx.size(); ++m) {
+    const int n = idx[m];
+    const Real nu_face = nu_scalar[n];
+#pragma omp simd
+    for (int i=il; i<=iu; ++i) {
+      Real rho_face = 0.5*(w(IDN,k,j,i) + w(IDN,k,j-1,i));
+      Real dprim_r_dy = (prim_r(n,k,j,i) - prim_r(n,k,j-1,i))/pco->h2v(i)/pco->dx2v(j-1);
+      x2flux(n,k,j,i) -= nu_face*rho_face*dprim_r_dy;
+    }
+  }
+  return;
+}
+
+//----------------------------------------------------------------------------------------
+//! \fn void PassiveScalars::AddDiffusiveFluxX3
+//! \brief add the isotropic diffusive x3-fluxes of the scalars listed in idx along a
+//!        single (k,j) pencil of faces il..iu
+
+void PassiveScalars::AddDiffusiveFluxX3(const std::vector<int> &idx, const int k,
+                                        const int j, const int il, const int iu,
+                                        const AthenaArray<Real> &prim_r,
+                                        const AthenaArray<Real> &w,
+                                        AthenaArray<Real> &x3flux) {
+  Coordinates *pco = pmy_block->pcoord;
+  for (std::size_t m=0; m<idx.size(); ++m) {
+    const int n = idx[m];
+    const Real nu_face = nu_scalar[n];
+#pragma omp simd
+    for (int i=il; i<=iu; ++i) {
+      Real rho_face = 0.5*(w(IDN,k,j,i) + w(IDN,k-1,j,i));
+      Real dprim_r_dz = (prim_r(n,k,j,i) - prim_r(n,k-1,j,i))/pco->dx3v(k-1)/pco->h31v(i)
+                        /pco->h32v(j);
+      x3flux(n,k,j,i) -= nu_face*rho_face*dprim_r_dz;
+    }
+  }
+  return;
+}
+
+//----------------------------------------------------------------------------------------
+//! \fn void PassiveScalars::NewDiffusionDt(Real &dt_explicit, Real &dt_sts)
+//! \brief diffusive timestep limits of the scalars integrated by the main integrator and
+//!        by STS
 
-Real PassiveScalars::NewDiffusionDt() {
+void PassiveScalars::NewDiffusionDt(Real &dt_explicit, Real &dt_sts) {
   Real real_max = std::numeric_limits<Real>::max();
   MeshBlock *pmb = pmy_block;
   const bool f2 = pmb->pmy_mesh->f2;
@@ -176,7 +221,15 @@ Real PassiveScalars::NewDiffusionDt() {
   else
     fac = 0.5;
 
-  Real dt_diff = real_max;
+  // the coefficients are constant, so only the largest one of each group matters
+  Real nu_explicit = 0.0, nu_sts = 0.0;
+  for (std::size_t m=0; m<diffuse_idx_.size(); ++m)
+    nu_explicit = std::max(nu_explicit, nu_scalar[diffuse_idx_[m]]);
+  for (std::size_t m=0; m<diffuse_sts_idx_.size(); ++m)
+    nu_sts = std::max(nu_sts, nu_scalar[diffuse_sts_idx_[m]]);
+
+  dt_explicit = real_max;
+  dt_sts = real_max;
   // Commented-out future extensions: local diffusion coefficients, anisotropic diffusion
   // for passive scalars:
   // AthenaArray<Real> &nu_scalar_t = nu_scalar_tot_;
@@ -184,18 +237,6 @@ Real PassiveScalars::NewDiffusionDt() {
 
   for (int k=kl; k<=ku; ++k) {
     for (int j=jl; j<=ju; ++j) {
-      // #pragma omp simd
-//       for (int i=il; i<=iu; ++i) {
-//         nu_scalar_t(i) = 0.0;
-//       }
-//       if (nu_scalar_iso > 0.0) {
-// #pragma omp simd
-//         for (int i=il; i<=iu; ++i) nu_scalar_t(i) += nu(DiffProcess::iso,k,j,i);
-//       }
-//       if (nu_scalar_aniso > 0.0) {
-// #pragma omp simd
-//         for (int i=il; i<=iu; ++i) nu_scalar_t(i) += nu(DiffProcess::aniso,k,j,i);
-//       }
       pmb->pcoord->CenterWidth1(k, j, il, iu, len);
       pmb->pcoord->CenterWidth2(k, j, il, iu, dx2);
       pmb->pcoord->CenterWidth3(k, j, il, iu, dx3);
@@ -204,14 +245,19 @@ Real PassiveScalars::NewDiffusionDt() {
         len(i) = (f2) ? std::min(len(i), dx2(i)) : len(i);
         len(i) = (f3) ? std::min(len(i), dx3(i)) : len(i);
       }
-      if (nu_scalar_iso > 0.0) { // || (nu_scalar_aniso > 0.0)) {
+      if (nu_explicit > 0.0) {
         for (int i=il; i<=iu; ++i) {
-          dt_diff = std::min(dt_diff, static_cast<Real>(
-              SQR(len(i))*fac/(nu_scalar_iso + TINY_NUMBER)));
-              // /(nu_scalar_t(i) + TINY_NUMBER)));
+          dt_explicit = std::min(dt_explicit, static_cast<Real>(
+              SQR(len(i))*fac/(nu_explicit + TINY_NUMBER)));
+        }
+      }
+      if (nu_sts > 0.0) {
+        for (int i=il; i<=iu; ++i) {
+          dt_sts = std::min(dt_sts, static_cast<Real>(
+              SQR(len(i))*fac/(nu_sts + TINY_NUMBER)));
         }
       }
     }
   }
-  return dt_diff;
+  return;
 }
@@ -10,6 +10,8 @@
 
 // C++ headers
 #include <algorithm>
+#include <sstream>
+#include <stdexcept>
 #include <string>
 #include <vector>
 
@@ -19,6 +21,7 @@
 #include "../coordinates/coordinates.hpp"
 #include "../eos/eos.hpp"
 #include "../mesh/mesh.hpp"
+#include "../parameter_input.hpp"
 #include "../reconstruct/reconstruction.hpp"
 #include "scalars.hpp"
 
@@ -45,11 +48,34 @@ PassiveScalars::PassiveScalars(MeshBlock *pmb, ParameterInput *pin)  :
     sbvar(pmb, &s, &coarse_s_, s_flux),
     nu_scalar_iso{pin->GetOrAddReal("problem", "nu_scalar_iso", 0.0)},
     //nu_scalar_aniso{pin->GetOrAddReal("problem", "nu_scalar_aniso", 0.0)},
-    scalar_diffusion_defined{(nu_scalar_iso > 0.0 ? true : false)},
+    nu_scalar(NSCALARS, nu_scalar_iso),
+    scalar_diffusion_defined{false}, scalar_diffusion_sts{false},
     pmy_block(pmb) {
   int nc1 = pmb->ncells1, nc2 = pmb->ncells2, nc3 = pmb->ncells3;
   Mesh *pm = pmy_block->pmy_mesh;
 
+  // per-scalar diffusion: nu_scalar_iso_<n> overrides the default coefficient (0 turns
+  // diffusion of scalar n off); with STS, scalar_sts_<n> = false keeps the diffusion of
+  // scalar n in the main integrator. Only the diffusing scalars are ever looped over.
+  for (int n=0; n<NSCALARS; ++n) {
+    std::string suffix = "_" + std::to_string(n);
+    if (pin->DoesParameterExist("problem", "nu_scalar_iso" + suffix))
+      nu_scalar[n] = pin->GetReal("problem", "nu_scalar_iso" + suffix);
+    if (nu_scalar[n] <= 0.0) {
+      nu_scalar[n] = 0.0;
+      continue;
+    }
+    bool sts = STS_ENABLED;
+    if (STS_ENABLED && pin->DoesParameterExist("problem", "scalar_sts" + suffix))
+      sts = pin->GetBoolean("problem", "scalar_sts" + suffix);
+    if (sts)
+      diffuse_sts_idx_.push_back(n);
+    else
+      diffuse_idx_.push_back(n);
+  }
+  scalar_diffusion_sts = !diffuse_sts_idx_.empty();
+  scalar_diffusion_defined = scalar_diffusion_sts || !diffuse_idx_.empty();
+
   pmb->RegisterMeshBlockData(s);
 
   // Allocate optional passive scalar variable memory registers for time-integrator
@@ -84,11 +110,25 @@ PassiveScalars::PassiveScalars(MeshBlock *pmb, ParameterInput *pin)  :
   pmb->pbval->bvars.push_back(&sbvar);
   pmb->pbval->bvars_main_int.push_back(&sbvar);
   if (STS_ENABLED) {
-    if (scalar_diffusion_defined) {
+    if (scalar_diffusion_sts) {
       pmb->pbval->bvars_sts.push_back(&sbvar);
     }
   }
 
+  // optionally exchange the ghost zones of same-level neighbors in single precision;
+  // fluxes and the conserved-to-primitive conversion are still computed in Real
+  std::string comm_precision = pin->GetOrAddString("problem", "scalar_comm_precision",
+                                                   "double");
+  if (comm_precision == "single") {
+    sbvar.float_buffers = (sizeof(Real) > sizeof(float));
+  } else if (comm_precision != "double") {
+    std::stringstream msg;
+    msg << "### FATAL ERROR in PassiveScalars constructor" << std::endl
+        << "scalar_comm_precision=" << comm_precision << " must be double or single"
+        << std::endl;
+    ATHENA_ERROR(msg);
+  }
+
   // Allocate memory for scratch arrays
   rl_.NewAthenaArray(NSCALARS, nc1);
   rr_.NewAthenaArray(NSCALARS, nc1);
@@ -124,10 +164,12 @@ PassiveScalars::PassiveScalars(MeshBlock *pmb, ParameterInput *pin)  :
     laplacian_r_fc_.NewAthenaArray(nc1);
   }
 
-  if (scalar_diffusion_defined) {
+  if (scalar_diffusion_sts) {
     diffusion_flx[X1DIR].NewAthenaArray(NSCALARS, nc3, nc2, nc1+1);
     diffusion_flx[X2DIR].NewAthenaArray(NSCALARS, nc3, nc2+1, nc1);
     diffusion_flx[X3DIR].NewAthenaArray(NSCALARS, nc3+1, nc2, nc1);
+  }
+  if (scalar_diffusion_defined) {
     //nu_scalar.NewAthenaArray(2, nc3, nc2, nc1);
     dx1_.NewAthenaArray(nc1);
     dx2_.NewAthenaArray(nc1);
@@ -11,6 +11,7 @@
 // C headers
 
 // C++ headers
+#include <vector>
 
 // Athena++ headers
 #include "../athena.hpp"
@@ -54,6 +55,8 @@ class PassiveScalars {
   // public functions:
   // KGF: use inheritance for these functions / overall class?
   void AddFluxDivergence(const Real wght, AthenaArray<Real> &s_out);
+  void AddFluxDivergenceFused(const Real wght, const Real delta,
+                              const Real ave_wghts[3]);
   void AddFluxDivergence_STS(const Real wght, int stage,
                              AthenaArray<Real> &s_out, AthenaArray<Real> &s_flux_div_out);
   void CalculateFluxes(AthenaArray<Real> &s, const int order);
@@ -63,22 +66,26 @@ class PassiveScalars {
   //! for now, not creating subfolder "scalars_diffusion/", nor class ScalarDiffusion
   //! that is would have an instance contained within PassiveScalars like HydroDiffusion
   //! approach. Consider creating an encapsulated class as these features are generalized.
-  Real nu_scalar_iso; //, nu_scalar_aniso;          // diffusion coeff
-  bool scalar_diffusion_defined;
-  AthenaArray<Real> diffusion_flx[3];
-  // AthenaArray<Real> nu_scalar;               // diffusion array
+  Real nu_scalar_iso; //, nu_scalar_aniso;          // default diffusion coeff
+  std::vector<Real> nu_scalar;                 // per-scalar diffusion coeff (0 = off)
+  bool scalar_diffusion_defined;               // any scalar diffuses
+  bool scalar_diffusion_sts;                   // any scalar diffuses within STS
+  AthenaArray<Real> diffusion_flx[3];          // (only for STS-integrated scalars)
 
   //! \note
-  //! No need for nu_scalar array, nor counterpart to HydroDiffusion::CalcDiffusionFlux
-  //! wrapper function since, currently:
-  //! - nu_scalar_iso must be constant across the mesh
+  //! No need for a spatially varying nu_scalar array, nor counterpart to
+  //! HydroDiffusion::CalcDiffusionFlux wrapper function since, currently:
+  //! - nu_scalar must be constant across the mesh
   //!   (does not depend on local fluid or field variables),
   //! - there is only one type of
   //!   passive scalar diffusion process (nu_scalar_aniso disabled, no "eta"l, etc.)
-  //! - nu_scalar_iso is identical for all NSCALARS
+  //!
+  //! Scalars integrated by the main integrator have their diffusive fluxes added pencil
+  //! by pencil in CalculateFluxes(); DiffusiveFluxIso() only fills diffusion_flx for the
+  //! STS-integrated scalars.
   void DiffusiveFluxIso(const AthenaArray<Real> &prim_r, const AthenaArray<Real> &w,
                         AthenaArray<Real> *flx_out);
-  Real NewDiffusionDt();
+  void NewDiffusionDt(Real &dt_explicit, Real &dt_sts);
 
  private:
   MeshBlock* pmy_block;
@@ -104,6 +111,19 @@ class PassiveScalars {
                          AthenaArray<Real> &mass_flx,
                          AthenaArray<Real> &flx_out);
   void AddDiffusionFluxes();
+  // compressed lists of the diffusing scalars (main integrator, STS)
+  std::vector<int> diffuse_idx_, diffuse_sts_idx_;
+  void AddDiffusiveFluxX1(const std::vector<int> &idx, const int k, const int j,
+                          const int il, const int iu, const AthenaArray<Real> &prim_r,
+                          const AthenaArray<Real> &w, AthenaArray<Real> &x1flux);
+  void AddDiffusiveFluxX2(const std::vector<int> &idx, const int k, const int j,
+                          const int il, const int iu, const AthenaArray<Real> &prim_r,
+                          const AthenaArray<Real> &w, AthenaArray<Real> &x2flux);
+  void AddDiffusiveFluxX3(const std::vector<int> &idx, const int k, const int j,
+                          const int il, const int iu, const AthenaArray<Real> &prim_r,
+                          const AthenaArray<Real> &w, AthenaArray<Real> &x3flux);
+  void AddFluxDivergencePencil(const int k, const int j, const Real wght,
+                               AthenaArray<Real> &s_out);
   // TODO(felker): dedpulicate these arrays and the same named ones in HydroDiffusion
   AthenaArray<Real> dx1_, dx2_, dx3_;
 };
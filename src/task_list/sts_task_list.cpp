@@ -63,7 +63,7 @@ SuperTimeStepTaskList::SuperTimeStepTaskList(
   if (!(pmb->phydro->hdif.hydro_diffusion_defined)
       // short-circuit evaluation makes these safe (won't dereference pscalars=nullptr):
       && !(MAGNETIC_FIELDS_ENABLED && pmb->pfield->fdif.field_diffusion_defined)
-      && !(NSCALARS > 0 && pmb->pscalars->scalar_diffusion_defined)) {
+      && !(NSCALARS > 0 && pmb->pscalars->scalar_diffusion_sts)) {
     std::stringstream msg;
     msg << "### FATAL ERROR in SuperTimeStepTaskList" << std::endl
         << "Super-time-stepping requires setting parameters for "
@@ -87,8 +87,9 @@ SuperTimeStepTaskList::SuperTimeStepTaskList(
         sts_idx_subset.push_back(IEN);
       }
     }
-    if (pmb->phydro->hdif.kappa_iso > 0.0
-        || pmb->phydro->hdif.kappa_aniso > 0.0) {
+    if ((pmb->phydro->hdif.kappa_iso > 0.0
+         || pmb->phydro->hdif.kappa_aniso > 0.0)
+        && !pmb->phydro->hdif.implicit_conduction) {
       if (!std::binary_search(sts_idx_subset.begin(), sts_idx_subset.end(), IEN)) {
         sts_idx_subset.push_back(IEN);
       }
@@ -107,7 +108,7 @@ SuperTimeStepTaskList::SuperTimeStepTaskList(
     }
   }
   if (NSCALARS > 0) {
-    if (pmb->pscalars->scalar_diffusion_defined) {
+    if (pmb->pscalars->scalar_diffusion_sts) {
       do_sts_scalar = true;
     }
   }
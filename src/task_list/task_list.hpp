@@ -17,6 +17,7 @@
 
 // Athena++ headers
 #include "../athena.hpp"
+#include "../athena_arrays.hpp"
 
 // forward declarations
 class Mesh;
@@ -141,6 +142,8 @@ class TimeIntegratorTaskList : public TaskList {
   std::string integrator;
   Real cfl_limit; // dt stability limit for the particular time integrator + spatial order
   int nstages_main; // number of stages labeled main_stage
+  bool fused_update; // single-sweep register average + flux divergence + pencil srcs
+  bool fused_dt;     // block dt limits reduced inside the final W(U) sweep
 
   // functions
   TaskStatus ClearAllBoundary(MeshBlock *pmb, int stage);
@@ -214,6 +217,8 @@ class TimeIntegratorTaskList : public TaskList {
   bool SHEAR_PERIODIC; // flag for shear periodic boundary (true w/ , false w/o)
   IntegratorWeight stage_wghts[MAX_NSTAGE];
 
+  void StageWeightsFused(int stage, AthenaArray<Real> &u, AthenaArray<Real> &u1,
+                         Real &delta, Real ave_wghts[5]);
   void AddTask(const TaskID& id, const TaskID& dep) override;
   void StartupTaskList(MeshBlock *pmb, int stage) override;
 };
@@ -74,6 +74,12 @@ TimeIntegratorTaskList::TimeIntegratorTaskList(ParameterInput *pin, Mesh *pm) {
   //! \todo (felker):
   //! - validate Field and Hydro diffusion with RK3, RK4, SSPRK(5,4)
   integrator = pin->GetOrAddString("time", "integrator", "vl2");
+  fused_update = pin->GetOrAddBoolean("time", "fused_update", false);
+  // STS may recompute W(U) after the main integrator, so the new block timestep must
+  // then be evaluated in its own pass. The fused sweep is serial within a MeshBlock, so
+  // it is also skipped when the W(U) loops are split over a loop-level OpenMP team.
+  fused_dt = pin->GetOrAddBoolean("time", "fused_dt", false) && !STS_ENABLED
+             && pm->GetNumLoopThreads() == 1;
 
   // Read a flag for orbital advection
   ORBITAL_ADVECTION = (pm->orbital_advection != 0)? true : false;
@@ -907,27 +913,29 @@ TimeIntegratorTaskList::TimeIntegratorTaskList(ParameterInput *pin, Mesh *pm) {
       } else { // Hydro
         AddTask(CALC_HYDFLX,DIFFUSE_HYD);
       }
-      if (NSCALARS > 0) {
-        AddTask(DIFFUSE_SCLR,NONE);
-        AddTask(CALC_SCLRFLX,(CALC_HYDFLX|DIFFUSE_SCLR));
-      }
+      // (scalar diffusion is added in the scalar flux sweep)
+      if (NSCALARS > 0)
+        AddTask(CALC_SCLRFLX,CALC_HYDFLX);
     } else { // STS enabled:
       AddTask(CALC_HYDFLX,NONE);
       if (NSCALARS > 0)
         AddTask(CALC_SCLRFLX,CALC_HYDFLX);
     }
+    // the fused hydro update adds the pencil source terms, which may also modify the
+    // passive scalars, so the scalar registers must be updated first
+    TaskID fused_dep = (fused_update && NSCALARS > 0) ? INT_SCLR : NONE;
     if (pm->multilevel || SHEAR_PERIODIC) { // SMR or AMR or shear periodic
       AddTask(SEND_HYDFLX,CALC_HYDFLX);
       AddTask(RECV_HYDFLX,CALC_HYDFLX);
       if (SHEAR_PERIODIC) {
         AddTask(SEND_HYDFLXSH,RECV_HYDFLX);
         AddTask(RECV_HYDFLXSH,(SEND_HYDFLX|RECV_HYDFLX));
-        AddTask(INT_HYD,RECV_HYDFLXSH);
+        AddTask(INT_HYD,(RECV_HYDFLXSH|fused_dep));
       } else {
-        AddTask(INT_HYD,RECV_HYDFLX);
+        AddTask(INT_HYD,(RECV_HYDFLX|fused_dep));
       }
     } else {
-      AddTask(INT_HYD, CALC_HYDFLX);
+      AddTask(INT_HYD,(CALC_HYDFLX|fused_dep));
     }
     if (NSCALARS > 0) {
       AddTask(SRC_TERM,(INT_HYD|INT_SCLR));
@@ -1563,6 +1571,7 @@ TaskStatus TimeIntegratorTaskList::ReceiveAndCorrectEMF(MeshBlock *pmb, int stag
 TaskStatus TimeIntegratorTaskList::IntegrateHydro(MeshBlock *pmb, int stage) {
   Hydro *ph = pmb->phydro;
   Field *pf = pmb->pfield;
+  PassiveScalars *ps = pmb->pscalars;
 
   if (pmb->pmy_mesh->fluid_setup != FluidFormulation::evolve) return TaskStatus::next;
 
@@ -1570,23 +1579,32 @@ TaskStatus TimeIntegratorTaskList::IntegrateHydro(MeshBlock *pmb, int stage) {
     if (stage_wghts[stage-1].main_stage) {
       // This time-integrator-specific averaging operation logic is identical to FieldInt
       Real ave_wghts[5];
-      ave_wghts[0] = 1.0;
-      ave_wghts[1] = stage_wghts[stage-1].delta;
-      ave_wghts[2] = 0.0;
-      ave_wghts[3] = 0.0;
-      ave_wghts[4] = 0.0;
-      pmb->WeightedAve(ph->u1, ph->u, ph->u2, ph->u0, ph->fl_div, ave_wghts);
-
-      ave_wghts[0] = stage_wghts[stage-1].gamma_1;
-      ave_wghts[1] = stage_wghts[stage-1].gamma_2;
-      ave_wghts[2] = stage_wghts[stage-1].gamma_3;
-      if (ave_wghts[0] == 0.0 && ave_wghts[1] == 1.0 && ave_wghts[2] == 0.0)
-        ph->u.SwapAthenaArray(ph->u1);
-      else
-        pmb->WeightedAve(ph->u, ph->u1, ph->u2, ph->u0, ph->fl_div, ave_wghts);
-
       const Real wght = stage_wghts[stage-1].beta*pmb->pmy_mesh->dt;
-      ph->AddFluxDivergence(wght, ph->u);
+      if (fused_update) {
+        Real t_start_stage = pmb->pmy_mesh->time
+                             + stage_wghts[(stage-1)].sbeta*pmb->pmy_mesh->dt;
+        Real delta;
+        StageWeightsFused(stage, ph->u, ph->u1, delta, ave_wghts);
+        ph->AddFluxDivergenceFused(wght, delta, ave_wghts, t_start_stage,
+                                   ps->r, pf->bcc, ps->s);
+      } else {
+        ave_wghts[0] = 1.0;
+        ave_wghts[1] = stage_wghts[stage-1].delta;
+        ave_wghts[2] = 0.0;
+        ave_wghts[3] = 0.0;
+        ave_wghts[4] = 0.0;
+        pmb->WeightedAve(ph->u1, ph->u, ph->u2, ph->u0, ph->fl_div, ave_wghts);
+
+        ave_wghts[0] = stage_wghts[stage-1].gamma_1;
+        ave_wghts[1] = stage_wghts[stage-1].gamma_2;
+        ave_wghts[2] = stage_wghts[stage-1].gamma_3;
+        if (ave_wghts[0] == 0.0 && ave_wghts[1] == 1.0 && ave_wghts[2] == 0.0)
+          ph->u.SwapAthenaArray(ph->u1);
+        else
+          pmb->WeightedAve(ph->u, ph->u1, ph->u2, ph->u0, ph->fl_div, ave_wghts);
+
+        ph->AddFluxDivergence(wght, ph->u);
+      }
       // add coordinate (geometric) source terms
       pmb->pcoord->AddCoordTermsDivergence(wght, ph->flux, ph->w, pf->bcc, ph->u);
 
@@ -1611,6 +1629,34 @@ TaskStatus TimeIntegratorTaskList::IntegrateHydro(MeshBlock *pmb, int stage) {
   return TaskStatus::fail;
 }
 
+//----------------------------------------------------------------------------------------
+//! \fn void TimeIntegratorTaskList::StageWeightsFused
+//! \brief Sets the register weights of the fused stage update (ave_wghts[3], [4] are
+//! zeroed so the array can be reused with MeshBlock::WeightedAve()).
+//!
+//! The fused update performs u1 += delta*u and then u = a*u + b*u1 + c*u2 per pencil.
+//! When the second average reduces to u = u1, the unfused update swaps the registers
+//! instead of copying; here the swap is done up front, so that u already holds the old
+//! u1 and the first average becomes u += delta*u1 (u1 then holds the old u, as before).
+
+void TimeIntegratorTaskList::StageWeightsFused(int stage, AthenaArray<Real> &u,
+                                               AthenaArray<Real> &u1, Real &delta,
+                                               Real ave_wghts[5]) {
+  delta = stage_wghts[stage-1].delta;
+  ave_wghts[0] = stage_wghts[stage-1].gamma_1;
+  ave_wghts[1] = stage_wghts[stage-1].gamma_2;
+  ave_wghts[2] = stage_wghts[stage-1].gamma_3;
+  ave_wghts[3] = 0.0;
+  ave_wghts[4] = 0.0;
+  if (ave_wghts[0] == 0.0 && ave_wghts[1] == 1.0 && ave_wghts[2] == 0.0) {
+    u.SwapAthenaArray(u1);
+    ave_wghts[0] = 1.0;
+    ave_wghts[1] = delta;
+    delta = 0.0;
+  }
+  return;
+}
+
 //----------------------------------------------------------------------------------------
 // Functions to integrate Field variables
 
@@ -1983,9 +2029,27 @@ TaskStatus TimeIntegratorTaskList::Primitives(MeshBlock *pmb, int stage) {
     // Newton-Raphson solver in GR EOS uses the following abscissae:
     // stage=1: W at t^n and
     // stage=2: W at t^{n+1/2} (VL2) or t^{n+1} (RK2)
-    pmb->peos->ConservedToPrimitive(ph->u, ph->w, pf->b,
-                                    ph->w1, pf->bcc, pmb->pcoord,
-                                    il, iu, jl, ju, kl, ku);
+    // Only the energy removed by the ceilings in the final W(U) changes the solution
+    pmb->peos->SetCeilingAccounting(stage == nstages);
+    if (fused_dt && stage == nstages && pmb->precon->xorder != 4) {
+      // Final W(U) of the cycle: reduce the timestep limits of each active pencil
+      // while it is still in cache, instead of in a separate pass in NewBlockTimeStep
+      ph->BeginFusedBlockTimeStep();
+      for (int k=kl; k<=ku; ++k) {
+        for (int j=jl; j<=ju; ++j) {
+          pmb->peos->ConservedToPrimitive(ph->u, ph->w, pf->b,
+                                          ph->w1, pf->bcc, pmb->pcoord,
+                                          il, iu, j, j, k, k);
+          if (k >= pmb->ks && k <= pmb->ke && j >= pmb->js && j <= pmb->je)
+            ph->NewBlockTimeStepPencil(k, j, ph->w1);
+        }
+      }
+    } else {
+      pmb->peos->ConservedToPrimitive(ph->u, ph->w, pf->b,
+                                      ph->w1, pf->bcc, pmb->pcoord,
+                                      il, iu, jl, ju, kl, ku);
+    }
+    pmb->peos->SetCeilingAccounting(true);
     if (pmb->porb->orbital_advection_defined) {
       pmb->porb->ResetOrbitalSystemConversionFlag();
     }
@@ -2138,23 +2202,29 @@ TaskStatus TimeIntegratorTaskList::IntegrateScalars(MeshBlock *pmb, int stage) {
       // This time-integrator-specific averaging operation logic is identical to
       // IntegrateHydro, IntegrateField
       Real ave_wghts[5];
-      ave_wghts[0] = 1.0;
-      ave_wghts[1] = stage_wghts[stage-1].delta;
-      ave_wghts[2] = 0.0;
-      ave_wghts[3] = 0.0;
-      ave_wghts[4] = 0.0;
-      pmb->WeightedAve(ps->s1, ps->s, ps->s2, ps->s0, ps->s_fl_div, ave_wghts);
-
-      ave_wghts[0] = stage_wghts[stage-1].gamma_1;
-      ave_wghts[1] = stage_wghts[stage-1].gamma_2;
-      ave_wghts[2] = stage_wghts[stage-1].gamma_3;
-      if (ave_wghts[0] == 0.0 && ave_wghts[1] == 1.0 && ave_wghts[2] == 0.0)
-        ps->s.SwapAthenaArray(ps->s1);
-      else
-        pmb->WeightedAve(ps->s, ps->s1, ps->s2, ps->s0, ps->s_fl_div, ave_wghts);
-
       const Real wght = stage_wghts[stage-1].beta*pmb->pmy_mesh->dt;
-      ps->AddFluxDivergence(wght, ps->s);
+      if (fused_update) {
+        Real delta;
+        StageWeightsFused(stage, ps->s, ps->s1, delta, ave_wghts);
+        ps->AddFluxDivergenceFused(wght, delta, ave_wghts);
+      } else {
+        ave_wghts[0] = 1.0;
+        ave_wghts[1] = stage_wghts[stage-1].delta;
+        ave_wghts[2] = 0.0;
+        ave_wghts[3] = 0.0;
+        ave_wghts[4] = 0.0;
+        pmb->WeightedAve(ps->s1, ps->s, ps->s2, ps->s0, ps->s_fl_div, ave_wghts);
+
+        ave_wghts[0] = stage_wghts[stage-1].gamma_1;
+        ave_wghts[1] = stage_wghts[stage-1].gamma_2;
+        ave_wghts[2] = stage_wghts[stage-1].gamma_3;
+        if (ave_wghts[0] == 0.0 && ave_wghts[1] == 1.0 && ave_wghts[2] == 0.0)
+          ps->s.SwapAthenaArray(ps->s1);
+        else
+          pmb->WeightedAve(ps->s, ps->s1, ps->s2, ps->s0, ps->s_fl_div, ave_wghts);
+
+        ps->AddFluxDivergence(wght, ps->s);
+      }
 
       // Hardcode an additional flux divergence weighted average for the penultimate
       // stage of SSPRK(5,4) since it cannot be expressed in a 3S* framework
@@ -2219,8 +2289,9 @@ TaskStatus TimeIntegratorTaskList::SetBoundariesScalars(MeshBlock *pmb, int stag
 TaskStatus TimeIntegratorTaskList::DiffuseScalars(MeshBlock *pmb, int stage) {
   PassiveScalars *ps = pmb->pscalars;
   Hydro *ph = pmb->phydro;
-  // return if there are no diffusion to be added
-  if (!(ps->scalar_diffusion_defined))
+  // return if there are no diffusion to be added (only the STS-integrated scalars are
+  // stored here, the others are added by PassiveScalars::CalculateFluxes)
+  if (!(ps->scalar_diffusion_sts))
     return TaskStatus::next;
 
   if (stage <= nstages) {
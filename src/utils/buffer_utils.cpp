@@ -9,6 +9,7 @@
 // C headers
 
 // C++ headers
+#include <cstring>    // memcpy()
 
 // Athena++ headers
 #include "../athena.hpp"
@@ -16,13 +17,43 @@
 #include "buffer_utils.hpp"
 
 namespace BufferUtility {
+namespace {
+// buffers with fewer elements are packed by a single thread: below this size the cost of
+// starting the loop-level team exceeds the copy itself
+constexpr int kMinThreadedSize = 32768;
+
+bool UseLoopThreads(const int nthreads, int sn, int en, int si, int ei, int sj, int ej,
+                    int sk, int ek) {
+  return nthreads > 1 && (en-sn+1)*(ek-sk+1)*(ej-sj+1)*(ei-si+1) >= kMinThreadedSize;
+}
+} // namespace
+
 //----------------------------------------------------------------------------------------
 //! \fn template <typename T> void PackData(const AthenaArray<T> &src, T *buf,
-//!     int sn, int en, int si, int ei, int sj, int ej, int sk, int ek, int &offset)
-//! \brief pack a 4D AthenaArray into a one-dimensional buffer
+//!     int sn, int en, int si, int ei, int sj, int ej, int sk, int ek, int &offset,
+//!     const int nthreads)
+//! \brief pack a 4D AthenaArray into a one-dimensional buffer. Large buffers are split
+//!        into (n,k) planes, which start at known offsets, over nthreads threads.
 
 template <typename T> void PackData(const AthenaArray<T> &src, T *buf,
-         int sn, int en, int si, int ei, int sj, int ej, int sk, int ek, int &offset) {
+         int sn, int en, int si, int ei, int sj, int ej, int sk, int ek, int &offset,
+         const int nthreads) {
+  if (UseLoopThreads(nthreads, sn, en, si, ei, sj, ej, sk, ek)) {
+    const int nk = ek - sk + 1, nji = (ej - sj + 1)*(ei - si + 1);
+#pragma omp parallel for collapse(2) num_threads(nthreads) schedule(static)
+    for (int n=sn; n<=en; ++n) {
+      for (int k=sk; k<=ek; k++) {
+        int p = offset + ((n - sn)*nk + k - sk)*nji;
+        for (int j=sj; j<=ej; j++) {
+#pragma omp simd linear(p)
+          for (int i=si; i<=ei; i++)
+            buf[p++] = src(n,k,j,i);
+        }
+      }
+    }
+    offset += (en - sn + 1)*nk*nji;
+    return;
+  }
   for (int n=sn; n<=en; ++n) {
     for (int k=sk; k<=ek; k++) {
       for (int j=sj; j<=ej; j++) {
@@ -54,11 +85,29 @@ template <typename T> void PackData(const AthenaArray<T> &src, T *buf,
 
 //----------------------------------------------------------------------------------------
 //! \fn template <typename T> void UnpackData(const T *buf, AthenaArray<T> &dst,
-//!     int sn, int en, int si, int ei, int sj, int ej, int sk, int ek, int &offset)
+//!     int sn, int en, int si, int ei, int sj, int ej, int sk, int ek, int &offset,
+//!     const int nthreads)
 //! \brief unpack a one-dimensional buffer into a 4D AthenaArray
 
 template <typename T> void UnpackData(const T *buf, AthenaArray<T> &dst,
-         int sn, int en, int si, int ei, int sj, int ej, int sk, int ek, int &offset) {
+         int sn, int en, int si, int ei, int sj, int ej, int sk, int ek, int &offset,
+         const int nthreads) {
+  if (UseLoopThreads(nthreads, sn, en, si, ei, sj, ej, sk, ek)) {
+    const int nk = ek - sk + 1, nji = (ej - sj + 1)*(ei - si + 1);
+#pragma omp parallel for collapse(2) num_threads(nthreads) schedule(static)
+    for (int n=sn; n<=en; ++n) {
+      for (int k=sk; k<=ek; ++k) {
+        int p = offset + ((n - sn)*nk + k - sk)*nji;
+        for (int j=sj; j<=ej; ++j) {
+#pragma omp simd linear(p)
+          for (int i=si; i<=ei; ++i)
+            dst(n,k,j,i) = buf[p++];
+        }
+      }
+    }
+    offset += (en - sn + 1)*nk*nji;
+    return;
+  }
   for (int n=sn; n<=en; ++n) {
     for (int k=sk; k<=ek; ++k) {
       for (int j=sj; j<=ej; ++j) {
@@ -88,19 +137,207 @@ template <typename T> void UnpackData(const T *buf, AthenaArray<T> &dst,
   return;
 }
 
+//----------------------------------------------------------------------------------------
+//! \fn template <typename T, typename B> void PackDataConverted(
+//!     const AthenaArray<T> &src, B *buf, int sn, int en, int si, int ei, int sj, int ej,
+//!     int sk, int ek, int &offset, const int nthreads)
+//! \brief pack a 4D AthenaArray into a one-dimensional buffer of element type B
+
+template <typename T, typename B> void PackDataConverted(const AthenaArray<T> &src,
+    B *buf, int sn, int en, int si, int ei, int sj, int ej, int sk, int ek, int &offset,
+    const int nthreads) {
+  if (UseLoopThreads(nthreads, sn, en, si, ei, sj, ej, sk, ek)) {
+    const int nk = ek - sk + 1, nji = (ej - sj + 1)*(ei - si + 1);
+#pragma omp parallel for collapse(2) num_threads(nthreads) schedule(static)
+    for (int n=sn; n<=en; ++n) {
+      for (int k=sk; k<=ek; k++) {
+        int p = offset + ((n - sn)*nk + k - sk)*nji;
+        for (int j=sj; j<=ej; j++) {
+#pragma omp simd linear(p)
+          for (int i=si; i<=ei; i++)
+            buf[p++] = static_cast<B>(src(n,k,j,i));
+        }
+      }
+    }
+    offset += (en - sn + 1)*nk*nji;
+    return;
+  }
+  for (int n=sn; n<=en; ++n) {
+    for (int k=sk; k<=ek; k++) {
+      for (int j=sj; j<=ej; j++) {
+#pragma omp simd
+        for (int i=si; i<=ei; i++)
+          buf[offset++] = static_cast<B>(src(n,k,j,i));
+      }
+    }
+  }
+  return;
+}
+
+//----------------------------------------------------------------------------------------
+//! \fn template <typename T, typename B> void UnpackDataConverted(const B *buf,
+//!     AthenaArray<T> &dst, int sn, int en, int si, int ei, int sj, int ej, int sk,
+//!     int ek, int &offset, const int nthreads)
+//! \brief unpack a one-dimensional buffer of element type B into a 4D AthenaArray
+
+template <typename T, typename B> void UnpackDataConverted(const B *buf,
+    AthenaArray<T> &dst, int sn, int en, int si, int ei, int sj, int ej, int sk, int ek,
+    int &offset, const int nthreads) {
+  if (UseLoopThreads(nthreads, sn, en, si, ei, sj, ej, sk, ek)) {
+    const int nk = ek - sk + 1, nji = (ej - sj + 1)*(ei - si + 1);
+#pragma omp parallel for collapse(2) num_threads(nthreads) schedule(static)
+    for (int n=sn; n<=en; ++n) {
+      for (int k=sk; k<=ek; ++k) {
+        int p = offset + ((n - sn)*nk + k - sk)*nji;
+        for (int j=sj; j<=ej; ++j) {
+#pragma omp simd linear(p)
+          for (int i=si; i<=ei; ++i)
+            dst(n,k,j,i) = static_cast<T>(buf[p++]);
+        }
+      }
+    }
+    offset += (en - sn + 1)*nk*nji;
+    return;
+  }
+  for (int n=sn; n<=en; ++n) {
+    for (int k=sk; k<=ek; ++k) {
+      for (int j=sj; j<=ej; ++j) {
+#pragma omp simd
+        for (int i=si; i<=ei; ++i)
+          dst(n,k,j,i) = static_cast<T>(buf[offset++]);
+      }
+    }
+  }
+  return;
+}
+
+//----------------------------------------------------------------------------------------
+//! \fn void BuildCopyPlan(CopyPlan &plan, int nx3, int nx2, int nx1,
+//!                        int si, int ei, int sj, int ej, int sk, int ek)
+//! \brief describe the box [sk:ek][sj:ej][si:ei] of a (nx3,nx2,nx1) array as runs
+
+void BuildCopyPlan(CopyPlan &plan, int nx3, int nx2, int nx1,
+                   int si, int ei, int sj, int ej, int sk, int ek) {
+  plan.nx1 = nx1, plan.nx2 = nx2, plan.nx3 = nx3;
+  plan.first = (sk*nx2 + sj)*nx1 + si;
+  plan.len = ei - si + 1;
+  plan.nrun_j = ej - sj + 1, plan.nrun_k = ek - sk + 1;
+  plan.stride_j = nx1, plan.stride_k = nx1*nx2;
+  // full rows are adjacent in memory: fold j (and then k) into the run length
+  if (plan.len == nx1) {
+    plan.len *= plan.nrun_j;
+    plan.nrun_j = 1;
+    if (plan.len == nx1*nx2) {
+      plan.len *= plan.nrun_k;
+      plan.nrun_k = 1;
+    }
+  }
+  return;
+}
+
+//----------------------------------------------------------------------------------------
+//! \fn template <typename T> void PackData(const AthenaArray<T> &src, T *buf,
+//!     int sn, int en, const CopyPlan &plan, int &offset, const int nthreads)
+//! \brief pack the runs of a CopyPlan of a 4D AthenaArray into a one-dimensional buffer
+
+template <typename T> void PackData(const AthenaArray<T> &src, T *buf, int sn, int en,
+                                    const CopyPlan &plan, int &offset,
+                                    const int nthreads) {
+  const int nrun = plan.nrun_j*plan.nrun_k, len = plan.len;
+  const int nslab = plan.nx1*plan.nx2*plan.nx3;
+  const T *psrc = src.data() + plan.first;
+  T *pbuf = buf + offset;
+  const int nt = ((en - sn + 1)*nrun*len >= kMinThreadedSize) ? nthreads : 1;
+#pragma omp parallel for collapse(2) num_threads(nt) schedule(static) if (nt > 1)
+  for (int n=sn; n<=en; ++n) {
+    for (int r=0; r<nrun; ++r) {
+      const int rk = r/plan.nrun_j, rj = r - rk*plan.nrun_j;
+      std::memcpy(pbuf + ((n - sn)*nrun + r)*len,
+                  psrc + n*nslab + rk*plan.stride_k + rj*plan.stride_j, len*sizeof(T));
+    }
+  }
+  offset += (en - sn + 1)*nrun*len;
+  return;
+}
+
+//----------------------------------------------------------------------------------------
+//! \fn template <typename T> void UnpackData(const T *buf, AthenaArray<T> &dst,
+//!     int sn, int en, const CopyPlan &plan, int &offset, const int nthreads)
+//! \brief unpack a one-dimensional buffer into the runs of a CopyPlan of a 4D array
+
+template <typename T> void UnpackData(const T *buf, AthenaArray<T> &dst, int sn, int en,
+                                      const CopyPlan &plan, int &offset,
+                                      const int nthreads) {
+  const int nrun = plan.nrun_j*plan.nrun_k, len = plan.len;
+  const int nslab = plan.nx1*plan.nx2*plan.nx3;
+  T *pdst = dst.data() + plan.first;
+  const T *pbuf = buf + offset;
+  const int nt = ((en - sn + 1)*nrun*len >= kMinThreadedSize) ? nthreads : 1;
+#pragma omp parallel for collapse(2) num_threads(nt) schedule(static) if (nt > 1)
+  for (int n=sn; n<=en; ++n) {
+    for (int r=0; r<nrun; ++r) {
+      const int rk = r/plan.nrun_j, rj = r - rk*plan.nrun_j;
+      std::memcpy(pdst + n*nslab + rk*plan.stride_k + rj*plan.stride_j,
+                  pbuf + ((n - sn)*nrun + r)*len, len*sizeof(T));
+    }
+  }
+  offset += (en - sn + 1)*nrun*len;
+  return;
+}
+
+//----------------------------------------------------------------------------------------
+//! \fn template <typename T> void CopyData(const AthenaArray<T> &src,
+//!     const CopyPlan &src_plan, AthenaArray<T> &dst, const CopyPlan &dst_plan,
+//!     int sn, int en)
+//! \brief copy the runs of src_plan into the runs of dst_plan; both plans must describe
+//!        boxes of the same extent in arrays of the same shape
+
+template <typename T> void CopyData(const AthenaArray<T> &src, const CopyPlan &src_plan,
+                                    AthenaArray<T> &dst, const CopyPlan &dst_plan,
+                                    int sn, int en) {
+  const int nrun = src_plan.nrun_j*src_plan.nrun_k, len = src_plan.len;
+  const int nslab = src_plan.nx1*src_plan.nx2*src_plan.nx3;
+  const T *psrc = src.data() + src_plan.first;
+  T *pdst = dst.data() + dst_plan.first;
+  for (int n=sn; n<=en; ++n) {
+    for (int r=0; r<nrun; ++r) {
+      const int rk = r/src_plan.nrun_j, rj = r - rk*src_plan.nrun_j;
+      const int q = n*nslab + rk*src_plan.stride_k + rj*src_plan.stride_j;
+      std::memcpy(pdst + q, psrc + q, len*sizeof(T));
+    }
+  }
+  return;
+}
+
 // provide explicit instantiation definitions (C++03) to allow the template definitions to
 // exist outside of header file (non-inline), but still provide the requisite instances
 // for other TUs during linking time (~13x files include "buffer_utils.hpp")
 
 // 13x files include buffer_utils.hpp
 template void UnpackData<Real>(const Real *, AthenaArray<Real> &,
-                               int, int, int, int, int, int, int, int, int &);
+                               int, int, int, int, int, int, int, int, int &,
+                               const int);
 template void UnpackData<Real>(const Real *, AthenaArray<Real> &,
                                int, int, int, int, int, int, int &);
 
 template void PackData<Real>(const AthenaArray<Real> &, Real *,
-                             int, int, int, int, int, int, int, int, int &);
+                             int, int, int, int, int, int, int, int, int &, const int);
 template void PackData<Real>(const AthenaArray<Real> &, Real *,
                              int, int, int, int, int, int, int &);
 
+template void PackData<Real>(const AthenaArray<Real> &, Real *, int, int,
+                             const CopyPlan &, int &, const int);
+template void UnpackData<Real>(const Real *, AthenaArray<Real> &, int, int,
+                               const CopyPlan &, int &, const int);
+template void CopyData<Real>(const AthenaArray<Real> &, const CopyPlan &,
+                             AthenaArray<Real> &, const CopyPlan &, int, int);
+
+// single-precision ghost-zone buffers (CellCenteredBoundaryVariable::float_buffers)
+template void PackDataConverted<Real, float>(const AthenaArray<Real> &, float *,
+                                             int, int, int, int, int, int, int, int,
+                                             int &, const int);
+template void UnpackDataConverted<Real, float>(const float *, AthenaArray<Real> &,
+                                               int, int, int, int, int, int, int, int,
+                                               int &, const int);
+
 } // end namespace BufferUtility
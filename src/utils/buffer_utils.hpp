@@ -17,18 +17,61 @@
 #include "../athena_arrays.hpp"
 
 namespace BufferUtility {
+//! \struct CopyPlan
+//! \brief a (k,j,i) box of a cell-centered AthenaArray described as contiguous runs:
+//!        run (rk,rj) of an n-slab starts at first + rk*stride_k + rj*stride_j and holds
+//!        len elements. Runs are merged across j (and k) when the box spans full rows.
+//!        A plan depends only on the box and the (nx3,nx2,nx1) shape, so one plan per
+//!        neighbor serves every variable whose arrays share that shape.
+
+struct CopyPlan {
+  int nx1 = 0, nx2 = 0, nx3 = 0;  // array shape the plan was built for (0 = not built)
+  int first = 0, len = 0;
+  int nrun_j = 0, nrun_k = 0;
+  int stride_j = 0, stride_k = 0;
+
+  int Size() const { return len*nrun_j*nrun_k; }
+  template <typename T> bool Matches(const AthenaArray<T> &a) const {
+    return nx1 > 0 && a.GetDim1() == nx1 && a.GetDim2() == nx2 && a.GetDim3() == nx3;
+  }
+};
+
+void BuildCopyPlan(CopyPlan &plan, int nx3, int nx2, int nx1,
+                   int si, int ei, int sj, int ej, int sk, int ek);
+
 // 2x templated and overloaded functions
+// the 4D versions split large buffers over nthreads loop-level OpenMP threads
 // 4D
 template <typename T> void PackData(const AthenaArray<T> &src, T *buf,
-         int sn, int en, int si, int ei, int sj, int ej, int sk, int ek, int &offset);
+         int sn, int en, int si, int ei, int sj, int ej, int sk, int ek, int &offset,
+         const int nthreads=1);
 // 3D
 template <typename T> void PackData(const AthenaArray<T> &src, T *buf,
                            int si, int ei, int sj, int ej, int sk, int ek, int &offset);
 // 4D
 template <typename T> void UnpackData(const T *buf, AthenaArray<T> &dst,
-         int sn, int en, int si, int ei, int sj, int ej, int sk, int ek, int &offset);
+         int sn, int en, int si, int ei, int sj, int ej, int sk, int ek, int &offset,
+         const int nthreads=1);
 // 3D
 template <typename T> void UnpackData(const T *buf, AthenaArray<T> &dst,
                       int si, int ei, int sj, int ej, int sk, int ek, int &offset);
+// 4D, copying the runs of a CopyPlan with memcpy
+template <typename T> void PackData(const AthenaArray<T> &src, T *buf, int sn, int en,
+                                    const CopyPlan &plan, int &offset,
+                                    const int nthreads=1);
+template <typename T> void UnpackData(const T *buf, AthenaArray<T> &dst, int sn, int en,
+                                      const CopyPlan &plan, int &offset,
+                                      const int nthreads=1);
+// 4D, array to array between two plans with the same run structure
+template <typename T> void CopyData(const AthenaArray<T> &src, const CopyPlan &src_plan,
+                                    AthenaArray<T> &dst, const CopyPlan &dst_plan,
+                                    int sn, int en);
+// 4D, converting to/from a (lower-precision) buffer element type B
+template <typename T, typename B> void PackDataConverted(const AthenaArray<T> &src,
+    B *buf, int sn, int en, int si, int ei, int sj, int ej, int sk, int ek, int &offset,
+    const int nthreads=1);
+template <typename T, typename B> void UnpackDataConverted(const B *buf,
+    AthenaArray<T> &dst, int sn, int en, int si, int ei, int sj, int ej, int sk, int ek,
+    int &offset, const int nthreads=1);
 } // namespace BufferUtility
 #endif // UTILS_BUFFER_UTILS_HPP_
@@ -0,0 +1,266 @@
+//========================================================================================
+// Athena++ astrophysical MHD code
+// Copyright(C) 2014 James M. Stone <jmstone@princeton.edu> and other code contributors
+// Licensed under the 3-clause BSD License, see LICENSE file for details
+//========================================================================================
+//! \file inversion_table.cpp
+//! \brief implements class InversionTable
+//!
+//! The table starts from nbase intervals per axis and refines the intervals of each axis
+//! by halving them, up to max_level times. In every pass the result of the Newton step
+//! from the interpolated T is checked against the exact inversion at the midpoints of the
+//! edges and in the interior of each cell that is not known to be accurate yet; the
+//! intervals of the axes along which the error exceeds the tolerance are split. Cells
+//! whose intervals are not split keep their verdict, and nodes that already exist keep
+//! their values, so that the exact inversion is done only once per node.
+
+// C headers
+
+// C++ headers
+#include <algorithm>  // max(), min()
+#include <cmath>      // abs(), exp(), isnan(), log()
+#include <initializer_list>
+#include <limits>     // numeric_limits
+#include <vector>
+
+// Athena++ headers
+#include "../athena.hpp"
+#include "inversion_table.hpp"
+
+//----------------------------------------------------------------------------------------
+//! \fn void InversionTable::Build(EosFunction q_of_T, InverseFunction T_of_q,
+//!          const std::vector<EosFunction> &checks, Real rho_min, Real rho_max,
+//!          Real T_min, Real T_max, int nbase, int max_level, Real tol, int nthreads)
+//! \brief build the table for rho_min <= rho < rho_max and the range of q/rho spanned by
+//!        T_min <= T <= T_max. T_of_q must invert q_of_T everywhere in this box. The
+//!        relative error of the functions in checks evaluated with the interpolated T is
+//!        kept below tol; cells that do not reach it at the finest level are left to
+//!        the caller. The exact inversions are done by nthreads OpenMP threads, so
+//!        T_of_q must be thread safe.
+
+void InversionTable::Build(EosFunction q_of_T, InverseFunction T_of_q,
+                           const std::vector<EosFunction> &checks, Real rho_min,
+                           Real rho_max, Real T_min, Real T_max, int nbase,
+                           int max_level, Real tol, int nthreads) {
+  q_of_T_ = q_of_T;
+  T_of_q_ = T_of_q;
+  nthreads_ = nthreads;
+  checks_ = checks;
+  tol_ = tol;
+
+  ax1_.Init(std::log(rho_min), std::log(rho_max), nbase, max_level);
+  ax1_.Finalize();
+  Real smin = std::numeric_limits<Real>::max();
+  Real smax = std::numeric_limits<Real>::lowest();
+  for (int i=0; i<ax1_.nnode(); ++i) {
+    Real rho = std::exp(ax1_.x[i]);
+    smin = std::min(smin, std::log(q_of_T(rho, T_min)/rho));
+    smax = std::max(smax, std::log(q_of_T(rho, T_max)/rho));
+  }
+  ax2_.Init(smin, smax, nbase, max_level);
+  ax2_.Finalize();
+
+  const int n1 = ax1_.nnode(), n2 = ax2_.nnode();
+  lnt_.resize(n1*n2);
+  std::vector<int> nodes(n1*n2);
+  for (int n=0; n<n1*n2; ++n)
+    nodes[n] = n;
+  SolveNodes(nodes);
+  ok_.assign((n1 - 1)*(n2 - 1), false);
+  bad_.assign((n1 - 1)*(n2 - 1), 0);
+  while (Refine()) {}
+  ok_.clear();
+  return;
+}
+
+//----------------------------------------------------------------------------------------
+//! \fn Real InversionTable::Error(Real lr, Real ls, Real lnt) const
+//! \brief largest relative error of T and of the check functions at rho = exp(lr),
+//!        q = rho*exp(ls) when T is polished from the approximation lnt of ln(T rho/q)
+
+Real InversionTable::Error(Real lr, Real ls, Real lnt) const {
+  Real rho = std::exp(lr), s = std::exp(ls);
+  Real T = Polish(rho, rho*s, std::exp(lnt)*s);
+  Real T_exact = T_of_q_(rho, rho*s);
+  Real err = std::abs(T/T_exact - 1.0);
+  for (EosFunction f : checks_) {
+    Real e = std::abs(f(rho, T)/f(rho, T_exact) - 1.0);
+    if (!(e <= err)) err = e;
+  }
+  // a NaN, e.g. from a negative T, is no match either
+  return std::isnan(err) ? std::numeric_limits<Real>::max() : err;
+}
+
+//----------------------------------------------------------------------------------------
+//! \fn Real InversionTable::CellError(int i, int j, Real w1, Real w2) const
+//! \brief error at the point with weights (w1, w2) of cell (i, j)
+
+Real InversionTable::CellError(int i, int j, Real w1, Real w2) const {
+  const int n1 = ax1_.nnode();
+  const Real *p = &lnt_[j*n1 + i];
+  const Real *q = p + n1;
+  Real lnt = (1.0 - w2)*((1.0 - w1)*p[0] + w1*p[1]) + w2*((1.0 - w1)*q[0] + w1*q[1]);
+  return Error(ax1_.x[i] + w1*(ax1_.x[i+1] - ax1_.x[i]),
+               ax2_.x[j] + w2*(ax2_.x[j+1] - ax2_.x[j]), lnt);
+}
+
+//----------------------------------------------------------------------------------------
+//! \fn bool InversionTable::Refine()
+//! \brief check the cells and split the intervals where the error is too large; returns
+//!        false when no interval was split
+
+bool InversionTable::Refine() {
+  const int n1 = ax1_.nnode(), n2 = ax2_.nnode();
+
+  // errors along x1 (edge midpoints), along x2, and in the interior of the unchecked
+  // cells; the upper and right edges are shared with the next cell, except at the
+  // boundary. Four interior points besides the center catch most of the features that
+  // cross a cell without touching its midpoints.
+  std::vector<int> cells;
+  for (int c=0; c<(n1 - 1)*(n2 - 1); ++c)
+    if (!ok_[c]) cells.push_back(c);
+  const int ncell = static_cast<int>(cells.size());
+  std::vector<Real> err(3*ncell);
+#pragma omp parallel for num_threads(nthreads_) schedule(dynamic, 64)
+  for (int n=0; n<ncell; ++n) {
+    int i = cells[n] % (n1 - 1), j = cells[n] / (n1 - 1);
+    Real e1 = CellError(i, j, 0.5, 0.0);
+    if (j == n2 - 2) e1 = std::max(e1, CellError(i, j, 0.5, 1.0));
+    Real e2 = CellError(i, j, 0.0, 0.5);
+    if (i == n1 - 2) e2 = std::max(e2, CellError(i, j, 1.0, 0.5));
+    Real ec = CellError(i, j, 0.5, 0.5);
+    for (Real w1 : {0.25, 0.75}) {
+      ec = std::max(ec, CellError(i, j, w1, 0.25));
+      ec = std::max(ec, CellError(i, j, w1, 0.75));
+    }
+    err[3*n] = e1;
+    err[3*n+1] = e2;
+    err[3*n+2] = ec;
+  }
+
+  std::vector<bool> split1(n1 - 1, false), split2(n2 - 1, false);
+  bool refine = false;
+  for (int n=0; n<ncell; ++n) {
+    int i = cells[n] % (n1 - 1), j = cells[n] / (n1 - 1);
+    Real e1 = err[3*n], e2 = err[3*n+1], ec = err[3*n+2];
+    bool can1 = (ax1_.node[i+1] - ax1_.node[i] > 1);
+    bool can2 = (ax2_.node[j+1] - ax2_.node[j] > 1);
+    // an error only in the interior is due to the cross term, which both axes resolve
+    bool cross = (ec > tol_ && e1 <= tol_ && e2 <= tol_);
+    bool s1 = can1 && (e1 > tol_ || cross);
+    bool s2 = can2 && (e2 > tol_ || cross);
+    if (s1) split1[i] = true;
+    if (s2) split2[j] = true;
+    if (s1 || s2) {
+      refine = true;
+    } else {
+      // within the tolerance, or at the finest level, where Lookup() falls back
+      ok_[cells[n]] = true;
+      if (std::max(std::max(e1, e2), ec) > tol_) bad_[cells[n]] = 1;
+    }
+  }
+  if (!refine) return false;
+
+  // old node index of each point of the finest grids
+  std::vector<int> old1(ax1_.nfine + 1, -1), old2(ax2_.nfine + 1, -1);
+  for (int i=0; i<n1; ++i) old1[ax1_.node[i]] = i;
+  for (int j=0; j<n2; ++j) old2[ax2_.node[j]] = j;
+  std::vector<Real> old_lnt(lnt_);
+  std::vector<bool> old_ok(ok_);
+  std::vector<unsigned char> old_bad(bad_);
+  ax1_.Split(split1);
+  ax2_.Split(split2);
+  ax1_.Finalize();
+  ax2_.Finalize();
+
+  const int m1 = ax1_.nnode(), m2 = ax2_.nnode();
+  lnt_.resize(m1*m2);
+  ok_.assign((m1 - 1)*(m2 - 1), false);
+  bad_.assign((m1 - 1)*(m2 - 1), 0);
+  std::vector<int> nodes;  // new nodes
+  for (int j=0; j<m2; ++j) {
+    int oj = old2[ax2_.node[j]];
+    for (int i=0; i<m1; ++i) {
+      int oi = old1[ax1_.node[i]];
+      if (oi >= 0 && oj >= 0) {
+        lnt_[j*m1 + i] = old_lnt[oj*n1 + oi];
+      } else {
+        nodes.push_back(j*m1 + i);
+      }
+      // a cell keeps its verdict if neither of its intervals was split
+      if (i < m1 - 1 && j < m2 - 1 && oi >= 0 && oj >= 0
+          && old1[ax1_.node[i+1]] == oi + 1 && old2[ax2_.node[j+1]] == oj + 1) {
+        ok_[j*(m1 - 1) + i] = old_ok[oj*(n1 - 1) + oi];
+        bad_[j*(m1 - 1) + i] = old_bad[oj*(n1 - 1) + oi];
+      }
+    }
+  }
+  SolveNodes(nodes);
+  return true;
+}
+
+//----------------------------------------------------------------------------------------
+//! \fn void InversionTable::SolveNodes(const std::vector<int> &nodes)
+//! \brief exact inversion at the given nodes
+
+void InversionTable::SolveNodes(const std::vector<int> &nodes) {
+  const int n1 = ax1_.nnode();
+  const int nnodes = static_cast<int>(nodes.size());
+#pragma omp parallel for num_threads(nthreads_) schedule(dynamic, 64)
+  for (int n=0; n<nnodes; ++n) {
+    int i = nodes[n] % n1, j = nodes[n] / n1;
+    Real rho = std::exp(ax1_.x[i]), s = std::exp(ax2_.x[j]);
+    lnt_[nodes[n]] = std::log(T_of_q_(rho, rho*s)/s);
+  }
+  return;
+}
+
+//----------------------------------------------------------------------------------------
+//! \fn void InversionTable::Axis::Init(Real x0, Real x1, int nbase, int max_level)
+//! \brief nbase equal intervals on [x0, x1], each of which can be halved max_level times
+
+void InversionTable::Axis::Init(Real x0, Real x1, int nbase, int max_level) {
+  nfine = nbase << max_level;
+  xmin = x0;
+  dx = (x1 - x0)/nfine;
+  inv_dx = 1.0/dx;
+  node.resize(nbase + 1);
+  for (int n=0; n<=nbase; ++n)
+    node[n] = n << max_level;
+  return;
+}
+
+//----------------------------------------------------------------------------------------
+//! \fn void InversionTable::Axis::Split(const std::vector<bool> &split)
+//! \brief halve the intervals flagged in split
+
+void InversionTable::Axis::Split(const std::vector<bool> &split) {
+  std::vector<int> old(node);
+  node.clear();
+  for (int n=0; n<static_cast<int>(old.size()) - 1; ++n) {
+    node.push_back(old[n]);
+    if (split[n]) node.push_back((old[n] + old[n+1])/2);
+  }
+  node.push_back(old.back());
+  return;
+}
+
+//----------------------------------------------------------------------------------------
+//! \fn void InversionTable::Axis::Finalize()
+//! \brief compute the coordinates and widths of the intervals and the lookup of the
+//!        interval containing each cell of the finest grid
+
+void InversionTable::Axis::Finalize() {
+  const int n = nnode();
+  x.resize(n);
+  inv_width.resize(n - 1);
+  bin.resize(nfine);
+  for (int m=0; m<n; ++m)
+    x[m] = xmin + node[m]*dx;
+  for (int m=0; m<n-1; ++m) {
+    inv_width[m] = 1.0/(x[m+1] - x[m]);
+    for (int f=node[m]; f<node[m+1]; ++f)
+      bin[f] = m;
+  }
+  return;
+}
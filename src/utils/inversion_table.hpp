@@ -0,0 +1,104 @@
+#ifndef UTILS_INVERSION_TABLE_HPP_
+#define UTILS_INVERSION_TABLE_HPP_
+//========================================================================================
+// Athena++ astrophysical MHD code
+// Copyright(C) 2014 James M. Stone <jmstone@princeton.edu> and other code contributors
+// Licensed under the 3-clause BSD License, see LICENSE file for details
+//========================================================================================
+//! \file inversion_table.hpp
+//! \brief defines class InversionTable, an adaptive lookup table of the temperature
+//!        T(rho, q) of an analytic EOS q(rho, T), where q is e.g. the internal energy
+//!        density or the pressure
+
+// C headers
+
+// C++ headers
+#include <cmath>   // exp(), log()
+#include <vector>
+
+// Athena++ headers
+#include "../athena.hpp"         // Real
+
+//----------------------------------------------------------------------------------------
+//! \class InversionTable
+//! \brief bilinear table of ln(T rho/q) on a tensor grid in (ln rho, ln(q/rho)), followed
+//!        by one Newton step on q(rho, T). Each axis is refined dyadically, interval by
+//!        interval, until the EOS functions evaluated with the resulting T agree with the
+//!        exact inversion within a tolerance.
+
+class InversionTable {
+ public:
+  using EosFunction = Real (*)(Real rho, Real T);
+  using InverseFunction = Real (*)(Real rho, Real q);
+
+  InversionTable() = default;
+
+  void Build(EosFunction q_of_T, InverseFunction T_of_q,
+             const std::vector<EosFunction> &checks, Real rho_min, Real rho_max,
+             Real T_min, Real T_max, int nbase, int max_level, Real tol,
+             int nthreads);
+  bool Built() const {return !lnt_.empty();}
+  int GetNumNodes() const {return static_cast<int>(lnt_.size());}
+
+  //! \brief interpolate T(rho, q) and polish it; returns false if (rho, q) is outside
+  //!        of the table
+  bool Lookup(Real rho, Real q, Real *T) const {
+    if (lnt_.empty()) return false;
+    Real ls = std::log(q/rho);
+    Real lr = std::log(rho);
+    Real f1 = (lr - ax1_.xmin)*ax1_.inv_dx;
+    Real f2 = (ls - ax2_.xmin)*ax2_.inv_dx;
+    // the negated comparison also rejects NaNs
+    if (!(f1 >= 0.0 && f1 < ax1_.nfine && f2 >= 0.0 && f2 < ax2_.nfine)) return false;
+    int i = ax1_.bin[static_cast<int>(f1)];
+    int j = ax2_.bin[static_cast<int>(f2)];
+    Real w1 = (lr - ax1_.x[i])*ax1_.inv_width[i];
+    Real w2 = (ls - ax2_.x[j])*ax2_.inv_width[j];
+    // cells that are not accurate enough at the finest level are left to the caller
+    if (bad_[j*(ax1_.nnode() - 1) + i]) return false;
+    const Real *p = &lnt_[j*ax1_.nnode() + i];
+    const Real *q2 = p + ax1_.nnode();
+    *T = Polish(rho, q, std::exp((1.0 - w2)*(p[0] + w1*(p[1] - p[0]))
+                                 + w2*(q2[0] + w1*(q2[1] - q2[0])))*(q/rho));
+    return true;
+  }
+
+ private:
+  //! \brief one Newton step on q(rho, T) = q, with a one-sided difference for dq/dT
+  Real Polish(Real rho, Real q, Real T) const {
+    Real q0 = q_of_T_(rho, T);
+    Real dT = 1e-6*T;
+    return T + (q - q0)*dT/(q_of_T_(rho, T + dT) - q0);
+  }
+
+  //! one axis of the table; the nodes are a subset of a uniform grid of nfine intervals
+  struct Axis {
+    Real xmin{0.0}, dx{0.0}, inv_dx{0.0};
+    int nfine{0};
+    std::vector<int> node;        // indices of the nodes on the finest grid
+    std::vector<Real> x;          // coordinates of the nodes
+    std::vector<Real> inv_width;  // inverse widths of the intervals
+    std::vector<int> bin;         // interval containing each cell of the finest grid
+    int nnode() const {return static_cast<int>(node.size());}
+    void Init(Real x0, Real x1, int nbase, int max_level);
+    void Split(const std::vector<bool> &split);
+    void Finalize();
+  };
+
+  Real Error(Real lr, Real ls, Real lnt) const;
+  Real CellError(int i, int j, Real w1, Real w2) const;
+  bool Refine();
+  void SolveNodes(const std::vector<int> &nodes);
+
+  EosFunction q_of_T_{nullptr};
+  InverseFunction T_of_q_{nullptr};
+  std::vector<EosFunction> checks_;
+  Real tol_{0.0};
+  int nthreads_{1};
+  Axis ax1_, ax2_;          // ln rho and ln(q/rho)
+  std::vector<Real> lnt_;   // ln(T rho/q) at the nodes, x1 fastest
+  std::vector<bool> ok_;    // cells that have been checked, only during Build()
+  std::vector<unsigned char> bad_;  // cells that did not reach the tolerance
+};
+
+#endif // UTILS_INVERSION_TABLE_HPP_
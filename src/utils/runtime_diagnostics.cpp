@@ -0,0 +1,272 @@
+//========================================================================================
+// Athena++ astrophysical MHD code
+// Copyright(C) 2014 James M. Stone <jmstone@princeton.edu> and other code contributors
+// Licensed under the 3-clause BSD License, see LICENSE file for details
+//========================================================================================
+//! \file runtime_diagnostics.cpp
+//! \brief rate-limited, aggregated reporting of recoverable events (RuntimeDiagnostics)
+//!
+//! Parameters (all optional) in the <diagnostics> block:
+//! - interval:      number of cycles between summaries (default 1; 0 = only at the end)
+//! - log_max_lines: cap on the per-rank detailed log <problem_id>.diag.<rank>.log, one
+//!                  line per event (default 0 = no detailed log)
+
+// C headers
+
+// C++ headers
+#include <algorithm>  // copy, max, min
+#include <cinttypes>  // format macro "PRId64" for fixed-width integer type std::int64_t
+#include <cstdint>    // int64_t
+#include <cstdio>     // fopen, fprintf, fclose
+#include <iostream>   // cout
+#include <sstream>    // stringstream
+#include <string>
+#include <vector>
+
+// Athena++ headers
+#include "../athena.hpp"
+#include "../globals.hpp"
+#include "../mesh/global_reduction.hpp"
+#include "../parameter_input.hpp"
+#include "utils.hpp"
+
+#ifdef OPENMP_PARALLEL
+#include <omp.h>
+#endif
+
+namespace RuntimeDiagnostics {
+
+namespace {
+constexpr int kNSample = 4;
+
+//! event count and first sample of one category on one thread
+struct Counter {
+  std::int64_t count;
+  Real sample[kNSample];
+};
+
+//! one line of the detailed log
+struct Event {
+  int cat;
+  Real sample[kNSample];
+};
+
+//! registry of categories and per-thread counters. Each thread owns separately
+//! allocated vectors so that counting does not share cache lines between threads.
+struct Registry {
+  std::vector<std::string> names;
+  std::vector<std::vector<std::string>> labels;
+  std::vector<std::vector<Counter>> counters;  // [thread][category]
+  std::vector<std::vector<Event>> events;      // [thread][event] for the detailed log
+  int interval = 1;
+  int loop_threads = 1;  // size of the nested loop-level teams (<mesh> num_loop_threads)
+  std::int64_t log_max_lines = 0, log_lines = 0;
+  int first_cycle = 0;
+  std::string log_name;
+  // counts moved out of the thread counters by Post() and not reported yet
+  std::vector<Counter> staged;
+  int count_slot = -1;            // GlobalReduction slots of the counts
+  std::vector<int> sample_slots;  // and of the samples, one per category
+  bool posted = false;
+};
+
+Registry &GetRegistry() {
+  static Registry reg;
+  return reg;
+}
+
+int NumThreads() {
+#ifdef OPENMP_PARALLEL
+  return omp_get_max_threads();
+#else
+  return 1;
+#endif
+}
+
+void ResizeThreads(Registry &reg, int nthreads) {
+  nthreads = std::max(nthreads, static_cast<int>(reg.counters.size()));
+  reg.counters.resize(nthreads);
+  reg.events.resize(nthreads);
+  for (std::vector<Counter> &c : reg.counters)
+    c.resize(reg.names.size(), Counter());
+}
+} // namespace
+
+//----------------------------------------------------------------------------------------
+//! \fn int AddCategory(const std::string &name, const std::string &sample_labels)
+//! \brief register an event category (or look up an existing one) and return its index.
+//!        sample_labels is a comma-separated list of up to 4 names for the sample values
+
+int AddCategory(const std::string &name, const std::string &sample_labels) {
+  Registry &reg = GetRegistry();
+  for (int n=0; n<static_cast<int>(reg.names.size()); ++n) {
+    if (reg.names[n] == name) return n;
+  }
+  std::vector<std::string> lab;
+  std::stringstream ss(sample_labels);
+  std::string item;
+  while (std::getline(ss, item, ',') && lab.size() < kNSample)
+    lab.push_back(item);
+  reg.names.push_back(name);
+  reg.labels.push_back(lab);
+  ResizeThreads(reg, NumThreads());
+  return static_cast<int>(reg.names.size()) - 1;
+}
+
+//----------------------------------------------------------------------------------------
+//! \fn void Record(const int cat, const Real s0, const Real s1, const Real s2,
+//!                 const Real s3)
+//! \brief count one event of category cat; thread-safe, no communication or I/O
+
+void Record(const int cat, const Real s0, const Real s1, const Real s2, const Real s3) {
+  Registry &reg = GetRegistry();
+  int tid = 0;
+#ifdef OPENMP_PARALLEL
+  tid = omp_get_thread_num();
+  // in a loop-level team nested in the block-level team, flatten the two thread ids
+  if (omp_get_level() > 1)
+    tid += omp_get_ancestor_thread_num(omp_get_level() - 1)*reg.loop_threads;
+#endif
+  if (tid >= static_cast<int>(reg.counters.size())) tid = 0;
+  Counter &c = reg.counters[tid][cat];
+  if (c.count++ == 0) {
+    c.sample[0] = s0, c.sample[1] = s1, c.sample[2] = s2, c.sample[3] = s3;
+  }
+  if (reg.log_max_lines > 0 && reg.log_lines
+      + static_cast<std::int64_t>(reg.events[tid].size()) < reg.log_max_lines) {
+    Event e = {cat, {s0, s1, s2, s3}};
+    reg.events[tid].push_back(e);
+  }
+  return;
+}
+
+//----------------------------------------------------------------------------------------
+//! \fn void Initialize(ParameterInput *pin)
+//! \brief read the <diagnostics> block; call once before the Mesh is constructed
+
+void Initialize(ParameterInput *pin) {
+  Registry &reg = GetRegistry();
+  reg.interval = pin->GetOrAddInteger("diagnostics", "interval", 1);
+  reg.log_max_lines = pin->GetOrAddInteger("diagnostics", "log_max_lines", 0);
+  reg.log_name = pin->GetString("job", "problem_id") + ".diag."
+                 + std::to_string(Globals::my_rank) + ".log";
+  reg.loop_threads = pin->GetOrAddInteger("mesh", "num_loop_threads", 1);
+  ResizeThreads(reg, std::max(NumThreads(), reg.loop_threads
+                              *pin->GetOrAddInteger("mesh", "num_threads", 1)));
+  return;
+}
+
+//----------------------------------------------------------------------------------------
+//! \fn void Post(GlobalReduction *pred)
+//! \brief move the counters of all threads to the counts not reported yet and add those
+//!        to the slots of pred. Called by Mesh::StartNewTimeStep() before pred->Start(),
+//!        so that the counts are summed over the ranks with the new time step.
+
+void Post(GlobalReduction *pred) {
+  Registry &reg = GetRegistry();
+  const int ncat = static_cast<int>(reg.names.size());
+  if (ncat == 0) return;
+  // one slot for the counts and one per category for the sample of the lowest rank,
+  // added as the categories are
+  if (reg.count_slot < 0)
+    reg.count_slot = pred->Register(ReductionOp::sum, ncat);
+  else
+    pred->Resize(reg.count_slot, ncat);
+  while (static_cast<int>(reg.sample_slots.size()) < ncat)
+    reg.sample_slots.push_back(pred->Register(ReductionOp::minloc, 1 + kNSample));
+  reg.staged.resize(ncat, Counter());
+
+  std::vector<Real> counts(ncat);
+  for (int n=0; n<ncat; ++n) {
+    Counter &st = reg.staged[n];
+    for (std::vector<Counter> &thread : reg.counters) {
+      Counter &c = thread[n];
+      if (c.count > 0 && st.count == 0)
+        std::copy(c.sample, c.sample + kNSample, st.sample);
+      st.count += c.count;
+      c.count = 0;
+    }
+    counts[n] = static_cast<Real>(st.count);
+    if (st.count > 0) {
+      Real rec[1 + kNSample];
+      rec[0] = static_cast<Real>(Globals::my_rank);
+      std::copy(st.sample, st.sample + kNSample, rec + 1);
+      pred->Accumulate(reg.sample_slots[n], rec);
+    }
+  }
+  pred->Accumulate(reg.count_slot, counts.data());
+  reg.posted = true;
+  return;
+}
+
+//----------------------------------------------------------------------------------------
+//! \fn void Report(GlobalReduction *pred, const int ncycle, const Real time,
+//!                 const bool force)
+//! \brief every interval cycles, after pred has completed, print one summary line on
+//!        rank 0 of the counts posted since the last summary. With force (at the end of
+//!        the run), the counts are posted and reduced first; collective.
+
+void Report(GlobalReduction *pred, const int ncycle, const Real time, const bool force) {
+  Registry &reg = GetRegistry();
+  const int ncat = static_cast<int>(reg.names.size());
+  if (ncat == 0) return;
+  if (!force && (reg.interval <= 0 || ncycle % reg.interval != 0)) return;
+  if (force) {
+    Post(pred);
+    pred->Start();
+    pred->Finish();
+  }
+  if (!reg.posted) return;
+
+  // detailed log of this rank, capped at log_max_lines in total
+  if (reg.log_max_lines > 0 && reg.log_lines < reg.log_max_lines) {
+    std::int64_t nevent = 0;
+    for (std::vector<Event> &thread : reg.events) nevent += thread.size();
+    if (nevent > 0) {
+      FILE *pfile = std::fopen(reg.log_name.c_str(), "a");
+      if (pfile != nullptr) {
+        for (std::vector<Event> &thread : reg.events) {
+          for (Event &e : thread) {
+            if (reg.log_lines == reg.log_max_lines) break;
+            std::fprintf(pfile, "cycles=%d-%d %s:", reg.first_cycle, ncycle,
+                         reg.names[e.cat].c_str());
+            for (int m=0; m<static_cast<int>(reg.labels[e.cat].size()); ++m)
+              std::fprintf(pfile, " %s=%e", reg.labels[e.cat][m].c_str(), e.sample[m]);
+            std::fprintf(pfile, "\n");
+            reg.log_lines++;
+          }
+        }
+        if (reg.log_lines == reg.log_max_lines)
+          std::fprintf(pfile, "log_max_lines=%" PRId64 " reached; detailed log stopped\n",
+                       reg.log_max_lines);
+        std::fclose(pfile);
+      }
+    }
+  }
+  for (std::vector<Event> &thread : reg.events) thread.clear();
+
+  if (Globals::my_rank == 0) {
+    std::stringstream line;
+    const int nposted = std::min(ncat, pred->Size(reg.count_slot));
+    for (int n=0; n<nposted; ++n) {
+      std::int64_t count = static_cast<std::int64_t>(pred->Result(reg.count_slot, n));
+      if (count == 0) continue;
+      const int slot = reg.sample_slots[n];
+      line << ((line.tellp() > 0) ? "; " : "") << reg.names[n] << ": " << count
+           << " (first on rank " << static_cast<int>(pred->Result(slot, 0));
+      for (int m=0; m<static_cast<int>(reg.labels[n].size()); ++m)
+        line << ((m == 0) ? ": " : ", ") << reg.labels[n][m] << "="
+             << pred->Result(slot, 1 + m);
+      line << ")";
+    }
+    if (line.tellp() > 0) {
+      std::cout << "### Warning: cycles " << reg.first_cycle << "-" << ncycle
+                << ", time=" << time << ": " << line.str() << std::endl;
+    }
+  }
+  for (Counter &st : reg.staged) st.count = 0;
+  reg.first_cycle = ncycle + 1;
+  return;
+}
+
+} // namespace RuntimeDiagnostics
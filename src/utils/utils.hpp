@@ -11,15 +11,39 @@
 // C headers
 
 // C++ headers
+#include <algorithm> // std::min()
 #include <csignal>   // sigset_t POSIX C extension
 #include <cstdint>   // std::int64_t
+#include <string>
 
 // Athena++ headers
+#include "../athena.hpp"
+
+#ifdef OPENMP_PARALLEL
+#include <omp.h>
+#endif
+
+class GlobalReduction;
+class ParameterInput;
 
 void ChangeRunDir(const char *pdir);
 double ran2(std::int64_t *idum);
 void ShowConfig();
 
+//----------------------------------------------------------------------------------------
+//! \fn int LoopThreadNum(const int nthreads)
+//! \brief index of the per-thread scratch set to use inside a loop-level team of
+//!        nthreads threads (<mesh> num_loop_threads). Outside such a team only one
+//!        thread works on a MeshBlock, so any set is safe and the index is clamped.
+
+inline int LoopThreadNum(const int nthreads) {
+#ifdef OPENMP_PARALLEL
+  return (nthreads > 1) ? std::min(omp_get_thread_num(), nthreads - 1) : 0;
+#else
+  return 0;
+#endif
+}
+
 //----------------------------------------------------------------------------------------
 //! \namespace SignalHandler
 //! \brief static data and functions that implement a simple signal handling system
@@ -37,4 +61,23 @@ void SetWallTimeAlarm(int t);
 void CancelWallTimeAlarm();
 } // namespace SignalHandler
 
+//----------------------------------------------------------------------------------------
+//! \namespace RuntimeDiagnostics
+//! \brief counters for recoverable events in hot loops (bad cells, failed solves, ...)
+//!
+//! Events are counted by category in per-thread counters, summed over all ranks with the
+//! time step reduction (Mesh::preduce) and reported every <diagnostics> interval cycles
+//! in a single line together with the first sample of each category, instead of one line
+//! per event. Categories must be added in the same order on all ranks, outside of
+//! threaded regions (e.g. in InitUserMeshData).
+
+namespace RuntimeDiagnostics {
+int AddCategory(const std::string &name, const std::string &sample_labels);
+void Record(const int cat, const Real s0 = 0.0, const Real s1 = 0.0,
+            const Real s2 = 0.0, const Real s3 = 0.0);
+void Initialize(ParameterInput *pin);
+void Post(GlobalReduction *pred);
+void Report(GlobalReduction *pred, const int ncycle, const Real time, const bool force);
+} // namespace RuntimeDiagnostics
+
 #endif // UTILS_UTILS_HPP_
@@ -0,0 +1,60 @@
+# Regression test for the budget of MeshBlocks in AMR
+#
+# Runs a 2D blast wave with 3 levels of AMR with and without max_blocks_per_rank in
+# <mesh>. Then counts the MeshBlocks in the last VTK dump of each run, and checks that
+# the budget holds, that it was binding, and that the finest level is still used.
+
+# Modules
+import glob
+import logging
+import numpy as np
+import scripts.utils.athena as athena
+import sys
+sys.path.insert(0, '../../vis/python')
+import athena_read  # noqa
+athena_read.check_nan_flag = True
+logger = logging.getLogger('athena' + __name__[7:])  # set logger name based on module
+
+budget = 160
+
+
+# Prepare Athena++
+def prepare(**kwargs):
+    logger.debug('Running test ' + __name__)
+    athena.configure(prob='blast', **kwargs)
+    athena.make()
+
+
+# Run Athena++
+def run(**kwargs):
+    athena.run('hydro/athinput.blast_amr_budget',
+               ['job/problem_id=Free', 'mesh/max_blocks_per_rank=-1'])
+    athena.run('hydro/athinput.blast_amr_budget',
+               ['job/problem_id=Budget',
+                'mesh/max_blocks_per_rank={0}'.format(budget)])
+
+
+# Analyze outputs
+def analyze():
+    analyze_status = True
+    nfree = len(glob.glob('bin/Free.block*.out1.00002.vtk'))
+    files = glob.glob('bin/Budget.block*.out1.00002.vtk')
+    logger.info('%d MeshBlocks without and %d with a budget of %d', nfree, len(files),
+                budget)
+    if nfree <= budget:
+        logger.warning('the budget is not binding: %d MeshBlocks without it', nfree)
+        analyze_status = False
+    if len(files) > budget:
+        logger.warning('%d MeshBlocks exceed the budget of %d', len(files), budget)
+        analyze_status = False
+    # the root grid has 8x8 cells per MeshBlock of width 1/64; the refinements with the
+    # steepest pressure jumps are kept, so some MeshBlocks reach the finest level
+    nfinest = 0
+    for f in files:
+        x1f, _, _, _ = athena_read.vtk(f)
+        if np.isclose(x1f[1] - x1f[0], 1.0/256):
+            nfinest += 1
+    if nfinest == 0:
+        logger.warning('no MeshBlock at the finest level within the budget')
+        analyze_status = False
+    return analyze_status
@@ -0,0 +1,91 @@
+# Regression test of the per-scalar diffusion configuration: two copies of the
+# Gaussian scalar distribution of scalar_diffusion.py, where diffusion of r0 is
+# switched off (problem/nu_scalar_iso_0=0). r1 must converge to the analytic
+# solution at the expected order, r0 must be left untouched.
+
+# Modules
+import logging
+import scripts.utils.athena as athena
+import numpy as np
+import sys
+sys.path.insert(0, '../../vis/python')
+import athena_read  # noqa
+athena_read.check_nan_flag = True
+logger = logging.getLogger('athena' + __name__[7:])  # set logger name based on module
+
+_amp = 1.e-6
+_nu = 0.25
+_t0 = 0.5
+_tf = 2.0
+_Lx1 = 12.0
+
+resolution_range = [256, 512]
+rate_tol = -1.99
+frozen_tol = 1.e-8  # round-off only; diffusing r0 would change it at O(1)
+
+
+def prepare(*args, **kwargs):
+    logger.debug('Running test ' + __name__)
+    athena.configure(prob='scalar_diff', *args,
+                     eos='isothermal', flux='roe',
+                     nscalars=2, **kwargs)
+    athena.make()
+
+
+def run(**kwargs):
+    for n in resolution_range:
+        arguments = ['job/problem_id=ScalarDiffusionMask_' + repr(n),
+                     'output2/file_type=tab', 'output2/variable=prim',
+                     'output2/data_format=%24.16e', 'output2/dt={}'.format(_tf),
+                     'time/cfl_number=0.8',
+                     'time/tlim={}'.format(_tf), 'time/nlim=10000',
+                     'time/ncycle_out=0',
+                     'mesh/nx1=' + repr(n),
+                     'mesh/x1min={}'.format(-_Lx1/2.),
+                     'mesh/x1max={}'.format(_Lx1/2.),
+                     'mesh/ix1_bc=outflow', 'mesh/ox1_bc=outflow',
+                     'mesh/nx2=1', 'mesh/x2min=-1.0', 'mesh/x2max=1.0',
+                     'mesh/ix2_bc=periodic', 'mesh/ox2_bc=periodic',
+                     'mesh/nx3=1', 'mesh/x3min=-1.0', 'mesh/x3max=1.0',
+                     'mesh/ix3_bc=periodic', 'mesh/ox3_bc=periodic',
+                     'hydro/iso_sound_speed=1.0',
+                     'problem/amp={}'.format(_amp), 'problem/iprob=0',
+                     'problem/t0={}'.format(_t0),
+                     'problem/nu_scalar_iso={}'.format(_nu),
+                     'problem/nu_scalar_iso_0=0.0']
+        athena.run('hydro/athinput.scalar_diff', arguments)
+
+
+def analyze():
+    def gaussian(x, t):
+        return (_amp/np.sqrt(4.*np.pi*_nu*t)
+                * np.exp(-(x**2.)/(4.*_nu*t)))
+
+    analyze_status = True
+    l1ERROR = []
+    for n in resolution_range:
+        data = athena_read.tab('bin/ScalarDiffusionMask_' + str(n)
+                               + '.block0.out2.00001.tab')
+        x1v = data['x1v']
+        dx1 = _Lx1/len(x1v)
+        l1ERROR.append(sum(np.absolute(data['r1'] - gaussian(x1v, _t0+_tf))*dx1))
+
+        # no diffusion (and no mean flow): r0 keeps its initial profile
+        frozen_err = (np.amax(np.absolute(data['r0'] - gaussian(x1v, _t0)))
+                      / np.amax(gaussian(x1v, _t0)))
+        logger.info('[Scalar Diffusion Mask]: N = {}, max. change of r0 = {}'
+                    .format(n, frozen_err))
+        if frozen_err > frozen_tol:
+            logger.warning('[Scalar Diffusion Mask]: r0 is diffused although '
+                           'nu_scalar_iso_0 = 0')
+            analyze_status = False
+
+    conv = (np.diff(np.log(np.array(l1ERROR)))
+            / np.diff(np.log(np.array(resolution_range))))
+    logger.info('[Scalar Diffusion Mask]: Convergence order of r1 = {}'.format(conv))
+    if conv > rate_tol:
+        logger.warning('[Scalar Diffusion Mask]: '
+                       'Scheme NOT converging at expected order.')
+        analyze_status = False
+
+    return analyze_status
@@ -0,0 +1,44 @@
+# Regression test based on the decaying linear wave due to thermal
+# conduction. The decay rate is fit and then compared with analytic
+# solution.  This test uses the implicit (Multigrid) conduction solver,
+# which requires cubic MeshBlocks.
+
+# Modules
+# (needed for global variables modified in run_tests.py, even w/o athena.run(), etc.)
+import scripts.utils.athena as athena
+import scripts.tests.diffusion.thermal_attenuation as thermal_attenuation
+import logging
+
+thermal_attenuation.method = 'Implicit'
+thermal_attenuation.logger = logging.getLogger('athena' + __name__[7:])
+
+
+def prepare(*args, **kwargs):
+    thermal_attenuation.prepare(*args, **kwargs)
+
+
+def run(**kwargs):
+    for i in thermal_attenuation.resolution_range:
+        arguments = ['output1/dt=0.03',
+                     'output2/dt=-1',  # disable .vtk outputs
+                     'time/tlim=3.0',
+                     'time/ncycle_out=0',
+                     # L-going sound wave
+                     'problem/wave_flag=0',
+                     'problem/amp=1.0e-4',
+                     'problem/vflow=0.0',
+                     'problem/kappa_iso=0.04',
+                     'problem/implicit_conduction=true',
+                     'problem/conduction_tol=1.0e-8',
+                     'mesh/nx1=' + repr(i),
+                     'mesh/nx2=' + repr(i//2),
+                     'mesh/nx3=' + repr(i//2),
+                     'meshblock/nx1=' + repr(i//2),
+                     'meshblock/nx2=' + repr(i//2),
+                     'meshblock/nx3=' + repr(i//2),
+                     'job/problem_id=DecayLinWave-{}'.format(i)]
+        athena.run('hydro/athinput.linear_wave3d', arguments)
+
+
+def analyze():
+    return thermal_attenuation.analyze()
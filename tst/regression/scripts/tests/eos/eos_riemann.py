@@ -1,5 +1,6 @@
 """
-Regression test for general EOS 1D Riemann problems.
+Regression test for general EOS 1D Riemann problems, with the hydrogen EOS inverted by
+root finding and by the tables built at startup (hydro/eos_tabulate).
 """
 
 # Modules
@@ -16,6 +17,8 @@ athena_read.check_nan_flag = True
 logger = logging.getLogger('athena' + __name__[7:])  # set logger name based on module
 _fluxes = ['hllc']
 _exec = os.path.join('bin', 'athena')
+_tabulate = ['false', 'true']
+_suffix = {'false': '', 'true': '_tab'}
 
 _tests = [[1e-07, 0.00, 0.150, 1.25e-8, 0., 0.062, .25],
           [4e-06, 0.00, 0.120, 4e-08, 0.00, 0.019, 0.3],
@@ -64,15 +67,18 @@ def run(**kwargs):
         move(_exec + '_' + flux, _exec)
         os.system('mv obj_' + flux + ' obj')
         for n, test in enumerate(_tests):
-            args = [i + '={0:}'.format(test[i]) for i in test]
-            args += ['job/problem_id=eos_riemann_{0:}_{1:02d}'.format(flux, n),
-                     'time/ncycle_out=0']
-            athena.run('hydro/athinput.sod_general_H', args)
+            for tab in _tabulate:
+                args = [i + '={0:}'.format(test[i]) for i in test]
+                args += ['job/problem_id=eos_riemann_{0:}{1:}_{2:02d}'.format(
+                             flux, _suffix[tab], n),
+                         'hydro/eos_tabulate={0:}'.format(tab), 'time/ncycle_out=0']
+                athena.run('hydro/athinput.sod_general_H', args)
 
 
 def analyze():
     analyze_status = True
-    for flux in _fluxes:
+    # runs with the tabulated EOS have the suffix _tab, e.g. eos_riemann_hllc_tab_00
+    for flux in [f + _suffix[t] for f in _fluxes for t in _tabulate]:
         for n, state in enumerate(_states):
             # the double shock tests are too hard for hlle
             t = 1
@@ -0,0 +1,61 @@
+# Regression test for the temperature and velocity ceilings (<hydro>/tceil, vceil)
+#
+# Runs the 2D blast wave in a periodic box with and without ceilings. Checks that the
+# energy removed by the ceilings (tceil-E, vceil-E history columns) accounts exactly for
+# the change of the total energy, that both ceilings were active, and that the time step
+# is larger with the ceilings.
+
+# Modules
+import logging
+import numpy as np
+import scripts.utils.athena as athena
+import sys
+sys.path.insert(0, '../../vis/python')
+import athena_read                             # noqa
+athena_read.check_nan_flag = True
+logger = logging.getLogger('athena' + __name__[7:])  # set logger name based on module
+_args = ['output1/dt=0.01', 'output2/dt=-1',
+         'time/tlim=0.2', 'time/ncycle_out=0',
+         'mesh/nx1=64', 'mesh/nx2=64', 'mesh/nx3=1', 'mesh/x2min=-0.5', 'mesh/x2max=0.5',
+         'meshblock/nx1=32', 'meshblock/nx2=32', 'meshblock/nx3=1']
+
+
+# Prepare Athena++
+def prepare(**kwargs):
+    logger.debug('Running test ' + __name__)
+    athena.configure(prob='blast', coord='cartesian', flux='hllc', **kwargs)
+    athena.make()
+
+
+# Run Athena++
+def run(**kwargs):
+    athena.run('hydro/athinput.blast',
+               _args + ['job/problem_id=Ceilings', 'hydro/tceil=2.0', 'hydro/vceil=0.5'])
+    athena.run('hydro/athinput.blast', _args + ['job/problem_id=Reference'])
+
+
+# Analyze outputs
+def analyze():
+    analyze_status = True
+    hst = athena_read.hst('bin/Ceilings.hst')
+    ref = athena_read.hst('bin/Reference.hst')
+
+    balance = hst['tot-E'] + hst['tceil-E'] + hst['vceil-E']
+    err = np.max(np.abs(balance - balance[0]))/balance[0]
+    logger.debug('relative error of the energy balance with ceilings: %g', err)
+    if err > 1.0e-12:
+        logger.warning('energy removed by the ceilings does not balance tot-E: %g', err)
+        analyze_status = False
+    for col in ['tceil-E', 'vceil-E']:
+        if not hst[col][-1] > 0.0 or np.any(np.diff(hst[col]) < 0.0):
+            logger.warning('%s = %g is not positive and increasing', col, hst[col][-1])
+            analyze_status = False
+    err = abs(ref['tot-E'][-1] - ref['tot-E'][0])/ref['tot-E'][0]
+    if err > 1.0e-12:
+        logger.warning('total energy not conserved without ceilings: %g', err)
+        analyze_status = False
+    if not np.mean(hst['dt']) > np.mean(ref['dt']):
+        logger.warning('mean dt %g with ceilings is not larger than %g without',
+                       np.mean(hst['dt']), np.mean(ref['dt']))
+        analyze_status = False
+    return analyze_status
@@ -0,0 +1,54 @@
+# Regression test for the fused timestep computation (<time>/fused_dt = true)
+#
+# Runs the 2D Kelvin-Helmholtz problem of Lecoanet et al. (explicit viscosity and
+# conduction) with the new block timestep computed in its own pass and inside the final
+# ConservedToPrimitive sweep of each cycle, and checks that the results are bitwise
+# identical
+
+# Modules
+import logging
+import numpy as np
+import scripts.utils.athena as athena
+import sys
+sys.path.insert(0, '../../vis/python')
+import athena_read                             # noqa
+athena_read.check_nan_flag = True
+logger = logging.getLogger('athena' + __name__[7:])  # set logger name based on module
+_integrators = ['vl2', 'rk3']
+
+
+# Prepare Athena++
+def prepare(**kwargs):
+    logger.debug('Running test ' + __name__)
+    athena.configure(prob='kh', coord='cartesian', flux='hllc', nscalars=1, **kwargs)
+    athena.make()
+
+
+# Run Athena++
+def run(**kwargs):
+    for integrator in _integrators:
+        for fused in ['false', 'true']:
+            arguments = ['job/problem_id=KHdt_{0}_{1}'.format(integrator, fused),
+                         'output2/file_type=vtk', 'output2/variable=cons',
+                         'output2/dt=0.5', 'output3/dt=-1',
+                         'time/tlim=0.5', 'time/ncycle_out=0',
+                         'time/integrator={0}'.format(integrator),
+                         'time/fused_dt={0}'.format(fused),
+                         'mesh/nx1=32', 'mesh/nx2=64',
+                         'meshblock/nx1=16', 'meshblock/nx2=32']
+            athena.run('hydro/athinput.kh-shear-lecoanet', arguments)
+
+
+# Analyze outputs
+def analyze():
+    analyze_status = True
+    for integrator in _integrators:
+        ref = athena_read.vtk('bin/KHdt_{0}_false.block0.out2.00001.vtk'.format(integrator))
+        new = athena_read.vtk('bin/KHdt_{0}_true.block0.out2.00001.vtk'.format(integrator))
+        for var in ref[3].keys():
+            if not np.array_equal(ref[3][var], new[3][var]):
+                max_diff = np.max(np.abs(ref[3][var] - new[3][var]))
+                logger.warning('fused dt with %s differs in %s by up to %g',
+                               integrator, var, max_diff)
+                analyze_status = False
+    return analyze_status
@@ -0,0 +1,57 @@
+# Regression test for in-memory rollback checkpoints (<rollback> block)
+#
+# Einfeldt's 1-2-0-3 strong rarefaction with |u|=4 (Mach 5) run with RK3 at cfl_number=1
+# fails the health check in an early cycle. Checks that the cycle is rolled back and retried, that the
+# run then finishes, and that the result agrees with a run at the default CFL number
+# to 10% (L1).
+
+# Modules
+import logging
+import numpy as np
+import scripts.utils.athena as athena
+import sys
+sys.path.insert(0, '../../vis/python')
+import athena_read                             # noqa
+athena_read.check_nan_flag = True
+logger = logging.getLogger('athena' + __name__[7:])  # set logger name based on module
+_args = ['problem/ul=-4.0', 'problem/ur=4.0', 'output1/dt=0.1', 'output2/dt=1e-4',
+         'output2/data_format=%.14e', 'time/ncycle_out=0']
+
+
+# Prepare Athena++
+def prepare(**kwargs):
+    logger.debug('Running test ' + __name__)
+    athena.configure(prob='shock_tube', coord='cartesian', flux='hllc', **kwargs)
+    athena.make()
+
+
+# Run Athena++
+def run(**kwargs):
+    athena.run('hydro/athinput.einfeldt1203',
+               _args + ['job/problem_id=Rollback', 'time/integrator=rk3',
+                        'time/cfl_number=1.0', 'rollback/interval=5'])
+    athena.run('hydro/athinput.einfeldt1203', _args + ['job/problem_id=Reference'])
+
+
+# Analyze outputs
+def analyze():
+    analyze_status = True
+    # history rows are written again when cycles are retried, so time jumps back
+    raw = athena_read.hst('bin/Rollback.hst', raw=True)
+    if np.all(np.diff(raw['time']) > 0.0):
+        logger.warning('no cycle was rolled back')
+        analyze_status = False
+    hst = athena_read.hst('bin/Rollback.hst')
+    if abs(hst['time'][-1] - 0.1) > 1.0e-12:
+        logger.warning('run with rollback stopped at t=%g', hst['time'][-1])
+        analyze_status = False
+
+    data = athena_read.tab('bin/Rollback.block0.out1.00001.tab')
+    ref = athena_read.tab('bin/Reference.block0.out1.00001.tab')
+    for var in ['rho', 'press']:
+        err = np.mean(np.abs(data[var] - ref[var]))/np.mean(np.abs(ref[var]))
+        logger.debug('%s L1 difference to cfl_number=0.4 run: %g', var, err)
+        if err > 0.1:
+            logger.warning('%s differs from the cfl_number=0.4 run by %g', var, err)
+            analyze_status = False
+    return analyze_status
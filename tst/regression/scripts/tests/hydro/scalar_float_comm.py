@@ -0,0 +1,61 @@
+# Regression test for single-precision passive scalar ghost-zone exchange
+# (<problem>/scalar_comm_precision = single)
+#
+# Runs the 2D Kelvin-Helmholtz problem of Lecoanet et al. (one passive scalar) on 8
+# MeshBlocks with the scalar boundary buffers packed in double and in single precision,
+# and checks that the scalar differs only at the level of single-precision round-off
+# while the (passively advecting) hydro variables are bitwise identical
+
+# Modules
+import logging
+import numpy as np
+import scripts.utils.athena as athena
+import sys
+sys.path.insert(0, '../../vis/python')
+import athena_read                             # noqa
+athena_read.check_nan_flag = True
+logger = logging.getLogger('athena' + __name__[7:])  # set logger name based on module
+_tol = 1.0e-5
+
+
+# Prepare Athena++
+def prepare(**kwargs):
+    logger.debug('Running test ' + __name__)
+    athena.configure(prob='kh', coord='cartesian', flux='hllc', nscalars=1, **kwargs)
+    athena.make()
+
+
+# Run Athena++
+def run(**kwargs):
+    for precision in ['double', 'single']:
+        arguments = ['job/problem_id=KH_{0}'.format(precision),
+                     'output2/file_type=vtk', 'output2/variable=prim',
+                     'output2/dt=0.5', 'output3/dt=-1',
+                     'time/tlim=0.5', 'time/ncycle_out=0',
+                     'problem/scalar_comm_precision={0}'.format(precision),
+                     'mesh/nx1=32', 'mesh/nx2=64',
+                     'meshblock/nx1=16', 'meshblock/nx2=16']
+        athena.run('hydro/athinput.kh-shear-lecoanet', arguments)
+
+
+# Analyze outputs
+def analyze():
+    analyze_status = True
+    for block in range(8):
+        ref = athena_read.vtk('bin/KH_double.block{0}.out2.00001.vtk'.format(block))
+        new = athena_read.vtk('bin/KH_single.block{0}.out2.00001.vtk'.format(block))
+        r_ref, r_new = ref[3]['r0'], new[3]['r0']
+        err = np.max(np.abs(r_new - r_ref))/np.max(np.abs(r_ref))
+        if err > _tol or not np.all(np.isfinite(r_new)):
+            logger.warning('single-precision scalar exchange differs in block %d '
+                           'by %g (tolerance %g)', block, err, _tol)
+            analyze_status = False
+        for var in ref[3].keys():
+            if var != 'r0' and not np.array_equal(ref[3][var], new[3][var]):
+                logger.warning('single-precision scalar exchange changed %s', var)
+                analyze_status = False
+        if np.array_equal(r_new, r_ref):
+            logger.warning('single-precision scalar exchange has no effect in block %d',
+                           block)
+            analyze_status = False
+    return analyze_status
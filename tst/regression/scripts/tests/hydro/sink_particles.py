@@ -0,0 +1,82 @@
+# Regression test for sink particles (<sinks> block)
+#
+# A cold dense sphere (blast problem with prat < 1) implodes in a periodic box and forms
+# sink particles. Checks that sinks form, that gas + sink mass is conserved, and that a
+# run restarted after the sinks formed, the same restart on 4 ranks and a run on 4 ranks
+# (8 MeshBlocks) reproduce the serial run.
+
+# Modules
+import logging
+import numpy as np
+import scripts.utils.athena as athena
+import sys
+sys.path.insert(0, '../../vis/python')
+import athena_read                             # noqa
+athena_read.check_nan_flag = True
+logger = logging.getLogger('athena' + __name__[7:])  # set logger name based on module
+_tol = 1.0e-10
+
+
+# Prepare Athena++
+def prepare(**kwargs):
+    logger.debug('Running test ' + __name__)
+    athena.configure('mpi', prob='blast', coord='cartesian', **kwargs)
+    athena.make()
+
+
+# Run Athena++
+def run(**kwargs):
+    arguments = ['output2/dt=-1', 'time/ncycle_out=0']
+    athena.run('hydro/athinput.sink_collapse', arguments)
+    # the sinks form at t~0.28; continue from the dump at t=0.3 (appends to Sink.hst)
+    athena.restart('Sink.00003.rst', ['time/ncycle_out=0'])
+    # the sink record must not depend on the number of ranks that wrote the file
+    athena.mpirestart(kwargs['mpirun_cmd'], kwargs['mpirun_opts'], 4, 'Sink.00003.rst',
+                      ['time/ncycle_out=0', 'job/problem_id=SinkRst4', 'output3/dt=-1'])
+    athena.mpirun(kwargs['mpirun_cmd'], kwargs['mpirun_opts'], 4,
+                  'hydro/athinput.sink_collapse',
+                  arguments + ['job/problem_id=SinkMPI', 'output3/dt=-1'])
+
+
+# Analyze outputs
+def analyze():
+    analyze_status = True
+    hst = athena_read.hst('bin/Sink.hst')
+    total = hst['mass'] + hst['sink-mass']
+    err = np.max(np.abs(total - total[0]))/total[0]
+    if err > _tol:
+        logger.warning('gas + sink mass is not conserved: relative error %g', err)
+        analyze_status = False
+    if hst['sink-N'][-1] < 1 or hst['sink-mass'][-1] <= 0.0:
+        logger.warning('no sink particles formed')
+        analyze_status = False
+    if np.min(hst['dt']) < 0.5*hst['dt'][0]:
+        logger.warning('time step dropped to %g (initially %g)', np.min(hst['dt']),
+                       hst['dt'][0])
+        analyze_status = False
+
+    # a restarted run does not write a header; columns are those of Sink.hst
+    rst = np.atleast_2d(np.loadtxt('bin/SinkRst4.hst'))
+    nrst = rst.shape[0]
+    columns = list(hst.keys())
+    if rst[0, columns.index('sink-N')] < 1:
+        logger.warning('sinks were not restored on 4 ranks')
+        analyze_status = False
+    for var in ['time', 'mass', 'sink-N', 'sink-mass']:
+        err = (np.max(np.abs(hst[var][-nrst:] - rst[:, columns.index(var)]))
+               / np.max(np.abs(hst[var])))
+        if err > _tol:
+            logger.warning('serial and 4-rank restarts differ in %s by %g', var, err)
+            analyze_status = False
+
+    ref = athena_read.hst('bin/SinkMPI.hst')
+    if len(ref['time']) != len(hst['time']):
+        logger.warning('restarted and MPI runs have different history lengths')
+        return False
+    for var in ['time', 'mass', 'tot-E', 'sink-N', 'sink-mass']:
+        err = np.max(np.abs(hst[var] - ref[var]))/np.max(np.abs(ref[var]))
+        if err > _tol:
+            logger.warning('restarted serial and 4-rank runs differ in %s by %g', var,
+                           err)
+            analyze_status = False
+    return analyze_status
@@ -0,0 +1,57 @@
+# Regression test of the on-node shared-memory ghost-zone exchange
+# (mesh/shared_memory_comm)
+#
+# Runs the 3D MHD linear wave convergence problem with SMR on 2 and 4 ranks, with and
+# without the shared-memory path. Only the transport of the ghost-zone data differs, so
+# the L1 errors (stored in linearwave-errors.dat) must be bitwise identical.
+
+# Modules
+import logging
+import scripts.utils.athena as athena
+import sys
+sys.path.insert(0, '../../vis/python')
+import athena_read                             # noqa
+athena_read.check_nan_flag = True
+logger = logging.getLogger('athena' + __name__[7:])  # set logger name based on module
+
+_nranks = [2, 4]
+
+
+# Prepare Athena++ w/ MPI
+def prepare(**kwargs):
+    logger.debug('Running test ' + __name__)
+    athena.configure('b', 'mpi', prob='linear_wave', coord='cartesian',
+                     flux='hlld', **kwargs)
+    athena.make()
+
+
+# Run Athena++ with MPI messages and with shared-memory windows for every rank count
+def run(**kwargs):
+    arguments = ['time/ncycle_out=0',
+                 'problem/wave_flag=0', 'problem/vflow=0.0', 'mesh/refinement=static',
+                 'mesh/nx1=32', 'mesh/nx2=16', 'mesh/nx3=16',
+                 'meshblock/nx1=8',
+                 'meshblock/nx2=8',
+                 'meshblock/nx3=8',
+                 'output2/dt=-1', 'time/tlim=1.0', 'problem/compute_error=true']
+    for n in _nranks:
+        for shm in ['false', 'true']:
+            athena.mpirun(kwargs['mpirun_cmd'], kwargs['mpirun_opts'], n,
+                          'mhd/athinput.linear_wave3d',
+                          arguments + ['mesh/shared_memory_comm=' + shm])
+
+
+# Analyze outputs
+def analyze():
+    analyze_status = True
+    data = athena_read.error_dat('bin/linearwave-errors.dat')
+
+    for i, n in enumerate(_nranks):
+        mpi, shm = data[2*i][4], data[2*i+1][4]
+        logger.info('%d ranks: MPI %g, shared memory %g', n, mpi, shm)
+        if mpi != shm:
+            logger.warning('Linear wave error with shared-memory exchange on %d ranks '
+                           'differs from MPI exchange: %g %g', n, shm, mpi)
+            analyze_status = False
+
+    return analyze_status
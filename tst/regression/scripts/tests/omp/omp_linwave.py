@@ -47,6 +47,10 @@ def run(**kwargs):
     athena.run('mhd/athinput.linear_wave3d', arguments + ['mesh/num_threads=2'])
     athena.run('mhd/athinput.linear_wave3d', arguments + ['mesh/num_threads=4'],
                lcov_test_suffix='omp')
+    # loop-level threading within each MeshBlock, alone and nested in block-level
+    athena.run('mhd/athinput.linear_wave3d', arguments + ['mesh/num_loop_threads=2'])
+    athena.run('mhd/athinput.linear_wave3d',
+               arguments + ['mesh/num_threads=2', 'mesh/num_loop_threads=2'])
     return 'skip_lcov'
 
 
@@ -57,7 +61,8 @@ def analyze():
     filename = 'bin/linearwave-errors.dat'
     data = athena_read.error_dat(filename)
 
-    logger.warning("%g %g %g %g", data[0][4], data[1][4], data[2][4], data[3][4])
+    logger.warning("%g %g %g %g %g %g", data[0][4], data[1][4], data[2][4], data[3][4],
+                   data[4][4], data[5][4])
 
     # check errors between runs w/wo OpenMP and different numbers of threads
     fmt = " %g %g"
@@ -73,5 +78,13 @@ def analyze():
         msg = "Linear wave error differences between 4 threads vs. serial is too large"
         logger.warning(msg + fmt, data[3][4], data[0][4])
         analyze_status = False
+    if abs(data[4][4] - data[0][4]) > 5.0e-4:
+        msg = "Linear wave error differences between 2 loop threads vs. serial too large"
+        logger.warning(msg + fmt, data[4][4], data[0][4])
+        analyze_status = False
+    if abs(data[5][4] - data[0][4]) > 5.0e-4:
+        msg = "Linear wave error with 2x2 hybrid threads differs too much from serial"
+        logger.warning(msg + fmt, data[5][4], data[0][4])
+        analyze_status = False
 
     return analyze_status
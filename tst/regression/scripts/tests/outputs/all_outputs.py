@@ -2,7 +2,8 @@
 #
 # Runs Orszag Tang vortex test, restarting the job twice and making history (hst),
 # formatted table (.tab), VTK, and HDF5 (if available) outputs.  Then reads last
-# version of each file to make sure output data is correct
+# version of each file to make sure output data is correct, including the restricted
+# copies of the HDF5 data (pyramid_levels) and the VTK and HDF5 outputs of a region
 
 # Modules
 import logging
@@ -83,4 +84,45 @@ def analyze():
     if max(hdf5_data['Bcc3'][0, 32, :]) != 0.0:
         analyze_status = False
 
+    # restricted copies are block averages of the full data on the uniform grid
+    for factor in [2, 4, 8]:
+        coarse = athena_read.athdf('bin/TestOutputs.out5.00010.athdf', dtype=np.float32,
+                                   pyramid=factor)
+        if coarse['rho'].shape != (1, 64 // factor, 64 // factor):
+            logger.warning('wrong shape %s of restricted data with factor %d',
+                           coarse['rho'].shape, factor)
+            analyze_status = False
+            continue
+        for q in ['rho', 'press', 'vel1', 'Bcc2']:
+            fine = hdf5_data[q][0].astype(np.float64)
+            n = 64 // factor
+            mean = fine.reshape(n, factor, n, factor).mean(axis=(1, 3))
+            err = np.max(np.abs(coarse[q][0] - mean))/np.max(np.abs(fine))
+            if err > 1.0e-6:
+                logger.warning('restricted %s with factor %d differs by %g', q, factor,
+                               err)
+                analyze_status = False
+        x1f = hdf5_data['x1f'][::factor]
+        if np.max(np.abs(coarse['x1f'] - x1f)) > 1.0e-6:
+            logger.warning('wrong x1f of restricted data with factor %d', factor)
+            analyze_status = False
+
+    # outputs of the region -0.2 < x1 < 0.1, 0 < x2 < 0.3 contain the cells 19-38 in x1
+    # and 32-51 in x2 of the full outputs
+    region = (0, slice(32, 52), slice(19, 39))
+    xf_region, yf_region, _, vtk_region = athena_read.vtk(
+        filename='bin/TestOutputs.block0.out7.00010.vtk')
+    if (vtk_region['rho'].shape != (1, 20, 20)
+            or np.any(vtk_region['rho'][0] != vtk_data['rho'][region])
+            or np.any(xf_region != xf[19:40]) or np.any(yf_region != yf[32:53])):
+        logger.warning('VTK output of the region differs from the full output')
+        analyze_status = False
+    hdf5_region = athena_read.athdf('bin/TestOutputs.out8.00010.athdf',
+                                    dtype=np.float32)
+    if (hdf5_region['rho'].shape != (1, 20, 20)
+            or np.any(hdf5_region['rho'][0] != hdf5_data['rho'][region])
+            or np.any(hdf5_region['x1f'] != hdf5_data['x1f'][19:40])):
+        logger.warning('HDF5 output of the region differs from the full output')
+        analyze_status = False
+
     return analyze_status
@@ -0,0 +1,81 @@
+# Regression test for the in-situ analysis plugins
+#
+# Builds the example plugin src/outputs/plugins/density_pdf.cpp with the compiler and
+# flags of the configured code, runs a periodic 2D blast wave that loads it every 10
+# cycles, and checks the mass and the density PDF that it writes.
+
+# Modules
+import logging
+import numpy as np
+import os
+import subprocess
+import scripts.utils.athena as athena
+logger = logging.getLogger('athena' + __name__[7:])  # set logger name based on module
+
+
+# Prepare Athena++ and the plugin
+def prepare(**kwargs):
+    logger.debug('Running test ' + __name__)
+    athena.configure('plugins', prob='blast', **kwargs)
+    athena.make()
+    make_vars = {}
+    with open(os.path.join(athena.athena_rel_path, 'Makefile')) as f:
+        for line in f:
+            if ':=' in line:
+                key, val = line.split(':=', 1)
+                make_vars[key.strip()] = val.split()
+    source = os.path.join(athena.athena_rel_path, 'src/outputs/plugins/density_pdf.cpp')
+    command = (make_vars['CXX'] + make_vars['CXXFLAGS']
+               + ['-shared', '-fPIC', '-o', 'bin/density_pdf.so', source])
+    logger.debug('Executing: ' + ' '.join(command))
+    subprocess.check_call(command)
+
+
+# Run Athena++
+def run(**kwargs):
+    athena.run('hydro/athinput.analysis_plugin', [])
+
+
+# Analyze outputs
+def analyze():
+    analyze_status = True
+    with open('bin/Blast.pdf.txt') as f:
+        lines = f.readlines()
+    data = np.loadtxt([line for line in lines if not line.startswith('#')], ndmin=2)
+    footer = [line for line in lines if line.startswith('# mean PDF')]
+
+    # cycles 0, 10, ..., 100, each with time, mass and 16 volume fractions
+    if data.shape != (11, 18):
+        logger.warning('expected 11 rows of 18 columns, found %s', str(data.shape))
+        return False
+    if np.any(np.diff(data[:, 0]) <= 0.0):
+        logger.warning('times are not increasing')
+        analyze_status = False
+    # uniform unit density in the unit square, conserved with periodic boundaries;
+    # the plugin writes 8 significant digits
+    mass_error = np.max(np.abs(data[:, 1] - 1.0))
+    if mass_error > 1.0e-7:
+        logger.warning('mass not conserved: error %g', mass_error)
+        analyze_status = False
+    # all of the density lies within [rho_min, rho_max)
+    pdf_error = np.max(np.abs(np.sum(data[:, 2:], axis=1) - 1.0))
+    if pdf_error > 1.0e-6:
+        logger.warning('volume fractions do not sum to 1: error %g', pdf_error)
+        analyze_status = False
+    # the initial density is 1, in the bin [1, 10^0.25)
+    if data[0, 2 + 8] != 1.0:
+        logger.warning('initial PDF is not concentrated in the bin of rho=1')
+        analyze_status = False
+    # the blast wave spreads the PDF
+    if np.count_nonzero(data[-1, 2:]) < 3:
+        logger.warning('final PDF has fewer than 3 populated bins')
+        analyze_status = False
+
+    if len(footer) != 1 or not footer[0].startswith('# mean PDF over 11 calls:'):
+        logger.warning('missing or wrong summary line written by Finalize()')
+        return False
+    mean = np.array(footer[0].split(':')[1].split(), dtype=float)
+    if np.max(np.abs(mean - np.mean(data[:, 2:], axis=0))) > 1.0e-7:
+        logger.warning('mean PDF does not match the rows')
+        analyze_status = False
+    return analyze_status
@@ -0,0 +1,80 @@
+# Regression test for continuous turbulence driving with the next forcing field generated
+# on a helper thread (<turbulence>/async_driving = true) with MPI+OpenMP.
+#
+# Runs the driven turbulence test in 3D on 1 rank x 1 thread and 4 ranks x 2 threads,
+# and restarts the hybrid run from an intermediate dump. Checks that the runs agree, that
+# the restarted run reproduces the uninterrupted one and that the forcing was in fact
+# generated asynchronously (one-cycle lag in the OU process, so the result differs from
+# synchronous driving).
+
+# Modules
+import logging
+import numpy as np
+import scripts.utils.athena as athena
+import sys
+sys.path.insert(0, '../../vis/python')
+import athena_read                             # noqa
+athena_read.check_nan_flag = True
+logger = logging.getLogger('athena' + __name__[7:])  # set logger name based on module
+
+
+# Prepare Athena++
+def prepare(**kwargs):
+    logger.debug('Running test ' + __name__)
+    athena.configure('mpi', 'fft', 'omp', prob='turb', **kwargs)
+    athena.make()
+
+
+# Run Athena++
+def run(**kwargs):
+    arguments = ['time/ncycle_out=0',
+                 'mesh/nx1=32', 'mesh/nx2=32', 'mesh/nx3=32',
+                 'meshblock/nx1=16', 'meshblock/nx2=16', 'meshblock/nx3=16',
+                 'problem/turb_flag=3', 'turbulence/rseed=1',
+                 'output2/file_type=rst', 'output2/dt=0.15', 'time/tlim=0.3']
+    athena.mpirun(kwargs['mpirun_cmd'], kwargs['mpirun_opts'], 1, 'hydro/athinput.turb',
+                  arguments + ['job/problem_id=turb_async1', 'mesh/num_threads=1',
+                               'turbulence/async_driving=true'])
+    athena.mpirun(kwargs['mpirun_cmd'], kwargs['mpirun_opts'], 4, 'hydro/athinput.turb',
+                  arguments + ['job/problem_id=turb_async4', 'mesh/num_threads=2',
+                               'turbulence/async_driving=true'])
+    athena.mpirun(kwargs['mpirun_cmd'], kwargs['mpirun_opts'], 4, 'hydro/athinput.turb',
+                  arguments + ['job/problem_id=turb_sync4', 'mesh/num_threads=2',
+                               'turbulence/async_driving=false'])
+    athena.mpirestart(kwargs['mpirun_cmd'], kwargs['mpirun_opts'], 4,
+                      'turb_async4.00001.rst',
+                      ['time/ncycle_out=0', 'job/problem_id=turb_async4_rst'])
+    return 'skip_lcov'
+
+
+# Analyze outputs
+def analyze():
+    analyze_status = True
+
+    def kinetic_energy(filename):
+        hst = athena_read.hst(filename)
+        return hst['1-KE'] + hst['2-KE'] + hst['3-KE']
+
+    ke1 = kinetic_energy('bin/turb_async1.hst')
+    ke4 = kinetic_energy('bin/turb_async4.hst')
+    diff = np.sum(np.abs(ke4 - ke1))
+    if diff > 1.e-7:
+        logger.warning('async driving on 1 and 4 ranks differs by %g', diff)
+        analyze_status = False
+
+    diff = np.sum(np.abs(kinetic_energy('bin/turb_sync4.hst') - ke4))
+    if diff < 1.e-10:
+        logger.warning('async driving gives the synchronous result; helper thread unused?')
+        analyze_status = False
+
+    # a restarted run does not write a header; columns are those of turb_async4.hst
+    hst = athena_read.hst('bin/turb_async4.hst')
+    rst = np.atleast_2d(np.loadtxt('bin/turb_async4_rst.hst'))
+    columns = list(hst.keys())
+    ke_rst = sum(rst[:, columns.index(var)] for var in ['1-KE', '2-KE', '3-KE'])
+    diff = np.max(np.abs(ke_rst - ke4[-len(ke_rst):]))
+    if diff > 1.e-12:
+        logger.warning('restarted async run differs by %g', diff)
+        analyze_status = False
+
+    return analyze_status
@@ -130,6 +130,27 @@ def restart(input_filename, arguments):
         os.chdir(current_dir)
 
 
+def mpirestart(mpirun_cmd, mpirun_opts, nproc, input_filename, arguments):
+    current_dir = os.getcwd()
+    os.chdir('bin')
+    out_log = LogPipe('athena.run', logging.INFO)
+    try:
+        run_command = [mpirun_cmd] + mpirun_opts + ['-n', str(nproc), './athena', '-r',
+                                                    input_filename]
+        run_command = list(filter(None, run_command))  # remove any empty strings
+        try:
+            cmd = run_command + arguments
+            logging.getLogger('athena.run').debug('Executing (mpirun restart): '
+                                                  + ' '.join(cmd))
+            subprocess.check_call(cmd, stdout=out_log)
+        except subprocess.CalledProcessError as err:
+            raise AthenaError('Return code {0} from command \'{1}\''
+                              .format(err.returncode, ' '.join(err.cmd)))
+    finally:
+        out_log.close()
+        os.chdir(current_dir)
+
+
 def mpirun(mpirun_cmd, mpirun_opts, nproc, input_filename, arguments,
            lcov_test_suffix=None):
     current_dir = os.getcwd()
@@ -328,16 +328,40 @@ def vtk(filename):
 
 # ========================================================================================
 
+class _PyramidView(object):
+    """Read-only view of an .athdf file in which the datasets and attributes of the
+    group /Pyramid<factor> take the place of those of the root."""
+
+    def __init__(self, f, factor):
+        name = 'Pyramid' + repr(factor)
+        if name not in f:
+            raise AthenaError('No restricted copy with factor {0} in file'.format(factor))
+        self.group = f[name]
+        self.root = f
+        self.attrs = dict(f.attrs)
+        self.attrs.update(self.group.attrs)
+
+    def __getitem__(self, name):
+        if name in self.group:
+            return self.group[name]
+        return self.root[name]
+
+
 def athdf(filename, raw=False, data=None, quantities=None, dtype=None, level=None,
           return_levels=False, subsample=False, fast_restrict=False, x1_min=None,
           x1_max=None, x2_min=None, x2_max=None, x3_min=None, x3_max=None, vol_func=None,
           vol_params=None, face_func_1=None, face_func_2=None, face_func_3=None,
-          center_func_1=None, center_func_2=None, center_func_3=None, num_ghost=0):
+          center_func_1=None, center_func_2=None, center_func_3=None, num_ghost=0,
+          pyramid=1):
     """Read .athdf files and populate dict of arrays of data.
 
 
     Keyword arguments:
     raw -- if True, do not merge MeshBlocks into a single array (default False)
+    x1_min, x1_max, ... -- bounds of the selection; they default to the region of
+                           interest of outputs written with x1min, x1max, ...
+    pyramid -- read the copy of the data restricted by this factor, written with
+               pyramid_levels > 0 (default 1, the full data)
     """
 
     # Load HDF5 reader
@@ -347,6 +371,8 @@ def athdf(filename, raw=False, data=None, quantities=None, dtype=None, level=Non
     if raw:
         # Open file
         with h5py.File(filename, 'r') as f:
+            if pyramid > 1:
+                f = _PyramidView(f, pyramid)
             # Store file-level attributes
             data = {}
             for key in f.attrs:
@@ -395,6 +421,18 @@ def athdf(filename, raw=False, data=None, quantities=None, dtype=None, level=Non
 
     # Open file
     with h5py.File(filename, 'r') as f:
+        if pyramid > 1:
+            f = _PyramidView(f, pyramid)
+
+        # Select the region of interest of the output by default
+        if 'RegionX1' in f.attrs:
+            x1_min = f.attrs['RegionX1'][0] if x1_min is None else x1_min
+            x1_max = f.attrs['RegionX1'][1] if x1_max is None else x1_max
+            x2_min = f.attrs['RegionX2'][0] if x2_min is None else x2_min
+            x2_max = f.attrs['RegionX2'][1] if x2_max is None else x2_max
+            x3_min = f.attrs['RegionX3'][0] if x3_min is None else x3_min
+            x3_max = f.attrs['RegionX3'][1] if x3_max is None else x3_max
+
         # Extract size information
         max_level = f.attrs['MaxLevel']
         if level is None:
@@ -601,7 +639,7 @@ def athdf(filename, raw=False, data=None, quantities=None, dtype=None, level=Non
             quantity_indices.append(dataset_index)
 
         # Locate fine block for coordinates in case of slice
-        fine_block = np.where(levels == max_level)[0][0]
+        fine_block = np.argmax(levels)
         x1m = f['x1f'][fine_block, 0]
         x1p = f['x1f'][fine_block, 1]
         x2m = f['x2f'][fine_block, 0]
@@ -636,11 +674,20 @@ def athdf(filename, raw=False, data=None, quantities=None, dtype=None, level=Non
                         data[xf] = np.empty(nx + 1, dtype=dtype)
                         for n_block in range(int((nx - 2*num_ghost)
                                                  / (block_size[d-1] - 2*num_ghost))):
-                            sample_block = np.where(logical_locations[:, d-1]
-                                                    == n_block)[0][0]
+                            sample_blocks = np.where(logical_locations[:, d-1]
+                                                     == n_block)[0]
                             index_low = n_block * (block_size[d-1] - 2*num_ghost)
                             index_high = index_low + block_size[d-1] + 1
-                            data[xf][index_low:index_high] = f[xf][sample_block, :]
+                            if len(sample_blocks) > 0:
+                                data[xf][index_low:index_high] = \
+                                    f[xf][sample_blocks[0], :]
+                            elif num_ghost > 0:
+                                raise AthenaError('Cannot use ghost zones with'
+                                                  + ' MeshBlocks outside of the'
+                                                  + ' output region')
+                            else:  # MeshBlocks outside of the output region
+                                data[xf][index_low:index_high] = np.linspace(
+                                    xmin, xmax, nx + 1, dtype=dtype)[index_low:index_high]
                     else:
                         if num_ghost > 0:
                             raise AthenaError('Cannot use ghost zones with different'